@@ -119,7 +119,15 @@ typedef struct {
  * - `ROCJPEG_OUTPUT_Y`: Returns only the luma component (Y) and writes it to the first channel of the RocJpegImage.
  * - `ROCJPEG_OUTPUT_RGB`: Converts the decoded image to interleaved RGB format using the VCN JPEG decoder or HIP kernels and writes it to the first channel of the RocJpegImage.
  * - `ROCJPEG_OUTPUT_RGB_PLANAR`: Converts the decoded image to RGB PLANAR format using the VCN JPEG decoder or HIP kernels and writes the RGB channels to separate channels of the RocJpegImage.
+ * - `ROCJPEG_OUTPUT_YUV_PLANAR_16`, `ROCJPEG_OUTPUT_Y_16`, `ROCJPEG_OUTPUT_RGB_16`, `ROCJPEG_OUTPUT_RGB_PLANAR_16`: The same as the corresponding 8-bit formats, with 16-bit samples (uint16_t)
+ *   that keep the precision of the image (0 to 255 for 8-bit images, 0 to 4095 for 12-bit images). The image is decoded by the hybrid decoder (the entropy decoding on the CPU, the IDCT and the color conversion on the GPU).
  * - `ROCJPEG_OUTPUT_FORMAT_MAX`: Maximum allowed value for the output format.
+ *
+ * With the 8-bit output formats, the samples of a 12-bit image are scaled to 8 bits.
+ *
+ * Images with four components (CMYK, or YCCK as flagged by an Adobe APP14 marker) are decoded by the hybrid decoder.
+ * The native and YUV planar formats write the four components (C, M, Y, and K, or Y, Cb, Cr, and K) to the four channels
+ * at their own resolution, the Y formats write the first component, and the RGB formats convert the image to RGB.
  */
 typedef enum {
     /**< return native unchanged decoded YUV image from the VCN JPEG decoder.
@@ -137,9 +145,51 @@ typedef enum {
     ROCJPEG_OUTPUT_RGB = 3,
     /**< convert to RGB PLANAR using VCN JPEG decoder (on MI300+) or HIP kernels and write to first, second, and third channel of RocJpegImage. */
     ROCJPEG_OUTPUT_RGB_PLANAR = 4,
-    ROCJPEG_OUTPUT_FORMAT_MAX = 5 /**< maximum allowed value */
+    /**< extract Y, U, and V channels as 16-bit samples and write into first, second, and third channel of RocJpegImage.
+         For ROCJPEG_CSS_400 write Y to first channel of RocJpegImage */
+    ROCJPEG_OUTPUT_YUV_PLANAR_16 = 5,
+    /**< return luma component (Y) as 16-bit samples and write to first channel of RocJpegImage */
+    ROCJPEG_OUTPUT_Y_16 = 6,
+    /**< convert to interleaved RGB with 16-bit samples using HIP kernels and write to first channel of RocJpegImage */
+    ROCJPEG_OUTPUT_RGB_16 = 7,
+    /**< convert to RGB PLANAR with 16-bit samples using HIP kernels and write to first, second, and third channel of RocJpegImage */
+    ROCJPEG_OUTPUT_RGB_PLANAR_16 = 8,
+    ROCJPEG_OUTPUT_FORMAT_MAX = 9 /**< maximum allowed value */
 } RocJpegOutputFormat;
 
+/**
+ * @enum RocJpegOrientation
+ * @ingroup group_amd_rocjpeg
+ * @brief Enum representing the orientation of a JPEG image.
+ *
+ * The values 1 to 8 match the values of the EXIF orientation tag (0x0112) and describe the transformation
+ * that has to be applied to the stored image to display it upright.
+ *
+ * The available orientations are:
+ * - `ROCJPEG_ORIENTATION_NONE`: The image is returned as stored in the JPEG stream (default).
+ * - `ROCJPEG_ORIENTATION_NORMAL`: The stored image is already upright.
+ * - `ROCJPEG_ORIENTATION_FLIP_HORIZONTAL`: Mirror the image horizontally.
+ * - `ROCJPEG_ORIENTATION_ROTATE_180`: Rotate the image by 180 degrees.
+ * - `ROCJPEG_ORIENTATION_FLIP_VERTICAL`: Mirror the image vertically.
+ * - `ROCJPEG_ORIENTATION_TRANSPOSE`: Mirror the image along its main diagonal.
+ * - `ROCJPEG_ORIENTATION_ROTATE_90`: Rotate the image by 90 degrees clockwise.
+ * - `ROCJPEG_ORIENTATION_TRANSVERSE`: Mirror the image along its anti-diagonal.
+ * - `ROCJPEG_ORIENTATION_ROTATE_270`: Rotate the image by 270 degrees clockwise.
+ * - `ROCJPEG_ORIENTATION_EXIF`: Apply the orientation recorded in the EXIF data of the JPEG stream, if any.
+ */
+typedef enum {
+    ROCJPEG_ORIENTATION_NONE = 0,
+    ROCJPEG_ORIENTATION_NORMAL = 1,
+    ROCJPEG_ORIENTATION_FLIP_HORIZONTAL = 2,
+    ROCJPEG_ORIENTATION_ROTATE_180 = 3,
+    ROCJPEG_ORIENTATION_FLIP_VERTICAL = 4,
+    ROCJPEG_ORIENTATION_TRANSPOSE = 5,
+    ROCJPEG_ORIENTATION_ROTATE_90 = 6,
+    ROCJPEG_ORIENTATION_TRANSVERSE = 7,
+    ROCJPEG_ORIENTATION_ROTATE_270 = 8,
+    ROCJPEG_ORIENTATION_EXIF = 9
+} RocJpegOrientation;
+
 /**
  * @struct RocJpegDecodeParams
  * @ingroup group_amd_rocjpeg
@@ -161,8 +211,20 @@ typedef struct {
     struct {
         uint32_t width; /**< Target width of the picture to be resized. */
         uint32_t height; /**< Target height of the picture to be resized. */
-    } target_dimension; /**< (future use) Defines the target width and height of the picture to be resized. Both should be even.
-                            If specified, allocate the RocJpegImage buffers based on these dimensions. */
+    } target_dimension; /**< Defines the target width and height to which the (cropped) picture is resized before the orientation
+                            is applied; zero for both keeps the picture size. If specified, allocate the RocJpegImage buffers based on
+                            these dimensions. The picture is decoded on the CPU with reduced-size IDCTs (1/2, 1/4, or 1/8 scale)
+                            and finished with a bilinear resize; the hardware and hybrid backends route these images to
+                            their CPU decoders and copy the result to the device memory of the destination. */
+    RocJpegOrientation orientation; /**< Orientation to apply to the output. See RocJpegOrientation for description. The crop rectangle
+                                         is given in the coordinates of the stored image and is applied before the orientation. For
+                                         ROCJPEG_ORIENTATION_TRANSPOSE through ROCJPEG_ORIENTATION_ROTATE_270 the width and height of
+                                         every output channel are swapped. Not supported for ROCJPEG_OUTPUT_NATIVE with 4:2:2 subsampling. */
+    bool dc_only; /**< If true, decodes a preview of the picture from the DC coefficients only: one sample per 8x8 block, so the (cropped)
+                       picture of width W and height H is output as ceil(W/8) x ceil(H/8) in any output format, and the RocJpegImage buffers
+                       must be allocated for these dimensions. The crop rectangle is given in the coordinates of the full picture. The AC
+                       coefficients are skipped by the entropy decoder and no IDCT is computed. Supported by the CPU and hybrid backends;
+                       with the hardware backend the previews are decoded by the hybrid decoder. */
 } RocJpegDecodeParams;
 
 /**
@@ -171,11 +233,18 @@ typedef struct {
  * @brief The backend options for the rocJpeg library.
  *
  * This enum defines the available backend options for the rocJpeg library.
- * The backend can be either hardware or hybrid.
+ * The backend can be hardware, hybrid, or CPU. The hardware backend decodes the images with the VCN JPEG decoder
+ * and falls back to the hybrid path for the images the VCN can't decode. The hybrid backend decodes every image with
+ * the hybrid path, which doesn't need a VCN JPEG decoder: the entropy-coded data of the images of a batch is decoded
+ * in parallel on the CPU, and the dequantization, the IDCT, and the color conversion run on the GPU. The CPU backend
+ * decodes every image entirely on the CPU and doesn't need a GPU; the channels of the destination images must be in
+ * host memory. It supports every output format, the crop rectangle, and the orientation, with the same output as the
+ * hybrid backend, and the images of a batch are decoded in parallel.
  */
 typedef enum {
     ROCJPEG_BACKEND_HARDWARE = 0, /**< Hardware backend option. */
-    ROCJPEG_BACKEND_HYBRID = 1    /**< Hybrid backend option. */
+    ROCJPEG_BACKEND_HYBRID = 1,   /**< Hybrid backend option. */
+    ROCJPEG_BACKEND_CPU = 2       /**< CPU backend option; the destination images are in host memory. */
 } RocJpegBackend;
 
 /**
@@ -209,7 +278,8 @@ RocJpegStatus ROCJPEGAPI rocJpegStreamCreate(RocJpegStreamHandle *jpeg_stream_ha
  * @brief Parses a JPEG stream.
  *
  * This function parses a JPEG stream represented by the `data` parameter of length `length`.
- * The parsed stream is associated with the `jpeg_stream_handle` provided.
+ * The parsed stream is associated with the `jpeg_stream_handle` provided. A stream handle is not synchronized;
+ * it must not be parsed, or parsed and decoded, from multiple threads at the same time.
  *
  * @param data The pointer to the JPEG stream data.
  * @param length The length of the JPEG stream data.
@@ -218,6 +288,116 @@ RocJpegStatus ROCJPEGAPI rocJpegStreamCreate(RocJpegStreamHandle *jpeg_stream_ha
  */
 RocJpegStatus ROCJPEGAPI rocJpegStreamParse(const unsigned char *data, size_t length, RocJpegStreamHandle jpeg_stream_handle);
 
+/**
+ * @fn RocJpegStatus ROCJPEGAPI rocJpegStreamParseBatched(const unsigned char **data, const size_t *lengths, int batch_size, RocJpegStreamHandle *jpeg_stream_handles, RocJpegStatus *statuses);
+ * @ingroup group_amd_rocjpeg
+ * @brief Parses a batch of JPEG streams in parallel.
+ *
+ * This function parses the JPEG stream `data[i]` of length `lengths[i]` into `jpeg_stream_handles[i]` for each i in
+ * [0, batch_size). The streams are parsed in parallel on an internal pool of worker threads shared by the process; the
+ * number of threads defaults to the number of hardware threads and can be set with the ROCJPEG_NUM_THREADS environment
+ * variable. The stream handles in a batch must be distinct.
+ *
+ * A failure to parse one stream doesn't fail the whole batch: the status of each stream is returned in `statuses[i]`,
+ * with the same values as rocJpegStreamParse (ROCJPEG_STATUS_SUCCESS, ROCJPEG_STATUS_INVALID_PARAMETER,
+ * ROCJPEG_STATUS_BAD_JPEG, or ROCJPEG_STATUS_RUNTIME_ERROR).
+ *
+ * @param data An array of pointers to the JPEG stream data.
+ * @param lengths An array of the lengths of the JPEG stream data.
+ * @param batch_size The number of JPEG streams in the batch.
+ * @param jpeg_stream_handles An array of the handles to the JPEG streams.
+ * @param statuses An array that will store the parsing status of each JPEG stream.
+ * @return The status of the operation. Returns ROCJPEG_STATUS_SUCCESS if the batch was processed (check `statuses`
+ *         for the result of each stream), or ROCJPEG_STATUS_INVALID_PARAMETER if one of the arrays is NULL or
+ *         `batch_size` is negative.
+ */
+RocJpegStatus ROCJPEGAPI rocJpegStreamParseBatched(const unsigned char **data, const size_t *lengths, int batch_size, RocJpegStreamHandle *jpeg_stream_handles, RocJpegStatus *statuses);
+
+/**
+ * @enum RocJpegStreamChunkFlags
+ * @ingroup group_amd_rocjpeg
+ * @brief Flags describing a chunk of a JPEG stream passed to rocJpegStreamParseChunk.
+ */
+typedef enum {
+    ROCJPEG_STREAM_CHUNK_FIRST = 0x1, /**< The chunk starts a new JPEG stream. */
+    ROCJPEG_STREAM_CHUNK_LAST = 0x2   /**< No more data of the JPEG stream follows the chunk. */
+} RocJpegStreamChunkFlags;
+
+/**
+ * @enum RocJpegStreamParseState
+ * @ingroup group_amd_rocjpeg
+ * @brief The progress of a JPEG stream that is parsed in chunks.
+ */
+typedef enum {
+    ROCJPEG_STREAM_PARSE_HEADER_PENDING = 0, /**< The header (up to the SOS marker) isn't completely received yet. */
+    ROCJPEG_STREAM_PARSE_SCAN_PENDING = 1, /**< The header is parsed and the image information can be retrieved;
+                                                the end of the scan data isn't received yet. */
+    ROCJPEG_STREAM_PARSE_COMPLETE = 2 /**< The stream is completely parsed and can be decoded. */
+} RocJpegStreamParseState;
+
+/**
+ * @fn RocJpegStatus ROCJPEGAPI rocJpegStreamParseChunk(const unsigned char *data, size_t length, uint32_t flags, RocJpegStreamHandle jpeg_stream_handle, RocJpegStreamParseState *parse_state);
+ * @ingroup group_amd_rocjpeg
+ * @brief Parses a JPEG stream that is received in chunks.
+ *
+ * This function appends the chunk represented by the `data` parameter of length `length` to the JPEG stream
+ * being parsed into `jpeg_stream_handle`, and parses as much of the stream as the received data allows. The first
+ * chunk of a stream must be passed with the ROCJPEG_STREAM_CHUNK_FIRST flag, which discards any stream in progress
+ * on the handle. The chunks are copied into a buffer owned by the handle, so the memory of a chunk can be reused as
+ * soon as the function returns.
+ *
+ * The header is parsed as soon as the SOS marker segment is received (`parse_state` becomes
+ * ROCJPEG_STREAM_PARSE_SCAN_PENDING), so rocJpegGetImageInfo can be called while the scan data is still being
+ * received. The end of the scan data is tracked as the chunks arrive, and the stream can be decoded once
+ * `parse_state` is ROCJPEG_STREAM_PARSE_COMPLETE, which happens when the EOI marker is received or, at the latest,
+ * with the chunk passed with the ROCJPEG_STREAM_CHUNK_LAST flag.
+ *
+ * @param data The pointer to the chunk data. It may be NULL if `length` is 0.
+ * @param length The length of the chunk data.
+ * @param flags A combination of RocJpegStreamChunkFlags.
+ * @param jpeg_stream_handle The handle to the JPEG stream.
+ * @param parse_state Pointer that will store the progress of the stream.
+ * @return The status of the operation. Returns ROCJPEG_STATUS_SUCCESS if the data received so far is valid,
+ *         ROCJPEG_STATUS_BAD_JPEG if the JPEG stream is invalid, or ROCJPEG_STATUS_INVALID_PARAMETER if the
+ *         parameters are invalid or no chunked parse is in progress on the handle.
+ */
+RocJpegStatus ROCJPEGAPI rocJpegStreamParseChunk(const unsigned char *data, size_t length, uint32_t flags, RocJpegStreamHandle jpeg_stream_handle, RocJpegStreamParseState *parse_state);
+
+/**
+ * @struct RocJpegTableCacheStats
+ * @ingroup group_amd_rocjpeg
+ * @brief Statistics of the table cache.
+ *
+ * The JPEG stream parser interns the Huffman (DHT) and quantization (DQT) tables of the parsed streams in a
+ * process-wide, bounded cache, so that the streams using the same tables share them and the decoder can reuse the
+ * buffers it prepared for them. A hit means that the tables of a stream were already in the cache.
+ */
+typedef struct {
+    uint64_t huffman_table_hits; /**< The number of streams whose Huffman tables were found in the cache. */
+    uint64_t huffman_table_misses; /**< The number of streams whose Huffman tables were added to the cache. */
+    uint64_t huffman_table_evictions; /**< The number of Huffman tables evicted from the cache. */
+    uint32_t num_huffman_tables; /**< The number of Huffman tables in the cache. */
+    uint64_t quantization_table_hits; /**< The number of streams whose quantization tables were found in the cache. */
+    uint64_t quantization_table_misses; /**< The number of streams whose quantization tables were added to the cache. */
+    uint64_t quantization_table_evictions; /**< The number of quantization tables evicted from the cache. */
+    uint32_t num_quantization_tables; /**< The number of quantization tables in the cache. */
+} RocJpegTableCacheStats;
+
+/**
+ * @fn RocJpegStatus ROCJPEGAPI rocJpegGetTableCacheStats(RocJpegTableCacheStats *stats);
+ * @ingroup group_amd_rocjpeg
+ * @brief Retrieves the statistics of the table cache.
+ *
+ * This function retrieves the hit and miss counts of the process-wide cache of Huffman and quantization tables
+ * since the start of the process. The size of the cache defaults to 1024 tables of each kind and can be set with
+ * the ROCJPEG_TABLE_CACHE_SIZE environment variable. This function is thread safe.
+ *
+ * @param stats Pointer to the structure that will store the statistics.
+ * @return The status of the operation. Returns ROCJPEG_STATUS_SUCCESS if the statistics are retrieved, or
+ *         ROCJPEG_STATUS_INVALID_PARAMETER if `stats` is NULL.
+ */
+RocJpegStatus ROCJPEGAPI rocJpegGetTableCacheStats(RocJpegTableCacheStats *stats);
+
 /**
  * @fn RocJpegStatus ROCJPEGAPI rocJpegStreamDestroy(RocJpegStreamHandle jpeg_stream_handle);
  * @ingroup group_amd_rocjpeg
@@ -249,7 +429,7 @@ typedef void *RocJpegHandle;
  * This function creates a RocJpegHandle for JPEG decoding using the specified backend and device ID.
  *
  * @param backend The backend to be used for JPEG decoding.
- * @param device_id The ID of the device to be used for JPEG decoding.
+ * @param device_id The ID of the device to be used for JPEG decoding; ignored by the ROCJPEG_BACKEND_CPU backend.
  * @param handle Pointer to a RocJpegHandle variable to store the created handle.
  * @return The status of the operation. Returns ROCJPEG_STATUS_INVALID_PARAMETER if handle is nullptr,
  *         ROCJPEG_STATUS_NOT_INITIALIZED if the rocJPEG handle initialization fails, or the status
@@ -295,6 +475,113 @@ RocJpegStatus ROCJPEGAPI rocJpegDestroy(RocJpegHandle handle);
  */
 RocJpegStatus ROCJPEGAPI rocJpegGetImageInfo(RocJpegHandle handle, RocJpegStreamHandle jpeg_stream_handle, uint8_t *num_components, RocJpegChromaSubsampling *subsampling, uint32_t *widths, uint32_t *heights);
 
+/**
+ * @fn RocJpegStatus ROCJPEGAPI rocJpegGetImageOrientation(RocJpegStreamHandle jpeg_stream_handle, RocJpegOrientation *orientation);
+ * @ingroup group_amd_rocjpeg
+ * @brief Retrieves the EXIF orientation of a parsed JPEG stream.
+ *
+ * This function returns the value of the orientation tag found in the EXIF (APP1) segment of the JPEG stream.
+ * ROCJPEG_ORIENTATION_NORMAL is returned when the stream has no EXIF data or no valid orientation tag.
+ *
+ * @param jpeg_stream_handle The handle to the parsed JPEG stream.
+ * @param orientation Pointer to store the orientation of the image (ROCJPEG_ORIENTATION_NORMAL to ROCJPEG_ORIENTATION_ROTATE_270).
+ * @return The status of the operation.
+ */
+RocJpegStatus ROCJPEGAPI rocJpegGetImageOrientation(RocJpegStreamHandle jpeg_stream_handle, RocJpegOrientation *orientation);
+
+/**
+ * @enum RocJpegEmbeddedImageType
+ * @ingroup group_amd_rocjpeg
+ * @brief The kinds of images a JPEG stream can hold.
+ */
+typedef enum {
+    ROCJPEG_EMBEDDED_IMAGE_PRIMARY = 0, /**< The primary image of the JPEG stream. */
+    ROCJPEG_EMBEDDED_IMAGE_EXIF_THUMBNAIL = 1, /**< The JPEG thumbnail stored in the EXIF (APP1) segment. */
+    ROCJPEG_EMBEDDED_IMAGE_MPF = 2 /**< An individual image of a Multi-Picture Format (APP2) file, such as a large preview. */
+} RocJpegEmbeddedImageType;
+
+/**
+ * @struct RocJpegEmbeddedImageInfo
+ * @ingroup group_amd_rocjpeg
+ * @brief Information about a JPEG image embedded in a JPEG stream.
+ */
+typedef struct {
+    RocJpegEmbeddedImageType type; /**< Where the image is stored. */
+    uint32_t width; /**< The width of the image. */
+    uint32_t height; /**< The height of the image. */
+    uint32_t offset; /**< The offset of the image from the start of the parsed data. */
+    uint32_t length; /**< The length of the image in bytes. */
+} RocJpegEmbeddedImageInfo;
+
+/**
+ * @fn RocJpegStatus ROCJPEGAPI rocJpegGetEmbeddedImages(RocJpegStreamHandle jpeg_stream_handle, RocJpegEmbeddedImageInfo *images, uint32_t *num_images);
+ * @ingroup group_amd_rocjpeg
+ * @brief Retrieves the JPEG images embedded in a parsed JPEG stream.
+ *
+ * The parser records the JPEG thumbnail of the EXIF data and the individual images listed in the Multi-Picture
+ * Format data, as long as they are completely contained in the parsed data and their frame header can be read.
+ * The individual images of an MPF file follow the primary image, so they are only found if the data passed to
+ * rocJpegStreamParse includes them; a chunked parse, which stops at the end of the primary image, doesn't find them.
+ *
+ * If `images` is NULL, `num_images` receives the number of embedded images. Otherwise, `num_images` holds the
+ * capacity of the `images` array on input and receives the number of entries written.
+ *
+ * @param jpeg_stream_handle The handle to the parsed JPEG stream.
+ * @param images Pointer to the array that will store the embedded images, or NULL.
+ * @param num_images Pointer to the number of embedded images.
+ * @return The status of the operation.
+ */
+RocJpegStatus ROCJPEGAPI rocJpegGetEmbeddedImages(RocJpegStreamHandle jpeg_stream_handle, RocJpegEmbeddedImageInfo *images, uint32_t *num_images);
+
+/**
+ * @fn RocJpegStatus ROCJPEGAPI rocJpegStreamParseEmbeddedImage(RocJpegStreamHandle jpeg_stream_handle, uint32_t min_width, uint32_t min_height, RocJpegStreamHandle embedded_stream_handle, RocJpegEmbeddedImageType *image_type);
+ * @ingroup group_amd_rocjpeg
+ * @brief Parses the smallest image of a JPEG stream that is at least a requested size.
+ *
+ * This function selects, among the embedded images of the stream parsed into `jpeg_stream_handle`, the smallest
+ * one whose width and height are at least `min_width` and `min_height`, and parses it into `embedded_stream_handle`.
+ * If no embedded image is large enough (or none can be parsed), the primary image is parsed instead. The selected
+ * image is then decoded with rocJpegDecode like any parsed stream, so that a small output can be produced from,
+ * e.g., a 160x120 EXIF thumbnail or an MPF preview rather than from the full-resolution primary image.
+ *
+ * Both handles reference the data that was parsed into `jpeg_stream_handle`, which must stay valid until the
+ * selected image is decoded.
+ *
+ * @param jpeg_stream_handle The handle to the parsed JPEG stream.
+ * @param min_width The minimum width of the selected image.
+ * @param min_height The minimum height of the selected image.
+ * @param embedded_stream_handle The handle that receives the selected image; it must differ from `jpeg_stream_handle`.
+ * @param image_type Pointer that will store the kind of the selected image.
+ * @return The status of the operation. Returns ROCJPEG_STATUS_BAD_JPEG if neither an embedded image nor the primary
+ *         image can be parsed.
+ */
+RocJpegStatus ROCJPEGAPI rocJpegStreamParseEmbeddedImage(RocJpegStreamHandle jpeg_stream_handle, uint32_t min_width, uint32_t min_height, RocJpegStreamHandle embedded_stream_handle, RocJpegEmbeddedImageType *image_type);
+
+/**
+ * @fn RocJpegStatus ROCJPEGAPI rocJpegPeekImageInfo(const unsigned char *data, size_t length, uint8_t *num_components, RocJpegChromaSubsampling *subsampling, uint32_t *widths, uint32_t *heights);
+ * @ingroup group_amd_rocjpeg
+ * @brief Retrieves information about a JPEG image by parsing only its header.
+ *
+ * This function parses the marker segments of the JPEG stream represented by the `data` parameter of length `length`
+ * up to the Start of Frame (SOF) marker, and returns the number of components, chroma subsampling, and dimensions
+ * (width and height) of the JPEG image. The entropy-coded scan data is not visited, so the cost is proportional to
+ * the size of the header. No RocJpegHandle or RocJpegStreamHandle is required; use rocJpegStreamParse before decoding.
+ *
+ * @param data The pointer to the JPEG stream data.
+ * @param length The length of the JPEG stream data.
+ * @param num_components A pointer to an unsigned 8-bit integer that will store the number of components in the JPEG image.
+ * @param subsampling A pointer to a RocJpegChromaSubsampling enum that will store the chroma subsampling information.
+ * @param widths A pointer to an unsigned 32-bit integer array that will store the width of each component in the JPEG image.
+ * @param heights A pointer to an unsigned 32-bit integer array that will store the height of each component in the JPEG image.
+ *
+ * @return The RocJpegStatus indicating the success or failure of the operation.
+ *         - ROCJPEG_STATUS_SUCCESS: The operation was successful.
+ *         - ROCJPEG_STATUS_INVALID_PARAMETER: One or more input parameters are invalid.
+ *         - ROCJPEG_STATUS_BAD_JPEG: The JPEG header is invalid or the SOF marker is not found.
+ *         - ROCJPEG_STATUS_RUNTIME_ERROR: An exception occurred during the operation.
+ */
+RocJpegStatus ROCJPEGAPI rocJpegPeekImageInfo(const unsigned char *data, size_t length, uint8_t *num_components, RocJpegChromaSubsampling *subsampling, uint32_t *widths, uint32_t *heights);
+
 /**
  * @fn RocJpegStatus ROCJPEGAPI rocJpegDecode(RocJpegHandle handle, RocJpegStreamHandle jpeg_stream_handle, const RocJpegDecodeParams *decode_params, RocJpegImage *destination);
  * @ingroup group_amd_rocjpeg
@@ -320,6 +607,8 @@ RocJpegStatus ROCJPEGAPI rocJpegDecode(RocJpegHandle handle, RocJpegStreamHandle
  * @brief Decodes a batch of JPEG images using the rocJPEG library.
  *
  * Decodes a batch of JPEG images using the rocJPEG library.
+ * An image that fails to decode doesn't stop the batch: the other images are still decoded to their destinations,
+ * and the status of the first image that failed is returned.
  *
  * @param handle The rocJPEG handle.
  * @param jpeg_stream_handles An array of rocJPEG stream handles representing the input JPEG streams.
@@ -330,6 +619,133 @@ RocJpegStatus ROCJPEGAPI rocJpegDecode(RocJpegHandle handle, RocJpegStreamHandle
  */
 RocJpegStatus ROCJPEGAPI rocJpegDecodeBatched(RocJpegHandle handle, RocJpegStreamHandle *jpeg_stream_handles, int batch_size, const RocJpegDecodeParams *decode_params, RocJpegImage *destinations);
 
+/**
+ * @enum RocJpegCoefficientFormat
+ * @ingroup group_amd_rocjpeg
+ * @brief The values of the DCT coefficients written by rocJpegDecodeCoefficients().
+ */
+typedef enum {
+    ROCJPEG_COEFFICIENTS_QUANTIZED = 0, /**< The quantized coefficients, as coded in the stream. */
+    ROCJPEG_COEFFICIENTS_DEQUANTIZED = 1, /**< The coefficients multiplied by the quantization table of their component,
+                                               saturated to the int16_t range. */
+} RocJpegCoefficientFormat;
+
+/**
+ * @struct RocJpegCoefficientParams
+ * @ingroup group_amd_rocjpeg
+ * @brief Structure containing the parameters of a DCT coefficient decode.
+ */
+typedef struct {
+    RocJpegCoefficientFormat coefficient_format; /**< The values of the coefficients. See RocJpegCoefficientFormat for description. */
+    bool is_host_memory; /**< True if the coefficient planes of the destinations are in host memory, false if they are in device memory.
+                              The ROCJPEG_BACKEND_CPU backend only writes to host memory. */
+} RocJpegCoefficientParams;
+
+/**
+ * @struct RocJpegCoefficientImage
+ * @ingroup group_amd_rocjpeg
+ * @brief Structure representing the DCT coefficients of a JPEG image.
+ *
+ * Each component has its own coefficient plane of widths_in_blocks x heights_in_blocks blocks, as returned by
+ * rocJpegGetCoefficientInfo(). The blocks of a row are contiguous, with the 64 int16_t coefficients of a block in
+ * natural (row-major) order, so block (x, y) of component c starts at byte y * pitch[c] + x * 128 of planes[c]; this
+ * is the layout of the coefficient arrays of the IJG libjpeg. The padding blocks that complete the last MCUs are
+ * not written.
+ */
+typedef struct {
+    int16_t* planes[ROCJPEG_MAX_COMPONENT]; /**< The coefficient plane of each component, in host or device memory. */
+    uint32_t pitch[ROCJPEG_MAX_COMPONENT]; /**< The stride (in bytes) between two rows of blocks of each plane; at least 128 * widths_in_blocks[c]. */
+    uint16_t quantization_tables[ROCJPEG_MAX_COMPONENT][64]; /**< Set to the quantization table of each component, in natural order. */
+} RocJpegCoefficientImage;
+
+/**
+ * @fn RocJpegStatus ROCJPEGAPI rocJpegGetCoefficientInfo(RocJpegStreamHandle jpeg_stream_handle, uint8_t *num_components, uint32_t *widths_in_blocks, uint32_t *heights_in_blocks);
+ * @ingroup group_amd_rocjpeg
+ * @brief Retrieves the size of the coefficient planes of a parsed JPEG stream.
+ *
+ * Component c of a frame of width W and height H with the sampling factors h and v, and the largest sampling factors
+ * hmax and vmax, has ceil(ceil(W * h / hmax) / 8) blocks per row and ceil(ceil(H * v / vmax) / 8) rows of blocks.
+ *
+ * @param jpeg_stream_handle The JPEG stream handle.
+ * @param num_components Pointer to store the number of components of the frame.
+ * @param widths_in_blocks Array of ROCJPEG_MAX_COMPONENT elements to store the number of blocks per row of each component (0 for the missing components).
+ * @param heights_in_blocks Array of ROCJPEG_MAX_COMPONENT elements to store the number of rows of blocks of each component (0 for the missing components).
+ * @return The status of the operation. Returns ROCJPEG_STATUS_INVALID_PARAMETER if a pointer is NULL.
+ */
+RocJpegStatus ROCJPEGAPI rocJpegGetCoefficientInfo(RocJpegStreamHandle jpeg_stream_handle, uint8_t *num_components, uint32_t *widths_in_blocks, uint32_t *heights_in_blocks);
+
+/**
+ * @fn RocJpegStatus ROCJPEGAPI rocJpegDecodeCoefficients(RocJpegHandle handle, RocJpegStreamHandle jpeg_stream_handle, const RocJpegCoefficientParams *coefficient_params, RocJpegCoefficientImage *destination);
+ * @ingroup group_amd_rocjpeg
+ * @brief Decodes the DCT coefficients of a JPEG image without the IDCT and the color conversion.
+ *
+ * The entropy-coded data is decoded by the software entropy decoder of the hybrid and CPU backends, for every backend,
+ * so the baseline, extended, and progressive streams are supported. The coefficients are written to the planes of
+ * the destination, and the quantization tables of the components to the destination structure.
+ *
+ * @param handle The rocJPEG handle.
+ * @param jpeg_stream_handle The JPEG stream handle.
+ * @param coefficient_params The parameters of the decode.
+ * @param destination The destination coefficient planes.
+ * @return The status of the operation. Returns ROCJPEG_STATUS_INVALID_PARAMETER if a pointer or a plane is NULL, or
+ *         if the planes are in device memory with the ROCJPEG_BACKEND_CPU backend, and ROCJPEG_STATUS_BAD_JPEG if the
+ *         stream can't be decoded.
+ */
+RocJpegStatus ROCJPEGAPI rocJpegDecodeCoefficients(RocJpegHandle handle, RocJpegStreamHandle jpeg_stream_handle, const RocJpegCoefficientParams *coefficient_params,
+                                                   RocJpegCoefficientImage *destination);
+
+/**
+ * @fn RocJpegStatus ROCJPEGAPI rocJpegDecodeCoefficientsBatched(RocJpegHandle handle, RocJpegStreamHandle *jpeg_stream_handles, int batch_size, const RocJpegCoefficientParams *coefficient_params, RocJpegCoefficientImage *destinations);
+ * @ingroup group_amd_rocjpeg
+ * @brief Decodes the DCT coefficients of a batch of JPEG images.
+ *
+ * The streams of the batch are entropy decoded in parallel on the internal thread pool. See rocJpegDecodeCoefficients().
+ *
+ * @param handle The rocJPEG handle.
+ * @param jpeg_stream_handles An array of JPEG stream handles.
+ * @param batch_size The number of JPEG streams in the batch.
+ * @param coefficient_params The parameters of the decode, shared by the batch.
+ * @param destinations An array of destination coefficient planes, one per stream.
+ * @return The status of the operation.
+ */
+RocJpegStatus ROCJPEGAPI rocJpegDecodeCoefficientsBatched(RocJpegHandle handle, RocJpegStreamHandle *jpeg_stream_handles, int batch_size,
+                                                          const RocJpegCoefficientParams *coefficient_params, RocJpegCoefficientImage *destinations);
+
+/**
+ * @struct RocJpegDecodeRouteStats
+ * @ingroup group_amd_rocjpeg
+ * @brief Counts of the images decoded by each decode path of a rocJPEG handle.
+ *
+ * The VCN JPEG decoder holds two DC and two AC Huffman tables. A scan that references the tables 2 or 3 is decoded
+ * by the VCN after its tables are remapped to the two slots, as long as it references at most two tables of each
+ * class. The images the VCN can't decode go through the hybrid path, where the entropy-coded data is decoded on the
+ * CPU and the IDCT runs on the GPU. The images with YUV 4:1:1 or an unknown chroma subsampling, which the hybrid path
+ * can't lay out, are decoded on the CPU and copied to their destination. The ROCJPEG_BACKEND_CPU backend decodes
+ * every image on the CPU. The images of a batch are routed one by one, so a batch can mix all the paths.
+ */
+typedef struct {
+    uint64_t num_hardware_decodes; /**< The number of images decoded by the VCN with the Huffman tables in the slots of their IDs. */
+    uint64_t num_hardware_remapped_decodes; /**< The number of images decoded by the VCN after their Huffman tables were remapped. */
+    uint64_t num_hybrid_decodes; /**< The number of images decoded by the hybrid path. */
+    uint64_t num_cpu_decodes; /**< The number of images decoded on the CPU, by the ROCJPEG_BACKEND_CPU backend or by the CPU path of the other backends. */
+    uint64_t num_resolution_fallbacks; /**< The number of images the ROCJPEG_BACKEND_HARDWARE backend didn't send to the VCN because their size is out of its range. */
+    uint64_t num_subsampling_fallbacks; /**< The number of images the ROCJPEG_BACKEND_HARDWARE backend didn't send to the VCN because of their chroma subsampling. */
+} RocJpegDecodeRouteStats;
+
+/**
+ * @fn RocJpegStatus ROCJPEGAPI rocJpegGetDecodeRouteStats(RocJpegHandle handle, RocJpegDecodeRouteStats *stats);
+ * @ingroup group_amd_rocjpeg
+ * @brief Retrieves the number of images decoded by each decode path of a rocJPEG handle.
+ *
+ * The counts include the images decoded by rocJpegDecode() and rocJpegDecodeBatched() since the handle was created.
+ *
+ * @param handle The rocJPEG handle.
+ * @param stats Pointer to the structure that will store the counts.
+ * @return The status of the operation. Returns ROCJPEG_STATUS_SUCCESS if the counts are retrieved, or
+ *         ROCJPEG_STATUS_INVALID_PARAMETER if `handle` or `stats` is NULL.
+ */
+RocJpegStatus ROCJPEGAPI rocJpegGetDecodeRouteStats(RocJpegHandle handle, RocJpegDecodeRouteStats *stats);
+
 /**
  * @fn extern const char* ROCDECAPI rocJpegGetErrorName(RocJpegStatus rocjpeg_status);
  * @ingroup group_amd_rocjpeg
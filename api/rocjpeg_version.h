@@ -33,8 +33,8 @@ THE SOFTWARE.
 #ifdef __cplusplus
 extern "C" {
 #endif
-#define ROCJPEG_MAJOR_VERSION 0
-#define ROCJPEG_MINOR_VERSION 6
+#define ROCJPEG_MAJOR_VERSION 1
+#define ROCJPEG_MINOR_VERSION 0
 #define ROCJPEG_MICRO_VERSION 0
 
 
@@ -0,0 +1,307 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "rocjpeg_parser.h"
+#include "rocjpeg_entropy_decoder.h"
+#include "rocjpeg_cpu_kernels.h"
+
+/**
+ * @brief A JPEG image of the input set, with its coefficients decoded once for the IDCT and color conversion stages.
+ */
+struct BenchImage {
+    std::string name;
+    std::vector<uint8_t> data;
+    JpegCoefficientImage layout;
+    std::vector<int16_t> coefficients;
+};
+
+/**
+ * @brief The time spent in each stage of the decode by one set of kernels.
+ */
+struct StageTimes {
+    uint64_t idct_ns = 0;
+    uint64_t color_ns = 0;
+    uint64_t color_pixels = 0; // the pixels of the images converted to RGB
+    uint64_t checksum = 0;
+};
+
+/**
+ * @brief Shows the usage of the benchmark and exits.
+ */
+void ShowHelpAndExit() {
+    std::cout << "Options:\n"
+    "-i     [input path] - input path to a single JPEG image or a directory containing JPEG images - [required]\n"
+    "-n     [iterations] - number of times each JPEG image is decoded by each set of kernels - [optional - default: 10]\n"
+    "-scale [denominator] - decode the images at 1/denominator of their size with the reduced-size IDCTs (1, 2, 4, or 8) - [optional - default: 1]\n";
+    exit(0);
+}
+
+/**
+ * @brief Reads the JPEG images of a file or a directory.
+ */
+static bool ReadImages(const std::string &input_path, std::vector<BenchImage> &images) {
+    std::vector<std::filesystem::path> paths;
+    if (std::filesystem::is_directory(input_path)) {
+        for (const auto &entry : std::filesystem::directory_iterator(input_path)) {
+            std::string extension = entry.path().extension().string();
+            std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+            if (entry.is_regular_file() && (extension == ".jpg" || extension == ".jpeg")) {
+                paths.push_back(entry.path());
+            }
+        }
+        std::sort(paths.begin(), paths.end());
+    } else if (std::filesystem::is_regular_file(input_path)) {
+        paths.push_back(input_path);
+    } else {
+        return false;
+    }
+    for (const auto &path : paths) {
+        std::ifstream file(path, std::ios::binary);
+        BenchImage image;
+        image.name = path.filename().string();
+        image.data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        images.push_back(std::move(image));
+    }
+    return true;
+}
+
+/**
+ * @brief Computes the inverse DCT of every component of an image and converts the image to interleaved RGB.
+ *
+ * The stages are those of the CPU backend: the IDCT writes one plane per component, and the chroma rows are
+ * upsampled and converted to RGB row by row. Only the IDCT is timed for the images that aren't YCbCr or greyscale.
+ * With a scale shift, the reduced-size IDCTs decode the image at 1/2^scale_shift of its size.
+ */
+static void DecodeImage(const RocJpegCpuKernels &kernels, const BenchImage &image, uint32_t scale_shift, std::vector<uint8_t> &planes, std::vector<uint8_t> &rgb,
+                        std::vector<uint8_t> &chroma_rows, StageTimes &times) {
+    const JpegCoefficientImage &layout = image.layout;
+    uint32_t block_size = 8 >> scale_shift;
+    size_t plane_offsets[NUM_COMPONENTS];
+    size_t planes_size = 0;
+    for (int i = 0; i < layout.num_components; i++) {
+        plane_offsets[i] = planes_size;
+        planes_size += static_cast<size_t>(layout.components[i].width_in_blocks) * block_size * layout.components[i].height_in_blocks * block_size;
+    }
+    planes.resize(planes_size);
+
+    auto start_time = std::chrono::steady_clock::now();
+    for (int i = 0; i < layout.num_components; i++) {
+        const JpegCoefficientComponent &component = layout.components[i];
+        kernels.DequantizeScaledIdctComponent(image.coefficients.data() + component.coefficient_offset, component.quantization_table, layout.sample_precision,
+                                              scale_shift, component.width_in_blocks, component.height_in_blocks, planes.data() + plane_offsets[i],
+                                              component.width_in_blocks * block_size, 1);
+    }
+    auto idct_end_time = std::chrono::steady_clock::now();
+    times.idct_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(idct_end_time - start_time).count();
+
+    bool is_greyscale = layout.num_components == 1;
+    const JpegCoefficientComponent &luma = layout.components[0];
+    bool is_ycbcr = layout.num_components == 3 && luma.h_sampling_factor == layout.max_h_sampling_factor && luma.v_sampling_factor == layout.max_v_sampling_factor;
+    if (!is_greyscale && !is_ycbcr) {
+        return;
+    }
+    uint32_t width = (layout.width + (1 << scale_shift) - 1) >> scale_shift;
+    uint32_t height = (layout.height + (1 << scale_shift) - 1) >> scale_shift;
+    uint32_t shift_x[3] = {}, shift_y[3] = {};
+    for (int i = 1; i < layout.num_components; i++) {
+        while ((layout.components[i].h_sampling_factor << shift_x[i]) < layout.max_h_sampling_factor) {
+            shift_x[i]++;
+        }
+        while ((layout.components[i].v_sampling_factor << shift_y[i]) < layout.max_v_sampling_factor) {
+            shift_y[i]++;
+        }
+    }
+    rgb.resize(static_cast<size_t>(width) * 3 * height);
+    chroma_rows.resize(2 * static_cast<size_t>(width));
+    uint8_t *cb_row_buffer = chroma_rows.data();
+    uint8_t *cr_row_buffer = cb_row_buffer + width;
+    if (is_greyscale) {
+        memset(chroma_rows.data(), 128, chroma_rows.size());
+    }
+    for (uint32_t y = 0; y < height; y++) {
+        const uint8_t *y_row = planes.data() + static_cast<size_t>(y) * luma.width_in_blocks * block_size;
+        const uint8_t *cb_row = cb_row_buffer;
+        const uint8_t *cr_row = cr_row_buffer;
+        if (!is_greyscale) {
+            uint32_t cb_pitch = layout.components[1].width_in_blocks * block_size;
+            uint32_t cr_pitch = layout.components[2].width_in_blocks * block_size;
+            cb_row = planes.data() + plane_offsets[1] + static_cast<size_t>(y >> shift_y[1]) * cb_pitch;
+            cr_row = planes.data() + plane_offsets[2] + static_cast<size_t>(y >> shift_y[2]) * cr_pitch;
+            if (shift_x[1]) {
+                kernels.UpsampleRow(cb_row, shift_x[1], width, cb_row_buffer);
+                cb_row = cb_row_buffer;
+            }
+            if (shift_x[2]) {
+                kernels.UpsampleRow(cr_row, shift_x[2], width, cr_row_buffer);
+                cr_row = cr_row_buffer;
+            }
+        }
+        kernels.ConvertYCbCrToRGBRow(y_row, cb_row, cr_row, width, rgb.data() + static_cast<size_t>(y) * width * 3);
+    }
+    auto color_end_time = std::chrono::steady_clock::now();
+    times.color_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(color_end_time - idct_end_time).count();
+    uint64_t checksum = 0;
+    for (size_t i = 0; i < rgb.size(); i++) {
+        checksum = checksum * 31 + rgb[i];
+    }
+    times.checksum += checksum;
+    times.color_pixels += static_cast<uint64_t>(width) * height;
+}
+
+int main(int argc, char **argv) {
+    std::string input_path;
+    int num_iterations = 10;
+    uint32_t scale_shift = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-h")) {
+            ShowHelpAndExit();
+        }
+        if (!strcmp(argv[i], "-i")) {
+            if (++i == argc) {
+                ShowHelpAndExit();
+            }
+            input_path = argv[i];
+            continue;
+        }
+        if (!strcmp(argv[i], "-n")) {
+            if (++i == argc) {
+                ShowHelpAndExit();
+            }
+            num_iterations = atoi(argv[i]);
+            if (num_iterations <= 0) {
+                ShowHelpAndExit();
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-scale")) {
+            if (++i == argc) {
+                ShowHelpAndExit();
+            }
+            int scale_denominator = atoi(argv[i]);
+            if (scale_denominator != 1 && scale_denominator != 2 && scale_denominator != 4 && scale_denominator != 8) {
+                ShowHelpAndExit();
+            }
+            while ((1 << scale_shift) < scale_denominator) {
+                scale_shift++;
+            }
+            continue;
+        }
+        ShowHelpAndExit();
+    }
+    if (input_path.empty()) {
+        ShowHelpAndExit();
+    }
+
+    std::vector<BenchImage> images;
+    if (!ReadImages(input_path, images) || images.empty()) {
+        std::cerr << "ERROR: no JPEG image found at " << input_path << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // entropy decode every image; this stage is shared by every set of kernels
+    RocJpegStreamParser parser;
+    RocJpegEntropyDecoder entropy_decoder;
+    uint64_t entropy_ns = 0;
+    uint64_t total_bytes = 0;
+    uint64_t total_pixels = 0;
+    for (auto it = images.begin(); it != images.end();) {
+        BenchImage &image = *it;
+        if (!parser.ParseJpegStream(image.data.data(), static_cast<uint32_t>(image.data.size())) ||
+            !entropy_decoder.SetStreamParameters(parser.GetJpegStreamParameters(), image.layout)) {
+            std::cout << "Skipping " << image.name << ": the stream can't be decoded on the CPU" << std::endl;
+            it = images.erase(it);
+            continue;
+        }
+        image.coefficients.resize(image.layout.num_coefficients);
+        bool is_decoded = true;
+        for (int n = 0; n < num_iterations && is_decoded; n++) {
+            auto start_time = std::chrono::steady_clock::now();
+            is_decoded = entropy_decoder.SetStreamParameters(parser.GetJpegStreamParameters(), image.layout) &&
+                         entropy_decoder.DecodeCoefficients(image.layout, image.coefficients.data());
+            auto end_time = std::chrono::steady_clock::now();
+            entropy_ns += std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count();
+        }
+        if (!is_decoded) {
+            std::cerr << "ERROR: failed to decode " << image.name << std::endl;
+            return EXIT_FAILURE;
+        }
+        total_bytes += image.data.size() * num_iterations;
+        total_pixels += static_cast<uint64_t>(image.layout.width) * image.layout.height * num_iterations;
+        ++it;
+    }
+    std::cout << "Decoding " << images.size() << " images at 1/" << (1 << scale_shift) << " scale " << num_iterations
+              << " times with each set of kernels, please wait!" << std::endl;
+
+    static const SimdLevel simd_levels[] = {kSimdScalar, kSimdAvx2, kSimdAvx512};
+    std::vector<uint8_t> planes, rgb, chroma_rows;
+    std::vector<StageTimes> level_times;
+    std::vector<SimdLevel> levels;
+    for (SimdLevel simd_level : simd_levels) {
+        RocJpegCpuKernels kernels(simd_level);
+        if (kernels.GetKernelSimdLevel() != simd_level) {
+            std::cout << "Skipping the " << GetSimdLevelName(simd_level) << " kernels: not supported by the CPU" << std::endl;
+            continue;
+        }
+        StageTimes times;
+        for (int n = 0; n < num_iterations; n++) {
+            for (const BenchImage &image : images) {
+                DecodeImage(kernels, image, scale_shift, planes, rgb, chroma_rows, times);
+            }
+        }
+        levels.push_back(simd_level);
+        level_times.push_back(times);
+    }
+
+    double total_mpixels = static_cast<double>(total_pixels) / 1e6;
+    std::cout << std::endl << "entropy decode: " << std::fixed << std::setprecision(2) << total_mpixels / (entropy_ns / 1e9) << " MPixels/s, "
+              << static_cast<double>(total_bytes) / (1 << 20) / (entropy_ns / 1e9) << " MiB/s" << std::endl << std::endl;
+    std::cout << std::left << std::setw(10) << "kernels" << std::right << std::setw(16) << "IDCT MPix/s" << std::setw(16) << "color MPix/s"
+              << std::setw(16) << "total MPix/s" << std::setw(10) << "speedup" << std::endl;
+    double scalar_ns = static_cast<double>(entropy_ns + level_times[0].idct_ns + level_times[0].color_ns);
+    bool is_bit_exact = true;
+    for (size_t i = 0; i < levels.size(); i++) {
+        const StageTimes &times = level_times[i];
+        double total_ns = static_cast<double>(entropy_ns + times.idct_ns + times.color_ns);
+        std::cout << std::left << std::setw(10) << GetSimdLevelName(levels[i]) << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(16) << total_mpixels / (times.idct_ns / 1e9)
+                  << std::setw(16) << (times.color_ns ? times.color_pixels / 1e6 / (times.color_ns / 1e9) : 0.0)
+                  << std::setw(16) << total_mpixels / (total_ns / 1e9)
+                  << std::setw(9) << scalar_ns / total_ns << "x" << std::endl;
+        is_bit_exact &= times.checksum == level_times[0].checksum;
+    }
+    if (!is_bit_exact) {
+        std::cerr << "ERROR: the output of the SIMD kernels differs from the output of the scalar kernels!" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << std::endl << "The output of every set of kernels is identical to the scalar output." << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,600 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "rocjpeg_parser.h"
+#include "rocjpeg_entropy_decoder.h"
+
+/**
+ * @brief The natural (row-major) position of the coefficients in zigzag order.
+ */
+static const uint8_t kZigzagToNatural[DCT_BLOCK_SIZE] = {
+     0,  1,  8, 16,  9,  2,  3, 10, 17, 24, 32, 25, 18, 11,  4,  5,
+    12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13,  6,  7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63
+};
+
+/**
+ * @brief The Huffman tables of Annex K of the JPEG standard, which most encoders use: the luminance and the
+ *        chrominance DC tables, then the luminance and the chrominance AC tables.
+ */
+static const uint8_t kAnnexKCounts[4][16] = {
+    {0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0},
+    {0, 3, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0},
+    {0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7D},
+    {0, 2, 1, 2, 4, 4, 3, 4, 7, 5, 4, 4, 0, 1, 2, 0x77}
+};
+static const uint8_t kAnnexKDcValues[12] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+static const uint8_t kAnnexKAcValues[2][162] = {
+    {0x01, 0x02, 0x03, 0x00, 0x04, 0x11, 0x05, 0x12, 0x21, 0x31, 0x41, 0x06, 0x13, 0x51, 0x61, 0x07,
+     0x22, 0x71, 0x14, 0x32, 0x81, 0x91, 0xA1, 0x08, 0x23, 0x42, 0xB1, 0xC1, 0x15, 0x52, 0xD1, 0xF0,
+     0x24, 0x33, 0x62, 0x72, 0x82, 0x09, 0x0A, 0x16, 0x17, 0x18, 0x19, 0x1A, 0x25, 0x26, 0x27, 0x28,
+     0x29, 0x2A, 0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48, 0x49,
+     0x4A, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68, 0x69,
+     0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x83, 0x84, 0x85, 0x86, 0x87, 0x88, 0x89,
+     0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7,
+     0xA8, 0xA9, 0xAA, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3, 0xC4, 0xC5,
+     0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA, 0xE1, 0xE2,
+     0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8,
+     0xF9, 0xFA},
+    {0x00, 0x01, 0x02, 0x03, 0x11, 0x04, 0x05, 0x21, 0x31, 0x06, 0x12, 0x41, 0x51, 0x07, 0x61, 0x71,
+     0x13, 0x22, 0x32, 0x81, 0x08, 0x14, 0x42, 0x91, 0xA1, 0xB1, 0xC1, 0x09, 0x23, 0x33, 0x52, 0xF0,
+     0x15, 0x62, 0x72, 0xD1, 0x0A, 0x16, 0x24, 0x34, 0xE1, 0x25, 0xF1, 0x17, 0x18, 0x19, 0x1A, 0x26,
+     0x27, 0x28, 0x29, 0x2A, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x43, 0x44, 0x45, 0x46, 0x47, 0x48,
+     0x49, 0x4A, 0x53, 0x54, 0x55, 0x56, 0x57, 0x58, 0x59, 0x5A, 0x63, 0x64, 0x65, 0x66, 0x67, 0x68,
+     0x69, 0x6A, 0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7A, 0x82, 0x83, 0x84, 0x85, 0x86, 0x87,
+     0x88, 0x89, 0x8A, 0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9A, 0xA2, 0xA3, 0xA4, 0xA5,
+     0xA6, 0xA7, 0xA8, 0xA9, 0xAA, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8, 0xB9, 0xBA, 0xC2, 0xC3,
+     0xC4, 0xC5, 0xC6, 0xC7, 0xC8, 0xC9, 0xCA, 0xD2, 0xD3, 0xD4, 0xD5, 0xD6, 0xD7, 0xD8, 0xD9, 0xDA,
+     0xE2, 0xE3, 0xE4, 0xE5, 0xE6, 0xE7, 0xE8, 0xE9, 0xEA, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7, 0xF8,
+     0xF9, 0xFA}
+};
+
+/**
+ * @brief A Huffman table of Annex K, with the code and the code length of each symbol for encoding, and the
+ *        canonical maximum code of each length for the reference decoder.
+ */
+struct HuffmanCodeTable {
+    const uint8_t *counts = nullptr;
+    const uint8_t *values = nullptr;
+    uint16_t code[256] = {};
+    uint8_t length[256] = {};
+    int32_t max_code[18] = {};
+    int32_t value_offset[17] = {};
+
+    void Build(const uint8_t *table_counts, const uint8_t *table_values) {
+        counts = table_counts;
+        values = table_values;
+        int32_t next_code = 0;
+        int32_t index = 0;
+        for (int32_t code_length = 1; code_length <= 16; code_length++) {
+            value_offset[code_length] = index - next_code;
+            for (int32_t i = 0; i < counts[code_length - 1]; i++) {
+                code[values[index]] = static_cast<uint16_t>(next_code++);
+                length[values[index]] = static_cast<uint8_t>(code_length);
+                index++;
+            }
+            max_code[code_length] = counts[code_length - 1] ? next_code - 1 : -1;
+            next_code <<= 1;
+        }
+        max_code[17] = INT32_MAX;
+    }
+};
+
+/**
+ * @brief Describes a synthetic JPEG image of the corpus.
+ */
+struct CorpusImageConfig {
+    uint16_t width;
+    uint16_t height;
+    ChromaSubsampling subsampling; // one of CSS_444, CSS_422, CSS_420, CSS_400
+    int quality; // 50, 75, 90, or 100; sets how many AC coefficients are nonzero and how large they are
+};
+
+/**
+ * @brief A synthetic JPEG image, its coefficients, and the decode times measured for it.
+ */
+struct CorpusImage {
+    CorpusImageConfig config;
+    std::vector<uint8_t> data;
+    size_t scan_offset; // the offset of the entropy-coded data in the stream
+    size_t scan_size; // the size of the entropy-coded data, with the stuffed bytes
+    uint32_t num_components;
+    uint32_t widths_in_blocks[3], heights_in_blocks[3];
+    uint32_t h_sampling_factors[3], v_sampling_factors[3];
+    std::vector<int16_t> coefficients[3]; // the coefficients of each component, in natural order
+    uint64_t reference_ns, rocjpeg_ns;
+};
+
+/**
+ * @brief Writes a synthetic baseline JPEG image with a single interleaved scan coded with the Huffman tables of Annex K.
+ *
+ * The DCT coefficients are generated rather than computed from pixels: the DC coefficients follow a smooth gradient
+ * with some noise, and the AC coefficients are sparse and decay along the zigzag order, more slowly at a higher
+ * quality. The entropy-coded data has the symbol statistics of a photo: mostly short codes, and a few long codes
+ * and large coefficients.
+ */
+class HuffmanJpegWriter {
+    public:
+        explicit HuffmanJpegWriter(std::mt19937 &generator) : generator_(generator) {
+            for (int t = 0; t < 2; t++) {
+                dc_tables_[t].Build(kAnnexKCounts[t], kAnnexKDcValues);
+                ac_tables_[t].Build(kAnnexKCounts[2 + t], kAnnexKAcValues[t]);
+            }
+        }
+
+        const HuffmanCodeTable& GetDcTable(uint32_t component) const { return dc_tables_[component ? 1 : 0]; }
+        const HuffmanCodeTable& GetAcTable(uint32_t component) const { return ac_tables_[component ? 1 : 0]; }
+
+        void Write(const CorpusImageConfig &config, CorpusImage &image) {
+            out_ = &image.data;
+            image.data.clear();
+            image.config = config;
+            image.num_components = config.subsampling == CSS_400 ? 1 : 3;
+            uint32_t luma_h = config.subsampling == CSS_422 || config.subsampling == CSS_420 ? 2 : 1;
+            uint32_t luma_v = config.subsampling == CSS_420 ? 2 : 1;
+            uint32_t mcus_per_row = (config.width + 8 * luma_h - 1) / (8 * luma_h);
+            uint32_t mcu_rows = (config.height + 8 * luma_v - 1) / (8 * luma_v);
+            if (image.num_components == 1) {
+                // a single component scan covers the blocks of the image only
+                luma_h = luma_v = 1;
+                mcus_per_row = (config.width + 7) / 8;
+                mcu_rows = (config.height + 7) / 8;
+            }
+            for (uint32_t c = 0; c < image.num_components; c++) {
+                image.h_sampling_factors[c] = c == 0 ? luma_h : 1;
+                image.v_sampling_factors[c] = c == 0 ? luma_v : 1;
+                image.widths_in_blocks[c] = mcus_per_row * image.h_sampling_factors[c];
+                image.heights_in_blocks[c] = mcu_rows * image.v_sampling_factors[c];
+                GenerateCoefficients(config.quality, c, image.widths_in_blocks[c], image.heights_in_blocks[c], image.coefficients[c]);
+            }
+
+            WriteMarker(SOI);
+            WriteMarker(DQT);
+            Write16(2 + 65);
+            Write8(0);
+            for (int i = 0; i < 64; i++) {
+                Write8(1);
+            }
+            WriteMarker(SOF);
+            Write16(8 + 3 * image.num_components);
+            Write8(8);
+            Write16(config.height);
+            Write16(config.width);
+            Write8(image.num_components);
+            for (uint32_t c = 0; c < image.num_components; c++) {
+                Write8(c + 1);
+                Write8((image.h_sampling_factors[c] << 4) | image.v_sampling_factors[c]);
+                Write8(0);
+            }
+            uint32_t num_table_sets = image.num_components == 1 ? 1 : 2;
+            for (uint32_t t = 0; t < num_table_sets; t++) {
+                WriteDHT(0x00 | t, dc_tables_[t]);
+                WriteDHT(0x10 | t, ac_tables_[t]);
+            }
+            WriteMarker(SOS);
+            Write16(6 + 2 * image.num_components);
+            Write8(image.num_components);
+            for (uint32_t c = 0; c < image.num_components; c++) {
+                Write8(c + 1);
+                Write8(c == 0 ? 0x00 : 0x11);
+            }
+            Write8(0);
+            Write8(63);
+            Write8(0);
+            image.scan_offset = out_->size();
+            WriteScanData(image, mcus_per_row * mcu_rows, mcus_per_row);
+            image.scan_size = out_->size() - image.scan_offset;
+            WriteMarker(EOI);
+        }
+
+    private:
+        void Write8(uint8_t value) { out_->push_back(value); }
+        void Write16(uint16_t value) { Write8(value >> 8); Write8(value & 0xFF); }
+        void WriteMarker(uint8_t marker) { Write8(0xFF); Write8(marker); }
+
+        void WriteDHT(uint8_t table_class_and_id, const HuffmanCodeTable &table) {
+            uint32_t num_values = 0;
+            for (int i = 0; i < 16; i++) {
+                num_values += table.counts[i];
+            }
+            WriteMarker(DHT);
+            Write16(static_cast<uint16_t>(2 + 17 + num_values));
+            Write8(table_class_and_id);
+            out_->insert(out_->end(), table.counts, table.counts + 16);
+            out_->insert(out_->end(), table.values, table.values + num_values);
+        }
+
+        void GenerateCoefficients(int quality, uint32_t component, uint32_t width_in_blocks, uint32_t height_in_blocks, std::vector<int16_t> &coefficients) {
+            // the number of nonzero AC coefficients and their largest magnitude grow with the quality
+            int32_t max_nonzero = quality >= 100 ? 40 : quality >= 90 ? 20 : quality >= 75 ? 10 : 5;
+            int32_t max_magnitude = quality >= 100 ? 1000 : quality >= 90 ? 256 : quality >= 75 ? 96 : 48;
+            if (component) {
+                max_nonzero = std::max(max_nonzero / 3, 1);
+                max_magnitude /= 2;
+            }
+            coefficients.assign(static_cast<size_t>(width_in_blocks) * height_in_blocks * DCT_BLOCK_SIZE, 0);
+            for (uint32_t by = 0; by < height_in_blocks; by++) {
+                for (uint32_t bx = 0; bx < width_in_blocks; bx++) {
+                    int16_t *block = &coefficients[(static_cast<size_t>(by) * width_in_blocks + bx) * DCT_BLOCK_SIZE];
+                    block[0] = static_cast<int16_t>(((bx * 7 + by * 5 + component * 100) % 1600) - 800 + static_cast<int>(generator_() % 64));
+                    int32_t num_nonzero = static_cast<int32_t>(generator_() % (max_nonzero + 1));
+                    for (int32_t k = 1; k < DCT_BLOCK_SIZE && num_nonzero > 0; k++) {
+                        if (generator_() % (k / 4 + 2) != 0) {
+                            continue;
+                        }
+                        int32_t magnitude = 1 + static_cast<int32_t>(generator_() % (1 + max_magnitude / (k * k)));
+                        block[kZigzagToNatural[k]] = static_cast<int16_t>(generator_() & 1 ? magnitude : -magnitude);
+                        num_nonzero--;
+                    }
+                }
+            }
+        }
+
+        void PutBits(uint32_t bits, int32_t length) {
+            bit_buffer_ = (bit_buffer_ << length) | (bits & ((1u << length) - 1));
+            bit_count_ += length;
+            while (bit_count_ >= 8) {
+                uint8_t byte = static_cast<uint8_t>(bit_buffer_ >> (bit_count_ - 8));
+                Write8(byte);
+                if (byte == 0xFF) {
+                    Write8(0x00);
+                }
+                bit_count_ -= 8;
+            }
+        }
+
+        void PutValue(const HuffmanCodeTable &table, uint8_t run, int32_t value) {
+            uint32_t magnitude = value < 0 ? -value : value;
+            uint8_t size = 0;
+            while (magnitude >> size) {
+                size++;
+            }
+            uint8_t symbol = static_cast<uint8_t>((run << 4) | size);
+            PutBits(table.code[symbol], table.length[symbol]);
+            if (size) {
+                PutBits(value < 0 ? static_cast<uint32_t>(value - 1) : static_cast<uint32_t>(value), size);
+            }
+        }
+
+        void WriteBlock(const int16_t *block, uint32_t component, int32_t &dc_predictor) {
+            const HuffmanCodeTable &ac_table = GetAcTable(component);
+            PutValue(GetDcTable(component), 0, block[0] - dc_predictor);
+            dc_predictor = block[0];
+            int32_t run = 0;
+            for (int32_t k = 1; k < DCT_BLOCK_SIZE; k++) {
+                int16_t value = block[kZigzagToNatural[k]];
+                if (value == 0) {
+                    run++;
+                    continue;
+                }
+                for (; run > 15; run -= 16) {
+                    PutBits(ac_table.code[0xF0], ac_table.length[0xF0]);
+                }
+                PutValue(ac_table, static_cast<uint8_t>(run), value);
+                run = 0;
+            }
+            if (run > 0) {
+                PutBits(ac_table.code[0x00], ac_table.length[0x00]);
+            }
+        }
+
+        void WriteScanData(const CorpusImage &image, uint32_t num_mcus, uint32_t mcus_per_row) {
+            int32_t dc_predictors[3] = {};
+            bit_buffer_ = 0;
+            bit_count_ = 0;
+            for (uint32_t mcu = 0; mcu < num_mcus; mcu++) {
+                uint32_t mcu_x = mcu % mcus_per_row;
+                uint32_t mcu_y = mcu / mcus_per_row;
+                for (uint32_t c = 0; c < image.num_components; c++) {
+                    for (uint32_t y = 0; y < image.v_sampling_factors[c]; y++) {
+                        for (uint32_t x = 0; x < image.h_sampling_factors[c]; x++) {
+                            size_t block_index = static_cast<size_t>(mcu_y * image.v_sampling_factors[c] + y) * image.widths_in_blocks[c] +
+                                                 mcu_x * image.h_sampling_factors[c] + x;
+                            WriteBlock(&image.coefficients[c][block_index * DCT_BLOCK_SIZE], c, dc_predictors[c]);
+                        }
+                    }
+                }
+            }
+            if (bit_count_ > 0) {
+                PutBits(0x7F, 8 - bit_count_);
+            }
+        }
+
+        std::mt19937 &generator_;
+        HuffmanCodeTable dc_tables_[2], ac_tables_[2];
+        std::vector<uint8_t> *out_ = nullptr;
+        uint64_t bit_buffer_ = 0;
+        int32_t bit_count_ = 0;
+};
+
+/**
+ * @brief A reference Huffman decoder that reads the entropy-coded data one bit at a time and decodes each code with
+ *        the DECODE procedure of Annex F of the JPEG standard, as a straightforward decoder would.
+ */
+class ReferenceHuffmanDecoder {
+    public:
+        ReferenceHuffmanDecoder(const uint8_t *data, const uint8_t *end) : position_(data), end_(end) {}
+
+        void DecodeImage(const HuffmanJpegWriter &writer, const CorpusImage &image, std::vector<int16_t> *coefficients) {
+            uint32_t mcus_per_row = image.widths_in_blocks[0] / image.h_sampling_factors[0];
+            uint32_t num_mcus = mcus_per_row * (image.heights_in_blocks[0] / image.v_sampling_factors[0]);
+            int32_t dc_predictors[3] = {};
+            for (uint32_t c = 0; c < image.num_components; c++) {
+                coefficients[c].assign(image.coefficients[c].size(), 0);
+            }
+            for (uint32_t mcu = 0; mcu < num_mcus; mcu++) {
+                uint32_t mcu_x = mcu % mcus_per_row;
+                uint32_t mcu_y = mcu / mcus_per_row;
+                for (uint32_t c = 0; c < image.num_components; c++) {
+                    for (uint32_t y = 0; y < image.v_sampling_factors[c]; y++) {
+                        for (uint32_t x = 0; x < image.h_sampling_factors[c]; x++) {
+                            size_t block_index = static_cast<size_t>(mcu_y * image.v_sampling_factors[c] + y) * image.widths_in_blocks[c] +
+                                                 mcu_x * image.h_sampling_factors[c] + x;
+                            DecodeBlock(writer.GetDcTable(c), writer.GetAcTable(c), dc_predictors[c], &coefficients[c][block_index * DCT_BLOCK_SIZE]);
+                        }
+                    }
+                }
+            }
+        }
+
+    private:
+        int32_t NextBit() {
+            if (bit_count_ == 0) {
+                byte_ = position_ < end_ ? *position_++ : 0;
+                if (byte_ == 0xFF && position_ < end_ && *position_ == 0) {
+                    position_++;
+                }
+                bit_count_ = 8;
+            }
+            bit_count_--;
+            return (byte_ >> bit_count_) & 1;
+        }
+
+        int32_t Receive(int32_t size) {
+            int32_t value = 0;
+            for (int32_t i = 0; i < size; i++) {
+                value = (value << 1) | NextBit();
+            }
+            return value;
+        }
+
+        int32_t Extend(int32_t value, int32_t size) {
+            return value < (1 << (size - 1)) ? value - (1 << size) + 1 : value;
+        }
+
+        uint8_t Decode(const HuffmanCodeTable &table) {
+            int32_t code = NextBit();
+            int32_t length = 1;
+            while (code > table.max_code[length]) {
+                code = (code << 1) | NextBit();
+                length++;
+            }
+            return length > 16 ? 0 : table.values[code + table.value_offset[length]];
+        }
+
+        void DecodeBlock(const HuffmanCodeTable &dc_table, const HuffmanCodeTable &ac_table, int32_t &dc_predictor, int16_t *block) {
+            int32_t size = Decode(dc_table);
+            dc_predictor += size ? Extend(Receive(size), size) : 0;
+            block[0] = static_cast<int16_t>(dc_predictor);
+            for (int32_t k = 1; k < DCT_BLOCK_SIZE; k++) {
+                uint8_t symbol = Decode(ac_table);
+                int32_t run = symbol >> 4;
+                size = symbol & 15;
+                if (size) {
+                    k += run;
+                    block[kZigzagToNatural[std::min(k, DCT_BLOCK_SIZE - 1)]] = static_cast<int16_t>(Extend(Receive(size), size));
+                } else if (run == 15) {
+                    k += 15;
+                } else {
+                    break;
+                }
+            }
+        }
+
+        const uint8_t *position_;
+        const uint8_t *end_;
+        uint32_t byte_ = 0;
+        int32_t bit_count_ = 0;
+};
+
+/**
+ * @brief Checks the coefficients decoded by the entropy decoder against the generated ones.
+ */
+static bool CheckCoefficients(const CorpusImage &image, const JpegCoefficientImage &layout, const int16_t *coefficients) {
+    if (layout.num_components != image.num_components) {
+        return false;
+    }
+    for (uint32_t c = 0; c < image.num_components; c++) {
+        const JpegCoefficientComponent &component = layout.components[c];
+        if (component.width_in_blocks != image.widths_in_blocks[c] || component.height_in_blocks != image.heights_in_blocks[c] ||
+            memcmp(coefficients + component.coefficient_offset, image.coefficients[c].data(), image.coefficients[c].size() * sizeof(int16_t))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static std::string SubsamplingName(ChromaSubsampling subsampling) {
+    switch (subsampling) {
+        case CSS_444: return "4:4:4";
+        case CSS_422: return "4:2:2";
+        case CSS_420: return "4:2:0";
+        default: return "4:0:0";
+    }
+}
+
+/**
+ * @brief Shows the usage of the benchmark and exits.
+ */
+void ShowHelpAndExit() {
+    std::cout << "Options:\n"
+    "-n     [iterations] - number of times each synthetic JPEG image is decoded by each decoder - [optional - default: 5]\n"
+    "-s     [seed] - seed of the random generator used to build the corpus - [optional - default: 0]\n"
+    "-max   [max size] - largest image size of the corpus, in the format WxH; the sizes of the corpus are 640x480,\n"
+    "                    1920x1080, and 3840x2160 - [optional - default: 3840x2160]\n";
+    exit(0);
+}
+
+int main(int argc, char **argv) {
+    int num_iterations = 5;
+    uint32_t seed = 0;
+    uint32_t max_width = 3840, max_height = 2160;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-h")) {
+            ShowHelpAndExit();
+        }
+        if (!strcmp(argv[i], "-n")) {
+            if (++i == argc) {
+                ShowHelpAndExit();
+            }
+            num_iterations = atoi(argv[i]);
+            if (num_iterations <= 0) {
+                ShowHelpAndExit();
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-s")) {
+            if (++i == argc) {
+                ShowHelpAndExit();
+            }
+            seed = static_cast<uint32_t>(strtoul(argv[i], nullptr, 10));
+            continue;
+        }
+        if (!strcmp(argv[i], "-max")) {
+            if (++i == argc || 2 != sscanf(argv[i], "%ux%u", &max_width, &max_height)) {
+                ShowHelpAndExit();
+            }
+            continue;
+        }
+        ShowHelpAndExit();
+    }
+
+    const uint16_t sizes[][2] = {{640, 480}, {1920, 1080}, {3840, 2160}};
+    const ChromaSubsampling subsamplings[] = {CSS_444, CSS_422, CSS_420, CSS_400};
+    const int qualities[] = {50, 75, 90, 100};
+    std::mt19937 generator(seed);
+    HuffmanJpegWriter writer(generator);
+    std::vector<CorpusImage> corpus;
+    for (auto &size : sizes) {
+        if (size[0] > max_width || size[1] > max_height) {
+            continue;
+        }
+        for (ChromaSubsampling subsampling : subsamplings) {
+            for (int quality : qualities) {
+                corpus.emplace_back();
+                writer.Write({size[0], size[1], subsampling, quality}, corpus.back());
+            }
+        }
+    }
+    if (corpus.empty()) {
+        std::cerr << "ERROR: no image of the corpus fits in " << max_width << "x" << max_height << std::endl;
+        return EXIT_FAILURE;
+    }
+    uint64_t corpus_scan_size = 0;
+    for (const CorpusImage &image : corpus) {
+        corpus_scan_size += image.scan_size;
+    }
+    std::cout << "Synthetic corpus: " << corpus.size() << " images, " << std::fixed << std::setprecision(1) << corpus_scan_size / 1e6
+              << " MB of entropy-coded data" << std::endl;
+    std::cout << "Decoding each image " << num_iterations << " times with each decoder on one thread, please wait!" << std::endl << std::endl;
+
+    // the scans are decoded on the calling thread to measure the throughput of one core
+    RocJpegStreamParser parser;
+    RocJpegEntropyDecoder entropy_decoder;
+    entropy_decoder.SetThreadPool(nullptr);
+    JpegCoefficientImage layout;
+    std::vector<int16_t> coefficients;
+    std::vector<int16_t> reference_coefficients[3];
+    for (CorpusImage &image : corpus) {
+        image.reference_ns = image.rocjpeg_ns = UINT64_MAX;
+        // the stream is parsed once; only the entropy decoding is timed
+        bool is_decoded = parser.ParseJpegStream(image.data.data(), static_cast<uint32_t>(image.data.size()));
+        for (int n = 0; n < num_iterations && is_decoded; n++) {
+            auto start_time = std::chrono::steady_clock::now();
+            ReferenceHuffmanDecoder reference_decoder(image.data.data() + image.scan_offset, image.data.data() + image.scan_offset + image.scan_size);
+            reference_decoder.DecodeImage(writer, image, reference_coefficients);
+            auto end_time = std::chrono::steady_clock::now();
+            image.reference_ns = std::min<uint64_t>(image.reference_ns, std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count());
+            for (uint32_t c = 0; c < image.num_components; c++) {
+                is_decoded = is_decoded && reference_coefficients[c] == image.coefficients[c];
+            }
+
+            start_time = std::chrono::steady_clock::now();
+            is_decoded = is_decoded && entropy_decoder.SetStreamParameters(parser.GetJpegStreamParameters(), layout);
+            if (is_decoded) {
+                coefficients.resize(layout.num_coefficients);
+                is_decoded = entropy_decoder.DecodeCoefficients(layout, coefficients.data());
+            }
+            end_time = std::chrono::steady_clock::now();
+            image.rocjpeg_ns = std::min<uint64_t>(image.rocjpeg_ns, std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count());
+            is_decoded = is_decoded && CheckCoefficients(image, layout, coefficients.data());
+        }
+        if (!is_decoded) {
+            std::cerr << "ERROR: the coefficients decoded from the " << image.config.width << "x" << image.config.height << " "
+                      << SubsamplingName(image.config.subsampling) << " image of quality " << image.config.quality
+                      << " differ from the encoded coefficients!" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    // the throughputs are in MB of entropy-coded data per second, per subsampling and quality and for the whole corpus
+    struct ImageGroup {
+        uint64_t scan_size = 0;
+        uint64_t reference_ns = 0;
+        uint64_t rocjpeg_ns = 0;
+    };
+    std::map<std::pair<int, int>, ImageGroup> groups;
+    ImageGroup total;
+    for (const CorpusImage &image : corpus) {
+        for (ImageGroup *group : {&groups[{image.config.subsampling, image.config.quality}], &total}) {
+            group->scan_size += image.scan_size;
+            group->reference_ns += image.reference_ns;
+            group->rocjpeg_ns += image.rocjpeg_ns;
+        }
+    }
+    auto print_group = [](const std::string &name, const ImageGroup &group) {
+        double reference_mbps = group.scan_size * 1e3 / group.reference_ns;
+        double rocjpeg_mbps = group.scan_size * 1e3 / group.rocjpeg_ns;
+        std::cout << std::left << std::setw(16) << name << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(12) << group.scan_size / 1e3 << std::setw(16) << reference_mbps << std::setw(14) << rocjpeg_mbps
+                  << std::setw(9) << rocjpeg_mbps / reference_mbps << "x" << std::endl;
+    };
+    std::cout << std::left << std::setw(16) << "images" << std::right << std::setw(12) << "data (KB)" << std::setw(16) << "reference MB/s"
+              << std::setw(14) << "rocJPEG MB/s" << std::setw(10) << "speedup" << std::endl;
+    for (auto &group : groups) {
+        print_group(SubsamplingName(static_cast<ChromaSubsampling>(group.first.first)) + " q" + std::to_string(group.first.second), group.second);
+    }
+    print_group("total", total);
+    std::cout << std::endl << "The coefficients decoded by both decoders match the encoded coefficients." << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,274 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "rocjpeg_cpu_kernels.h"
+
+/**
+ * @brief The natural (row-major) position of the coefficients in zigzag order.
+ */
+static const uint8_t kZigzagToNatural[DCT_BLOCK_SIZE] = {
+     0,  1,  8, 16,  9,  2,  3, 10, 17, 24, 32, 25, 18, 11,  4,  5,
+    12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13,  6,  7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63
+};
+
+/**
+ * @brief The luminance quantization table of Annex K of the JPEG standard, in natural order.
+ */
+static const uint16_t kAnnexKLuminanceTable[DCT_BLOCK_SIZE] = {
+    16,  11,  10,  16,  24,  40,  51,  61,
+    12,  12,  14,  19,  26,  58,  60,  55,
+    14,  13,  16,  24,  40,  57,  69,  56,
+    14,  17,  22,  29,  51,  87,  80,  62,
+    18,  22,  37,  56,  68, 109, 103,  77,
+    24,  35,  55,  64,  81, 104, 113,  92,
+    49,  64,  78,  87, 103, 121, 120, 101,
+    72,  92,  95,  98, 112, 100, 103,  99
+};
+
+/**
+ * @brief A set of blocks with the coefficients of one kind of content, and the quantization table they are coded with.
+ */
+struct BlockSet {
+    std::string name;
+    std::vector<int16_t> coefficients;
+    uint16_t quantization_table[DCT_BLOCK_SIZE];
+};
+
+/**
+ * @brief Scales the Annex K luminance table to a quality (1 to 100) with the formula of the IJG libjpeg.
+ */
+static void GetQuantizationTable(int quality, uint16_t quantization_table[DCT_BLOCK_SIZE]) {
+    int scale = quality < 50 ? 5000 / quality : 200 - 2 * quality;
+    for (int i = 0; i < DCT_BLOCK_SIZE; i++) {
+        quantization_table[i] = static_cast<uint16_t>(std::min(std::max((kAnnexKLuminanceTable[i] * scale + 50) / 100, 1), 255));
+    }
+}
+
+/**
+ * @brief Builds the block sets: blocks with the statistics of a photo at quality 50 and 90, DC-only blocks, dense
+ * blocks covering the whole range of the coefficients of an 8-bit frame, and blocks of arbitrary 16-bit coefficients
+ * and quantization values, whose dequantized values and intermediate results wrap around in 32 bits.
+ */
+static std::vector<BlockSet> BuildBlockSets(uint32_t num_blocks, std::mt19937 &generator) {
+    std::vector<BlockSet> block_sets(5);
+    std::uniform_real_distribution<float> uniform(0.0f, 1.0f);
+    for (int i = 0; i < 2; i++) {
+        // the coefficients are sparse and decay along the zigzag order, as the quantized DCT of a photo
+        BlockSet &photo = block_sets[i];
+        int quality = i == 0 ? 50 : 90;
+        photo.name = "photo q" + std::to_string(quality);
+        GetQuantizationTable(quality, photo.quantization_table);
+        photo.coefficients.assign(static_cast<size_t>(num_blocks) * DCT_BLOCK_SIZE, 0);
+        for (uint32_t b = 0; b < num_blocks; b++) {
+            int16_t *block = photo.coefficients.data() + static_cast<size_t>(b) * DCT_BLOCK_SIZE;
+            block[0] = static_cast<int16_t>(std::uniform_int_distribution<int>(-1024, 1023)(generator) / photo.quantization_table[0]);
+            for (int k = 1; k < DCT_BLOCK_SIZE; k++) {
+                float amplitude = 600.0f / (1.0f + k) / photo.quantization_table[kZigzagToNatural[k]];
+                if (uniform(generator) < std::min(amplitude, 0.9f)) {
+                    int magnitude = 1 + static_cast<int>(uniform(generator) * amplitude * 2.0f);
+                    block[kZigzagToNatural[k]] = static_cast<int16_t>(uniform(generator) < 0.5f ? -magnitude : magnitude);
+                }
+            }
+        }
+    }
+
+    BlockSet &dc_only = block_sets[2];
+    dc_only.name = "DC only";
+    GetQuantizationTable(75, dc_only.quantization_table);
+    dc_only.coefficients.assign(static_cast<size_t>(num_blocks) * DCT_BLOCK_SIZE, 0);
+    for (uint32_t b = 0; b < num_blocks; b++) {
+        dc_only.coefficients[static_cast<size_t>(b) * DCT_BLOCK_SIZE] = static_cast<int16_t>(std::uniform_int_distribution<int>(-128, 127)(generator));
+    }
+
+    // the dequantized coefficients of an 8-bit frame are in [-2048, 2047], give or take one quantization step
+    BlockSet &dense = block_sets[3];
+    dense.name = "dense";
+    for (int i = 0; i < DCT_BLOCK_SIZE; i++) {
+        dense.quantization_table[i] = static_cast<uint16_t>(std::uniform_int_distribution<int>(1, 255)(generator));
+    }
+    dense.coefficients.resize(static_cast<size_t>(num_blocks) * DCT_BLOCK_SIZE);
+    for (size_t i = 0; i < dense.coefficients.size(); i++) {
+        int max_value = 2048 / dense.quantization_table[i % DCT_BLOCK_SIZE] + 1;
+        dense.coefficients[i] = static_cast<int16_t>(std::uniform_int_distribution<int>(-max_value, max_value)(generator));
+    }
+
+    BlockSet &extreme = block_sets[4];
+    extreme.name = "extreme";
+    for (int i = 0; i < DCT_BLOCK_SIZE; i++) {
+        extreme.quantization_table[i] = static_cast<uint16_t>(std::uniform_int_distribution<int>(1, 65535)(generator));
+    }
+    extreme.coefficients.resize(static_cast<size_t>(num_blocks) * DCT_BLOCK_SIZE);
+    for (size_t i = 0; i < extreme.coefficients.size(); i++) {
+        extreme.coefficients[i] = static_cast<int16_t>(std::uniform_int_distribution<int>(-32768, 32767)(generator));
+    }
+    return block_sets;
+}
+
+/**
+ * @brief Checks that the kernels transform every block of a set like the scalar reference, DequantizeIdct8x8, on
+ * rows of 1 to 17 blocks (so the odd blocks of the AVX-512 kernel are covered) and on the whole plane.
+ * @return The index of the first block that differs, or -1 if all the blocks are identical.
+ */
+static int64_t CheckBlockSet(const RocJpegCpuKernels &kernels, const BlockSet &block_set, uint32_t width_in_blocks, uint32_t height_in_blocks) {
+    std::vector<uint8_t> plane(static_cast<size_t>(width_in_blocks) * 8 * height_in_blocks * 8);
+    std::vector<uint8_t> reference(plane.size());
+    uint32_t stride = width_in_blocks * 8;
+    uint32_t num_blocks = width_in_blocks * height_in_blocks;
+    for (uint32_t b = 0; b < num_blocks; b++) {
+        DequantizeIdct8x8(block_set.coefficients.data() + static_cast<size_t>(b) * DCT_BLOCK_SIZE, block_set.quantization_table,
+                          reference.data() + static_cast<size_t>(b / width_in_blocks) * 8 * stride + (b % width_in_blocks) * 8, stride, 1);
+    }
+    auto first_mismatch = [&](uint32_t width, uint32_t height) -> int64_t {
+        for (uint32_t b = 0; b < width * height; b++) {
+            for (uint32_t row = 0; row < 8; row++) {
+                size_t offset = static_cast<size_t>(b / width) * 8 * stride + row * stride + (b % width) * 8;
+                if (memcmp(plane.data() + offset, reference.data() + offset, 8)) {
+                    return b;
+                }
+            }
+        }
+        return -1;
+    };
+
+    for (uint32_t width = 1; width <= std::min(width_in_blocks, 17u); width++) {
+        std::fill(plane.begin(), plane.end(), 0);
+        kernels.DequantizeIdctComponent(block_set.coefficients.data(), block_set.quantization_table, 8, width, 1, plane.data(), stride, 1);
+        int64_t mismatch = first_mismatch(width, 1);
+        if (mismatch >= 0) {
+            return mismatch;
+        }
+    }
+    std::fill(plane.begin(), plane.end(), 0);
+    kernels.DequantizeIdctComponent(block_set.coefficients.data(), block_set.quantization_table, 8, width_in_blocks, height_in_blocks, plane.data(), stride, 1);
+    return first_mismatch(width_in_blocks, height_in_blocks);
+}
+
+void ShowHelpAndExit() {
+    std::cout << "Options:\n"
+    "-n     [iterations] - number of times each set of blocks is transformed by each set of kernels - [optional - default: 10]\n"
+    "-s     [seed] - seed of the random generator used to build the blocks - [optional - default: 0]\n"
+    "-size  [plane size] - size of the plane of each set of blocks, in the format WxH - [optional - default: 1920x1080]\n";
+    exit(0);
+}
+
+int main(int argc, char **argv) {
+    int num_iterations = 10;
+    uint32_t seed = 0;
+    uint32_t width = 1920, height = 1080;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-h")) {
+            ShowHelpAndExit();
+        }
+        if (!strcmp(argv[i], "-n")) {
+            if (++i == argc) {
+                ShowHelpAndExit();
+            }
+            num_iterations = atoi(argv[i]);
+            if (num_iterations <= 0) {
+                ShowHelpAndExit();
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-s")) {
+            if (++i == argc) {
+                ShowHelpAndExit();
+            }
+            seed = static_cast<uint32_t>(strtoul(argv[i], nullptr, 10));
+            continue;
+        }
+        if (!strcmp(argv[i], "-size")) {
+            if (++i == argc || 2 != sscanf(argv[i], "%ux%u", &width, &height) || width == 0 || height == 0) {
+                ShowHelpAndExit();
+            }
+            continue;
+        }
+        ShowHelpAndExit();
+    }
+
+    uint32_t width_in_blocks = (width + 7) / 8;
+    uint32_t height_in_blocks = (height + 7) / 8;
+    uint32_t num_blocks = width_in_blocks * height_in_blocks;
+    std::mt19937 generator(seed);
+    std::vector<BlockSet> block_sets = BuildBlockSets(num_blocks, generator);
+    std::cout << "Block sets: " << block_sets.size() << " planes of " << width_in_blocks << "x" << height_in_blocks << " blocks" << std::endl;
+    std::cout << "Transforming each set " << num_iterations << " times with each set of kernels on one thread, please wait!" << std::endl << std::endl;
+
+    static const SimdLevel simd_levels[] = {kSimdScalar, kSimdAvx2, kSimdAvx512};
+    std::vector<SimdLevel> levels;
+    std::vector<std::vector<uint64_t>> level_ns;
+    std::vector<uint8_t> plane(static_cast<size_t>(num_blocks) * DCT_BLOCK_SIZE);
+    uint32_t stride = width_in_blocks * 8;
+    for (SimdLevel simd_level : simd_levels) {
+        RocJpegCpuKernels kernels(simd_level);
+        if (kernels.GetKernelSimdLevel() != simd_level) {
+            std::cout << "Skipping the " << GetSimdLevelName(simd_level) << " kernels: not supported by the CPU" << std::endl;
+            continue;
+        }
+        std::vector<uint64_t> set_ns;
+        for (const BlockSet &block_set : block_sets) {
+            int64_t mismatch = CheckBlockSet(kernels, block_set, width_in_blocks, height_in_blocks);
+            if (mismatch >= 0) {
+                std::cerr << "ERROR: the " << GetSimdLevelName(simd_level) << " kernels transform block " << mismatch << " of the " << block_set.name
+                          << " set differently from the scalar reference!" << std::endl;
+                return EXIT_FAILURE;
+            }
+            // the best time of the iterations is kept, the blocks are transformed on the calling thread to measure one core
+            uint64_t best_ns = UINT64_MAX;
+            for (int n = 0; n < num_iterations; n++) {
+                auto start_time = std::chrono::steady_clock::now();
+                kernels.DequantizeIdctComponent(block_set.coefficients.data(), block_set.quantization_table, 8, width_in_blocks, height_in_blocks,
+                                                plane.data(), stride, 1);
+                auto end_time = std::chrono::steady_clock::now();
+                best_ns = std::min<uint64_t>(best_ns, std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count());
+            }
+            set_ns.push_back(best_ns);
+        }
+        levels.push_back(simd_level);
+        level_ns.push_back(set_ns);
+    }
+
+    std::cout << std::left << std::setw(12) << "blocks";
+    for (SimdLevel simd_level : levels) {
+        std::cout << std::right << std::setw(18) << std::string(GetSimdLevelName(simd_level)) + " Mblocks/s";
+    }
+    std::cout << std::setw(10) << "speedup" << std::endl;
+    for (size_t s = 0; s < block_sets.size(); s++) {
+        std::cout << std::left << std::setw(12) << block_sets[s].name << std::right << std::fixed << std::setprecision(2);
+        for (size_t i = 0; i < levels.size(); i++) {
+            std::cout << std::setw(18) << num_blocks * 1e3 / level_ns[i][s];
+        }
+        std::cout << std::setw(9) << static_cast<double>(level_ns[0][s]) / level_ns.back()[s] << "x" << std::endl;
+    }
+    std::cout << std::endl << "The samples of every set of kernels are identical to the scalar reference." << std::endl;
+    return EXIT_SUCCESS;
+}
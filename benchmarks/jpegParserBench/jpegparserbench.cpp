@@ -0,0 +1,538 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "rocjpeg_parser.h"
+
+/**
+ * @brief Describes a synthetic JPEG image of the corpus.
+ */
+struct CorpusImageConfig {
+    uint16_t width;
+    uint16_t height;
+    ChromaSubsampling subsampling; // one of CSS_444, CSS_422, CSS_420, CSS_400
+    uint16_t restart_interval; // in MCUs, 0 if the image has no DRI marker
+    uint32_t app_padding; // number of bytes of APPn segments before the frame header
+    bool split_tables; // true to write each DQT/DHT table in its own marker segment
+};
+
+/**
+ * @brief A synthetic JPEG image and the parse times measured for it.
+ */
+struct CorpusImage {
+    CorpusImageConfig config;
+    std::vector<uint8_t> data;
+    std::vector<uint64_t> parse_times_ns;
+};
+
+/**
+ * @brief Writes the marker segments of a synthetic baseline JPEG stream.
+ *
+ * The headers are valid for the rocJPEG parser; the entropy-coded data is random, with the 0xFF bytes stuffed as
+ * an encoder would, so the parser visits the same amount of data as for a real image of the same size. The
+ * entropy-coded data isn't meant to be decoded.
+ */
+class SyntheticJpegWriter {
+    public:
+        explicit SyntheticJpegWriter(std::mt19937 &generator) : generator_(generator) {}
+
+        void Write(const CorpusImageConfig &config, int quality, std::vector<uint8_t> &out) {
+            out_ = &out;
+            out.clear();
+            bool is_grey = config.subsampling == CSS_400;
+            int num_table_sets = is_grey ? 1 : 2;
+            WriteMarker(SOI);
+            WriteAppPadding(config.app_padding);
+            WriteDQT(num_table_sets, quality, config.split_tables);
+            WriteSOF(config);
+            WriteDHT(num_table_sets, config.split_tables);
+            if (config.restart_interval) {
+                WriteMarker(DRI);
+                Write16(4);
+                Write16(config.restart_interval);
+            }
+            WriteSOS(is_grey ? 1 : 3);
+            WriteScanData(config);
+            WriteMarker(EOI);
+        }
+
+    private:
+        void Write8(uint8_t value) { out_->push_back(value); }
+        void Write16(uint16_t value) { Write8(value >> 8); Write8(value & 0xFF); }
+        void WriteMarker(uint8_t marker) { Write8(0xFF); Write8(marker); }
+
+        /**
+         * @brief Writes APPn segments totaling about `padding` bytes, as cameras and editors do.
+         *
+         * The first segment is an EXIF APP1 segment with an orientation tag, followed by ICC profile (APP2) and
+         * Photoshop (APP13) segments of random content.
+         */
+        void WriteAppPadding(uint32_t padding) {
+            static const uint8_t exif[] = {'E', 'x', 'i', 'f', 0, 0, 'M', 'M', 0, 42, 0, 0, 0, 8,
+                                           0, 1, 0x01, 0x12, 0, 3, 0, 0, 0, 1, 0, 1, 0, 0, 0, 0, 0, 0};
+            static const char *identifiers[] = {"ICC_PROFILE", "Photoshop 3.0"};
+            if (padding == 0) {
+                return;
+            }
+            WriteMarker(APP1);
+            Write16(2 + sizeof(exif));
+            out_->insert(out_->end(), exif, exif + sizeof(exif));
+            uint32_t written = 4 + sizeof(exif);
+            for (int i = 0; written < padding; i++) {
+                uint32_t segment_size = std::min<uint32_t>(padding - written, 65535 + 2);
+                const char *identifier = identifiers[i & 1];
+                uint32_t identifier_size = static_cast<uint32_t>(strlen(identifier)) + 1;
+                segment_size = std::max(segment_size, 4 + identifier_size);
+                WriteMarker((i & 1) ? 0xED : 0xE2);
+                Write16(segment_size - 2);
+                out_->insert(out_->end(), identifier, identifier + identifier_size);
+                for (uint32_t j = 4 + identifier_size; j < segment_size; j++) {
+                    Write8(generator_() & 0xFF);
+                }
+                written += segment_size;
+            }
+        }
+
+        /**
+         * @brief Writes the luminance and chrominance quantization tables of Annex K, scaled to the quality.
+         */
+        void WriteDQT(int num_table_sets, int quality, bool split_tables) {
+            static const uint8_t base_tables[2][64] = {
+                {16, 11, 10, 16, 24, 40, 51, 61, 12, 12, 14, 19, 26, 58, 60, 55, 14, 13, 16, 24, 40, 57, 69, 56,
+                 14, 17, 22, 29, 51, 87, 80, 62, 18, 22, 37, 56, 68, 109, 103, 77, 24, 35, 55, 64, 81, 104, 113, 92,
+                 49, 64, 78, 87, 103, 121, 120, 101, 72, 92, 95, 98, 112, 100, 103, 99},
+                {17, 18, 24, 47, 99, 99, 99, 99, 18, 21, 26, 66, 99, 99, 99, 99, 24, 26, 56, 99, 99, 99, 99, 99,
+                 47, 66, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99,
+                 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99}};
+            int scale = quality < 50 ? 5000 / quality : 200 - quality * 2;
+            for (int t = 0; t < num_table_sets; t++) {
+                if (split_tables || t == 0) {
+                    WriteMarker(DQT);
+                    Write16(2 + (split_tables ? 1 : num_table_sets) * 65);
+                }
+                Write8(t);
+                for (int i = 0; i < 64; i++) {
+                    Write8(static_cast<uint8_t>(std::min(std::max((base_tables[t][i] * scale + 50) / 100, 1), 255)));
+                }
+            }
+        }
+
+        void WriteSOF(const CorpusImageConfig &config) {
+            uint8_t luma_sampling_factors = 0x11;
+            if (config.subsampling == CSS_422) {
+                luma_sampling_factors = 0x21;
+            } else if (config.subsampling == CSS_420) {
+                luma_sampling_factors = 0x22;
+            }
+            int num_components = config.subsampling == CSS_400 ? 1 : 3;
+            WriteMarker(SOF);
+            Write16(8 + 3 * num_components);
+            Write8(8);
+            Write16(config.height);
+            Write16(config.width);
+            Write8(num_components);
+            for (int i = 0; i < num_components; i++) {
+                Write8(i + 1);
+                Write8(i == 0 ? luma_sampling_factors : 0x11);
+                Write8(i == 0 ? 0 : 1);
+            }
+        }
+
+        /**
+         * @brief Writes a DC and an AC Huffman table per table set, with the code length counts of Annex K.
+         */
+        void WriteDHT(int num_table_sets, bool split_tables) {
+            static const uint8_t dc_counts[16] = {0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0};
+            static const uint8_t ac_counts[16] = {0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7D};
+            std::vector<uint8_t> ac_values = {0x00, 0xF0};
+            for (int run = 0; run < 16; run++) {
+                for (int size = 1; size <= 10; size++) {
+                    ac_values.push_back(static_cast<uint8_t>((run << 4) | size));
+                }
+            }
+            uint32_t dc_table_size = 1 + 16 + DC_HUFFMAN_TABLE_VALUES_SIZE;
+            uint32_t ac_table_size = 1 + 16 + AC_HUFFMAN_TABLE_VALUES_SIZE;
+            for (int t = 0; t < num_table_sets; t++) {
+                for (int is_ac = 0; is_ac < 2; is_ac++) {
+                    if (split_tables || (t == 0 && is_ac == 0)) {
+                        WriteMarker(DHT);
+                        Write16(2 + (split_tables ? (is_ac ? ac_table_size : dc_table_size) : num_table_sets * (dc_table_size + ac_table_size)));
+                    }
+                    Write8((is_ac << 4) | t);
+                    const uint8_t *counts = is_ac ? ac_counts : dc_counts;
+                    out_->insert(out_->end(), counts, counts + 16);
+                    if (is_ac) {
+                        out_->insert(out_->end(), ac_values.begin(), ac_values.end());
+                    } else {
+                        for (int i = 0; i < DC_HUFFMAN_TABLE_VALUES_SIZE; i++) {
+                            Write8(i);
+                        }
+                    }
+                }
+            }
+        }
+
+        void WriteSOS(int num_components) {
+            WriteMarker(SOS);
+            Write16(6 + 2 * num_components);
+            Write8(num_components);
+            for (int i = 0; i < num_components; i++) {
+                Write8(i + 1);
+                Write8(i == 0 ? 0x00 : 0x11);
+            }
+            Write8(0);
+            Write8(63);
+            Write8(0);
+        }
+
+        /**
+         * @brief Writes random entropy-coded data at a typical bit rate for the subsampling, split into restart
+         *        segments by RSTn markers when the image has a restart interval.
+         */
+        void WriteScanData(const CorpusImageConfig &config) {
+            double bits_per_pixel;
+            uint32_t mcu_width = 8, mcu_height = 8;
+            switch (config.subsampling) {
+                case CSS_444: bits_per_pixel = 3.0; break;
+                case CSS_422: bits_per_pixel = 2.2; mcu_width = 16; break;
+                case CSS_420: bits_per_pixel = 1.8; mcu_width = mcu_height = 16; break;
+                default: bits_per_pixel = 1.2; break;
+            }
+            uint64_t scan_size = static_cast<uint64_t>(bits_per_pixel * config.width * config.height / 8);
+            uint64_t num_mcus = static_cast<uint64_t>((config.width + mcu_width - 1) / mcu_width) * ((config.height + mcu_height - 1) / mcu_height);
+            uint64_t num_segments = config.restart_interval ? (num_mcus + config.restart_interval - 1) / config.restart_interval : 1;
+            uint64_t segment_size = std::max<uint64_t>(scan_size / num_segments, 1);
+            out_->reserve(out_->size() + scan_size + scan_size / 128 + 2 * num_segments + 2);
+            for (uint64_t s = 0; s < num_segments; s++) {
+                if (s > 0) {
+                    WriteMarker(RST0 + ((s - 1) & 7));
+                }
+                for (uint64_t i = 0; i < segment_size; i++) {
+                    uint8_t value = generator_() & 0xFF;
+                    Write8(value);
+                    if (value == 0xFF) {
+                        Write8(0x00);
+                    }
+                }
+            }
+        }
+
+        std::mt19937 &generator_;
+        std::vector<uint8_t> *out_ = nullptr;
+};
+
+/**
+ * @brief Shows the usage of the benchmark and exits.
+ */
+void ShowHelpAndExit() {
+    std::cout << "Options:\n"
+    "-n     [iterations] - number of times each synthetic JPEG image is parsed - [optional - default: 20]\n"
+    "-s     [seed] - seed of the random generator used to build the corpus - [optional - default: 0]\n"
+    "-max   [max size] - largest image size of the corpus, in the format WxH; the sizes of the corpus are 160x120, 640x480,\n"
+    "                    1920x1080, and 3840x2160 - [optional - default: 3840x2160]\n";
+    exit(0);
+}
+
+/**
+ * @brief Checks that two slice parameter buffers describe the same scan.
+ */
+static bool IsSameSliceParameters(const SliceParameterBuffer &a, const SliceParameterBuffer &b) {
+    if (a.slice_data_size != b.slice_data_size || a.slice_data_offset != b.slice_data_offset || a.slice_data_flag != b.slice_data_flag ||
+        a.slice_horizontal_position != b.slice_horizontal_position || a.slice_vertical_position != b.slice_vertical_position ||
+        a.num_components != b.num_components || a.restart_interval != b.restart_interval || a.num_mcus != b.num_mcus) {
+        return false;
+    }
+    for (int c = 0; c < 4; c++) {
+        if (a.components[c].component_selector != b.components[c].component_selector ||
+            a.components[c].dc_table_selector != b.components[c].dc_table_selector ||
+            a.components[c].ac_table_selector != b.components[c].ac_table_selector) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Checks that two scans have the same location, header, and tables.
+ */
+static bool IsSameScan(const JpegScan &a, const JpegScan &b) {
+    if (a.data_offset != b.data_offset || a.data_size != b.data_size || a.num_components != b.num_components ||
+        a.spectral_start != b.spectral_start || a.spectral_end != b.spectral_end || a.approximation_high != b.approximation_high ||
+        a.approximation_low != b.approximation_low || a.restart_interval != b.restart_interval) {
+        return false;
+    }
+    for (int c = 0; c < a.num_components; c++) {
+        if (a.components[c].component_selector != b.components[c].component_selector ||
+            a.components[c].dc_table_selector != b.components[c].dc_table_selector ||
+            a.components[c].ac_table_selector != b.components[c].ac_table_selector) {
+            return false;
+        }
+    }
+    return a.huffman_tables != nullptr && b.huffman_tables != nullptr && a.quantization_tables != nullptr && b.quantization_tables != nullptr &&
+           !memcmp(a.huffman_tables, b.huffman_tables, sizeof(*a.huffman_tables)) &&
+           !memcmp(a.quantization_tables, b.quantization_tables, sizeof(*a.quantization_tables));
+}
+
+/**
+ * @brief Checks that two parsers hold the same stream parameters for the same JPEG image.
+ *
+ * The frame (SOF) and scan (SOS) parameters, the offset of the slice data from the start of the stream and its
+ * size, the location of each scan and the contents of the quantization (DQT) and Huffman (DHT) tables in effect for
+ * it, the restart interval, and the restart marker index are compared.
+ * The slice data of each parser is located in its own copy of the stream, so only its offset is compared.
+ */
+static bool IsSameStreamParameters(const RocJpegStreamParser &parser, const RocJpegStreamParser &reference_parser) {
+    const JpegStreamParameters &a = *parser.GetJpegStreamParameters();
+    const JpegStreamParameters &b = *reference_parser.GetJpegStreamParameters();
+    const PictureParameterBuffer &pa = a.picture_parameter_buffer;
+    const PictureParameterBuffer &pb = b.picture_parameter_buffer;
+    if (pa.picture_width != pb.picture_width || pa.picture_height != pb.picture_height || pa.num_components != pb.num_components ||
+        pa.color_space != pb.color_space || pa.rotation != pb.rotation) {
+        return false;
+    }
+    for (int c = 0; c < NUM_COMPONENTS; c++) {
+        if (pa.components[c].component_id != pb.components[c].component_id || pa.components[c].h_sampling_factor != pb.components[c].h_sampling_factor ||
+            pa.components[c].v_sampling_factor != pb.components[c].v_sampling_factor ||
+            pa.components[c].quantiser_table_selector != pb.components[c].quantiser_table_selector) {
+            return false;
+        }
+    }
+    if (a.slice_data_buffer == nullptr || b.slice_data_buffer == nullptr ||
+        a.slice_data_buffer - parser.GetStreamData() != b.slice_data_buffer - reference_parser.GetStreamData() ||
+        !IsSameSliceParameters(a.slice_parameter_buffer, b.slice_parameter_buffer) || a.num_scans != b.num_scans ||
+        a.scans == nullptr || b.scans == nullptr) {
+        return false;
+    }
+    for (uint32_t i = 0; i < a.num_scans; i++) {
+        if (!IsSameScan(a.scans[i], b.scans[i])) {
+            return false;
+        }
+    }
+    if (a.num_restart_markers != b.num_restart_markers || a.restart_marker_stride != b.restart_marker_stride) {
+        return false;
+    }
+    for (uint32_t i = 0; i < a.num_restart_markers; i++) {
+        if (a.restart_markers[i].byte_offset != b.restart_markers[i].byte_offset || a.restart_markers[i].mcu_index != b.restart_markers[i].mcu_index) {
+            return false;
+        }
+    }
+    if (a.quantization_matrix_buffer == nullptr || b.quantization_matrix_buffer == nullptr || a.huffman_table_buffer == nullptr || b.huffman_table_buffer == nullptr ||
+        memcmp(a.quantization_matrix_buffer->load_quantiser_table, b.quantization_matrix_buffer->load_quantiser_table, sizeof(a.quantization_matrix_buffer->load_quantiser_table)) ||
+        memcmp(a.quantization_matrix_buffer->quantiser_table, b.quantization_matrix_buffer->quantiser_table, sizeof(a.quantization_matrix_buffer->quantiser_table)) ||
+        memcmp(a.huffman_table_buffer->load_huffman_table, b.huffman_table_buffer->load_huffman_table, sizeof(a.huffman_table_buffer->load_huffman_table)) ||
+        memcmp(a.huffman_table_buffer->huffman_table, b.huffman_table_buffer->huffman_table, sizeof(a.huffman_table_buffer->huffman_table))) {
+        return false;
+    }
+    return a.chroma_subsampling == b.chroma_subsampling && a.orientation == b.orientation && a.coding_process == b.coding_process &&
+           a.sample_precision == b.sample_precision && a.hardware_limitations == b.hardware_limitations && a.has_adobe_marker == b.has_adobe_marker &&
+           a.adobe_color_transform == b.adobe_color_transform && a.is_huffman_table_remapped == b.is_huffman_table_remapped;
+}
+
+/**
+ * @brief Returns the p-th percentile (0 to 100) of sorted samples, using the nearest-rank method.
+ */
+static uint64_t GetPercentile(const std::vector<uint64_t> &sorted_samples, double p) {
+    if (sorted_samples.empty()) {
+        return 0;
+    }
+    size_t rank = static_cast<size_t>(p / 100.0 * sorted_samples.size() + 0.5);
+    return sorted_samples[std::min(std::max<size_t>(rank, 1), sorted_samples.size()) - 1];
+}
+
+/**
+ * @brief Prints the statistics of the corpus images that satisfy a predicate.
+ */
+template <typename Predicate>
+static void PrintGroupStats(const std::string &name, const std::vector<CorpusImage> &corpus, Predicate predicate) {
+    std::vector<uint64_t> samples;
+    uint64_t total_bytes = 0;
+    uint64_t total_time_ns = 0;
+    uint32_t num_images = 0;
+    for (const CorpusImage &image : corpus) {
+        if (!predicate(image.config)) {
+            continue;
+        }
+        num_images++;
+        for (uint64_t t : image.parse_times_ns) {
+            samples.push_back(t);
+            total_time_ns += t;
+            total_bytes += image.data.size();
+        }
+    }
+    if (samples.empty()) {
+        return;
+    }
+    std::sort(samples.begin(), samples.end());
+    std::cout << std::left << std::setw(16) << name << std::right << std::setw(8) << num_images
+              << std::setw(14) << total_time_ns / samples.size()
+              << std::setw(12) << GetPercentile(samples, 50) << std::setw(12) << GetPercentile(samples, 90)
+              << std::setw(12) << GetPercentile(samples, 99) << std::setw(12) << samples.back()
+              << std::setw(10) << std::fixed << std::setprecision(2) << static_cast<double>(total_bytes) / total_time_ns << std::endl;
+}
+
+int main(int argc, char **argv) {
+    int num_iterations = 20;
+    uint32_t seed = 0;
+    uint32_t max_width = 3840, max_height = 2160;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-h")) {
+            ShowHelpAndExit();
+        }
+        if (!strcmp(argv[i], "-n")) {
+            if (++i == argc) {
+                ShowHelpAndExit();
+            }
+            num_iterations = atoi(argv[i]);
+            if (num_iterations <= 0) {
+                ShowHelpAndExit();
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-s")) {
+            if (++i == argc) {
+                ShowHelpAndExit();
+            }
+            seed = static_cast<uint32_t>(strtoul(argv[i], nullptr, 10));
+            continue;
+        }
+        if (!strcmp(argv[i], "-max")) {
+            if (++i == argc || 2 != sscanf(argv[i], "%ux%u", &max_width, &max_height)) {
+                ShowHelpAndExit();
+            }
+            continue;
+        }
+        ShowHelpAndExit();
+    }
+
+    // build the corpus: every combination of size, subsampling, restart interval, APPn padding, and table layout
+    static const uint16_t sizes[][2] = {{160, 120}, {640, 480}, {1920, 1080}, {3840, 2160}};
+    static const ChromaSubsampling subsamplings[] = {CSS_444, CSS_422, CSS_420, CSS_400};
+    static const uint16_t restart_intervals[] = {0, 4};
+    static const uint32_t app_paddings[] = {0, 64 * 1024};
+    std::mt19937 generator(seed);
+    SyntheticJpegWriter writer(generator);
+    std::vector<CorpusImage> corpus;
+    uint64_t corpus_size = 0;
+    for (auto &size : sizes) {
+        if (size[0] > max_width || size[1] > max_height) {
+            continue;
+        }
+        for (ChromaSubsampling subsampling : subsamplings) {
+            for (uint16_t restart_interval : restart_intervals) {
+                for (uint32_t app_padding : app_paddings) {
+                    for (int split_tables = 0; split_tables < 2; split_tables++) {
+                        CorpusImage image;
+                        image.config = {size[0], size[1], subsampling, restart_interval, app_padding, split_tables != 0};
+                        writer.Write(image.config, 50 + static_cast<int>(corpus.size() % 10) * 5, image.data);
+                        corpus_size += image.data.size();
+                        corpus.push_back(std::move(image));
+                    }
+                }
+            }
+        }
+    }
+    if (corpus.empty()) {
+        std::cerr << "ERROR: the corpus is empty; the max size is smaller than all the image sizes!" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "Synthetic corpus: " << corpus.size() << " images, " << corpus_size / (1024 * 1024) << " MiB" << std::endl;
+
+    // parse every image once to check that the stream parameters match the configuration, and that parsing the image
+    // in chunks of random sizes gives the same stream parameters (this also warms up the caches)
+    RocJpegStreamParser parser;
+    RocJpegStreamParser chunked_parser;
+    std::uniform_int_distribution<uint32_t> chunk_size_distribution(1, 4096);
+    uint32_t num_mismatches = 0;
+    for (const CorpusImage &image : corpus) {
+        const JpegStreamParameters *params = parser.GetJpegStreamParameters();
+        if (!parser.ParseJpegStream(image.data.data(), static_cast<uint32_t>(image.data.size())) ||
+            params->picture_parameter_buffer.picture_width != image.config.width ||
+            params->picture_parameter_buffer.picture_height != image.config.height ||
+            params->chroma_subsampling != image.config.subsampling ||
+            params->slice_parameter_buffer.restart_interval != image.config.restart_interval ||
+            (image.config.restart_interval != 0 && params->num_restart_markers == 0)) {
+            num_mismatches++;
+            continue;
+        }
+        uint32_t image_size = static_cast<uint32_t>(image.data.size());
+        bool is_valid = true;
+        for (uint32_t offset = 0; is_valid && offset < image_size;) {
+            uint32_t chunk_size = std::min(chunk_size_distribution(generator), image_size - offset);
+            is_valid = chunked_parser.AppendJpegStreamChunk(image.data.data() + offset, chunk_size, offset == 0, offset + chunk_size == image_size);
+            offset += chunk_size;
+        }
+        if (!is_valid || chunked_parser.GetIncrementalParseState() != PARSE_STATE_COMPLETE || !IsSameStreamParameters(chunked_parser, parser)) {
+            num_mismatches++;
+        }
+    }
+    if (num_mismatches) {
+        std::cerr << "ERROR: " << num_mismatches << " synthetic images were not parsed as expected!" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Parsing started with " << num_iterations << " iterations, please wait!" << std::endl;
+    for (CorpusImage &image : corpus) {
+        image.parse_times_ns.reserve(num_iterations);
+    }
+    for (int n = 0; n < num_iterations; n++) {
+        for (CorpusImage &image : corpus) {
+            auto start_time = std::chrono::steady_clock::now();
+            bool is_parsed = parser.ParseJpegStream(image.data.data(), static_cast<uint32_t>(image.data.size()));
+            auto end_time = std::chrono::steady_clock::now();
+            if (!is_parsed) {
+                std::cerr << "ERROR: failed to parse a synthetic image!" << std::endl;
+                return EXIT_FAILURE;
+            }
+            image.parse_times_ns.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count());
+        }
+    }
+
+    std::cout << std::endl << std::left << std::setw(16) << "group" << std::right << std::setw(8) << "images" << std::setw(14) << "mean ns/img"
+              << std::setw(12) << "p50 ns" << std::setw(12) << "p90 ns" << std::setw(12) << "p99 ns" << std::setw(12) << "max ns"
+              << std::setw(10) << "GB/s" << std::endl;
+    PrintGroupStats("all", corpus, [](const CorpusImageConfig &) { return true; });
+    for (auto &size : sizes) {
+        PrintGroupStats(std::to_string(size[0]) + "x" + std::to_string(size[1]), corpus,
+                        [&](const CorpusImageConfig &c) { return c.width == size[0] && c.height == size[1]; });
+    }
+    static const char *subsampling_names[] = {"444", "440", "422", "420", "411", "400"};
+    for (ChromaSubsampling subsampling : subsamplings) {
+        PrintGroupStats(std::string("css ") + subsampling_names[subsampling], corpus, [&](const CorpusImageConfig &c) { return c.subsampling == subsampling; });
+    }
+    PrintGroupStats("no restart", corpus, [](const CorpusImageConfig &c) { return c.restart_interval == 0; });
+    PrintGroupStats("restart", corpus, [](const CorpusImageConfig &c) { return c.restart_interval != 0; });
+    PrintGroupStats("no APPn", corpus, [](const CorpusImageConfig &c) { return c.app_padding == 0; });
+    PrintGroupStats("64 KiB APPn", corpus, [](const CorpusImageConfig &c) { return c.app_padding != 0; });
+    PrintGroupStats("shared tables", corpus, [](const CorpusImageConfig &c) { return !c.split_tables; });
+    PrintGroupStats("split tables", corpus, [](const CorpusImageConfig &c) { return c.split_tables; });
+
+    std::cout << std::endl << "Parsing completed!" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,321 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "rocjpeg_parser.h"
+#include "rocjpeg_entropy_decoder.h"
+#include "rocjpeg_cpu_kernels.h"
+
+/**
+ * @brief A JPEG image of the input set.
+ */
+struct BenchImage {
+    std::string name;
+    std::vector<uint8_t> data;
+};
+
+/**
+ * @brief The buffers of a decode, kept between the images.
+ */
+struct DecodeBuffers {
+    JpegCoefficientImage layout;
+    std::vector<int16_t> coefficients;
+    std::vector<uint8_t> planes;
+    std::vector<uint8_t> rgb;
+    std::vector<uint8_t> chroma_rows;
+};
+
+/**
+ * @brief Shows the usage of the benchmark and exits.
+ */
+void ShowHelpAndExit() {
+    std::cout << "Options:\n"
+    "-i     [input path] - input path to a single JPEG image or a directory containing JPEG images - [required]\n"
+    "-n     [iterations] - number of times each JPEG image is decoded in each mode - [optional - default: 10]\n";
+    exit(0);
+}
+
+/**
+ * @brief Reads the JPEG images of a file or a directory.
+ */
+static bool ReadImages(const std::string &input_path, std::vector<BenchImage> &images) {
+    std::vector<std::filesystem::path> paths;
+    if (std::filesystem::is_directory(input_path)) {
+        for (const auto &entry : std::filesystem::directory_iterator(input_path)) {
+            std::string extension = entry.path().extension().string();
+            std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+            if (entry.is_regular_file() && (extension == ".jpg" || extension == ".jpeg")) {
+                paths.push_back(entry.path());
+            }
+        }
+        std::sort(paths.begin(), paths.end());
+    } else if (std::filesystem::is_regular_file(input_path)) {
+        paths.push_back(input_path);
+    } else {
+        return false;
+    }
+    for (const auto &path : paths) {
+        std::ifstream file(path, std::ios::binary);
+        BenchImage image;
+        image.name = path.filename().string();
+        image.data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        images.push_back(std::move(image));
+    }
+    return true;
+}
+
+/**
+ * @brief Converts the planes of a decoded image to interleaved RGB, as the CPU backend does.
+ *
+ * The chroma rows are upsampled and converted to RGB row by row. The images that aren't YCbCr or greyscale are
+ * left in their planes.
+ *
+ * @param block_size The number of samples per row and column of a block in the planes (8, or 1 for a preview).
+ */
+static void ConvertToRgb(const RocJpegCpuKernels &kernels, uint32_t block_size, const size_t *plane_offsets, DecodeBuffers &buffers) {
+    const JpegCoefficientImage &layout = buffers.layout;
+    bool is_greyscale = layout.num_components == 1;
+    const JpegCoefficientComponent &luma = layout.components[0];
+    bool is_ycbcr = layout.num_components == 3 && luma.h_sampling_factor == layout.max_h_sampling_factor && luma.v_sampling_factor == layout.max_v_sampling_factor;
+    if (!is_greyscale && !is_ycbcr) {
+        return;
+    }
+    uint32_t scale = 8 / block_size;
+    uint32_t width = (layout.width + scale - 1) / scale;
+    uint32_t height = (layout.height + scale - 1) / scale;
+    uint32_t shift_x[3] = {}, shift_y[3] = {};
+    for (int i = 1; i < layout.num_components; i++) {
+        while ((layout.components[i].h_sampling_factor << shift_x[i]) < layout.max_h_sampling_factor) {
+            shift_x[i]++;
+        }
+        while ((layout.components[i].v_sampling_factor << shift_y[i]) < layout.max_v_sampling_factor) {
+            shift_y[i]++;
+        }
+    }
+    buffers.rgb.resize(static_cast<size_t>(width) * 3 * height);
+    buffers.chroma_rows.resize(2 * static_cast<size_t>(width));
+    uint8_t *cb_row_buffer = buffers.chroma_rows.data();
+    uint8_t *cr_row_buffer = cb_row_buffer + width;
+    if (is_greyscale) {
+        memset(buffers.chroma_rows.data(), 128, buffers.chroma_rows.size());
+    }
+    const uint8_t *planes = buffers.planes.data();
+    for (uint32_t y = 0; y < height; y++) {
+        const uint8_t *y_row = planes + static_cast<size_t>(y) * luma.width_in_blocks * block_size;
+        const uint8_t *cb_row = cb_row_buffer;
+        const uint8_t *cr_row = cr_row_buffer;
+        if (!is_greyscale) {
+            uint32_t cb_pitch = layout.components[1].width_in_blocks * block_size;
+            uint32_t cr_pitch = layout.components[2].width_in_blocks * block_size;
+            cb_row = planes + plane_offsets[1] + static_cast<size_t>(y >> shift_y[1]) * cb_pitch;
+            cr_row = planes + plane_offsets[2] + static_cast<size_t>(y >> shift_y[2]) * cr_pitch;
+            if (shift_x[1]) {
+                kernels.UpsampleRow(cb_row, shift_x[1], width, cb_row_buffer);
+                cb_row = cb_row_buffer;
+            }
+            if (shift_x[2]) {
+                kernels.UpsampleRow(cr_row, shift_x[2], width, cr_row_buffer);
+                cr_row = cr_row_buffer;
+            }
+        }
+        kernels.ConvertYCbCrToRGBRow(y_row, cb_row, cr_row, width, buffers.rgb.data() + static_cast<size_t>(y) * width * 3);
+    }
+}
+
+/**
+ * @brief Decodes an image with the stages of the CPU backend, at full size or as a DC-only preview.
+ *
+ * The full decode entropy decodes all the coefficients, computes the islow IDCT of every block, and converts the
+ * image to RGB. The preview entropy decodes the DC coefficients only, writes one sample per block, and converts
+ * the 1/8 size image to RGB.
+ *
+ * @return True if the image was decoded, false otherwise.
+ */
+static bool DecodeImage(RocJpegEntropyDecoder &entropy_decoder, const RocJpegCpuKernels &kernels, const JpegStreamParameters *jpeg_stream_params,
+                        bool is_dc_only, DecodeBuffers &buffers) {
+    entropy_decoder.SetDcOnly(is_dc_only);
+    if (!entropy_decoder.SetStreamParameters(jpeg_stream_params, buffers.layout)) {
+        return false;
+    }
+    const JpegCoefficientImage &layout = buffers.layout;
+    if (buffers.coefficients.size() < layout.num_coefficients) {
+        buffers.coefficients.resize(layout.num_coefficients);
+    }
+    if (!entropy_decoder.DecodeCoefficients(buffers.layout, buffers.coefficients.data())) {
+        return false;
+    }
+
+    uint32_t block_size = is_dc_only ? 1 : 8;
+    size_t plane_offsets[NUM_COMPONENTS];
+    size_t planes_size = 0;
+    for (int i = 0; i < layout.num_components; i++) {
+        plane_offsets[i] = planes_size;
+        planes_size += static_cast<size_t>(layout.components[i].width_in_blocks) * block_size * layout.components[i].height_in_blocks * block_size;
+    }
+    buffers.planes.resize(planes_size);
+    for (int i = 0; i < layout.num_components; i++) {
+        const JpegCoefficientComponent &component = layout.components[i];
+        if (is_dc_only) {
+            kernels.DequantizeDcComponent(buffers.coefficients.data() + component.coefficient_offset, component.quantization_table, layout.sample_precision,
+                                          component.width_in_blocks, component.height_in_blocks, buffers.planes.data() + plane_offsets[i],
+                                          component.width_in_blocks, 1);
+        } else {
+            kernels.DequantizeIdctComponent(buffers.coefficients.data() + component.coefficient_offset, component.quantization_table, layout.sample_precision,
+                                            component.width_in_blocks, component.height_in_blocks, buffers.planes.data() + plane_offsets[i],
+                                            component.width_in_blocks * block_size, 1);
+        }
+    }
+    ConvertToRgb(kernels, block_size, plane_offsets, buffers);
+    return true;
+}
+
+/**
+ * @brief Checks that the preview of an image is the image decoded at 1/8 scale from all its coefficients.
+ */
+static bool CheckPreview(RocJpegEntropyDecoder &entropy_decoder, const RocJpegCpuKernels &kernels, const JpegStreamParameters *jpeg_stream_params,
+                         const DecodeBuffers &preview) {
+    DecodeBuffers full;
+    entropy_decoder.SetDcOnly(false);
+    if (!entropy_decoder.SetStreamParameters(jpeg_stream_params, full.layout)) {
+        return false;
+    }
+    full.coefficients.resize(full.layout.num_coefficients);
+    if (!entropy_decoder.DecodeCoefficients(full.layout, full.coefficients.data())) {
+        return false;
+    }
+    size_t plane_offset = 0;
+    for (int i = 0; i < full.layout.num_components; i++) {
+        const JpegCoefficientComponent &component = full.layout.components[i];
+        size_t plane_size = static_cast<size_t>(component.width_in_blocks) * component.height_in_blocks;
+        full.planes.resize(plane_size);
+        kernels.DequantizeScaledIdctComponent(full.coefficients.data() + component.coefficient_offset, component.quantization_table, full.layout.sample_precision,
+                                              3, component.width_in_blocks, component.height_in_blocks, full.planes.data(), component.width_in_blocks, 1);
+        if (std::memcmp(full.planes.data(), preview.planes.data() + plane_offset, plane_size) != 0) {
+            return false;
+        }
+        plane_offset += plane_size;
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    std::string input_path;
+    int num_iterations = 10;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-h")) {
+            ShowHelpAndExit();
+        }
+        if (!strcmp(argv[i], "-i")) {
+            if (++i == argc) {
+                ShowHelpAndExit();
+            }
+            input_path = argv[i];
+            continue;
+        }
+        if (!strcmp(argv[i], "-n")) {
+            if (++i == argc) {
+                ShowHelpAndExit();
+            }
+            num_iterations = atoi(argv[i]);
+            if (num_iterations <= 0) {
+                ShowHelpAndExit();
+            }
+            continue;
+        }
+        ShowHelpAndExit();
+    }
+    if (input_path.empty()) {
+        ShowHelpAndExit();
+    }
+
+    std::vector<BenchImage> images;
+    if (!ReadImages(input_path, images) || images.empty()) {
+        std::cerr << "ERROR: no JPEG image found at " << input_path << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // both modes run on one thread, so the throughputs are per core; the streams are parsed outside of the timed decodes
+    RocJpegStreamParser parser;
+    RocJpegEntropyDecoder entropy_decoder;
+    entropy_decoder.SetThreadPool(nullptr);
+    RocJpegCpuKernels kernels;
+    DecodeBuffers buffers;
+    std::cout << "Decoding " << images.size() << " images " << num_iterations << " times in full and as DC-only previews with the "
+              << GetSimdLevelName(kernels.GetKernelSimdLevel()) << " kernels, please wait!" << std::endl << std::endl;
+    std::cout << std::left << std::setw(32) << "image" << std::right << std::setw(12) << "size" << std::setw(16) << "full MPix/s"
+              << std::setw(16) << "preview MPix/s" << std::setw(10) << "speedup" << std::endl;
+
+    uint64_t total_pixels = 0;
+    uint64_t total_full_ns = 0;
+    uint64_t total_preview_ns = 0;
+    for (const BenchImage &image : images) {
+        if (!parser.ParseJpegStream(image.data.data(), static_cast<uint32_t>(image.data.size())) ||
+            !DecodeImage(entropy_decoder, kernels, parser.GetJpegStreamParameters(), false, buffers)) {
+            std::cout << "Skipping " << image.name << ": the stream can't be decoded on the CPU" << std::endl;
+            continue;
+        }
+        uint64_t pixels = static_cast<uint64_t>(buffers.layout.width) * buffers.layout.height;
+        std::string size = std::to_string(buffers.layout.width) + "x" + std::to_string(buffers.layout.height);
+        uint64_t mode_ns[2] = {};
+        for (int mode = 0; mode < 2; mode++) {
+            for (int n = 0; n < num_iterations; n++) {
+                auto start_time = std::chrono::steady_clock::now();
+                if (!DecodeImage(entropy_decoder, kernels, parser.GetJpegStreamParameters(), mode == 1, buffers)) {
+                    std::cerr << "ERROR: failed to decode " << image.name << std::endl;
+                    return EXIT_FAILURE;
+                }
+                auto end_time = std::chrono::steady_clock::now();
+                mode_ns[mode] += std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count();
+            }
+        }
+        if (!CheckPreview(entropy_decoder, kernels, parser.GetJpegStreamParameters(), buffers)) {
+            std::cerr << "ERROR: the preview of " << image.name << " differs from the image decoded at 1/8 scale!" << std::endl;
+            return EXIT_FAILURE;
+        }
+        double mpixels = static_cast<double>(pixels) * num_iterations / 1e6;
+        std::cout << std::left << std::setw(32) << image.name << std::right << std::setw(12) << size << std::fixed << std::setprecision(2)
+                  << std::setw(16) << mpixels / (mode_ns[0] / 1e9) << std::setw(16) << mpixels / (mode_ns[1] / 1e9)
+                  << std::setw(9) << static_cast<double>(mode_ns[0]) / mode_ns[1] << "x" << std::endl;
+        total_pixels += pixels * num_iterations;
+        total_full_ns += mode_ns[0];
+        total_preview_ns += mode_ns[1];
+    }
+    if (total_pixels == 0) {
+        std::cerr << "ERROR: no image could be decoded" << std::endl;
+        return EXIT_FAILURE;
+    }
+    double total_mpixels = static_cast<double>(total_pixels) / 1e6;
+    std::cout << std::left << std::setw(32) << "total" << std::right << std::setw(12) << "" << std::fixed << std::setprecision(2)
+              << std::setw(16) << total_mpixels / (total_full_ns / 1e9) << std::setw(16) << total_mpixels / (total_preview_ns / 1e9)
+              << std::setw(9) << static_cast<double>(total_full_ns) / total_preview_ns << "x" << std::endl;
+    std::cout << std::endl << "The throughputs are in pixels of the full-size images. Every preview is identical to the image decoded at 1/8 scale." << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,426 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "rocjpeg_parser.h"
+#include "rocjpeg_entropy_decoder.h"
+
+/**
+ * @brief The natural (row-major) position of the coefficients in zigzag order.
+ */
+static const uint8_t kZigzagToNatural[DCT_BLOCK_SIZE] = {
+     0,  1,  8, 16,  9,  2,  3, 10, 17, 24, 32, 25, 18, 11,  4,  5,
+    12, 19, 26, 33, 40, 48, 41, 34, 27, 20, 13,  6,  7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36, 29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46, 53, 60, 61, 54, 47, 55, 62, 63
+};
+
+/**
+ * @brief A Huffman code table for encoding: the code and the code length of each symbol.
+ */
+struct HuffmanEncodeTable {
+    uint16_t code[256] = {};
+    uint8_t length[256] = {};
+};
+
+/**
+ * @brief Writes a synthetic 4:2:0 baseline JPEG stream, with or without a restart interval.
+ *
+ * The DCT coefficients are generated rather than computed from pixels: the DC coefficients follow a smooth
+ * gradient and the AC coefficients are sparse and decay along the zigzag order, which gives a bit rate close to a
+ * photo compressed at a high quality. They are coded with the code length counts of Annex K, and an RSTn marker
+ * ends every restart interval if the stream has one, as an encoder would write them. The coefficients are kept to check the decoded ones.
+ */
+class RestartJpegWriter {
+    public:
+        RestartJpegWriter(uint16_t width, uint16_t height, uint16_t restart_interval) : width_(width), height_(height), restart_interval_(restart_interval) {
+            mcus_per_row_ = (width + 15) / 16;
+            mcu_rows_ = (height + 15) / 16;
+            for (int c = 0; c < 3; c++) {
+                int sampling_factor = c == 0 ? 2 : 1;
+                widths_in_blocks_[c] = mcus_per_row_ * sampling_factor;
+                heights_in_blocks_[c] = mcu_rows_ * sampling_factor;
+            }
+        }
+
+        /**
+         * @brief Generates the coefficients of every component and writes the JPEG stream.
+         */
+        void Write(std::vector<uint8_t> &out) {
+            out_ = &out;
+            out.clear();
+            GenerateCoefficients();
+            BuildTables();
+            WriteMarker(SOI);
+            WriteMarker(DQT);
+            Write16(2 + 65);
+            Write8(0);
+            for (int i = 0; i < 64; i++) {
+                Write8(1);
+            }
+            WriteMarker(SOF);
+            Write16(8 + 3 * 3);
+            Write8(8);
+            Write16(height_);
+            Write16(width_);
+            Write8(3);
+            for (int c = 0; c < 3; c++) {
+                Write8(c + 1);
+                Write8(c == 0 ? 0x22 : 0x11);
+                Write8(0);
+            }
+            WriteMarker(DHT);
+            Write16(2 + 2 * 17 + static_cast<uint16_t>(dc_values_.size() + ac_values_.size()));
+            Write8(0x00);
+            out_->insert(out_->end(), dc_counts_, dc_counts_ + 16);
+            out_->insert(out_->end(), dc_values_.begin(), dc_values_.end());
+            Write8(0x10);
+            out_->insert(out_->end(), ac_counts_, ac_counts_ + 16);
+            out_->insert(out_->end(), ac_values_.begin(), ac_values_.end());
+            if (restart_interval_) {
+                WriteMarker(DRI);
+                Write16(4);
+                Write16(restart_interval_);
+            }
+            WriteMarker(SOS);
+            Write16(6 + 2 * 3);
+            Write8(3);
+            for (int c = 0; c < 3; c++) {
+                Write8(c + 1);
+                Write8(0x00);
+            }
+            Write8(0);
+            Write8(63);
+            Write8(0);
+            WriteScanData();
+            WriteMarker(EOI);
+        }
+
+        /**
+         * @brief Checks the coefficients decoded from the stream against the generated ones.
+         */
+        bool CheckCoefficients(const JpegCoefficientImage &image, const int16_t *coefficients) const {
+            if (image.num_components != 3) {
+                return false;
+            }
+            for (int c = 0; c < 3; c++) {
+                const JpegCoefficientComponent &component = image.components[c];
+                if (component.width_in_blocks != widths_in_blocks_[c] || component.height_in_blocks != heights_in_blocks_[c] ||
+                    memcmp(coefficients + component.coefficient_offset, coefficients_[c].data(), coefficients_[c].size() * sizeof(int16_t))) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    private:
+        void Write8(uint8_t value) { out_->push_back(value); }
+        void Write16(uint16_t value) { Write8(value >> 8); Write8(value & 0xFF); }
+        void WriteMarker(uint8_t marker) { Write8(0xFF); Write8(marker); }
+
+        void GenerateCoefficients() {
+            std::mt19937 generator(12345);
+            for (int c = 0; c < 3; c++) {
+                coefficients_[c].assign(static_cast<size_t>(widths_in_blocks_[c]) * heights_in_blocks_[c] * DCT_BLOCK_SIZE, 0);
+                for (uint32_t by = 0; by < heights_in_blocks_[c]; by++) {
+                    for (uint32_t bx = 0; bx < widths_in_blocks_[c]; bx++) {
+                        int16_t *block = &coefficients_[c][(static_cast<size_t>(by) * widths_in_blocks_[c] + bx) * DCT_BLOCK_SIZE];
+                        block[0] = static_cast<int16_t>(((bx * 7 + by * 5 + c * 100) % 1600) - 800 + static_cast<int>(generator() % 32));
+                        int32_t num_nonzero = static_cast<int32_t>(generator() % (c == 0 ? 24 : 8));
+                        for (int32_t k = 1; k < DCT_BLOCK_SIZE && num_nonzero > 0; k++) {
+                            if (generator() % (k / 4 + 2) != 0) {
+                                continue;
+                            }
+                            int32_t magnitude = 1 + static_cast<int32_t>(generator() % (1 + 256 / (k * k)));
+                            block[kZigzagToNatural[k]] = static_cast<int16_t>(generator() & 1 ? magnitude : -magnitude);
+                            num_nonzero--;
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Builds the DC and AC tables from the code length counts of Annex K, with codes assigned canonically.
+         */
+        void BuildTables() {
+            dc_values_.clear();
+            for (int i = 0; i < 12; i++) {
+                dc_values_.push_back(static_cast<uint8_t>(i));
+            }
+            ac_values_ = {0x00, 0xF0};
+            for (int run = 0; run < 16; run++) {
+                for (int size = 1; size <= 10; size++) {
+                    ac_values_.push_back(static_cast<uint8_t>((run << 4) | size));
+                }
+            }
+            AssignCodes(dc_counts_, dc_values_, dc_table_);
+            AssignCodes(ac_counts_, ac_values_, ac_table_);
+        }
+
+        static void AssignCodes(const uint8_t *counts, const std::vector<uint8_t> &values, HuffmanEncodeTable &table) {
+            uint32_t code = 0;
+            size_t index = 0;
+            for (int length = 1; length <= 16; length++) {
+                for (int i = 0; i < counts[length - 1]; i++) {
+                    table.code[values[index]] = static_cast<uint16_t>(code++);
+                    table.length[values[index]] = static_cast<uint8_t>(length);
+                    index++;
+                }
+                code <<= 1;
+            }
+        }
+
+        void PutBits(uint32_t bits, int32_t length) {
+            bit_buffer_ = (bit_buffer_ << length) | (bits & ((1u << length) - 1));
+            bit_count_ += length;
+            while (bit_count_ >= 8) {
+                uint8_t byte = static_cast<uint8_t>(bit_buffer_ >> (bit_count_ - 8));
+                Write8(byte);
+                if (byte == 0xFF) {
+                    Write8(0x00);
+                }
+                bit_count_ -= 8;
+            }
+        }
+
+        void FlushBits() {
+            if (bit_count_ > 0) {
+                PutBits(0x7F, 8 - bit_count_);
+            }
+            bit_buffer_ = 0;
+            bit_count_ = 0;
+        }
+
+        void PutSymbol(const HuffmanEncodeTable &table, uint8_t symbol) {
+            PutBits(table.code[symbol], table.length[symbol]);
+        }
+
+        void PutValue(int32_t value, uint8_t &size, uint32_t &bits) {
+            uint32_t magnitude = value < 0 ? -value : value;
+            size = 0;
+            while (magnitude >> size) {
+                size++;
+            }
+            bits = value < 0 ? static_cast<uint32_t>(value - 1) : static_cast<uint32_t>(value);
+        }
+
+        void WriteBlock(const int16_t *block, int32_t &dc_predictor) {
+            uint8_t size;
+            uint32_t bits;
+            PutValue(block[0] - dc_predictor, size, bits);
+            dc_predictor = block[0];
+            PutSymbol(dc_table_, size);
+            if (size) {
+                PutBits(bits, size);
+            }
+            int32_t run = 0;
+            for (int32_t k = 1; k < DCT_BLOCK_SIZE; k++) {
+                int16_t value = block[kZigzagToNatural[k]];
+                if (value == 0) {
+                    run++;
+                    continue;
+                }
+                for (; run > 15; run -= 16) {
+                    PutSymbol(ac_table_, 0xF0);
+                }
+                PutValue(value, size, bits);
+                PutSymbol(ac_table_, static_cast<uint8_t>((run << 4) | size));
+                PutBits(bits, size);
+                run = 0;
+            }
+            if (run > 0) {
+                PutSymbol(ac_table_, 0x00);
+            }
+        }
+
+        void WriteScanData() {
+            int32_t dc_predictors[3] = {};
+            uint32_t num_mcus = mcus_per_row_ * mcu_rows_;
+            bit_buffer_ = 0;
+            bit_count_ = 0;
+            for (uint32_t mcu = 0; mcu < num_mcus; mcu++) {
+                if (restart_interval_ && mcu != 0 && mcu % restart_interval_ == 0) {
+                    FlushBits();
+                    WriteMarker(RST0 + ((mcu / restart_interval_ - 1) & 7));
+                    memset(dc_predictors, 0, sizeof(dc_predictors));
+                }
+                uint32_t mcu_x = mcu % mcus_per_row_;
+                uint32_t mcu_y = mcu / mcus_per_row_;
+                for (int c = 0; c < 3; c++) {
+                    int sampling_factor = c == 0 ? 2 : 1;
+                    for (int y = 0; y < sampling_factor; y++) {
+                        for (int x = 0; x < sampling_factor; x++) {
+                            size_t block_index = static_cast<size_t>(mcu_y * sampling_factor + y) * widths_in_blocks_[c] + mcu_x * sampling_factor + x;
+                            WriteBlock(&coefficients_[c][block_index * DCT_BLOCK_SIZE], dc_predictors[c]);
+                        }
+                    }
+                }
+            }
+            FlushBits();
+        }
+
+        uint16_t width_, height_, restart_interval_;
+        uint32_t mcus_per_row_, mcu_rows_;
+        uint32_t widths_in_blocks_[3], heights_in_blocks_[3];
+        std::vector<int16_t> coefficients_[3];
+        const uint8_t dc_counts_[16] = {0, 1, 5, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0};
+        const uint8_t ac_counts_[16] = {0, 2, 1, 3, 3, 2, 4, 3, 5, 5, 4, 4, 0, 0, 1, 0x7D};
+        std::vector<uint8_t> dc_values_, ac_values_;
+        HuffmanEncodeTable dc_table_, ac_table_;
+        std::vector<uint8_t> *out_ = nullptr;
+        uint64_t bit_buffer_ = 0;
+        int32_t bit_count_ = 0;
+};
+
+/**
+ * @brief Shows the usage of the benchmark and exits.
+ */
+void ShowHelpAndExit() {
+    std::cout << "Options:\n"
+    "-size  [image size] - size of the synthetic image in the format WxH - [optional - default: 8192x6144]\n"
+    "-r     [restart interval] - restart interval in MCUs, 0 for one MCU row, -1 for no restart interval - [optional - default: 0]\n"
+    "-t     [max threads] - largest number of threads to measure - [optional - default: number of hardware threads]\n"
+    "-n     [iterations] - number of times the image is decoded with each number of threads - [optional - default: 5]\n";
+    exit(0);
+}
+
+int main(int argc, char **argv) {
+    uint32_t width = 8192, height = 6144;
+    int restart_interval = 0;
+    int max_threads = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+    int num_iterations = 5;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-h")) {
+            ShowHelpAndExit();
+        }
+        if (!strcmp(argv[i], "-size")) {
+            if (++i == argc || 2 != sscanf(argv[i], "%ux%u", &width, &height) || width == 0 || height == 0 || width > 65535 || height > 65535) {
+                ShowHelpAndExit();
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-r")) {
+            if (++i == argc) {
+                ShowHelpAndExit();
+            }
+            restart_interval = atoi(argv[i]);
+            if (restart_interval < -1 || restart_interval > 65535) {
+                ShowHelpAndExit();
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-t")) {
+            if (++i == argc) {
+                ShowHelpAndExit();
+            }
+            max_threads = atoi(argv[i]);
+            if (max_threads <= 0) {
+                ShowHelpAndExit();
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-n")) {
+            if (++i == argc) {
+                ShowHelpAndExit();
+            }
+            num_iterations = atoi(argv[i]);
+            if (num_iterations <= 0) {
+                ShowHelpAndExit();
+            }
+            continue;
+        }
+        ShowHelpAndExit();
+    }
+    if (restart_interval == 0) {
+        restart_interval = static_cast<int>(std::min<uint32_t>((width + 15) / 16, 65535));
+    } else if (restart_interval < 0) {
+        // without RSTn markers, the scan is decoded speculatively in parallel
+        restart_interval = 0;
+    }
+
+    std::vector<uint8_t> jpeg_stream;
+    RestartJpegWriter writer(static_cast<uint16_t>(width), static_cast<uint16_t>(height), static_cast<uint16_t>(restart_interval));
+    writer.Write(jpeg_stream);
+    double mpixels = static_cast<double>(width) * height / 1e6;
+    std::cout << "Synthetic 4:2:0 image: " << width << "x" << height << " (" << std::fixed << std::setprecision(1) << mpixels << " MPixels), "
+              << jpeg_stream.size() / 1024 << " KiB, " << (restart_interval ? "restart interval of " + std::to_string(restart_interval) + " MCUs" : "no restart interval")
+              << std::endl;
+    std::cout << "Decoding the image " << num_iterations << " times with up to " << max_threads << " threads, please wait!" << std::endl << std::endl;
+
+    std::vector<int> thread_counts;
+    for (int num_threads = 1; num_threads < max_threads; num_threads *= 2) {
+        thread_counts.push_back(num_threads);
+    }
+    thread_counts.push_back(max_threads);
+
+    std::cout << std::left << std::setw(10) << "threads" << std::right << std::setw(14) << "time (ms)" << std::setw(12) << "MPix/s"
+              << std::setw(12) << "MiB/s" << std::setw(10) << "speedup" << std::setw(12) << "efficiency" << std::endl;
+    // the stream is parsed once; only the entropy decoding is timed
+    RocJpegStreamParser parser;
+    JpegCoefficientImage image;
+    std::vector<int16_t> coefficients;
+    double single_thread_ns = 0;
+    bool is_decoded = parser.ParseJpegStream(jpeg_stream.data(), static_cast<uint32_t>(jpeg_stream.size()));
+    for (int num_threads : thread_counts) {
+        // a pool of one thread decodes the scan sequentially, which is the baseline
+        std::unique_ptr<RocJpegThreadPool> thread_pool = std::make_unique<RocJpegThreadPool>(num_threads);
+        RocJpegEntropyDecoder entropy_decoder;
+        entropy_decoder.SetThreadPool(thread_pool.get());
+        uint64_t best_ns = UINT64_MAX;
+        for (int n = 0; n < num_iterations && is_decoded; n++) {
+            auto start_time = std::chrono::steady_clock::now();
+            is_decoded = entropy_decoder.SetStreamParameters(parser.GetJpegStreamParameters(), image);
+            if (is_decoded) {
+                coefficients.resize(image.num_coefficients);
+                is_decoded = entropy_decoder.DecodeCoefficients(image, coefficients.data());
+            }
+            auto end_time = std::chrono::steady_clock::now();
+            best_ns = std::min<uint64_t>(best_ns, std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time).count());
+            is_decoded = is_decoded && writer.CheckCoefficients(image, coefficients.data());
+        }
+        if (!is_decoded) {
+            std::cerr << "ERROR: the coefficients decoded with " << num_threads << " threads differ from the encoded coefficients!" << std::endl;
+            return EXIT_FAILURE;
+        }
+        if (num_threads == 1) {
+            single_thread_ns = static_cast<double>(best_ns);
+        }
+        double speedup = single_thread_ns / best_ns;
+        std::cout << std::left << std::setw(10) << num_threads << std::right << std::fixed << std::setprecision(2)
+                  << std::setw(14) << best_ns / 1e6 << std::setw(12) << mpixels / (best_ns / 1e9)
+                  << std::setw(12) << jpeg_stream.size() / static_cast<double>(1 << 20) / (best_ns / 1e9)
+                  << std::setw(9) << speedup << "x" << std::setw(11) << 100.0 * speedup / num_threads << "%" << std::endl;
+    }
+    std::cout << std::endl << "The coefficients decoded with every number of threads match the encoded coefficients." << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -148,10 +148,10 @@ int main(int argc, char **argv) {
         for (int i = 0; i < num_channels; i++) {
             if (prior_channel_sizes[i] != channel_sizes[i]) {
                 if (output_image.channel[i] != nullptr) {
-                    CHECK_HIP(hipFree((void *)output_image.channel[i]));
+                    CHECK_HIP(RocJpegUtils::FreeChannel(rocjpeg_backend, output_image.channel[i]));
                     output_image.channel[i] = nullptr;
                 }
-                CHECK_HIP(hipMalloc(&output_image.channel[i], channel_sizes[i]));
+                CHECK_HIP(RocJpegUtils::AllocateChannel(rocjpeg_backend, &output_image.channel[i], channel_sizes[i]));
             }
         }
 
@@ -193,7 +193,7 @@ int main(int argc, char **argv) {
 
     for (int i = 0; i < num_channels; i++) {
         if (output_image.channel[i] != nullptr) {
-            CHECK_HIP(hipFree((void *)output_image.channel[i]));
+            CHECK_HIP(RocJpegUtils::FreeChannel(rocjpeg_backend, output_image.channel[i]));
             output_image.channel[i] = nullptr;
         }
     }
@@ -59,7 +59,6 @@ int main(int argc, char **argv) {
     uint64_t num_bad_jpegs = 0;
     uint64_t num_jpegs_with_411_subsampling = 0;
     uint64_t num_jpegs_with_unknown_subsampling = 0;
-    uint64_t num_jpegs_with_unsupported_resolution = 0;
     int current_batch_size = 0;
 
     RocJpegUtils::ParseCommandLine(input_path, output_file_path, save_images, device_id, rocjpeg_backend, decode_params, nullptr, &batch_size, argc, argv);
@@ -139,17 +138,10 @@ int main(int argc, char **argv) {
             }
 
             rocjpeg_utils.GetChromaSubsamplingStr(temp_subsampling, chroma_sub_sampling);
-            if (temp_widths[0] < 64 || temp_heights[0] < 64) {
-                if (is_dir) {
-                    num_jpegs_with_unsupported_resolution++;
-                    continue;
-                } else {
-                    std::cerr << "The image resolution is not supported by VCN Hardware" << std::endl;
-                    return EXIT_FAILURE;
-                }
-            }
-
-            if (temp_subsampling == ROCJPEG_CSS_411 || temp_subsampling == ROCJPEG_CSS_UNKNOWN) {
+            // the images the VCN can't decode are routed to the hybrid or CPU decoders, except for the subsamplings
+            // without a channel layout: YUV 4:1:1 has no native output format, and the chroma size of an unknown
+            // subsampling isn't reported
+            if ((temp_subsampling == ROCJPEG_CSS_411 && decode_params.output_format == ROCJPEG_OUTPUT_NATIVE) || temp_subsampling == ROCJPEG_CSS_UNKNOWN) {
                 if (is_dir) {
                     if (temp_subsampling == ROCJPEG_CSS_411) {
                         num_jpegs_with_411_subsampling++;
@@ -159,7 +151,7 @@ int main(int argc, char **argv) {
                     }
                     continue;
                 } else {
-                    std::cerr << "The chroma sub-sampling is not supported by VCN Hardware" << std::endl;
+                    std::cerr << "The chroma sub-sampling is not supported for the requested output format" << std::endl;
                     return EXIT_FAILURE;
                 }
             }
@@ -173,10 +165,10 @@ int main(int argc, char **argv) {
             for (int n = 0; n < num_channels; n++) {
                 if (prior_channel_sizes[current_batch_size][n] != channel_sizes[n]) {
                     if (output_images[current_batch_size].channel[n] != nullptr) {
-                        CHECK_HIP(hipFree((void *)output_images[current_batch_size].channel[n]));
+                        CHECK_HIP(RocJpegUtils::FreeChannel(rocjpeg_backend, output_images[current_batch_size].channel[n]));
                         output_images[current_batch_size].channel[n] = nullptr;
                     }
-                    CHECK_HIP(hipMalloc(&output_images[current_batch_size].channel[n], channel_sizes[n]));
+                    CHECK_HIP(RocJpegUtils::AllocateChannel(rocjpeg_backend, &output_images[current_batch_size].channel[n], channel_sizes[n]));
                     prior_channel_sizes[current_batch_size][n] = channel_sizes[n];
                 }
             }
@@ -229,8 +221,8 @@ int main(int argc, char **argv) {
         images_per_sec = 1000 / time_per_image_all;
         double mpixels_per_sec = mpixels_all * images_per_sec / total_images;
         std::cout << "Total decoded images: " << total_images << std::endl;
-        if (num_bad_jpegs || num_jpegs_with_411_subsampling || num_jpegs_with_unknown_subsampling || num_jpegs_with_unsupported_resolution) {
-            std::cout << "Total skipped images: " << num_bad_jpegs + num_jpegs_with_411_subsampling + num_jpegs_with_unknown_subsampling + num_jpegs_with_unsupported_resolution;
+        if (num_bad_jpegs || num_jpegs_with_411_subsampling || num_jpegs_with_unknown_subsampling) {
+            std::cout << "Total skipped images: " << num_bad_jpegs + num_jpegs_with_411_subsampling + num_jpegs_with_unknown_subsampling;
             if (num_bad_jpegs) {
                 std::cout << " ,total images that cannot be parsed: " << num_bad_jpegs;
             }
@@ -240,9 +232,6 @@ int main(int argc, char **argv) {
             if (num_jpegs_with_unknown_subsampling) {
                 std::cout << " ,total images with unknwon chroam subsampling: " << num_jpegs_with_unknown_subsampling;
             }
-            if (num_jpegs_with_unsupported_resolution) {
-                std::cout << " ,total images with unsupported_resolution: " << num_jpegs_with_unsupported_resolution;
-            }
             std::cout << std::endl;
         }
         if (total_images) {
@@ -256,7 +245,7 @@ int main(int argc, char **argv) {
     for (auto& it : output_images) {
         for (int i = 0; i < ROCJPEG_MAX_COMPONENT; i++) {
             if (it.channel[i] != nullptr) {
-                CHECK_HIP(hipFree((void *)it.channel[i]));
+                CHECK_HIP(RocJpegUtils::FreeChannel(rocjpeg_backend, it.channel[i]));
                 it.channel[i] = nullptr;
             }
         }
@@ -0,0 +1,258 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "../rocjpeg_samples_utils.h"
+
+/**
+ * @brief Shows the usage of the sample and exits.
+ *
+ * @param option The command line option that caused the error, if any.
+ */
+void ShowHelpAndExit(const char *option = nullptr) {
+    std::cout << "Options:\n"
+    "-i     [input path] - input path to a single JPEG image or a directory containing JPEG images - [required]\n"
+    "-size  [min size] - minimum size of the decoded image in the format WxH; the smallest embedded image (EXIF thumbnail or MPF image)\n"
+    "                    that is at least this size is decoded, or the primary image if there is none - [optional - default: 0x0]\n"
+    "-o     [output path] - path to an output file or a path to an existing directory - write decoded images in RGB to files - [optional]\n"
+    "-be    [backend] - select rocJPEG backend (0 for hardware-accelerated JPEG decoding using VCN,\n"
+    "                                           1 for hybrid JPEG decoding using CPU and GPU HIP kernels,\n"
+    "                                           2 for JPEG decoding on the CPU into host memory) [optional - default: 0]\n"
+    "-d     [device id] - specify the GPU device id for the desired device (use 0 for the first device, 1 for the second device, and so on) [optional - default: 0]\n";
+    exit(0);
+}
+
+/**
+ * @brief Returns the name of a kind of image.
+ */
+static const char* GetEmbeddedImageTypeName(RocJpegEmbeddedImageType image_type) {
+    switch (image_type) {
+        case ROCJPEG_EMBEDDED_IMAGE_PRIMARY:
+            return "primary image";
+        case ROCJPEG_EMBEDDED_IMAGE_EXIF_THUMBNAIL:
+            return "EXIF thumbnail";
+        case ROCJPEG_EMBEDDED_IMAGE_MPF:
+            return "MPF image";
+        default:
+            return "unknown";
+    }
+}
+
+int main(int argc, char **argv) {
+    int device_id = 0;
+    bool save_images = false;
+    uint32_t min_width = 0;
+    uint32_t min_height = 0;
+    uint8_t num_components;
+    uint32_t widths[ROCJPEG_MAX_COMPONENT] = {};
+    uint32_t heights[ROCJPEG_MAX_COMPONENT] = {};
+    uint32_t channel_sizes[ROCJPEG_MAX_COMPONENT] = {};
+    uint32_t prior_channel_sizes[ROCJPEG_MAX_COMPONENT] = {};
+    uint32_t num_channels = 0;
+    std::string chroma_sub_sampling = "";
+    std::string input_path, output_file_path;
+    std::vector<std::string> file_paths = {};
+    bool is_dir = false;
+    bool is_file = false;
+    RocJpegChromaSubsampling subsampling;
+    RocJpegBackend rocjpeg_backend = ROCJPEG_BACKEND_HARDWARE;
+    RocJpegHandle rocjpeg_handle = nullptr;
+    RocJpegStreamHandle rocjpeg_stream_handle = nullptr;
+    RocJpegStreamHandle selected_stream_handle = nullptr;
+    RocJpegImage output_image = {};
+    RocJpegDecodeParams decode_params = {};
+    RocJpegUtils rocjpeg_utils;
+    std::vector<RocJpegEmbeddedImageInfo> embedded_images;
+    uint64_t num_decoded_images = 0;
+    uint64_t num_embedded_images_decoded = 0;
+    uint64_t num_skipped_images = 0;
+    uint64_t num_failures = 0;
+
+    decode_params.output_format = ROCJPEG_OUTPUT_RGB;
+    if (argc <= 1) {
+        ShowHelpAndExit();
+    }
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-h")) {
+            ShowHelpAndExit();
+        }
+        if (!strcmp(argv[i], "-i")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-i");
+            }
+            input_path = argv[i];
+            continue;
+        }
+        if (!strcmp(argv[i], "-size")) {
+            if (++i == argc || 2 != sscanf(argv[i], "%ux%u", &min_width, &min_height)) {
+                ShowHelpAndExit("-size");
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-o")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-o");
+            }
+            output_file_path = argv[i];
+            save_images = true;
+            continue;
+        }
+        if (!strcmp(argv[i], "-be")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-be");
+            }
+            rocjpeg_backend = static_cast<RocJpegBackend>(atoi(argv[i]));
+            continue;
+        }
+        if (!strcmp(argv[i], "-d")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-d");
+            }
+            device_id = atoi(argv[i]);
+            continue;
+        }
+        ShowHelpAndExit(argv[i]);
+    }
+
+    if (!RocJpegUtils::GetFilePaths(input_path, file_paths, is_dir, is_file)) {
+        std::cerr << "ERROR: Failed to get input file paths!" << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (!RocJpegUtils::InitHipDevice(device_id)) {
+        std::cerr << "ERROR: Failed to initialize HIP!" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    CHECK_ROCJPEG(rocJpegCreate(rocjpeg_backend, device_id, &rocjpeg_handle));
+    CHECK_ROCJPEG(rocJpegStreamCreate(&rocjpeg_stream_handle));
+    CHECK_ROCJPEG(rocJpegStreamCreate(&selected_stream_handle));
+
+    std::vector<char> file_data;
+    for (auto file_path : file_paths) {
+        std::string base_file_name = file_path.substr(file_path.find_last_of("/\\") + 1);
+        std::ifstream input(file_path.c_str(), std::ios::in | std::ios::binary | std::ios::ate);
+        if (!(input.is_open())) {
+            std::cerr << "ERROR: Cannot open image: " << file_path << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::streamsize file_size = input.tellg();
+        input.seekg(0, std::ios::beg);
+        if (file_data.size() < file_size) {
+            file_data.resize(file_size);
+        }
+        if (!input.read(file_data.data(), file_size)) {
+            std::cerr << "ERROR: Cannot read from file: " << file_path << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << "Input file name: " << file_path << std::endl;
+        if (rocJpegStreamParse(reinterpret_cast<uint8_t*>(file_data.data()), file_size, rocjpeg_stream_handle) != ROCJPEG_STATUS_SUCCESS) {
+            std::cout << "Skipped: the JPEG stream cannot be parsed" << std::endl << std::endl;
+            num_skipped_images++;
+            continue;
+        }
+        CHECK_ROCJPEG(rocJpegGetImageInfo(rocjpeg_handle, rocjpeg_stream_handle, &num_components, &subsampling, widths, heights));
+        std::cout << "Primary image resolution: " << widths[0] << "x" << heights[0] << std::endl;
+
+        uint32_t num_embedded_images = 0;
+        CHECK_ROCJPEG(rocJpegGetEmbeddedImages(rocjpeg_stream_handle, nullptr, &num_embedded_images));
+        embedded_images.resize(num_embedded_images);
+        CHECK_ROCJPEG(rocJpegGetEmbeddedImages(rocjpeg_stream_handle, embedded_images.data(), &num_embedded_images));
+        for (uint32_t i = 0; i < num_embedded_images; i++) {
+            std::cout << "Embedded image " << i << ": " << GetEmbeddedImageTypeName(embedded_images[i].type) << ", " << embedded_images[i].width << "x"
+                      << embedded_images[i].height << ", " << embedded_images[i].length << " bytes" << std::endl;
+        }
+
+        RocJpegEmbeddedImageType image_type;
+        CHECK_ROCJPEG(rocJpegStreamParseEmbeddedImage(rocjpeg_stream_handle, min_width, min_height, selected_stream_handle, &image_type));
+        CHECK_ROCJPEG(rocJpegGetImageInfo(rocjpeg_handle, selected_stream_handle, &num_components, &subsampling, widths, heights));
+        rocjpeg_utils.GetChromaSubsamplingStr(subsampling, chroma_sub_sampling);
+        std::cout << "Selected image: " << GetEmbeddedImageTypeName(image_type) << ", " << widths[0] << "x" << heights[0]
+                  << ", chroma subsampling: " << chroma_sub_sampling << std::endl;
+
+        // an embedded image is only selected if it is large enough, and it must be the smallest of those
+        if (image_type != ROCJPEG_EMBEDDED_IMAGE_PRIMARY) {
+            bool is_valid = widths[0] >= min_width && heights[0] >= min_height;
+            for (uint32_t i = 0; i < num_embedded_images; i++) {
+                if (embedded_images[i].width >= min_width && embedded_images[i].height >= min_height &&
+                    static_cast<uint64_t>(embedded_images[i].width) * embedded_images[i].height < static_cast<uint64_t>(widths[0]) * heights[0]) {
+                    is_valid = false;
+                }
+            }
+            if (!is_valid) {
+                std::cerr << "ERROR: the selected image is not the smallest embedded image of the requested size!" << std::endl;
+                num_failures++;
+            }
+            num_embedded_images_decoded++;
+        }
+
+        if (widths[0] < 64 || heights[0] < 64 || subsampling == ROCJPEG_CSS_411 || subsampling == ROCJPEG_CSS_UNKNOWN) {
+            std::cout << "Skipped: the selected image is not supported by VCN Hardware" << std::endl << std::endl;
+            num_skipped_images++;
+            continue;
+        }
+
+        if (rocjpeg_utils.GetChannelPitchAndSizes(decode_params, subsampling, widths, heights, num_channels, output_image, channel_sizes)) {
+            std::cerr << "ERROR: Failed to get the channel pitch and sizes" << std::endl;
+            return EXIT_FAILURE;
+        }
+        for (int i = 0; i < num_channels; i++) {
+            if (prior_channel_sizes[i] != channel_sizes[i]) {
+                if (output_image.channel[i] != nullptr) {
+                    CHECK_HIP(RocJpegUtils::FreeChannel(rocjpeg_backend, output_image.channel[i]));
+                    output_image.channel[i] = nullptr;
+                }
+                CHECK_HIP(RocJpegUtils::AllocateChannel(rocjpeg_backend, &output_image.channel[i], channel_sizes[i]));
+                prior_channel_sizes[i] = channel_sizes[i];
+            }
+        }
+
+        CHECK_ROCJPEG(rocJpegDecode(rocjpeg_handle, selected_stream_handle, &decode_params, &output_image));
+        num_decoded_images++;
+
+        if (save_images) {
+            std::string image_save_path = output_file_path;
+            if (is_dir) {
+                rocjpeg_utils.GetOutputFileExt(decode_params.output_format, base_file_name, widths[0], heights[0], subsampling, image_save_path);
+            }
+            rocjpeg_utils.SaveImage(image_save_path, &output_image, widths[0], heights[0], subsampling, decode_params.output_format);
+        }
+        std::cout << std::endl;
+    }
+
+    for (int i = 0; i < ROCJPEG_MAX_COMPONENT; i++) {
+        if (output_image.channel[i] != nullptr) {
+            CHECK_HIP(RocJpegUtils::FreeChannel(rocjpeg_backend, output_image.channel[i]));
+            output_image.channel[i] = nullptr;
+        }
+    }
+    CHECK_ROCJPEG(rocJpegDestroy(rocjpeg_handle));
+    CHECK_ROCJPEG(rocJpegStreamDestroy(rocjpeg_stream_handle));
+    CHECK_ROCJPEG(rocJpegStreamDestroy(selected_stream_handle));
+
+    std::cout << "Total decoded images: " << num_decoded_images << " (" << num_embedded_images_decoded << " from an embedded image), total skipped images: "
+              << num_skipped_images << std::endl;
+    if (num_failures) {
+        std::cerr << "ERROR: " << num_failures << " images were not selected correctly!" << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
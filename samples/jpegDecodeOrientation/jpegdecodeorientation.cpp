@@ -0,0 +1,235 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "../rocjpeg_samples_utils.h"
+
+/**
+ * @brief Describes a plane of the output image of the decoder as stored in the JPEG stream (i.e., before the orientation).
+ */
+struct OutputPlane {
+    uint32_t width; // width in samples
+    uint32_t height; // height in samples
+    uint32_t bytes_per_sample;
+};
+
+/**
+ * @brief Lists the planes of the output image for the given output format and chroma subsampling.
+ *
+ * @return False if the combination can't be verified with an orientation.
+ */
+static bool GetOutputPlanes(RocJpegOutputFormat output_format, RocJpegChromaSubsampling subsampling, uint8_t num_components, uint32_t width, uint32_t height,
+                            std::vector<OutputPlane> &planes) {
+    uint32_t chroma_width = (subsampling == ROCJPEG_CSS_422 || subsampling == ROCJPEG_CSS_420) ? width >> 1 : width;
+    uint32_t chroma_height = (subsampling == ROCJPEG_CSS_440 || subsampling == ROCJPEG_CSS_420) ? height >> 1 : height;
+    planes.clear();
+    switch (output_format) {
+        case ROCJPEG_OUTPUT_NATIVE:
+            if (num_components == 4) {
+                // CMYK and YCCK images have a plane per component in the native format
+                return GetOutputPlanes(ROCJPEG_OUTPUT_YUV_PLANAR, subsampling, num_components, width, height, planes);
+            }
+            if (subsampling == ROCJPEG_CSS_422) {
+                return false; // packed YUYV can't be reoriented
+            }
+            planes.push_back({width, height, 1});
+            if (subsampling == ROCJPEG_CSS_420) {
+                planes.push_back({chroma_width, chroma_height, 2}); // interleaved UV
+            } else if (subsampling != ROCJPEG_CSS_400) {
+                planes.push_back({chroma_width, chroma_height, 1});
+                planes.push_back({chroma_width, chroma_height, 1});
+            }
+            break;
+        case ROCJPEG_OUTPUT_YUV_PLANAR:
+            planes.push_back({width, height, 1});
+            if (subsampling != ROCJPEG_CSS_400) {
+                planes.push_back({chroma_width, chroma_height, 1});
+                planes.push_back({chroma_width, chroma_height, 1});
+            }
+            if (num_components == 4) {
+                planes.push_back({width, height, 1}); // K
+            }
+            break;
+        case ROCJPEG_OUTPUT_Y:
+            planes.push_back({width, height, 1});
+            break;
+        case ROCJPEG_OUTPUT_RGB:
+            planes.push_back({width, height, 3});
+            break;
+        case ROCJPEG_OUTPUT_RGB_PLANAR:
+            for (int i = 0; i < 3; i++) {
+                planes.push_back({width, height, 1});
+            }
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Decodes the stream with the given orientation and copies the planes of the output image to the host.
+ */
+static void DecodeToHost(RocJpegHandle rocjpeg_handle, RocJpegStreamHandle rocjpeg_stream_handle, RocJpegDecodeParams decode_params, RocJpegOrientation orientation,
+                         const std::vector<OutputPlane> &planes, RocJpegImage &output_image, std::vector<std::vector<uint8_t>> &host_planes) {
+    bool is_transposed = orientation >= ROCJPEG_ORIENTATION_TRANSPOSE && orientation <= ROCJPEG_ORIENTATION_ROTATE_270;
+    decode_params.orientation = orientation;
+    for (size_t i = 0; i < planes.size(); i++) {
+        output_image.pitch[i] = (is_transposed ? planes[i].height : planes[i].width) * planes[i].bytes_per_sample;
+    }
+    CHECK_ROCJPEG(rocJpegDecode(rocjpeg_handle, rocjpeg_stream_handle, &decode_params, &output_image));
+    host_planes.resize(planes.size());
+    for (size_t i = 0; i < planes.size(); i++) {
+        host_planes[i].resize(static_cast<size_t>(planes[i].width) * planes[i].height * planes[i].bytes_per_sample);
+        CHECK_HIP(hipMemcpy(host_planes[i].data(), output_image.channel[i], host_planes[i].size(), hipMemcpyDefault));
+    }
+}
+
+int main(int argc, char **argv) {
+    int device_id = 0;
+    bool save_images = false;
+    uint8_t num_components;
+    uint32_t widths[ROCJPEG_MAX_COMPONENT] = {};
+    uint32_t heights[ROCJPEG_MAX_COMPONENT] = {};
+    std::string chroma_sub_sampling = "";
+    std::string input_path, output_file_path;
+    std::vector<std::string> file_paths = {};
+    bool is_dir = false;
+    bool is_file = false;
+    RocJpegChromaSubsampling subsampling;
+    RocJpegBackend rocjpeg_backend = ROCJPEG_BACKEND_HARDWARE;
+    RocJpegHandle rocjpeg_handle = nullptr;
+    RocJpegStreamHandle rocjpeg_stream_handle = nullptr;
+    RocJpegImage output_image = {};
+    RocJpegDecodeParams decode_params = {};
+    RocJpegUtils rocjpeg_utils;
+    uint64_t num_verified_images = 0;
+    uint64_t num_skipped_images = 0;
+    uint64_t num_mismatches = 0;
+
+    RocJpegUtils::ParseCommandLine(input_path, output_file_path, save_images, device_id, rocjpeg_backend, decode_params, nullptr, nullptr, argc, argv);
+
+    uint32_t roi_width = decode_params.crop_rectangle.right - decode_params.crop_rectangle.left;
+    uint32_t roi_height = decode_params.crop_rectangle.bottom - decode_params.crop_rectangle.top;
+
+    if (!RocJpegUtils::GetFilePaths(input_path, file_paths, is_dir, is_file)) {
+        std::cerr << "ERROR: Failed to get input file paths!" << std::endl;
+        return EXIT_FAILURE;
+    }
+    if (!RocJpegUtils::InitHipDevice(device_id)) {
+        std::cerr << "ERROR: Failed to initialize HIP!" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    CHECK_ROCJPEG(rocJpegCreate(rocjpeg_backend, device_id, &rocjpeg_handle));
+    CHECK_ROCJPEG(rocJpegStreamCreate(&rocjpeg_stream_handle));
+
+    std::vector<char> file_data;
+    std::vector<OutputPlane> planes;
+    std::vector<std::vector<uint8_t>> reference_planes, oriented_planes;
+    std::vector<uint8_t> expected_plane;
+    for (auto file_path : file_paths) {
+        std::ifstream input(file_path.c_str(), std::ios::in | std::ios::binary | std::ios::ate);
+        if (!(input.is_open())) {
+            std::cerr << "ERROR: Cannot open image: " << file_path << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::streamsize file_size = input.tellg();
+        input.seekg(0, std::ios::beg);
+        if (file_data.size() < file_size) {
+            file_data.resize(file_size);
+        }
+        if (!input.read(file_data.data(), file_size)) {
+            std::cerr << "ERROR: Cannot read from file: " << file_path << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        std::cout << "Input file name: " << file_path << std::endl;
+        if (rocJpegStreamParse(reinterpret_cast<uint8_t*>(file_data.data()), file_size, rocjpeg_stream_handle) != ROCJPEG_STATUS_SUCCESS) {
+            std::cout << "Skipped: the JPEG stream cannot be parsed" << std::endl << std::endl;
+            num_skipped_images++;
+            continue;
+        }
+        CHECK_ROCJPEG(rocJpegGetImageInfo(rocjpeg_handle, rocjpeg_stream_handle, &num_components, &subsampling, widths, heights));
+        RocJpegOrientation exif_orientation;
+        CHECK_ROCJPEG(rocJpegGetImageOrientation(rocjpeg_stream_handle, &exif_orientation));
+        rocjpeg_utils.GetChromaSubsamplingStr(subsampling, chroma_sub_sampling);
+        std::cout << "Input image resolution: " << widths[0] << "x" << heights[0] << std::endl;
+        std::cout << "Chroma subsampling: " + chroma_sub_sampling << std::endl;
+        std::cout << "EXIF orientation: " << exif_orientation << std::endl;
+
+        bool is_roi_valid = roi_width > 0 && roi_height > 0 && roi_width <= widths[0] && roi_height <= heights[0];
+        if (widths[0] < 64 || heights[0] < 64 || subsampling == ROCJPEG_CSS_411 || subsampling == ROCJPEG_CSS_UNKNOWN ||
+            !GetOutputPlanes(decode_params.output_format, subsampling, num_components, is_roi_valid ? roi_width : widths[0], is_roi_valid ? roi_height : heights[0], planes)) {
+            std::cout << "Skipped: the image or the output format is not supported" << std::endl << std::endl;
+            num_skipped_images++;
+            continue;
+        }
+
+        for (size_t i = 0; i < planes.size(); i++) {
+            if (output_image.channel[i] != nullptr) {
+                CHECK_HIP(RocJpegUtils::FreeChannel(rocjpeg_backend, output_image.channel[i]));
+            }
+            CHECK_HIP(RocJpegUtils::AllocateChannel(rocjpeg_backend, &output_image.channel[i], static_cast<size_t>(planes[i].width) * planes[i].height * planes[i].bytes_per_sample));
+        }
+
+        // decode the image as stored, then compare the output of every orientation with the CPU reference
+        DecodeToHost(rocjpeg_handle, rocjpeg_stream_handle, decode_params, ROCJPEG_ORIENTATION_NONE, planes, output_image, reference_planes);
+        for (int orientation = ROCJPEG_ORIENTATION_NORMAL; orientation <= ROCJPEG_ORIENTATION_ROTATE_270; orientation++) {
+            bool is_transposed = orientation >= ROCJPEG_ORIENTATION_TRANSPOSE;
+            DecodeToHost(rocjpeg_handle, rocjpeg_stream_handle, decode_params, static_cast<RocJpegOrientation>(orientation), planes, output_image, oriented_planes);
+            bool is_match = true;
+            for (size_t i = 0; i < planes.size(); i++) {
+                uint32_t src_pitch = planes[i].width * planes[i].bytes_per_sample;
+                uint32_t dst_pitch = (is_transposed ? planes[i].height : planes[i].width) * planes[i].bytes_per_sample;
+                expected_plane.resize(reference_planes[i].size());
+                RocJpegUtils::ApplyOrientation(reference_planes[i].data(), planes[i].width, planes[i].height, src_pitch, planes[i].bytes_per_sample,
+                                               static_cast<RocJpegOrientation>(orientation), expected_plane.data(), dst_pitch);
+                if (expected_plane != oriented_planes[i]) {
+                    is_match = false;
+                }
+            }
+            std::cout << "Orientation " << orientation << ": " << (is_match ? "PASSED" : "FAILED") << std::endl;
+            if (!is_match) {
+                num_mismatches++;
+            }
+        }
+        num_verified_images++;
+        std::cout << std::endl;
+    }
+
+    for (int i = 0; i < ROCJPEG_MAX_COMPONENT; i++) {
+        if (output_image.channel[i] != nullptr) {
+            CHECK_HIP(RocJpegUtils::FreeChannel(rocjpeg_backend, output_image.channel[i]));
+            output_image.channel[i] = nullptr;
+        }
+    }
+    CHECK_ROCJPEG(rocJpegDestroy(rocjpeg_handle));
+    CHECK_ROCJPEG(rocJpegStreamDestroy(rocjpeg_stream_handle));
+
+    std::cout << "Total verified images: " << num_verified_images << ", total skipped images: " << num_skipped_images << std::endl;
+    if (num_mismatches) {
+        std::cerr << "ERROR: " << num_mismatches << " oriented outputs don't match the CPU reference!" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "All the oriented outputs match the CPU reference!" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -25,6 +25,7 @@ THE SOFTWARE.
 struct DecodeInfo {
     std::vector<std::string> file_paths;
     RocJpegHandle rocjpeg_handle;
+    RocJpegBackend rocjpeg_backend;
     std::vector<RocJpegStreamHandle> rocjpeg_stream_handles;
     uint64_t num_decoded_images;
     double images_per_sec;
@@ -32,7 +33,6 @@ struct DecodeInfo {
     uint64_t num_bad_jpegs;
     uint64_t num_jpegs_with_411_subsampling;
     uint64_t num_jpegs_with_unknown_subsampling;
-    uint64_t num_jpegs_with_unsupported_resolution;
 };
 
 /**
@@ -109,12 +109,10 @@ void DecodeImages(DecodeInfo &decode_info, RocJpegUtils rocjpeg_utils, RocJpegDe
             }
 
             rocjpeg_utils.GetChromaSubsamplingStr(temp_subsampling, chroma_sub_sampling);
-            if (temp_widths[0] < 64 || temp_heights[0] < 64) {
-                decode_info.num_jpegs_with_unsupported_resolution++;
-                continue;
-            }
-
-            if (temp_subsampling == ROCJPEG_CSS_411 || temp_subsampling == ROCJPEG_CSS_UNKNOWN) {
+            // the images the VCN can't decode are routed to the hybrid or CPU decoders, except for the subsamplings
+            // without a channel layout: YUV 4:1:1 has no native output format, and the chroma size of an unknown
+            // subsampling isn't reported
+            if ((temp_subsampling == ROCJPEG_CSS_411 && decode_params.output_format == ROCJPEG_OUTPUT_NATIVE) || temp_subsampling == ROCJPEG_CSS_UNKNOWN) {
                 if (temp_subsampling == ROCJPEG_CSS_411) {
                     decode_info.num_jpegs_with_411_subsampling++;
                 }
@@ -133,10 +131,10 @@ void DecodeImages(DecodeInfo &decode_info, RocJpegUtils rocjpeg_utils, RocJpegDe
             for (int n = 0; n < num_channels; n++) {
                 if (prior_channel_sizes[current_batch_size][n] != channel_sizes[n]) {
                     if (output_images[current_batch_size].channel[n] != nullptr) {
-                        CHECK_HIP(hipFree((void *)output_images[current_batch_size].channel[n]));
+                        CHECK_HIP(RocJpegUtils::FreeChannel(decode_info.rocjpeg_backend, output_images[current_batch_size].channel[n]));
                         output_images[current_batch_size].channel[n] = nullptr;
                     }
-                    CHECK_HIP(hipMalloc(&output_images[current_batch_size].channel[n], channel_sizes[n]));
+                    CHECK_HIP(RocJpegUtils::AllocateChannel(decode_info.rocjpeg_backend, &output_images[current_batch_size].channel[n], channel_sizes[n]));
                     prior_channel_sizes[current_batch_size][n] = channel_sizes[n];
                 }
             }
@@ -188,7 +186,7 @@ void DecodeImages(DecodeInfo &decode_info, RocJpegUtils rocjpeg_utils, RocJpegDe
     for (auto& it : output_images) {
         for (int i = 0; i < ROCJPEG_MAX_COMPONENT; i++) {
             if (it.channel[i] != nullptr) {
-                CHECK_HIP(hipFree((void *)it.channel[i]));
+                CHECK_HIP(RocJpegUtils::FreeChannel(decode_info.rocjpeg_backend, it.channel[i]));
                 it.channel[i] = nullptr;
             }
         }
@@ -227,6 +225,7 @@ int main(int argc, char **argv) {
 
     for (int i = 0; i < num_threads; i++) {
         CHECK_ROCJPEG(rocJpegCreate(rocjpeg_backend, device_id, &decode_info_per_thread[i].rocjpeg_handle));
+        decode_info_per_thread[i].rocjpeg_backend = rocjpeg_backend;
         decode_info_per_thread[i].rocjpeg_stream_handles.resize(batch_size);
         for (auto j = 0; j < batch_size; j++) {
             CHECK_ROCJPEG(rocJpegStreamCreate(&decode_info_per_thread[i].rocjpeg_stream_handles[j]));
@@ -237,7 +236,6 @@ int main(int argc, char **argv) {
         decode_info_per_thread[i].num_bad_jpegs = 0;
         decode_info_per_thread[i].num_jpegs_with_411_subsampling = 0;
         decode_info_per_thread[i].num_jpegs_with_unknown_subsampling = 0;
-        decode_info_per_thread[i].num_jpegs_with_unsupported_resolution = 0;
     }
 
     ThreadPool thread_pool(num_threads);
@@ -263,7 +261,6 @@ int main(int argc, char **argv) {
     uint64_t total_num_bad_jpegs = 0;
     uint64_t total_num_jpegs_with_411_subsampling = 0;
     uint64_t total_num_jpegs_with_unknown_subsampling = 0;
-    uint64_t total_num_jpegs_with_unsupported_resolution = 0;
 
     for (auto i = 0; i < num_threads; i++) {
         total_decoded_images += decode_info_per_thread[i].num_decoded_images;
@@ -272,12 +269,11 @@ int main(int argc, char **argv) {
         total_num_bad_jpegs += decode_info_per_thread[i].num_bad_jpegs;
         total_num_jpegs_with_411_subsampling += decode_info_per_thread[i].num_jpegs_with_411_subsampling;
         total_num_jpegs_with_unknown_subsampling += decode_info_per_thread[i].num_jpegs_with_unknown_subsampling;
-        total_num_jpegs_with_unsupported_resolution += decode_info_per_thread[i].num_jpegs_with_unsupported_resolution;
     }
 
     std::cout << "Total decoded images: " << total_decoded_images << std::endl;
-    if (total_num_bad_jpegs || total_num_jpegs_with_411_subsampling || total_num_jpegs_with_unknown_subsampling || total_num_jpegs_with_unsupported_resolution) {
-        std::cout << "Total skipped images: " << total_num_bad_jpegs + total_num_jpegs_with_411_subsampling + total_num_jpegs_with_unknown_subsampling + total_num_jpegs_with_unsupported_resolution;
+    if (total_num_bad_jpegs || total_num_jpegs_with_411_subsampling || total_num_jpegs_with_unknown_subsampling) {
+        std::cout << "Total skipped images: " << total_num_bad_jpegs + total_num_jpegs_with_411_subsampling + total_num_jpegs_with_unknown_subsampling;
         if (total_num_bad_jpegs) {
             std::cout << " ,total images that cannot be parsed: " << total_num_bad_jpegs;
         }
@@ -287,9 +283,6 @@ int main(int argc, char **argv) {
         if (total_num_jpegs_with_unknown_subsampling) {
             std::cout << " ,total images with unknwon chroam subsampling: " << total_num_jpegs_with_unknown_subsampling;
         }
-        if (total_num_jpegs_with_unsupported_resolution) {
-            std::cout << " ,total images with unsupported_resolution: " << total_num_jpegs_with_unsupported_resolution;
-        }
         std::cout << std::endl;
     }
 
@@ -299,6 +292,24 @@ int main(int argc, char **argv) {
         std::cout << "Average decoded images size (Mpixels/Sec): " << total_image_size_in_mpixels_per_sec << std::endl;
     }
 
+    RocJpegDecodeRouteStats total_route_stats = {};
+    for (int i = 0; i < num_threads; i++) {
+        RocJpegDecodeRouteStats route_stats;
+        CHECK_ROCJPEG(rocJpegGetDecodeRouteStats(decode_info_per_thread[i].rocjpeg_handle, &route_stats));
+        total_route_stats.num_hardware_decodes += route_stats.num_hardware_decodes;
+        total_route_stats.num_hardware_remapped_decodes += route_stats.num_hardware_remapped_decodes;
+        total_route_stats.num_hybrid_decodes += route_stats.num_hybrid_decodes;
+        total_route_stats.num_cpu_decodes += route_stats.num_cpu_decodes;
+        total_route_stats.num_resolution_fallbacks += route_stats.num_resolution_fallbacks;
+        total_route_stats.num_subsampling_fallbacks += route_stats.num_subsampling_fallbacks;
+    }
+    std::cout << "Decode routes: VCN " << total_route_stats.num_hardware_decodes << ", VCN with remapped Huffman tables " << total_route_stats.num_hardware_remapped_decodes
+              << ", hybrid " << total_route_stats.num_hybrid_decodes << ", CPU " << total_route_stats.num_cpu_decodes << std::endl;
+    if (total_route_stats.num_resolution_fallbacks || total_route_stats.num_subsampling_fallbacks) {
+        std::cout << "Images routed away from the VCN: unsupported resolution " << total_route_stats.num_resolution_fallbacks
+                  << ", unsupported chroma subsampling " << total_route_stats.num_subsampling_fallbacks << std::endl;
+    }
+
     for (int i = 0; i < num_threads; i++) {
         CHECK_ROCJPEG(rocJpegDestroy(decode_info_per_thread[i].rocjpeg_handle));
         for (auto j = 0; j < batch_size; j++) {
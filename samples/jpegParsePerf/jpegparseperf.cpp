@@ -0,0 +1,337 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include <random>
+#include "../rocjpeg_samples_utils.h"
+
+/**
+ * @brief Shows the usage of the sample and exits.
+ *
+ * @param option The command line option that caused the error, if any.
+ */
+void ShowHelpAndExit(const char *option = nullptr) {
+    std::cout << "Options:\n"
+    "-i     [input path] - input path to a single JPEG image or a directory containing JPEG images - [required]\n"
+    "-n     [iterations] - number of times each JPEG image is parsed - [optional - default: 100]\n"
+    "-b     [batch size] - parse the JPEG images in batches of this size with rocJpegStreamParseBatched - [optional - default: 1 (rocJpegStreamParse)]\n"
+    "-c     [max chunk size] - feed each JPEG image to rocJpegStreamParseChunk in chunks of random sizes between 1 and this size - [optional - default: 0 (disabled)]\n";
+    exit(0);
+}
+
+/**
+ * @brief Feeds a JPEG image to rocJpegStreamParseChunk in chunks of random sizes, as if it was received over a socket.
+ *
+ * @param data The JPEG image.
+ * @param max_chunk_size The largest chunk size.
+ * @param chunk_size_generator The random generator of the chunk sizes.
+ * @param rocjpeg_stream_handle The stream handle that parses the image.
+ * @param header_size Set to the size of the data received when the header was parsed, or 0 if it wasn't parsed.
+ * @return True if the image was completely parsed after its last chunk, false otherwise.
+ */
+bool ParseInChunks(const std::vector<char> &data, int max_chunk_size, std::mt19937 &chunk_size_generator, RocJpegStreamHandle rocjpeg_stream_handle,
+                   size_t &header_size) {
+    std::uniform_int_distribution<size_t> chunk_size_distribution(1, max_chunk_size);
+    const unsigned char *stream = reinterpret_cast<const unsigned char*>(data.data());
+    size_t offset = 0;
+    RocJpegStatus rocjpeg_status = ROCJPEG_STATUS_SUCCESS;
+    RocJpegStreamParseState parse_state = ROCJPEG_STREAM_PARSE_HEADER_PENDING;
+    header_size = 0;
+    do {
+        size_t chunk_size = std::min(chunk_size_distribution(chunk_size_generator), data.size() - offset);
+        uint32_t flags = (offset == 0 ? ROCJPEG_STREAM_CHUNK_FIRST : 0) | (offset + chunk_size == data.size() ? ROCJPEG_STREAM_CHUNK_LAST : 0);
+        rocjpeg_status = rocJpegStreamParseChunk(stream + offset, chunk_size, flags, rocjpeg_stream_handle, &parse_state);
+        offset += chunk_size;
+        if (header_size == 0 && parse_state != ROCJPEG_STREAM_PARSE_HEADER_PENDING) {
+            header_size = offset;
+        }
+    } while (rocjpeg_status == ROCJPEG_STATUS_SUCCESS && offset < data.size());
+    return rocjpeg_status == ROCJPEG_STATUS_SUCCESS && parse_state == ROCJPEG_STREAM_PARSE_COMPLETE;
+}
+
+/**
+ * @brief Checks that two stream handles hold the same parsed image.
+ *
+ * The image information, the coefficient plane sizes (which follow the sampling factors of every component), the
+ * orientation, and the EXIF thumbnail are compared. The MPF images aren't compared, as a chunked parse stops at the
+ * end of the primary image.
+ *
+ * @param rocjpeg_handle The rocJPEG handle used to retrieve the image information.
+ * @param stream_handle The stream handle parsed in chunks.
+ * @param reference_stream_handle The stream handle parsed in one call.
+ * @return True if the parsed images match, false otherwise.
+ */
+bool IsSameParsedImage(RocJpegHandle rocjpeg_handle, RocJpegStreamHandle stream_handle, RocJpegStreamHandle reference_stream_handle) {
+    RocJpegStreamHandle stream_handles[2] = {stream_handle, reference_stream_handle};
+    uint8_t num_components[2];
+    RocJpegChromaSubsampling subsamplings[2];
+    uint32_t widths[2][ROCJPEG_MAX_COMPONENT] = {};
+    uint32_t heights[2][ROCJPEG_MAX_COMPONENT] = {};
+    uint8_t num_coefficient_components[2];
+    uint32_t widths_in_blocks[2][ROCJPEG_MAX_COMPONENT] = {};
+    uint32_t heights_in_blocks[2][ROCJPEG_MAX_COMPONENT] = {};
+    RocJpegOrientation orientations[2];
+    std::vector<RocJpegEmbeddedImageInfo> thumbnails[2];
+    for (int k = 0; k < 2; k++) {
+        uint32_t num_images = 0;
+        if (rocJpegGetImageInfo(rocjpeg_handle, stream_handles[k], &num_components[k], &subsamplings[k], widths[k], heights[k]) != ROCJPEG_STATUS_SUCCESS ||
+            rocJpegGetCoefficientInfo(stream_handles[k], &num_coefficient_components[k], widths_in_blocks[k], heights_in_blocks[k]) != ROCJPEG_STATUS_SUCCESS ||
+            rocJpegGetImageOrientation(stream_handles[k], &orientations[k]) != ROCJPEG_STATUS_SUCCESS ||
+            rocJpegGetEmbeddedImages(stream_handles[k], nullptr, &num_images) != ROCJPEG_STATUS_SUCCESS) {
+            return false;
+        }
+        std::vector<RocJpegEmbeddedImageInfo> images(num_images);
+        if (num_images > 0 && rocJpegGetEmbeddedImages(stream_handles[k], images.data(), &num_images) != ROCJPEG_STATUS_SUCCESS) {
+            return false;
+        }
+        for (const RocJpegEmbeddedImageInfo &image : images) {
+            if (image.type == ROCJPEG_EMBEDDED_IMAGE_EXIF_THUMBNAIL) {
+                thumbnails[k].push_back(image);
+            }
+        }
+    }
+    if (num_components[0] != num_components[1] || subsamplings[0] != subsamplings[1] || orientations[0] != orientations[1] ||
+        memcmp(widths[0], widths[1], sizeof(widths[0])) || memcmp(heights[0], heights[1], sizeof(heights[0])) ||
+        num_coefficient_components[0] != num_coefficient_components[1] ||
+        memcmp(widths_in_blocks[0], widths_in_blocks[1], sizeof(widths_in_blocks[0])) ||
+        memcmp(heights_in_blocks[0], heights_in_blocks[1], sizeof(heights_in_blocks[0])) || thumbnails[0].size() != thumbnails[1].size()) {
+        return false;
+    }
+    for (size_t i = 0; i < thumbnails[0].size(); i++) {
+        if (thumbnails[0][i].width != thumbnails[1][i].width || thumbnails[0][i].height != thumbnails[1][i].height ||
+            thumbnails[0][i].offset != thumbnails[1][i].offset || thumbnails[0][i].length != thumbnails[1][i].length) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    int num_iterations = 100;
+    int batch_size = 1;
+    int max_chunk_size = 0;
+    std::mt19937 chunk_size_generator(0);
+    uint64_t header_size_in_bytes = 0;
+    bool is_dir = false;
+    bool is_file = false;
+    std::string input_path;
+    std::vector<std::string> file_paths = {};
+    std::vector<std::vector<char>> file_data;
+    uint64_t total_size_in_bytes = 0;
+    uint64_t num_bad_jpegs = 0;
+    uint64_t num_mismatches = 0;
+    std::vector<RocJpegStreamHandle> rocjpeg_stream_handles;
+    std::vector<const unsigned char*> batch_data;
+    std::vector<size_t> batch_lengths;
+    std::vector<RocJpegStatus> batch_statuses;
+
+    if (argc <= 1) {
+        ShowHelpAndExit();
+    }
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-h")) {
+            ShowHelpAndExit();
+        }
+        if (!strcmp(argv[i], "-i")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-i");
+            }
+            input_path = argv[i];
+            continue;
+        }
+        if (!strcmp(argv[i], "-n")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-n");
+            }
+            num_iterations = atoi(argv[i]);
+            if (num_iterations <= 0) {
+                ShowHelpAndExit(argv[i]);
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-b")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-b");
+            }
+            batch_size = atoi(argv[i]);
+            if (batch_size <= 0) {
+                ShowHelpAndExit(argv[i]);
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-c")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-c");
+            }
+            max_chunk_size = atoi(argv[i]);
+            if (max_chunk_size <= 0) {
+                ShowHelpAndExit(argv[i]);
+            }
+            continue;
+        }
+        ShowHelpAndExit(argv[i]);
+    }
+
+    if (!RocJpegUtils::GetFilePaths(input_path, file_paths, is_dir, is_file)) {
+        std::cerr << "ERROR: Failed to get input file paths!" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // Read all the images into memory, so that only the parsing is measured.
+    file_data.resize(file_paths.size());
+    for (size_t i = 0; i < file_paths.size(); i++) {
+        std::ifstream input(file_paths[i].c_str(), std::ios::in | std::ios::binary | std::ios::ate);
+        if (!(input.is_open())) {
+            std::cerr << "ERROR: Cannot open image: " << file_paths[i] << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::streamsize file_size = input.tellg();
+        input.seekg(0, std::ios::beg);
+        file_data[i].resize(file_size);
+        if (!input.read(file_data[i].data(), file_size)) {
+            std::cerr << "ERROR: Cannot read from file: " << file_paths[i] << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    rocjpeg_stream_handles.resize(batch_size);
+    batch_data.resize(batch_size);
+    batch_lengths.resize(batch_size);
+    batch_statuses.resize(batch_size);
+    for (auto &rocjpeg_stream_handle : rocjpeg_stream_handles) {
+        CHECK_ROCJPEG(rocJpegStreamCreate(&rocjpeg_stream_handle));
+    }
+
+    if (max_chunk_size > 0) {
+        // check that every image parsed in chunks gives the same result as parsing it in one call
+        RocJpegHandle rocjpeg_handle = nullptr;
+        RocJpegStreamHandle reference_stream_handle = nullptr;
+        CHECK_ROCJPEG(rocJpegCreate(ROCJPEG_BACKEND_CPU, 0, &rocjpeg_handle));
+        CHECK_ROCJPEG(rocJpegStreamCreate(&reference_stream_handle));
+        for (size_t i = 0; i < file_data.size(); i++) {
+            size_t header_size;
+            if (rocJpegStreamParse(reinterpret_cast<uint8_t*>(file_data[i].data()), file_data[i].size(), reference_stream_handle) != ROCJPEG_STATUS_SUCCESS ||
+                !ParseInChunks(file_data[i], max_chunk_size, chunk_size_generator, rocjpeg_stream_handles[0], header_size)) {
+                continue;
+            }
+            if (!IsSameParsedImage(rocjpeg_handle, rocjpeg_stream_handles[0], reference_stream_handle)) {
+                num_mismatches++;
+                std::cerr << "The chunked parse doesn't match the one-shot parse of input file: " << file_paths[i] << std::endl;
+            }
+        }
+        CHECK_ROCJPEG(rocJpegStreamDestroy(reference_stream_handle));
+        CHECK_ROCJPEG(rocJpegDestroy(rocjpeg_handle));
+    }
+
+    std::cout << "Parsing started with " << num_iterations << " iterations and batch size " << batch_size << ", please wait!" << std::endl;
+    auto start_time = std::chrono::high_resolution_clock::now();
+    for (int n = 0; n < num_iterations; n++) {
+        if (max_chunk_size > 0) {
+            for (size_t i = 0; i < file_data.size(); i++) {
+                size_t header_size = 0;
+                if (!ParseInChunks(file_data[i], max_chunk_size, chunk_size_generator, rocjpeg_stream_handles[0], header_size)) {
+                    if (n == 0) {
+                        num_bad_jpegs++;
+                        std::cerr << "Failed to parse input file: " << file_paths[i] << std::endl;
+                    }
+                    continue;
+                }
+                total_size_in_bytes += file_data[i].size();
+                header_size_in_bytes += header_size;
+            }
+            continue;
+        }
+        if (batch_size == 1) {
+            for (size_t i = 0; i < file_data.size(); i++) {
+                RocJpegStatus rocjpeg_status = rocJpegStreamParse(reinterpret_cast<uint8_t*>(file_data[i].data()), file_data[i].size(), rocjpeg_stream_handles[0]);
+                if (rocjpeg_status != ROCJPEG_STATUS_SUCCESS) {
+                    if (n == 0) {
+                        num_bad_jpegs++;
+                        std::cerr << "Failed to parse input file: " << file_paths[i] << std::endl;
+                    }
+                    continue;
+                }
+                total_size_in_bytes += file_data[i].size();
+            }
+            continue;
+        }
+        for (size_t i = 0; i < file_data.size(); i += batch_size) {
+            int current_batch_size = static_cast<int>(std::min(static_cast<size_t>(batch_size), file_data.size() - i));
+            for (int b = 0; b < current_batch_size; b++) {
+                batch_data[b] = reinterpret_cast<const unsigned char*>(file_data[i + b].data());
+                batch_lengths[b] = file_data[i + b].size();
+            }
+            CHECK_ROCJPEG(rocJpegStreamParseBatched(batch_data.data(), batch_lengths.data(), current_batch_size, rocjpeg_stream_handles.data(), batch_statuses.data()));
+            for (int b = 0; b < current_batch_size; b++) {
+                if (batch_statuses[b] != ROCJPEG_STATUS_SUCCESS) {
+                    if (n == 0) {
+                        num_bad_jpegs++;
+                        std::cerr << "Failed to parse input file: " << file_paths[i + b] << std::endl;
+                    }
+                    continue;
+                }
+                total_size_in_bytes += batch_lengths[b];
+            }
+        }
+    }
+    auto end_time = std::chrono::high_resolution_clock::now();
+    double total_parse_time_in_sec = std::chrono::duration<double>(end_time - start_time).count();
+
+    for (auto &rocjpeg_stream_handle : rocjpeg_stream_handles) {
+        CHECK_ROCJPEG(rocJpegStreamDestroy(rocjpeg_stream_handle));
+    }
+
+    uint64_t total_parsed_images = (file_data.size() - num_bad_jpegs) * num_iterations;
+    std::cout << "Total parsed images: " << total_parsed_images << std::endl;
+    if (num_bad_jpegs) {
+        std::cout << "Total images that cannot be parsed: " << num_bad_jpegs << std::endl;
+    }
+    if (num_mismatches) {
+        std::cout << "Total images whose chunked parse doesn't match the one-shot parse: " << num_mismatches << std::endl;
+    }
+    if (total_parsed_images > 0 && total_parse_time_in_sec > 0) {
+        std::cout << "Average parsing time per image (us): " << total_parse_time_in_sec * 1000000 / total_parsed_images << std::endl;
+        std::cout << "Average parsed images per sec (Images/Sec): " << total_parsed_images / total_parse_time_in_sec << std::endl;
+        std::cout << "Average parsing throughput (GB/Sec): " << total_size_in_bytes / total_parse_time_in_sec / 1000000000 << std::endl;
+        if (max_chunk_size > 0 && total_size_in_bytes > 0) {
+            std::cout << "Average received data when the header was parsed (%): " << 100.0 * header_size_in_bytes / total_size_in_bytes << std::endl;
+        }
+    }
+
+    RocJpegTableCacheStats table_cache_stats;
+    CHECK_ROCJPEG(rocJpegGetTableCacheStats(&table_cache_stats));
+    uint64_t huffman_table_lookups = table_cache_stats.huffman_table_hits + table_cache_stats.huffman_table_misses;
+    uint64_t quantization_table_lookups = table_cache_stats.quantization_table_hits + table_cache_stats.quantization_table_misses;
+    if (huffman_table_lookups > 0 && quantization_table_lookups > 0) {
+        std::cout << "Huffman table cache hit rate (%): " << 100.0 * table_cache_stats.huffman_table_hits / huffman_table_lookups
+                  << " (" << table_cache_stats.num_huffman_tables << " tables)" << std::endl;
+        std::cout << "Quantization table cache hit rate (%): " << 100.0 * table_cache_stats.quantization_table_hits / quantization_table_lookups
+                  << " (" << table_cache_stats.num_quantization_tables << " tables)" << std::endl;
+    }
+
+    if (num_bad_jpegs || num_mismatches) {
+        std::cerr << "ERROR: Parsing failed!" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::cout << "Parsing completed!" << std::endl;
+    return EXIT_SUCCESS;
+}
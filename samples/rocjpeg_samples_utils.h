@@ -27,6 +27,7 @@ THE SOFTWARE.
 #include <fstream>
 #include <iomanip>
 #include <string>
+#include <cstring>
 #include <vector>
 #include <thread>
 #include <mutex>
@@ -139,6 +140,14 @@ public:
                     decode_params.output_format = ROCJPEG_OUTPUT_RGB;
                 } else if (selected_output_format == "rgb_planar") {
                     decode_params.output_format = ROCJPEG_OUTPUT_RGB_PLANAR;
+                } else if (selected_output_format == "yuv_planar_16") {
+                    decode_params.output_format = ROCJPEG_OUTPUT_YUV_PLANAR_16;
+                } else if (selected_output_format == "y_16") {
+                    decode_params.output_format = ROCJPEG_OUTPUT_Y_16;
+                } else if (selected_output_format == "rgb_16") {
+                    decode_params.output_format = ROCJPEG_OUTPUT_RGB_16;
+                } else if (selected_output_format == "rgb_planar_16") {
+                    decode_params.output_format = ROCJPEG_OUTPUT_RGB_PLANAR_16;
                 } else {
                     ShowHelpAndExit(argv[i], num_threads != nullptr);
                 }
@@ -263,6 +272,38 @@ public:
         return true;
     }
 
+    /**
+     * @brief Allocates a channel of an output image.
+     *
+     * The channels are allocated in device memory for the GPU backends and in pinned host memory for the
+     * ROCJPEG_BACKEND_CPU backend, which writes the decoded images on the CPU.
+     *
+     * @param rocjpeg_backend The rocJPEG backend.
+     * @param channel Pointer to store the address of the channel.
+     * @param size The size of the channel in bytes.
+     * @return The status of the allocation.
+     */
+    static hipError_t AllocateChannel(RocJpegBackend rocjpeg_backend, uint8_t **channel, size_t size) {
+        if (rocjpeg_backend == ROCJPEG_BACKEND_CPU) {
+            return hipHostMalloc(reinterpret_cast<void **>(channel), size);
+        }
+        return hipMalloc(reinterpret_cast<void **>(channel), size);
+    }
+
+    /**
+     * @brief Frees a channel allocated by AllocateChannel.
+     *
+     * @param rocjpeg_backend The rocJPEG backend.
+     * @param channel The address of the channel.
+     * @return The status of the operation.
+     */
+    static hipError_t FreeChannel(RocJpegBackend rocjpeg_backend, uint8_t *channel) {
+        if (rocjpeg_backend == ROCJPEG_BACKEND_CPU) {
+            return hipHostFree(channel);
+        }
+        return hipFree(channel);
+    }
+
     /**
      * @brief Gets the chroma subsampling string.
      *
@@ -300,6 +341,30 @@ public:
         }
     }
 
+    /**
+     * @brief Maps a 16-bit output format to the 8-bit output format with the same channel layout.
+     *
+     * @param output_format The output format.
+     * @param sample_size The size of a sample in bytes (1 or 2).
+     * @return The output format with 8-bit samples.
+     */
+    static RocJpegOutputFormat Get8BitOutputFormat(RocJpegOutputFormat output_format, uint32_t &sample_size) {
+        sample_size = 2;
+        switch (output_format) {
+            case ROCJPEG_OUTPUT_YUV_PLANAR_16:
+                return ROCJPEG_OUTPUT_YUV_PLANAR;
+            case ROCJPEG_OUTPUT_Y_16:
+                return ROCJPEG_OUTPUT_Y;
+            case ROCJPEG_OUTPUT_RGB_16:
+                return ROCJPEG_OUTPUT_RGB;
+            case ROCJPEG_OUTPUT_RGB_PLANAR_16:
+                return ROCJPEG_OUTPUT_RGB_PLANAR;
+            default:
+                sample_size = 1;
+                return output_format;
+        }
+    }
+
     /**
      * @brief Gets the channel pitch and sizes.
      *
@@ -326,6 +391,16 @@ public:
         if (roi_width > 0 && roi_height > 0 && roi_width <= widths[0] && roi_height <= heights[0]) {
             is_roi_valid = true; 
         }
+        // the 16-bit output formats have the layout of the 8-bit formats with twice the bytes per sample
+        uint32_t sample_size;
+        decode_params.output_format = Get8BitOutputFormat(decode_params.output_format, sample_size);
+        // a CMYK or YCCK image has a plane per component in the native format, and a fourth plane for K
+        bool has_k_plane = widths[3] > 0;
+        if (has_k_plane && decode_params.output_format == ROCJPEG_OUTPUT_NATIVE) {
+            decode_params.output_format = ROCJPEG_OUTPUT_YUV_PLANAR;
+        }
+        output_image.pitch[3] = 0;
+        channel_sizes[3] = 0;
         switch (decode_params.output_format) {
             case ROCJPEG_OUTPUT_NATIVE:
                 switch (subsampling) {
@@ -395,6 +470,15 @@ public:
                 std::cout << "Unknown output format!" << std::endl;
                 return EXIT_FAILURE;
         }
+        if (has_k_plane && decode_params.output_format == ROCJPEG_OUTPUT_YUV_PLANAR) {
+            num_channels = 4;
+            output_image.pitch[3] = is_roi_valid ? roi_width : widths[3];
+            channel_sizes[3] = output_image.pitch[3] * (is_roi_valid ? roi_height : heights[3]);
+        }
+        for (uint32_t i = 0; i < num_channels; i++) {
+            output_image.pitch[i] *= sample_size;
+            channel_sizes[i] *= sample_size;
+        }
         return EXIT_SUCCESS;
     }
 
@@ -415,6 +499,8 @@ public:
         std::string::size_type const p(base_file_name.find_last_of('.'));
         std::string file_name_no_ext = base_file_name.substr(0, p);
         std::string format_description = "";
+        uint32_t sample_size;
+        output_format = Get8BitOutputFormat(output_format, sample_size);
         switch (output_format) {
             case ROCJPEG_OUTPUT_NATIVE:
                 file_extension = "yuv";
@@ -459,6 +545,9 @@ public:
                 file_extension = "";
                 break;
         }
+        if (sample_size == 2) {
+            format_description += "_16bit";
+        }
         file_name_for_saving += "//" + file_name_no_ext + "_" + std::to_string(image_width) + "x"
             + std::to_string(image_height) + "_" + format_description + "." + file_extension;
     }
@@ -488,6 +577,14 @@ public:
 
         uint32_t widths[ROCJPEG_MAX_COMPONENT] = {};
         uint32_t heights[ROCJPEG_MAX_COMPONENT] = {};
+        uint32_t sample_size;
+        output_format = Get8BitOutputFormat(output_format, sample_size);
+        // the K plane of a CMYK or YCCK image follows the planes of the other components
+        bool has_k_plane = output_image->pitch[3] != 0 && output_image->channel[3] != nullptr &&
+                           (output_format == ROCJPEG_OUTPUT_NATIVE || output_format == ROCJPEG_OUTPUT_YUV_PLANAR);
+        if (has_k_plane) {
+            output_format = ROCJPEG_OUTPUT_YUV_PLANAR;
+        }
 
         switch (output_format) {
             case ROCJPEG_OUTPUT_NATIVE:
@@ -566,18 +663,27 @@ public:
                 std::cout << "Unknown output format!" << std::endl;
                 return;
         }
+        if (has_k_plane) {
+            widths[3] = img_width;
+            heights[3] = img_height;
+        }
+        // the widths are written in bytes
+        for (int i = 0; i < ROCJPEG_MAX_COMPONENT; i++) {
+            widths[i] *= sample_size;
+        }
 
         uint32_t channel0_size = output_image->pitch[0] * heights[0];
         uint32_t channel1_size = output_image->pitch[1] * heights[1];
         uint32_t channel2_size = output_image->pitch[2] * heights[2];
+        uint32_t channel3_size = output_image->pitch[3] * heights[3];
 
-        uint32_t output_image_size = channel0_size + channel1_size + channel2_size;
+        uint32_t output_image_size = channel0_size + channel1_size + channel2_size + channel3_size;
 
         if (hst_ptr == nullptr) {
             hst_ptr = new uint8_t [output_image_size];
         }
 
-        CHECK_HIP(hipMemcpyDtoH((void *)hst_ptr, output_image->channel[0], channel0_size));
+        CHECK_HIP(hipMemcpy((void *)hst_ptr, output_image->channel[0], channel0_size, hipMemcpyDefault));
 
         uint8_t *tmp_hst_ptr = hst_ptr;
         fp = fopen(output_file_name.c_str(), "wb");
@@ -594,7 +700,7 @@ public:
             // write channel1
             if (channel1_size != 0 && output_image->channel[1] != nullptr) {
                 uint8_t *channel1_hst_ptr = hst_ptr + channel0_size;
-                CHECK_HIP(hipMemcpyDtoH((void *)channel1_hst_ptr, output_image->channel[1], channel1_size));
+                CHECK_HIP(hipMemcpy((void *)channel1_hst_ptr, output_image->channel[1], channel1_size, hipMemcpyDefault));
                 if (widths[1] == output_image->pitch[1]) {
                     fwrite(channel1_hst_ptr, 1, channel1_size, fp);
                 } else {
@@ -607,7 +713,7 @@ public:
             // write channel2
             if (channel2_size != 0 && output_image->channel[2] != nullptr) {
                 uint8_t *channel2_hst_ptr = hst_ptr + channel0_size + channel1_size;
-                CHECK_HIP(hipMemcpyDtoH((void *)channel2_hst_ptr, output_image->channel[2], channel2_size));
+                CHECK_HIP(hipMemcpy((void *)channel2_hst_ptr, output_image->channel[2], channel2_size, hipMemcpyDefault));
                 if (widths[2] == output_image->pitch[2]) {
                     fwrite(channel2_hst_ptr, 1, channel2_size, fp);
                 } else {
@@ -617,6 +723,19 @@ public:
                     }
                 }
             }
+            // write channel3
+            if (channel3_size != 0 && output_image->channel[3] != nullptr) {
+                uint8_t *channel3_hst_ptr = hst_ptr + channel0_size + channel1_size + channel2_size;
+                CHECK_HIP(hipMemcpy((void *)channel3_hst_ptr, output_image->channel[3], channel3_size, hipMemcpyDefault));
+                if (widths[3] == output_image->pitch[3]) {
+                    fwrite(channel3_hst_ptr, 1, channel3_size, fp);
+                } else {
+                    for (int i = 0; i < heights[3]; i++) {
+                        fwrite(channel3_hst_ptr, 1, widths[3], fp);
+                        channel3_hst_ptr += output_image->pitch[3];
+                    }
+                }
+            }
             fclose(fp);
         }
 
@@ -627,6 +746,42 @@ public:
         }
     }
 
+    /**
+     * @brief Applies an EXIF orientation to a plane of samples on the CPU.
+     *
+     * This is the reference implementation used to verify the oriented output of the decoder. Each source sample
+     * is moved to its reoriented position; for orientations 5 to 8 the destination plane is `src_height` samples
+     * wide and `src_width` samples high.
+     *
+     * @param src Pointer to the source plane.
+     * @param src_width The width of the source plane in samples.
+     * @param src_height The height of the source plane in samples.
+     * @param src_pitch The pitch (in bytes) of the source plane.
+     * @param bytes_per_sample The size of a sample in bytes (e.g., 3 for interleaved RGB).
+     * @param orientation The EXIF orientation (ROCJPEG_ORIENTATION_NORMAL to ROCJPEG_ORIENTATION_ROTATE_270).
+     * @param dst Pointer to the destination plane.
+     * @param dst_pitch The pitch (in bytes) of the destination plane.
+     */
+    static void ApplyOrientation(const uint8_t *src, uint32_t src_width, uint32_t src_height, uint32_t src_pitch, uint32_t bytes_per_sample,
+                                 RocJpegOrientation orientation, uint8_t *dst, uint32_t dst_pitch) {
+        for (uint32_t y = 0; y < src_height; y++) {
+            for (uint32_t x = 0; x < src_width; x++) {
+                uint32_t dst_x, dst_y;
+                switch (orientation) {
+                    case ROCJPEG_ORIENTATION_FLIP_HORIZONTAL: dst_x = src_width - 1 - x; dst_y = y; break;
+                    case ROCJPEG_ORIENTATION_ROTATE_180: dst_x = src_width - 1 - x; dst_y = src_height - 1 - y; break;
+                    case ROCJPEG_ORIENTATION_FLIP_VERTICAL: dst_x = x; dst_y = src_height - 1 - y; break;
+                    case ROCJPEG_ORIENTATION_TRANSPOSE: dst_x = y; dst_y = x; break;
+                    case ROCJPEG_ORIENTATION_ROTATE_90: dst_x = src_height - 1 - y; dst_y = x; break;
+                    case ROCJPEG_ORIENTATION_TRANSVERSE: dst_x = src_height - 1 - y; dst_y = src_width - 1 - x; break;
+                    case ROCJPEG_ORIENTATION_ROTATE_270: dst_x = y; dst_y = src_width - 1 - x; break;
+                    default: dst_x = x; dst_y = y; break;
+                }
+                memcpy(dst + dst_y * dst_pitch + dst_x * bytes_per_sample, src + y * src_pitch + x * bytes_per_sample, bytes_per_sample);
+            }
+        }
+    }
+
 private:
     static const int mem_alignment = 4 * 1024 * 1024;
     /**
@@ -641,8 +796,9 @@ private:
         std::cout  << "Options:\n"
         "-i     [input path] - input path to a single JPEG image or a directory containing JPEG images - [required]\n"
         "-be    [backend] - select rocJPEG backend (0 for hardware-accelerated JPEG decoding using VCN,\n"
-        "                                           1 for hybrid JPEG decoding using CPU and GPU HIP kernels (currently not supported)) [optional - default: 0]\n"
-        "-fmt   [output format] - select rocJPEG output format for decoding, one of the [native, yuv_planar, y, rgb, rgb_planar] - [optional - default: native]\n"
+        "                                           1 for hybrid JPEG decoding using CPU and GPU HIP kernels,\n"
+        "                                           2 for JPEG decoding on the CPU into host memory) [optional - default: 0]\n"
+        "-fmt   [output format] - select rocJPEG output format for decoding, one of the [native, yuv_planar, y, rgb, rgb_planar, yuv_planar_16, y_16, rgb_16, rgb_planar_16] - [optional - default: native]\n"
         "-o     [output path] - path to an output file or a path to an existing directory - write decoded images to a file or an existing directory based on selected output format - [optional]\n"
         "-crop  [crop rectangle] - crop rectangle for output in a comma-separated format: left,top,right,bottom - [optional]\n"
         "-d     [device id] - specify the GPU device id for the desired device (use 0 for the first device, 1 for the second device, and so on) [optional - default: 0]\n";
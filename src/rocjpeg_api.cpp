@@ -20,9 +20,12 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 */
 
+#include <algorithm>
 #include "rocjpeg_api_stream_handle.h"
 #include "rocjpeg_api_decoder_handle.h"
 #include "rocjpeg_commons.h"
+#include "rocjpeg_thread_pool.h"
+#include "rocjpeg_table_cache.h"
 
 /**
  * @brief Creates a RocJpegStreamHandle for JPEG stream processing.
@@ -76,6 +79,117 @@ RocJpegStatus ROCJPEGAPI rocJpegStreamParse(const unsigned char *data, size_t le
     return ROCJPEG_STATUS_SUCCESS;
 }
 
+/**
+ * @brief Parses a batch of JPEG streams in parallel.
+ *
+ * This function distributes the JPEG streams of the batch over the process-wide thread pool and parses each
+ * of them into its stream handle. The status of each stream is stored in the statuses array, so that a bad
+ * stream doesn't fail the whole batch.
+ *
+ * @param data An array of pointers to the JPEG stream data.
+ * @param lengths An array of the lengths of the JPEG stream data.
+ * @param batch_size The number of JPEG streams in the batch.
+ * @param jpeg_stream_handles An array of the handles to the JPEG streams.
+ * @param statuses An array that will store the parsing status of each JPEG stream.
+ * @return The status of the operation.
+ *         - ROCJPEG_STATUS_SUCCESS if the batch was processed.
+ *         - ROCJPEG_STATUS_INVALID_PARAMETER if the input parameters are invalid.
+ */
+RocJpegStatus ROCJPEGAPI rocJpegStreamParseBatched(const unsigned char **data, const size_t *lengths, int batch_size, RocJpegStreamHandle *jpeg_stream_handles, RocJpegStatus *statuses) {
+    if (data == nullptr || lengths == nullptr || jpeg_stream_handles == nullptr || statuses == nullptr || batch_size < 0) {
+        return ROCJPEG_STATUS_INVALID_PARAMETER;
+    }
+    RocJpegThreadPool::GetInstance().ParallelFor(batch_size, [&](int i) {
+        try {
+            statuses[i] = rocJpegStreamParse(data[i], lengths[i], jpeg_stream_handles[i]);
+        } catch (const std::exception& e) {
+            ERR(e.what());
+            statuses[i] = ROCJPEG_STATUS_RUNTIME_ERROR;
+        }
+    });
+    return ROCJPEG_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Parses a JPEG stream that is received in chunks.
+ *
+ * This function appends the chunk to the stream being parsed into the stream handle and reports how far the
+ * stream is parsed.
+ *
+ * @param data The pointer to the chunk data.
+ * @param length The length of the chunk data.
+ * @param flags A combination of RocJpegStreamChunkFlags.
+ * @param jpeg_stream_handle The handle to the JPEG stream.
+ * @param parse_state Pointer that will store the progress of the stream.
+ * @return The status of the operation.
+ *         - ROCJPEG_STATUS_SUCCESS if the data received so far is valid.
+ *         - ROCJPEG_STATUS_INVALID_PARAMETER if the input parameters are invalid.
+ *         - ROCJPEG_STATUS_BAD_JPEG if the JPEG stream is invalid.
+ */
+RocJpegStatus ROCJPEGAPI rocJpegStreamParseChunk(const unsigned char *data, size_t length, uint32_t flags, RocJpegStreamHandle jpeg_stream_handle, RocJpegStreamParseState *parse_state) {
+    if ((data == nullptr && length != 0) || jpeg_stream_handle == nullptr || parse_state == nullptr || length > UINT32_MAX) {
+        return ROCJPEG_STATUS_INVALID_PARAMETER;
+    }
+    auto rocjpeg_stream_handle = static_cast<RocJpegStreamParserHandle*>(jpeg_stream_handle);
+    bool first_chunk = (flags & ROCJPEG_STREAM_CHUNK_FIRST) != 0;
+    bool last_chunk = (flags & ROCJPEG_STREAM_CHUNK_LAST) != 0;
+    if (!first_chunk) {
+        IncrementalParseState state = rocjpeg_stream_handle->rocjpeg_stream->GetIncrementalParseState();
+        if (state == PARSE_STATE_FAILED) {
+            return ROCJPEG_STATUS_BAD_JPEG;
+        }
+        if (state != PARSE_STATE_HEADER && state != PARSE_STATE_SCAN) {
+            return ROCJPEG_STATUS_INVALID_PARAMETER;
+        }
+    }
+    try {
+        if (!rocjpeg_stream_handle->rocjpeg_stream->AppendJpegStreamChunk(data, static_cast<uint32_t>(length), first_chunk, last_chunk)) {
+            return ROCJPEG_STATUS_BAD_JPEG;
+        }
+    } catch (const std::exception& e) {
+        rocjpeg_stream_handle->CaptureError(e.what());
+        ERR(e.what());
+        return ROCJPEG_STATUS_RUNTIME_ERROR;
+    }
+    switch (rocjpeg_stream_handle->rocjpeg_stream->GetIncrementalParseState()) {
+        case PARSE_STATE_SCAN:
+            *parse_state = ROCJPEG_STREAM_PARSE_SCAN_PENDING;
+            break;
+        case PARSE_STATE_COMPLETE:
+            *parse_state = ROCJPEG_STREAM_PARSE_COMPLETE;
+            break;
+        default:
+            *parse_state = ROCJPEG_STREAM_PARSE_HEADER_PENDING;
+            break;
+    }
+    return ROCJPEG_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Retrieves the statistics of the table cache.
+ *
+ * @param stats Pointer to the structure that will store the statistics.
+ * @return The status of the operation.
+ *         - ROCJPEG_STATUS_SUCCESS if the statistics are retrieved.
+ *         - ROCJPEG_STATUS_INVALID_PARAMETER if the input parameters are invalid.
+ */
+RocJpegStatus ROCJPEGAPI rocJpegGetTableCacheStats(RocJpegTableCacheStats *stats) {
+    if (stats == nullptr) {
+        return ROCJPEG_STATUS_INVALID_PARAMETER;
+    }
+    TableCacheStats huffman_table_stats, quantization_table_stats;
+    RocJpegTableCache::GetInstance().GetStats(huffman_table_stats, quantization_table_stats);
+    stats->huffman_table_hits = huffman_table_stats.hits;
+    stats->huffman_table_misses = huffman_table_stats.misses;
+    stats->huffman_table_evictions = huffman_table_stats.evictions;
+    stats->num_huffman_tables = huffman_table_stats.num_entries;
+    stats->quantization_table_hits = quantization_table_stats.hits;
+    stats->quantization_table_misses = quantization_table_stats.misses;
+    stats->quantization_table_evictions = quantization_table_stats.evictions;
+    stats->num_quantization_tables = quantization_table_stats.num_entries;
+    return ROCJPEG_STATUS_SUCCESS;
+}
+
 /**
  * @brief Destroys a RocJpegStreamHandle object and releases associated resources.
  *
@@ -98,7 +212,7 @@ RocJpegStatus ROCJPEGAPI rocJpegStreamDestroy(RocJpegStreamHandle jpeg_stream_ha
  * This function creates a RocJpegHandle for JPEG decoding using the specified backend and device ID.
  *
  * @param backend The backend to be used for JPEG decoding.
- * @param device_id The ID of the device to be used for JPEG decoding.
+ * @param device_id The ID of the device to be used for JPEG decoding; ignored by the ROCJPEG_BACKEND_CPU backend.
  * @param handle Pointer to a RocJpegHandle variable to store the created handle.
  * @return The status of the operation. Returns ROCJPEG_STATUS_INVALID_PARAMETER if handle is nullptr,
  *         ROCJPEG_STATUS_NOT_INITIALIZED if the rocJPEG handle initialization fails, or the status
@@ -176,6 +290,154 @@ RocJpegStatus ROCJPEGAPI rocJpegGetImageInfo(RocJpegHandle handle, RocJpegStream
     return rocjpeg_status;
 }
 
+/**
+ * @brief Retrieves the EXIF orientation of a parsed JPEG stream.
+ *
+ * @param jpeg_stream_handle The handle to the parsed JPEG stream.
+ * @param orientation Pointer to store the orientation of the image.
+ * @return The status of the operation.
+ *         - ROCJPEG_STATUS_SUCCESS if the orientation was retrieved.
+ *         - ROCJPEG_STATUS_INVALID_PARAMETER if the input parameters are invalid.
+ */
+RocJpegStatus ROCJPEGAPI rocJpegGetImageOrientation(RocJpegStreamHandle jpeg_stream_handle, RocJpegOrientation *orientation) {
+    if (jpeg_stream_handle == nullptr || orientation == nullptr) {
+        return ROCJPEG_STATUS_INVALID_PARAMETER;
+    }
+    auto rocjpeg_stream_handle = static_cast<RocJpegStreamParserHandle*>(jpeg_stream_handle);
+    const JpegStreamParameters *jpeg_stream_params = rocjpeg_stream_handle->rocjpeg_stream->GetJpegStreamParameters();
+    *orientation = static_cast<RocJpegOrientation>(jpeg_stream_params->orientation);
+    return ROCJPEG_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Retrieves the JPEG images embedded in a parsed JPEG stream.
+ *
+ * @param jpeg_stream_handle The handle to the parsed JPEG stream.
+ * @param images Pointer to the array that will store the embedded images, or nullptr to query their number.
+ * @param num_images Pointer to the capacity of the array on input, and to the number of embedded images on output.
+ * @return The status of the operation.
+ *         - ROCJPEG_STATUS_SUCCESS if the embedded images were retrieved.
+ *         - ROCJPEG_STATUS_INVALID_PARAMETER if the input parameters are invalid.
+ */
+RocJpegStatus ROCJPEGAPI rocJpegGetEmbeddedImages(RocJpegStreamHandle jpeg_stream_handle, RocJpegEmbeddedImageInfo *images, uint32_t *num_images) {
+    if (jpeg_stream_handle == nullptr || num_images == nullptr) {
+        return ROCJPEG_STATUS_INVALID_PARAMETER;
+    }
+    auto rocjpeg_stream_handle = static_cast<RocJpegStreamParserHandle*>(jpeg_stream_handle);
+    const std::vector<EmbeddedImage> &embedded_images = rocjpeg_stream_handle->rocjpeg_stream->GetEmbeddedImages();
+    if (images == nullptr) {
+        *num_images = static_cast<uint32_t>(embedded_images.size());
+        return ROCJPEG_STATUS_SUCCESS;
+    }
+    uint32_t count = std::min(*num_images, static_cast<uint32_t>(embedded_images.size()));
+    for (uint32_t i = 0; i < count; i++) {
+        images[i].type = static_cast<RocJpegEmbeddedImageType>(embedded_images[i].source);
+        images[i].width = embedded_images[i].width;
+        images[i].height = embedded_images[i].height;
+        images[i].offset = embedded_images[i].offset;
+        images[i].length = embedded_images[i].length;
+    }
+    *num_images = count;
+    return ROCJPEG_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Parses the smallest image of a JPEG stream that is at least a requested size.
+ *
+ * The embedded images that are large enough are tried from the smallest to the largest area, and the first one
+ * that parses successfully is selected. The primary image is parsed if none is selected.
+ *
+ * @param jpeg_stream_handle The handle to the parsed JPEG stream.
+ * @param min_width The minimum width of the selected image.
+ * @param min_height The minimum height of the selected image.
+ * @param embedded_stream_handle The handle that receives the selected image.
+ * @param image_type Pointer that will store the kind of the selected image.
+ * @return The status of the operation.
+ *         - ROCJPEG_STATUS_SUCCESS if an image was parsed into the embedded stream handle.
+ *         - ROCJPEG_STATUS_INVALID_PARAMETER if the input parameters are invalid.
+ *         - ROCJPEG_STATUS_BAD_JPEG if no image can be parsed.
+ *         - ROCJPEG_STATUS_RUNTIME_ERROR if an exception occurred.
+ */
+RocJpegStatus ROCJPEGAPI rocJpegStreamParseEmbeddedImage(RocJpegStreamHandle jpeg_stream_handle, uint32_t min_width, uint32_t min_height,
+                                                         RocJpegStreamHandle embedded_stream_handle, RocJpegEmbeddedImageType *image_type) {
+    if (jpeg_stream_handle == nullptr || embedded_stream_handle == nullptr || image_type == nullptr || embedded_stream_handle == jpeg_stream_handle) {
+        return ROCJPEG_STATUS_INVALID_PARAMETER;
+    }
+    auto rocjpeg_stream_handle = static_cast<RocJpegStreamParserHandle*>(jpeg_stream_handle);
+    auto rocjpeg_embedded_stream_handle = static_cast<RocJpegStreamParserHandle*>(embedded_stream_handle);
+    const RocJpegStreamParser &jpeg_stream = *rocjpeg_stream_handle->rocjpeg_stream;
+    RocJpegStreamParser &embedded_stream = *rocjpeg_embedded_stream_handle->rocjpeg_stream;
+    const uint8_t *stream_data = jpeg_stream.GetStreamData();
+    if (stream_data == nullptr) {
+        return ROCJPEG_STATUS_INVALID_PARAMETER;
+    }
+    try {
+        std::vector<EmbeddedImage> candidates;
+        for (const EmbeddedImage &embedded_image : jpeg_stream.GetEmbeddedImages()) {
+            if (embedded_image.width >= min_width && embedded_image.height >= min_height) {
+                candidates.push_back(embedded_image);
+            }
+        }
+        std::stable_sort(candidates.begin(), candidates.end(), [](const EmbeddedImage &a, const EmbeddedImage &b) {
+            return static_cast<uint32_t>(a.width) * a.height < static_cast<uint32_t>(b.width) * b.height;
+        });
+        for (const EmbeddedImage &candidate : candidates) {
+            if (embedded_stream.ParseJpegStream(stream_data + candidate.offset, candidate.length)) {
+                *image_type = static_cast<RocJpegEmbeddedImageType>(candidate.source);
+                return ROCJPEG_STATUS_SUCCESS;
+            }
+        }
+        if (!embedded_stream.ParseJpegStream(stream_data, jpeg_stream.GetStreamLength())) {
+            return ROCJPEG_STATUS_BAD_JPEG;
+        }
+    } catch (const std::exception& e) {
+        rocjpeg_embedded_stream_handle->CaptureError(e.what());
+        ERR(e.what());
+        return ROCJPEG_STATUS_RUNTIME_ERROR;
+    }
+    *image_type = ROCJPEG_EMBEDDED_IMAGE_PRIMARY;
+    return ROCJPEG_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Retrieves information about a JPEG image by parsing only its header.
+ *
+ * This function parses the JPEG stream up to the SOF marker without visiting the scan data, and
+ * returns the number of components, chroma subsampling, and dimensions of the JPEG image.
+ *
+ * @param data The pointer to the JPEG stream data.
+ * @param length The length of the JPEG stream data.
+ * @param num_components A pointer to an unsigned 8-bit integer that will store the number of components in the JPEG image.
+ * @param subsampling A pointer to a RocJpegChromaSubsampling enum that will store the chroma subsampling information.
+ * @param widths A pointer to an unsigned 32-bit integer array that will store the width of each component in the JPEG image.
+ * @param heights A pointer to an unsigned 32-bit integer array that will store the height of each component in the JPEG image.
+ *
+ * @return The RocJpegStatus indicating the success or failure of the operation.
+ *         - ROCJPEG_STATUS_SUCCESS: The operation was successful.
+ *         - ROCJPEG_STATUS_INVALID_PARAMETER: One or more input parameters are invalid.
+ *         - ROCJPEG_STATUS_BAD_JPEG: The JPEG header is invalid.
+ *         - ROCJPEG_STATUS_RUNTIME_ERROR: An exception occurred during the operation.
+ */
+RocJpegStatus ROCJPEGAPI rocJpegPeekImageInfo(const unsigned char *data, size_t length, uint8_t *num_components,
+    RocJpegChromaSubsampling *subsampling, uint32_t *widths, uint32_t *heights) {
+    if (data == nullptr || num_components == nullptr ||
+        subsampling == nullptr || widths == nullptr || heights == nullptr) {
+        return ROCJPEG_STATUS_INVALID_PARAMETER;
+    }
+    try {
+        RocJpegStreamParser rocjpeg_stream_parser;
+        if (!rocjpeg_stream_parser.PeekJpegStream(data, length)) {
+            return ROCJPEG_STATUS_BAD_JPEG;
+        }
+        RocJpegDecoder::GetImageInfo(*rocjpeg_stream_parser.GetJpegStreamParameters(), num_components, subsampling, widths, heights);
+    } catch (const std::exception& e) {
+        ERR(e.what());
+        return ROCJPEG_STATUS_RUNTIME_ERROR;
+    }
+
+    return ROCJPEG_STATUS_SUCCESS;
+}
+
 /**
  * @brief Decodes a JPEG image using the rocJPEG library.
  *
@@ -235,6 +497,100 @@ RocJpegStatus ROCJPEGAPI rocJpegDecodeBatched(RocJpegHandle handle, RocJpegStrea
 
     return rocjpeg_status;
 }
+
+/**
+ * @brief Retrieves the coefficient plane dimensions of a JPEG stream.
+ *
+ * @param jpeg_stream_handle The stream handle of the parsed JPEG stream.
+ * @param num_components Pointer to store the number of components.
+ * @param widths_in_blocks Array of ROCJPEG_MAX_COMPONENT entries to store the width of each plane in 8x8 blocks.
+ * @param heights_in_blocks Array of ROCJPEG_MAX_COMPONENT entries to store the height of each plane in 8x8 blocks.
+ * @return The status of the operation.
+ */
+RocJpegStatus ROCJPEGAPI rocJpegGetCoefficientInfo(RocJpegStreamHandle jpeg_stream_handle, uint8_t *num_components, uint32_t *widths_in_blocks, uint32_t *heights_in_blocks) {
+    if (jpeg_stream_handle == nullptr || num_components == nullptr || widths_in_blocks == nullptr || heights_in_blocks == nullptr) {
+        return ROCJPEG_STATUS_INVALID_PARAMETER;
+    }
+    auto rocjpeg_stream_handle = static_cast<RocJpegStreamParserHandle*>(jpeg_stream_handle);
+    const JpegStreamParameters *jpeg_stream_params = rocjpeg_stream_handle->rocjpeg_stream->GetJpegStreamParameters();
+    if (jpeg_stream_params == nullptr) {
+        return ROCJPEG_STATUS_INVALID_PARAMETER;
+    }
+    RocJpegCoefficientDecoder::GetCoefficientInfo(*jpeg_stream_params, num_components, widths_in_blocks, heights_in_blocks);
+    return ROCJPEG_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Entropy decodes a JPEG stream into per-component DCT coefficient planes.
+ *
+ * @param handle The rocJPEG handle.
+ * @param jpeg_stream_handle The stream handle of the parsed JPEG stream.
+ * @param coefficient_params The format and memory location of the coefficient planes.
+ * @param destination The coefficient planes and quantization tables to fill.
+ * @return The status of the operation.
+ */
+RocJpegStatus ROCJPEGAPI rocJpegDecodeCoefficients(RocJpegHandle handle, RocJpegStreamHandle jpeg_stream_handle, const RocJpegCoefficientParams *coefficient_params,
+    RocJpegCoefficientImage *destination) {
+    if (handle == nullptr || jpeg_stream_handle == nullptr || coefficient_params == nullptr || destination == nullptr) {
+        return ROCJPEG_STATUS_INVALID_PARAMETER;
+    }
+    RocJpegStatus rocjpeg_status = ROCJPEG_STATUS_SUCCESS;
+    auto rocjpeg_handle = static_cast<RocJpegDecoderHandle*>(handle);
+    try {
+        rocjpeg_status = rocjpeg_handle->rocjpeg_decoder->DecodeCoefficientsBatched(&jpeg_stream_handle, 1, coefficient_params, destination);
+    } catch (const std::exception& e) {
+        rocjpeg_handle->CaptureError(e.what());
+        ERR(e.what());
+        return ROCJPEG_STATUS_RUNTIME_ERROR;
+    }
+
+    return rocjpeg_status;
+}
+
+/**
+ * @brief Entropy decodes a batch of JPEG streams into per-component DCT coefficient planes.
+ *
+ * @param handle The rocJPEG handle.
+ * @param jpeg_stream_handles An array of stream handles of the parsed JPEG streams.
+ * @param batch_size The number of streams in the batch.
+ * @param coefficient_params The format and memory location of the coefficient planes.
+ * @param destinations An array of batch_size coefficient images to fill.
+ * @return The status of the operation.
+ */
+RocJpegStatus ROCJPEGAPI rocJpegDecodeCoefficientsBatched(RocJpegHandle handle, RocJpegStreamHandle *jpeg_stream_handles, int batch_size,
+    const RocJpegCoefficientParams *coefficient_params, RocJpegCoefficientImage *destinations) {
+    if (handle == nullptr || jpeg_stream_handles == nullptr || coefficient_params == nullptr || destinations == nullptr) {
+        return ROCJPEG_STATUS_INVALID_PARAMETER;
+    }
+    RocJpegStatus rocjpeg_status = ROCJPEG_STATUS_SUCCESS;
+    auto rocjpeg_handle = static_cast<RocJpegDecoderHandle*>(handle);
+    try {
+        rocjpeg_status = rocjpeg_handle->rocjpeg_decoder->DecodeCoefficientsBatched(jpeg_stream_handles, batch_size, coefficient_params, destinations);
+    } catch (const std::exception& e) {
+        rocjpeg_handle->CaptureError(e.what());
+        ERR(e.what());
+        return ROCJPEG_STATUS_RUNTIME_ERROR;
+    }
+
+    return rocjpeg_status;
+}
+
+/**
+ * @brief Retrieves the number of images decoded by each decode path of a rocJPEG handle.
+ *
+ * @param handle The rocJPEG handle.
+ * @param stats Pointer to the structure that will store the counts.
+ * @return The status of the operation.
+ */
+RocJpegStatus ROCJPEGAPI rocJpegGetDecodeRouteStats(RocJpegHandle handle, RocJpegDecodeRouteStats *stats) {
+    if (handle == nullptr || stats == nullptr) {
+        return ROCJPEG_STATUS_INVALID_PARAMETER;
+    }
+    auto rocjpeg_handle = static_cast<RocJpegDecoderHandle*>(handle);
+    rocjpeg_handle->rocjpeg_decoder->GetDecodeRouteStats(stats);
+    return ROCJPEG_STATUS_SUCCESS;
+}
+
 /**
  * @brief Returns the error name corresponding to the given RocJpegStatus.
  *
@@ -0,0 +1,232 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include "rocjpeg_coefficient_decoder.h"
+
+RocJpegCoefficientDecoder::RocJpegCoefficientDecoder() : host_staging_{nullptr}, staging_buffer_size_{0} {}
+
+RocJpegCoefficientDecoder::~RocJpegCoefficientDecoder() {
+    if (host_staging_) {
+        hipError_t hip_status = hipHostFree(host_staging_);
+    }
+}
+
+/**
+ * @brief Computes the size of the coefficient planes of a stream from its frame header.
+ *
+ * A component has one block per 8x8 samples of its size, rounded up; the padding blocks of the last MCUs aren't
+ * counted.
+ *
+ * @param jpeg_stream_params The parsed JPEG stream parameters.
+ * @param num_components Pointer to store the number of components of the frame.
+ * @param widths_in_blocks Array of NUM_COMPONENTS elements to store the number of blocks per row of each component.
+ * @param heights_in_blocks Array of NUM_COMPONENTS elements to store the number of rows of blocks of each component.
+ */
+void RocJpegCoefficientDecoder::GetCoefficientInfo(const JpegStreamParameters &jpeg_stream_params, uint8_t *num_components, uint32_t *widths_in_blocks,
+                                                   uint32_t *heights_in_blocks) {
+    const PictureParameterBuffer &picture_parameter_buffer = jpeg_stream_params.picture_parameter_buffer;
+    uint32_t max_h_factor = 1;
+    uint32_t max_v_factor = 1;
+    for (int i = 0; i < picture_parameter_buffer.num_components; i++) {
+        max_h_factor = std::max<uint32_t>(max_h_factor, picture_parameter_buffer.components[i].h_sampling_factor);
+        max_v_factor = std::max<uint32_t>(max_v_factor, picture_parameter_buffer.components[i].v_sampling_factor);
+    }
+    *num_components = picture_parameter_buffer.num_components;
+    for (int i = 0; i < NUM_COMPONENTS; i++) {
+        widths_in_blocks[i] = 0;
+        heights_in_blocks[i] = 0;
+        if (i < picture_parameter_buffer.num_components) {
+            uint32_t width = (picture_parameter_buffer.picture_width * picture_parameter_buffer.components[i].h_sampling_factor + max_h_factor - 1) / max_h_factor;
+            uint32_t height = (picture_parameter_buffer.picture_height * picture_parameter_buffer.components[i].v_sampling_factor + max_v_factor - 1) / max_v_factor;
+            widths_in_blocks[i] = (width + 7) / 8;
+            heights_in_blocks[i] = (height + 7) / 8;
+        }
+    }
+}
+
+/**
+ * @brief Decodes the coefficients of a batch of JPEG streams.
+ *
+ * The streams are decoded by sub-batches of one stream per thread of the pool. The coefficients of a sub-batch are
+ * laid out first from their parsed frame headers, which gives the size of the planes; the streams are then entropy
+ * decoded in parallel, and each thread writes the blocks of its stream to the planes of the destination in host
+ * memory, or to compact planes in the pinned staging buffer, which are copied to the planes in device memory. The HIP stream is synchronized before
+ * the staging buffer is reused, because it may still be read by the copies queued for the previous sub-batch.
+ *
+ * @param jpeg_streams_params The parsed parameters of the JPEG streams.
+ * @param batch_size The number of JPEG streams in the batch.
+ * @param coefficient_params The parameters of the decode.
+ * @param hip_stream The HIP stream to be used for the copies to device memory.
+ * @param destinations The destination coefficient planes.
+ * @return The status of the decoding operation.
+ *         - ROCJPEG_STATUS_INVALID_PARAMETER if the coefficient format is invalid, or a plane is NULL or its pitch too small.
+ *         - ROCJPEG_STATUS_BAD_JPEG if a stream can't be decoded.
+ */
+RocJpegStatus RocJpegCoefficientDecoder::DecodeBatch(const JpegStreamParameters *const *jpeg_streams_params, int batch_size,
+                                                     const RocJpegCoefficientParams *coefficient_params, hipStream_t hip_stream, RocJpegCoefficientImage *destinations) {
+    if (batch_size <= 0) {
+        return ROCJPEG_STATUS_INVALID_PARAMETER;
+    }
+    if (coefficient_params->coefficient_format != ROCJPEG_COEFFICIENTS_QUANTIZED && coefficient_params->coefficient_format != ROCJPEG_COEFFICIENTS_DEQUANTIZED) {
+        ERR("ERROR: the coefficient format is not valid!");
+        return ROCJPEG_STATUS_INVALID_PARAMETER;
+    }
+    bool is_dequantized = coefficient_params->coefficient_format == ROCJPEG_COEFFICIENTS_DEQUANTIZED;
+    bool is_host_memory = coefficient_params->is_host_memory;
+    int sub_batch_size = std::min(RocJpegThreadPool::GetInstance().GetNumThreads(), batch_size);
+    if (entropy_decoders_.size() < static_cast<size_t>(sub_batch_size)) {
+        entropy_decoders_.resize(sub_batch_size);
+        images_.resize(sub_batch_size);
+        coefficients_.resize(sub_batch_size);
+    }
+    std::vector<int16_t*> planes(sub_batch_size * NUM_COMPONENTS);
+    std::vector<uint32_t> pitches(sub_batch_size * NUM_COMPONENTS);
+    std::vector<size_t> staging_offsets(sub_batch_size * NUM_COMPONENTS);
+    std::vector<uint8_t> is_decoded(sub_batch_size);
+
+    for (int i = 0; i < batch_size; i += sub_batch_size) {
+        int batch_end = std::min(i + sub_batch_size, batch_size);
+        size_t staging_size = 0;
+        for (int k = 0; k < batch_end - i; k++) {
+            if (!entropy_decoders_[k].SetStreamParameters(jpeg_streams_params[i + k], images_[k])) {
+                return ROCJPEG_STATUS_BAD_JPEG;
+            }
+            const RocJpegCoefficientImage &destination = destinations[i + k];
+            for (int32_t c = 0; c < images_[k].num_components; c++) {
+                const JpegCoefficientComponent &component = images_[k].components[c];
+                uint32_t row_size = (component.width + 7) / 8 * DCT_BLOCK_SIZE * sizeof(int16_t);
+                if (destination.planes[c] == nullptr || destination.pitch[c] < row_size) {
+                    ERR("ERROR: the coefficient plane of component " + TOSTR(c) + " is missing or its pitch is too small!");
+                    return ROCJPEG_STATUS_INVALID_PARAMETER;
+                }
+                planes[k * NUM_COMPONENTS + c] = destination.planes[c];
+                pitches[k * NUM_COMPONENTS + c] = destination.pitch[c];
+                if (!is_host_memory) {
+                    // the planes are written to the staging buffer without padding
+                    staging_offsets[k * NUM_COMPONENTS + c] = staging_size;
+                    pitches[k * NUM_COMPONENTS + c] = row_size;
+                    staging_size += static_cast<size_t>(row_size) * ((component.height + 7) / 8);
+                }
+            }
+        }
+        if (!is_host_memory) {
+            CHECK_HIP(hipStreamSynchronize(hip_stream));
+            CHECK_ROCJPEG(AllocateStagingBuffer(staging_size));
+            for (int k = 0; k < (batch_end - i) * NUM_COMPONENTS; k++) {
+                planes[k] = reinterpret_cast<int16_t*>(host_staging_ + staging_offsets[k]);
+            }
+        }
+
+        RocJpegThreadPool::GetInstance().ParallelFor(batch_end - i, [&](int k) {
+            JpegCoefficientImage &image = images_[k];
+            if (coefficients_[k].size() < image.num_coefficients) {
+                coefficients_[k].resize(image.num_coefficients);
+            }
+            is_decoded[k] = entropy_decoders_[k].DecodeCoefficients(image, coefficients_[k].data());
+            if (!is_decoded[k]) {
+                return;
+            }
+            RocJpegCoefficientImage &destination = destinations[i + k];
+            for (int32_t c = 0; c < image.num_components; c++) {
+                const JpegCoefficientComponent &component = image.components[c];
+                WriteCoefficientPlane(coefficients_[k].data() + component.coefficient_offset, component.width_in_blocks, (component.width + 7) / 8,
+                                      (component.height + 7) / 8, is_dequantized ? component.quantization_table : nullptr, planes[k * NUM_COMPONENTS + c],
+                                      pitches[k * NUM_COMPONENTS + c]);
+                std::memcpy(destination.quantization_tables[c], component.quantization_table, sizeof(destination.quantization_tables[c]));
+            }
+        });
+        for (int k = 0; k < batch_end - i; k++) {
+            if (!is_decoded[k]) {
+                return ROCJPEG_STATUS_BAD_JPEG;
+            }
+        }
+
+        if (!is_host_memory) {
+            for (int k = 0; k < batch_end - i; k++) {
+                const RocJpegCoefficientImage &destination = destinations[i + k];
+                for (int32_t c = 0; c < images_[k].num_components; c++) {
+                    const JpegCoefficientComponent &component = images_[k].components[c];
+                    CHECK_HIP(hipMemcpy2DAsync(destination.planes[c], destination.pitch[c], planes[k * NUM_COMPONENTS + c], pitches[k * NUM_COMPONENTS + c],
+                                               pitches[k * NUM_COMPONENTS + c], (component.height + 7) / 8, hipMemcpyHostToDevice, hip_stream));
+                }
+            }
+        }
+    }
+    return ROCJPEG_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Copies the blocks of a component, without the padding blocks, to a plane.
+ *
+ * The dequantized coefficients are saturated to the int16_t range, which they only exceed for corrupt streams or
+ * unusual quantization tables.
+ *
+ * @param coefficients The coefficients of the component, 64 per block in natural order, padded to a whole number of MCUs.
+ * @param padded_width_in_blocks The number of blocks per row of the coefficients.
+ * @param width_in_blocks The number of blocks per row to write.
+ * @param height_in_blocks The number of rows of blocks to write.
+ * @param quantization_table The quantization table of the component, or nullptr to copy the quantized coefficients.
+ * @param dst Pointer to the first block of the plane.
+ * @param dst_pitch The stride (in bytes) of the plane.
+ */
+void RocJpegCoefficientDecoder::WriteCoefficientPlane(const int16_t *coefficients, uint32_t padded_width_in_blocks, uint32_t width_in_blocks,
+                                                      uint32_t height_in_blocks, const uint16_t *quantization_table, int16_t *dst, uint32_t dst_pitch) {
+    for (uint32_t y = 0; y < height_in_blocks; y++) {
+        const int16_t *src_row = coefficients + static_cast<size_t>(y) * padded_width_in_blocks * DCT_BLOCK_SIZE;
+        int16_t *dst_row = reinterpret_cast<int16_t*>(reinterpret_cast<uint8_t*>(dst) + static_cast<size_t>(y) * dst_pitch);
+        if (quantization_table == nullptr) {
+            std::memcpy(dst_row, src_row, static_cast<size_t>(width_in_blocks) * DCT_BLOCK_SIZE * sizeof(int16_t));
+            continue;
+        }
+        for (uint32_t x = 0; x < width_in_blocks; x++) {
+            for (int32_t k = 0; k < DCT_BLOCK_SIZE; k++) {
+                int32_t value = src_row[x * DCT_BLOCK_SIZE + k] * static_cast<int32_t>(quantization_table[k]);
+                dst_row[x * DCT_BLOCK_SIZE + k] = static_cast<int16_t>(std::min(std::max(value, -32768), 32767));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Grows the pinned staging buffer.
+ *
+ * The buffer is only reallocated when a sub-batch doesn't fit, so a sequence of batches of similar size reuses it.
+ *
+ * @param staging_size The size of the staging buffer needed in bytes.
+ * @return The status of the operation. Returns ROCJPEG_STATUS_OUTOF_MEMORY if the buffer can't be allocated.
+ */
+RocJpegStatus RocJpegCoefficientDecoder::AllocateStagingBuffer(size_t staging_size) {
+    if (staging_size > staging_buffer_size_) {
+        if (host_staging_) {
+            CHECK_HIP(hipHostFree(host_staging_));
+            host_staging_ = nullptr;
+        }
+        staging_buffer_size_ = 0;
+        if (hipHostMalloc(reinterpret_cast<void**>(&host_staging_), staging_size) != hipSuccess) {
+            ERR("ERROR: failed to allocate the coefficient staging buffer!");
+            return ROCJPEG_STATUS_OUTOF_MEMORY;
+        }
+        staging_buffer_size_ = staging_size;
+    }
+    return ROCJPEG_STATUS_SUCCESS;
+}
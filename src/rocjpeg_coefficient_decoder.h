@@ -0,0 +1,110 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef ROC_JPEG_COEFFICIENT_DECODER_H_
+#define ROC_JPEG_COEFFICIENT_DECODER_H_
+
+#pragma once
+
+#include <hip/hip_runtime.h>
+#include <vector>
+#include "../api/rocjpeg.h"
+#include "rocjpeg_commons.h"
+#include "rocjpeg_parser.h"
+#include "rocjpeg_entropy_decoder.h"
+#include "rocjpeg_thread_pool.h"
+
+/**
+ * @class RocJpegCoefficientDecoder
+ * @brief A class that decodes the DCT coefficients of JPEG streams into coefficient planes in host or device memory.
+ *
+ * The coefficient decoder serves rocJpegDecodeCoefficients() and rocJpegDecodeCoefficientsBatched() for every
+ * backend. The streams of a batch are entropy decoded in parallel on the rocJPEG thread pool by the software entropy
+ * decoder, and the blocks of each component, without the padding blocks of the last MCUs, are written to the planes
+ * of the destination, dequantized if requested. The planes in device memory are written from a pinned staging
+ * buffer with one asynchronous copy per component; no IDCT or color conversion is run.
+ */
+class RocJpegCoefficientDecoder {
+public:
+   /**
+    * @brief Constructs a RocJpegCoefficientDecoder object.
+    */
+   RocJpegCoefficientDecoder();
+
+   /**
+    * @brief Destroys the RocJpegCoefficientDecoder object and releases its staging buffer.
+    */
+   ~RocJpegCoefficientDecoder();
+
+   /**
+    * @brief Computes the size of the coefficient planes of a stream from its frame header.
+    * @param jpeg_stream_params The parsed JPEG stream parameters.
+    * @param num_components Pointer to store the number of components of the frame.
+    * @param widths_in_blocks Array to store the number of blocks per row of each component.
+    * @param heights_in_blocks Array to store the number of rows of blocks of each component.
+    */
+   static void GetCoefficientInfo(const JpegStreamParameters &jpeg_stream_params, uint8_t *num_components, uint32_t *widths_in_blocks, uint32_t *heights_in_blocks);
+
+   /**
+    * @brief Decodes the coefficients of a batch of JPEG streams.
+    *
+    * For the planes in device memory, the copies are queued on the HIP stream, and the caller must synchronize it.
+    *
+    * @param jpeg_streams_params The parsed parameters of the JPEG streams.
+    * @param batch_size The number of JPEG streams in the batch.
+    * @param coefficient_params The parameters of the decode.
+    * @param hip_stream The HIP stream to be used for the copies to device memory.
+    * @param destinations The destination coefficient planes, one per stream.
+    * @return The status of the decoding operation.
+    */
+   RocJpegStatus DecodeBatch(const JpegStreamParameters *const *jpeg_streams_params, int batch_size, const RocJpegCoefficientParams *coefficient_params,
+                             hipStream_t hip_stream, RocJpegCoefficientImage *destinations);
+
+private:
+   /**
+    * @brief Copies the blocks of a component, without the padding blocks, to a plane, dequantizing them if requested.
+    * @param coefficients The coefficients of the component, 64 per block, padded to a whole number of MCUs.
+    * @param padded_width_in_blocks The number of blocks per row of the coefficients.
+    * @param width_in_blocks The number of blocks per row to write.
+    * @param height_in_blocks The number of rows of blocks to write.
+    * @param quantization_table The quantization table to multiply the coefficients by, or nullptr to copy them.
+    * @param dst Pointer to the first block of the plane.
+    * @param dst_pitch The stride (in bytes) of the plane.
+    */
+   static void WriteCoefficientPlane(const int16_t *coefficients, uint32_t padded_width_in_blocks, uint32_t width_in_blocks, uint32_t height_in_blocks,
+                                     const uint16_t *quantization_table, int16_t *dst, uint32_t dst_pitch);
+
+   /**
+    * @brief Grows the pinned staging buffer if it is too small.
+    * @param staging_size The size of the staging buffer needed in bytes.
+    * @return The status of the operation.
+    */
+   RocJpegStatus AllocateStagingBuffer(size_t staging_size);
+
+   std::vector<RocJpegEntropyDecoder> entropy_decoders_; // The software entropy decoders, one per stream of a sub-batch
+   std::vector<JpegCoefficientImage> images_; // The layout of the coefficients of each stream of a sub-batch
+   std::vector<std::vector<int16_t>> coefficients_; // The coefficients of each stream of a sub-batch, padded to whole MCUs
+   uint8_t *host_staging_; // The compact planes written to device memory, in pinned host memory
+   size_t staging_buffer_size_; // The size of the staging buffer in bytes
+};
+
+#endif  // ROC_JPEG_COEFFICIENT_DECODER_H_
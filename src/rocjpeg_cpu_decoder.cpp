@@ -0,0 +1,791 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include "rocjpeg_cpu_decoder.h"
+
+/**
+ * @brief Checks if an output format has 16-bit samples.
+ *
+ * @param output_format The output format.
+ * @return True for the 16-bit output formats, false otherwise.
+ */
+static bool Is16BitOutputFormat(RocJpegOutputFormat output_format) {
+    return output_format == ROCJPEG_OUTPUT_YUV_PLANAR_16 || output_format == ROCJPEG_OUTPUT_Y_16 ||
+           output_format == ROCJPEG_OUTPUT_RGB_16 || output_format == ROCJPEG_OUTPUT_RGB_PLANAR_16;
+}
+
+/**
+ * @brief Divides a dimension by 2^shift, rounding up.
+ */
+static inline uint32_t ScaleDimension(uint32_t size, uint32_t shift) {
+    return (size + (1u << shift) - 1) >> shift;
+}
+
+/**
+ * @brief Computes where the samples of a source row are written in an oriented destination channel.
+ *
+ * This is the inverse of GetOrientedSourceCoordinates of the oriented HIP kernels: sample x of source row y is
+ * written at dst_offset + x * dst_step. The orientations 5 to 8 transpose the picture, so a source row becomes a
+ * destination column.
+ *
+ * @param orientation The EXIF orientation (1 to 8) to apply.
+ * @param width The width of the source picture.
+ * @param height The height of the source picture.
+ * @param y The source row.
+ * @param dst_pitch The stride (in bytes) of the destination channel.
+ * @param pixel_size The size (in bytes) of a pixel in the destination channel.
+ * @param dst_offset Reference to store the offset (in bytes) of the first sample of the row.
+ * @param dst_step Reference to store the signed distance (in bytes) between two samples of the row.
+ */
+static void GetOrientedRowLayout(uint8_t orientation, uint32_t width, uint32_t height, uint32_t y, uint32_t dst_pitch, uint32_t pixel_size,
+                                 ptrdiff_t &dst_offset, ptrdiff_t &dst_step) {
+    ptrdiff_t pitch = dst_pitch;
+    ptrdiff_t size = pixel_size;
+    switch (orientation) {
+        case 2: // flip horizontal
+            dst_offset = y * pitch + (width - 1) * size;
+            dst_step = -size;
+            break;
+        case 3: // rotate 180
+            dst_offset = (height - 1 - y) * pitch + (width - 1) * size;
+            dst_step = -size;
+            break;
+        case 4: // flip vertical
+            dst_offset = (height - 1 - y) * pitch;
+            dst_step = size;
+            break;
+        case 5: // transpose
+            dst_offset = y * size;
+            dst_step = pitch;
+            break;
+        case 6: // rotate 90 clockwise
+            dst_offset = (height - 1 - y) * size;
+            dst_step = pitch;
+            break;
+        case 7: // transverse
+            dst_offset = (height - 1 - y) * size + (width - 1) * pitch;
+            dst_step = -pitch;
+            break;
+        case 8: // rotate 270 clockwise
+            dst_offset = y * size + (width - 1) * pitch;
+            dst_step = -pitch;
+            break;
+        default:
+            dst_offset = y * pitch;
+            dst_step = size;
+            break;
+    }
+}
+
+template <uint32_t kPixelSize>
+static void ScatterRow(const uint8_t *src, uint32_t width, uint8_t *dst, ptrdiff_t dst_step) {
+    for (uint32_t x = 0; x < width; x++, src += kPixelSize, dst += dst_step) {
+        memcpy(dst, src, kPixelSize);
+    }
+}
+
+/**
+ * @brief Writes a source row at its oriented position in a destination channel.
+ *
+ * @param src Pointer to the first pixel of the row; the pixels are contiguous.
+ * @param width The width of the source picture.
+ * @param height The height of the source picture.
+ * @param y The source row.
+ * @param orientation The EXIF orientation (1 to 8) to apply.
+ * @param pixel_size The size (in bytes) of a pixel.
+ * @param dst Pointer to the destination channel.
+ * @param dst_pitch The stride (in bytes) of the destination channel.
+ */
+static void WriteOrientedRow(const uint8_t *src, uint32_t width, uint32_t height, uint32_t y, uint8_t orientation, uint32_t pixel_size,
+                             uint8_t *dst, uint32_t dst_pitch) {
+    ptrdiff_t dst_offset, dst_step;
+    GetOrientedRowLayout(orientation, width, height, y, dst_pitch, pixel_size, dst_offset, dst_step);
+    dst += dst_offset;
+    if (dst_step == static_cast<ptrdiff_t>(pixel_size)) {
+        memcpy(dst, src, static_cast<size_t>(width) * pixel_size);
+        return;
+    }
+    switch (pixel_size) {
+        case 1: ScatterRow<1>(src, width, dst, dst_step); break;
+        case 2: ScatterRow<2>(src, width, dst, dst_step); break;
+        case 3: ScatterRow<3>(src, width, dst, dst_step); break;
+        case 6: ScatterRow<6>(src, width, dst, dst_step); break;
+        default:
+            for (uint32_t x = 0; x < width; x++, src += pixel_size, dst += dst_step) {
+                memcpy(dst, src, pixel_size);
+            }
+            break;
+    }
+}
+
+/**
+ * @brief Converts a YCbCr sample triplet with the coefficients of the GPU color conversion kernels and the clamping of the sample precision.
+ */
+static inline void ConvertYCbCrToRGBSample(float luma, float cb, float cr, float center, float max_sample_value, uint32_t &r, uint32_t &g, uint32_t &b) {
+    float fu = cb - center;
+    float fv = cr - center;
+    r = static_cast<uint32_t>(std::min(std::max(std::fma(1.5748f, fv, luma) + 0.5f, 0.0f), max_sample_value));
+    g = static_cast<uint32_t>(std::min(std::max(std::fma(-0.4681f, fv, std::fma(-0.1873f, fu, luma)) + 0.5f, 0.0f), max_sample_value));
+    b = static_cast<uint32_t>(std::min(std::max(std::fma(1.8556f, fu, luma) + 0.5f, 0.0f), max_sample_value));
+}
+
+RocJpegCpuDecoder::RocJpegCpuDecoder() : image_{}, components_{}, plane_offsets_{}, plane_pitches_{}, sample_size_{1}, output_width_{0}, output_height_{0} {}
+
+/**
+ * @brief Decodes a JPEG stream into a destination image in host memory.
+ *
+ * The stream is decoded into one plane per component, with 16-bit samples for the 16-bit output formats, and the
+ * planes are then written to the destination in the output format, with the crop rectangle and the orientation
+ * applied as the output stage of the GPU decoders applies them.
+ *
+ * If a target dimension is given, the cropped picture is resized to it before the orientation is applied. The
+ * blocks are then transformed by the reduced-size IDCTs of the largest scale (1/2, 1/4, or 1/8) that keeps the
+ * cropped picture at least as large as the target, and the scaled planes are resized to the target with a bilinear
+ * filter, which is skipped when the scaled picture already has the target size.
+ *
+ * For a DC-only preview, the picture is decoded at 1/8 scale from the DC coefficients alone: the entropy decoder
+ * parses the AC coefficients without storing them, and each block gives one sample. The crop rectangle is given
+ * in the coordinates of the full picture, and a target dimension resizes the preview.
+ *
+ * @param jpeg_stream_params The parsed JPEG stream parameters.
+ * @param decode_params The decode parameters (output format, crop rectangle, target dimension, and DC-only preview).
+ * @param orientation The EXIF orientation (1 to 8) to apply.
+ * @param destination The destination image; its channels must be in host memory.
+ * @return The status of the decoding operation. Returns ROCJPEG_STATUS_INVALID_PARAMETER if only one of the target width and height is set.
+ */
+RocJpegStatus RocJpegCpuDecoder::Decode(const JpegStreamParameters *jpeg_stream_params, const RocJpegDecodeParams *decode_params, uint8_t orientation,
+                                        RocJpegImage *destination) {
+    const PictureParameterBuffer &picture_parameter_buffer = jpeg_stream_params->picture_parameter_buffer;
+    uint32_t roi_width = decode_params->crop_rectangle.right - decode_params->crop_rectangle.left;
+    uint32_t roi_height = decode_params->crop_rectangle.bottom - decode_params->crop_rectangle.top;
+    bool is_roi_valid = roi_width > 0 && roi_height > 0 && roi_width <= picture_parameter_buffer.picture_width &&
+                        roi_height <= picture_parameter_buffer.picture_height;
+    uint32_t picture_width = is_roi_valid ? roi_width : picture_parameter_buffer.picture_width;
+    uint32_t picture_height = is_roi_valid ? roi_height : picture_parameter_buffer.picture_height;
+    uint32_t top = is_roi_valid ? decode_params->crop_rectangle.top : 0;
+    uint32_t left = is_roi_valid ? decode_params->crop_rectangle.left : 0;
+
+    uint32_t target_width = decode_params->target_dimension.width;
+    uint32_t target_height = decode_params->target_dimension.height;
+    if ((target_width == 0) != (target_height == 0)) {
+        ERR("ERROR! both the target width and height must be set to resize the picture!");
+        return ROCJPEG_STATUS_INVALID_PARAMETER;
+    }
+    uint32_t scale_shift = 0;
+    if (decode_params->dc_only) {
+        scale_shift = 3;
+    } else if (target_width != 0) {
+        while (scale_shift < 3 && ScaleDimension(picture_width, scale_shift + 1) >= target_width &&
+               ScaleDimension(picture_height, scale_shift + 1) >= target_height) {
+            scale_shift++;
+        }
+    }
+
+    CHECK_ROCJPEG(DecodePlanes(jpeg_stream_params, Is16BitOutputFormat(decode_params->output_format) ? sizeof(uint16_t) : sizeof(uint8_t), scale_shift));
+    CHECK_ROCJPEG(LocateComponents(top >> scale_shift, left >> scale_shift));
+    picture_width = ScaleDimension(picture_width, scale_shift);
+    picture_height = ScaleDimension(picture_height, scale_shift);
+    if (target_width != 0 && (target_width != picture_width || target_height != picture_height)) {
+        ResizeComponents(picture_width, picture_height, target_width, target_height);
+        picture_width = target_width;
+        picture_height = target_height;
+    }
+    output_width_ = picture_width;
+    output_height_ = picture_height;
+
+    RocJpegOutputFormat output_format = decode_params->output_format;
+    bool is_planar = output_format == ROCJPEG_OUTPUT_RGB_PLANAR || output_format == ROCJPEG_OUTPUT_RGB_PLANAR_16;
+    if (is_planar && (destination->pitch[0] != destination->pitch[1] || destination->pitch[0] != destination->pitch[2])) {
+        ERR("ERROR! the pitches of the RGB planes must be equal!");
+        return ROCJPEG_STATUS_INVALID_PARAMETER;
+    }
+
+    if (image_.num_components == NUM_COMPONENTS) {
+        switch (output_format) {
+            case ROCJPEG_OUTPUT_RGB:
+            case ROCJPEG_OUTPUT_RGB_16:
+            case ROCJPEG_OUTPUT_RGB_PLANAR:
+            case ROCJPEG_OUTPUT_RGB_PLANAR_16:
+                return ColorConvertCMYKToRGB(jpeg_stream_params, is_planar, picture_width, picture_height, orientation, destination);
+            case ROCJPEG_OUTPUT_Y:
+            case ROCJPEG_OUTPUT_Y_16:
+                GetPlanarOutputFormat(1, picture_width, picture_height, orientation, destination);
+                return ROCJPEG_STATUS_SUCCESS;
+            default:
+                GetPlanarOutputFormat(NUM_COMPONENTS, picture_width, picture_height, orientation, destination);
+                return ROCJPEG_STATUS_SUCCESS;
+        }
+    }
+
+    switch (output_format) {
+        case ROCJPEG_OUTPUT_NATIVE:
+            CHECK_ROCJPEG(GetNativeOutputFormat(picture_width, picture_height, orientation, destination));
+            break;
+        case ROCJPEG_OUTPUT_YUV_PLANAR:
+        case ROCJPEG_OUTPUT_YUV_PLANAR_16:
+            GetPlanarOutputFormat(image_.num_components, picture_width, picture_height, orientation, destination);
+            break;
+        case ROCJPEG_OUTPUT_Y:
+        case ROCJPEG_OUTPUT_Y_16:
+            GetPlanarOutputFormat(1, picture_width, picture_height, orientation, destination);
+            break;
+        case ROCJPEG_OUTPUT_RGB:
+        case ROCJPEG_OUTPUT_RGB_PLANAR:
+            CHECK_ROCJPEG(ColorConvertToRGB(is_planar, picture_width, picture_height, orientation, destination));
+            break;
+        case ROCJPEG_OUTPUT_RGB_16:
+        case ROCJPEG_OUTPUT_RGB_PLANAR_16:
+            CHECK_ROCJPEG(ColorConvertToRGB16(is_planar, picture_width, picture_height, orientation, destination));
+            break;
+        default:
+            break;
+    }
+    return ROCJPEG_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Retrieves the number of rows the last successful Decode() wrote to each destination channel.
+ *
+ * The hardware and hybrid backends decode the streams they route to the CPU into a staging image in host memory,
+ * and copy these rows to the destination in device memory. The heights follow the layouts written by Decode(): the
+ * RGB formats and the luma plane have the height of the picture, and the other planes the height of their
+ * component, with the width and height swapped by the orientations 5 to 8.
+ *
+ * @param output_format The output format of the decode.
+ * @param orientation The EXIF orientation (1 to 8) of the decode.
+ * @param channel_heights Array of NUM_COMPONENTS entries to store the number of rows of each channel (0 if unused).
+ */
+void RocJpegCpuDecoder::GetOutputChannelHeights(RocJpegOutputFormat output_format, uint8_t orientation, uint32_t *channel_heights) const {
+    bool is_transposed = orientation >= ROCJPEG_ORIENTATION_TRANSPOSE;
+    auto get_oriented_height = [is_transposed](uint32_t width, uint32_t height) { return is_transposed ? width : height; };
+    for (int32_t i = 0; i < NUM_COMPONENTS; i++) {
+        channel_heights[i] = 0;
+    }
+    uint32_t num_planes = image_.num_components;
+    switch (output_format) {
+        case ROCJPEG_OUTPUT_RGB:
+        case ROCJPEG_OUTPUT_RGB_16:
+            channel_heights[0] = get_oriented_height(output_width_, output_height_);
+            return;
+        case ROCJPEG_OUTPUT_RGB_PLANAR:
+        case ROCJPEG_OUTPUT_RGB_PLANAR_16:
+            channel_heights[0] = channel_heights[1] = channel_heights[2] = get_oriented_height(output_width_, output_height_);
+            return;
+        case ROCJPEG_OUTPUT_Y:
+        case ROCJPEG_OUTPUT_Y_16:
+            num_planes = 1;
+            break;
+        case ROCJPEG_OUTPUT_NATIVE:
+            if (image_.num_components == 3 && components_[1].shift_x == 1) {
+                if (components_[1].shift_y == 0) {
+                    // packed YUYV, which isn't oriented
+                    channel_heights[0] = output_height_;
+                    return;
+                }
+                // NV12, with an interleaved UV plane of half the height
+                channel_heights[0] = get_oriented_height(output_width_, output_height_);
+                channel_heights[1] = get_oriented_height(output_width_ >> 1, output_height_ >> 1);
+                return;
+            }
+            break;
+        default:
+            break;
+    }
+    for (uint32_t i = 0; i < num_planes; i++) {
+        channel_heights[i] = get_oriented_height(output_width_ >> components_[i].shift_x, output_height_ >> components_[i].shift_y);
+    }
+}
+
+/**
+ * @brief Decodes the entropy-coded data of a stream and writes the inverse DCT of every component to its plane.
+ *
+ * The planes are padded to whole blocks and kept between the calls, so a sequence of streams of similar size
+ * reuses them. With a scale shift, every block is written as (8 >> scale_shift) x (8 >> scale_shift) samples; at 1/8
+ * scale only the DC coefficients are decoded.
+ *
+ * @param jpeg_stream_params The parsed JPEG stream parameters.
+ * @param sample_size The size of the samples of the planes in bytes (1 or 2).
+ * @param scale_shift The scaling shift of the IDCT (0 to 3).
+ * @return The status of the operation. Returns ROCJPEG_STATUS_BAD_JPEG if the stream can't be decoded.
+ */
+RocJpegStatus RocJpegCpuDecoder::DecodePlanes(const JpegStreamParameters *jpeg_stream_params, uint32_t sample_size, uint32_t scale_shift) {
+    // the 1x1 IDCT of a block only needs its DC coefficient
+    entropy_decoder_.SetDcOnly(scale_shift == 3);
+    if (!entropy_decoder_.SetStreamParameters(jpeg_stream_params, image_)) {
+        return ROCJPEG_STATUS_BAD_JPEG;
+    }
+    if (image_.num_components == 2) {
+        ERR("ERROR: the number of JPEG components is not supported!");
+        return ROCJPEG_STATUS_JPEG_NOT_SUPPORTED;
+    }
+    if (coefficients_.size() < image_.num_coefficients) {
+        coefficients_.resize(image_.num_coefficients);
+    }
+    if (!entropy_decoder_.DecodeCoefficients(image_, coefficients_.data())) {
+        return ROCJPEG_STATUS_BAD_JPEG;
+    }
+
+    sample_size_ = sample_size;
+    uint32_t block_size = 8 >> scale_shift;
+    size_t planes_size = 0;
+    for (int32_t i = 0; i < image_.num_components; i++) {
+        const JpegCoefficientComponent &component = image_.components[i];
+        plane_offsets_[i] = planes_size;
+        plane_pitches_[i] = component.width_in_blocks * block_size * sample_size;
+        planes_size += static_cast<size_t>(plane_pitches_[i]) * component.height_in_blocks * block_size;
+    }
+    if (planes_buffer_.size() < planes_size) {
+        planes_buffer_.resize(planes_size);
+    }
+    for (int32_t i = 0; i < image_.num_components; i++) {
+        const JpegCoefficientComponent &component = image_.components[i];
+        if (image_.coefficients_per_block == 1) {
+            kernels_.DequantizeDcComponent(coefficients_.data() + component.coefficient_offset, component.quantization_table, image_.sample_precision,
+                                           component.width_in_blocks, component.height_in_blocks, planes_buffer_.data() + plane_offsets_[i],
+                                           plane_pitches_[i], sample_size);
+        } else {
+            kernels_.DequantizeScaledIdctComponent(coefficients_.data() + component.coefficient_offset, component.quantization_table, image_.sample_precision,
+                                                   scale_shift, component.width_in_blocks, component.height_in_blocks, planes_buffer_.data() + plane_offsets_[i],
+                                                   plane_pitches_[i], sample_size);
+        }
+    }
+    return ROCJPEG_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Computes the subsampling shifts of the components and locates the crop rectangle in their planes.
+ *
+ * The shift of a component is the power of two between its sampling factors and the largest ones, as in
+ * GetCmykSourceImage. The chroma samples of the crop rectangle start at (top >> shift_y, left >> shift_x), as in
+ * the oriented source images of the GPU decoders.
+ *
+ * @param top The top coordinate of the crop rectangle.
+ * @param left The left coordinate of the crop rectangle.
+ * @return The status of the operation. Returns ROCJPEG_STATUS_JPEG_NOT_SUPPORTED if the sampling factors are not supported.
+ */
+RocJpegStatus RocJpegCpuDecoder::LocateComponents(uint32_t top, uint32_t left) {
+    for (int32_t i = 0; i < image_.num_components; i++) {
+        uint32_t h_factor = image_.components[i].h_sampling_factor;
+        uint32_t v_factor = image_.components[i].v_sampling_factor;
+        uint32_t shift_x = 0;
+        uint32_t shift_y = 0;
+        while ((h_factor << shift_x) < image_.max_h_sampling_factor) {
+            shift_x++;
+        }
+        while ((v_factor << shift_y) < image_.max_v_sampling_factor) {
+            shift_y++;
+        }
+        if ((h_factor << shift_x) != image_.max_h_sampling_factor || (v_factor << shift_y) != image_.max_v_sampling_factor ||
+            (image_.num_components == 3 && i == 0 && (shift_x != 0 || shift_y != 0))) {
+            ERR("ERROR: the sampling factors of the JPEG components are not supported!");
+            return ROCJPEG_STATUS_JPEG_NOT_SUPPORTED;
+        }
+        components_[i].shift_x = shift_x;
+        components_[i].shift_y = shift_y;
+        components_[i].pitch = plane_pitches_[i];
+        components_[i].samples = planes_buffer_.data() + plane_offsets_[i] + static_cast<size_t>(top >> shift_y) * plane_pitches_[i] +
+                                 (left >> shift_x) * sample_size_;
+    }
+    return ROCJPEG_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Resizes the cropped planes of the components to the target dimension and points the components at them.
+ *
+ * Each plane keeps the subsampling of its component: a plane subsampled by 2^shift is resized from and to the
+ * dimensions of the picture divided by 2^shift, rounded up.
+ *
+ * @param width The width of the cropped picture.
+ * @param height The height of the cropped picture.
+ * @param target_width The target width of the picture.
+ * @param target_height The target height of the picture.
+ */
+void RocJpegCpuDecoder::ResizeComponents(uint32_t width, uint32_t height, uint32_t target_width, uint32_t target_height) {
+    size_t offsets[NUM_COMPONENTS];
+    size_t resized_size = 0;
+    for (int32_t i = 0; i < image_.num_components; i++) {
+        offsets[i] = resized_size;
+        resized_size += static_cast<size_t>(ScaleDimension(target_width, components_[i].shift_x)) * sample_size_ *
+                        ScaleDimension(target_height, components_[i].shift_y);
+    }
+    if (resized_buffer_.size() < resized_size) {
+        resized_buffer_.resize(resized_size);
+    }
+    for (int32_t i = 0; i < image_.num_components; i++) {
+        ComponentPlane &plane = components_[i];
+        uint32_t dst_width = ScaleDimension(target_width, plane.shift_x);
+        uint32_t dst_pitch = dst_width * sample_size_;
+        kernels_.ResizePlane(plane.samples, plane.pitch, ScaleDimension(width, plane.shift_x), ScaleDimension(height, plane.shift_y), sample_size_,
+                             resized_buffer_.data() + offsets[i], dst_pitch, dst_width, ScaleDimension(target_height, plane.shift_y));
+        plane.samples = resized_buffer_.data() + offsets[i];
+        plane.pitch = dst_pitch;
+    }
+}
+
+/**
+ * @brief Writes the rows produced by produce_row to the destination channels at their oriented position.
+ *
+ * Without an orientation, produce_row writes directly into the destination channels; otherwise, it writes into
+ * row buffers, which are then scattered to the oriented position of the row.
+ *
+ * @param width The width of the source picture.
+ * @param height The height of the source picture.
+ * @param orientation The EXIF orientation (1 to 8) to apply.
+ * @param num_channels The number of destination channels written for each row (1 to 3).
+ * @param dst_channels The destination channels.
+ * @param dst_pitch The stride (in bytes) of the destination channels.
+ * @param pixel_size The size (in bytes) of a pixel in each destination channel.
+ * @param produce_row The function writing row y of each channel to the row pointers it is given.
+ */
+template <typename ProduceRow>
+void RocJpegCpuDecoder::WriteOrientedRows(uint32_t width, uint32_t height, uint8_t orientation, uint32_t num_channels, uint8_t *const *dst_channels,
+                                          uint32_t dst_pitch, uint32_t pixel_size, ProduceRow produce_row) {
+    uint8_t *rows[3];
+    if (orientation == ROCJPEG_ORIENTATION_NORMAL) {
+        for (uint32_t y = 0; y < height; y++) {
+            for (uint32_t c = 0; c < num_channels; c++) {
+                rows[c] = dst_channels[c] + static_cast<size_t>(y) * dst_pitch;
+            }
+            produce_row(y, rows);
+        }
+        return;
+    }
+    size_t row_size = static_cast<size_t>(width) * pixel_size;
+    if (row_buffer_.size() < num_channels * row_size) {
+        row_buffer_.resize(num_channels * row_size);
+    }
+    for (uint32_t c = 0; c < num_channels; c++) {
+        rows[c] = row_buffer_.data() + c * row_size;
+    }
+    for (uint32_t y = 0; y < height; y++) {
+        produce_row(y, rows);
+        for (uint32_t c = 0; c < num_channels; c++) {
+            WriteOrientedRow(rows[c], width, height, y, orientation, pixel_size, dst_channels[c], dst_pitch);
+        }
+    }
+}
+
+/**
+ * @brief Copies the cropped samples of a plane to a destination channel, applying the orientation.
+ *
+ * @param src The description of the source plane.
+ * @param sample_size The size of a sample in bytes.
+ * @param width The width of the plane in samples.
+ * @param height The height of the plane in samples.
+ * @param orientation The EXIF orientation (1 to 8) to apply.
+ * @param dst The destination channel.
+ * @param dst_pitch The stride (in bytes) of the destination channel.
+ */
+void RocJpegCpuDecoder::CopyPlane(const ComponentPlane &src, uint32_t sample_size, uint32_t width, uint32_t height, uint8_t orientation, uint8_t *dst, uint32_t dst_pitch) {
+    for (uint32_t y = 0; y < height; y++) {
+        WriteOrientedRow(src.samples + static_cast<size_t>(y) * src.pitch, width, height, y, orientation, sample_size, dst, dst_pitch);
+    }
+}
+
+/**
+ * @brief Writes the native output of a picture with one or three components.
+ *
+ * The layouts are those of the surfaces of the VCN JPEG decoder: one plane per component for YUV 4:4:4, 4:4:0,
+ * and 4:0:0, packed YUYV for YUV 4:2:2, and NV12 (a luma plane and an interleaved UV plane) for YUV 4:2:0.
+ *
+ * @param picture_width The width of the picture.
+ * @param picture_height The height of the picture.
+ * @param orientation The EXIF orientation (1 to 8) to apply.
+ * @param destination The destination image.
+ * @return The status of the operation. Returns ROCJPEG_STATUS_JPEG_NOT_SUPPORTED for the chroma subsamplings without a native layout.
+ */
+RocJpegStatus RocJpegCpuDecoder::GetNativeOutputFormat(uint32_t picture_width, uint32_t picture_height, uint8_t orientation, RocJpegImage *destination) {
+    if (image_.num_components == 1) {
+        GetPlanarOutputFormat(1, picture_width, picture_height, orientation, destination);
+        return ROCJPEG_STATUS_SUCCESS;
+    }
+    const ComponentPlane &luma = components_[0];
+    const ComponentPlane &cb = components_[1];
+    const ComponentPlane &cr = components_[2];
+    if (cb.shift_x != cr.shift_x || cb.shift_y != cr.shift_y || cb.shift_x > 1 || cb.shift_y > 1) {
+        ERR("ERROR: the chroma subsampling has no native output format!");
+        return ROCJPEG_STATUS_JPEG_NOT_SUPPORTED;
+    }
+    if (cb.shift_x == 0) {
+        // YUV 4:4:4 and 4:4:0
+        GetPlanarOutputFormat(3, picture_width, picture_height, orientation, destination);
+        return ROCJPEG_STATUS_SUCCESS;
+    }
+    if (destination->channel[0] == nullptr || destination->pitch[0] == 0) {
+        return ROCJPEG_STATUS_SUCCESS;
+    }
+    if (cb.shift_y == 0) {
+        // YUV 4:2:2 is packed as YUYV; GetOutputOrientation rejects the orientations of this layout
+        for (uint32_t y = 0; y < picture_height; y++) {
+            const uint8_t *y_row = luma.samples + static_cast<size_t>(y) * luma.pitch;
+            const uint8_t *cb_row = cb.samples + static_cast<size_t>(y) * cb.pitch;
+            const uint8_t *cr_row = cr.samples + static_cast<size_t>(y) * cr.pitch;
+            uint8_t *dst = destination->channel[0] + static_cast<size_t>(y) * destination->pitch[0];
+            uint32_t x = 0;
+            for (; x + 1 < picture_width; x += 2, dst += 4) {
+                dst[0] = y_row[x];
+                dst[1] = cb_row[x >> 1];
+                dst[2] = y_row[x + 1];
+                dst[3] = cr_row[x >> 1];
+            }
+            if (x < picture_width) {
+                dst[0] = y_row[x];
+                dst[1] = cb_row[x >> 1];
+            }
+        }
+        return ROCJPEG_STATUS_SUCCESS;
+    }
+    // YUV 4:2:0 is written as NV12
+    CopyPlane(luma, 1, picture_width, picture_height, orientation, destination->channel[0], destination->pitch[0]);
+    if (destination->channel[1] == nullptr || destination->pitch[1] == 0) {
+        return ROCJPEG_STATUS_SUCCESS;
+    }
+    uint32_t chroma_width = picture_width >> 1;
+    WriteOrientedRows(chroma_width, picture_height >> 1, orientation, 1, &destination->channel[1], destination->pitch[1], 2,
+                      [&](uint32_t y, uint8_t *const *rows) {
+        const uint8_t *cb_row = cb.samples + static_cast<size_t>(y) * cb.pitch;
+        const uint8_t *cr_row = cr.samples + static_cast<size_t>(y) * cr.pitch;
+        uint8_t *dst = rows[0];
+        for (uint32_t x = 0; x < chroma_width; x++) {
+            dst[2 * x] = cb_row[x];
+            dst[2 * x + 1] = cr_row[x];
+        }
+    });
+    return ROCJPEG_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Writes the planes of the components to the destination channels.
+ *
+ * This serves the YUV planar and Y output formats, with 8-bit or 16-bit samples, and the native output of the
+ * pictures with one plane per component. Each plane is written at the resolution of its component.
+ *
+ * @param num_planes The number of planes to write.
+ * @param picture_width The width of the picture.
+ * @param picture_height The height of the picture.
+ * @param orientation The EXIF orientation (1 to 8) to apply.
+ * @param destination The destination image.
+ */
+void RocJpegCpuDecoder::GetPlanarOutputFormat(uint32_t num_planes, uint32_t picture_width, uint32_t picture_height, uint8_t orientation, RocJpegImage *destination) {
+    num_planes = std::min<uint32_t>(num_planes, image_.num_components);
+    for (uint32_t i = 0; i < num_planes; i++) {
+        if (destination->channel[i] == nullptr || destination->pitch[i] == 0) {
+            continue;
+        }
+        const ComponentPlane &plane = components_[i];
+        CopyPlane(plane, sample_size_, picture_width >> plane.shift_x, picture_height >> plane.shift_y, orientation, destination->channel[i],
+                  destination->pitch[i]);
+    }
+}
+
+/**
+ * @brief Converts a YCbCr or greyscale picture with 8-bit samples to interleaved or planar RGB.
+ *
+ * The subsampled chroma rows are upsampled and every row is converted by the SIMD kernels of RocJpegCpuKernels;
+ * a greyscale picture is converted with a neutral chroma row, which gives R = G = B = Y.
+ *
+ * @param is_planar True for planar RGB, false for interleaved RGB.
+ * @param picture_width The width of the picture.
+ * @param picture_height The height of the picture.
+ * @param orientation The EXIF orientation (1 to 8) to apply.
+ * @param destination The destination image.
+ * @return The status of the operation. Returns ROCJPEG_STATUS_INVALID_PARAMETER if a destination channel is missing.
+ */
+RocJpegStatus RocJpegCpuDecoder::ColorConvertToRGB(bool is_planar, uint32_t picture_width, uint32_t picture_height, uint8_t orientation, RocJpegImage *destination) {
+    uint32_t num_channels = is_planar ? 3 : 1;
+    for (uint32_t c = 0; c < num_channels; c++) {
+        if (destination->channel[c] == nullptr) {
+            ERR("ERROR! the destination channels of the RGB output are not set!");
+            return ROCJPEG_STATUS_INVALID_PARAMETER;
+        }
+    }
+    if (chroma_row_buffer_.size() < 2 * static_cast<size_t>(picture_width)) {
+        chroma_row_buffer_.resize(2 * static_cast<size_t>(picture_width));
+    }
+    uint8_t *cb_row_buffer = chroma_row_buffer_.data();
+    uint8_t *cr_row_buffer = cb_row_buffer + picture_width;
+    bool is_greyscale = image_.num_components == 1;
+    if (is_greyscale) {
+        memset(cb_row_buffer, 128, 2 * static_cast<size_t>(picture_width));
+    }
+    const ComponentPlane &luma = components_[0];
+    const ComponentPlane &cb = components_[1];
+    const ComponentPlane &cr = components_[2];
+
+    WriteOrientedRows(picture_width, picture_height, orientation, num_channels, destination->channel, destination->pitch[0], is_planar ? 1 : 3,
+                      [&](uint32_t y, uint8_t *const *rows) {
+        const uint8_t *y_row = luma.samples + static_cast<size_t>(y) * luma.pitch;
+        const uint8_t *cb_row = cb_row_buffer;
+        const uint8_t *cr_row = cr_row_buffer;
+        if (!is_greyscale) {
+            cb_row = cb.samples + static_cast<size_t>(y >> cb.shift_y) * cb.pitch;
+            cr_row = cr.samples + static_cast<size_t>(y >> cr.shift_y) * cr.pitch;
+            if (cb.shift_x != 0) {
+                kernels_.UpsampleRow(cb_row, cb.shift_x, picture_width, cb_row_buffer);
+                cb_row = cb_row_buffer;
+            }
+            if (cr.shift_x != 0) {
+                kernels_.UpsampleRow(cr_row, cr.shift_x, picture_width, cr_row_buffer);
+                cr_row = cr_row_buffer;
+            }
+        }
+        if (is_planar) {
+            kernels_.ConvertYCbCrToRGBPlanarRow(y_row, cb_row, cr_row, picture_width, rows[0], rows[1], rows[2]);
+        } else {
+            kernels_.ConvertYCbCrToRGBRow(y_row, cb_row, cr_row, picture_width, rows[0]);
+        }
+    });
+    return ROCJPEG_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Converts a YCbCr or greyscale picture with 16-bit samples to interleaved or planar RGB.
+ *
+ * The conversion computes the same arithmetic as the ColorConvertToRGB16Oriented kernel, with the chroma offset
+ * and the clamping of the sample precision of the frame.
+ *
+ * @param is_planar True for planar RGB, false for interleaved RGB.
+ * @param picture_width The width of the picture.
+ * @param picture_height The height of the picture.
+ * @param orientation The EXIF orientation (1 to 8) to apply.
+ * @param destination The destination image.
+ * @return The status of the operation. Returns ROCJPEG_STATUS_INVALID_PARAMETER if a destination channel is missing.
+ */
+RocJpegStatus RocJpegCpuDecoder::ColorConvertToRGB16(bool is_planar, uint32_t picture_width, uint32_t picture_height, uint8_t orientation, RocJpegImage *destination) {
+    uint32_t num_channels = is_planar ? 3 : 1;
+    for (uint32_t c = 0; c < num_channels; c++) {
+        if (destination->channel[c] == nullptr) {
+            ERR("ERROR! the destination channels of the RGB output are not set!");
+            return ROCJPEG_STATUS_INVALID_PARAMETER;
+        }
+    }
+    float max_sample_value = static_cast<float>((1 << image_.sample_precision) - 1);
+    float center = static_cast<float>(1 << (image_.sample_precision - 1));
+    bool is_greyscale = image_.num_components == 1;
+    const ComponentPlane &luma = components_[0];
+    const ComponentPlane &cb = components_[1];
+    const ComponentPlane &cr = components_[2];
+
+    WriteOrientedRows(picture_width, picture_height, orientation, num_channels, destination->channel, destination->pitch[0],
+                      (is_planar ? 1 : 3) * sizeof(uint16_t), [&](uint32_t y, uint8_t *const *rows) {
+        const uint16_t *y_row = reinterpret_cast<const uint16_t*>(luma.samples + static_cast<size_t>(y) * luma.pitch);
+        const uint16_t *cb_row = is_greyscale ? nullptr : reinterpret_cast<const uint16_t*>(cb.samples + static_cast<size_t>(y >> cb.shift_y) * cb.pitch);
+        const uint16_t *cr_row = is_greyscale ? nullptr : reinterpret_cast<const uint16_t*>(cr.samples + static_cast<size_t>(y >> cr.shift_y) * cr.pitch);
+        uint16_t *dst_r = reinterpret_cast<uint16_t*>(rows[0]);
+        uint16_t *dst_g = is_planar ? reinterpret_cast<uint16_t*>(rows[1]) : dst_r + 1;
+        uint16_t *dst_b = is_planar ? reinterpret_cast<uint16_t*>(rows[2]) : dst_r + 2;
+        uint32_t step = is_planar ? 1 : 3;
+        for (uint32_t x = 0; x < picture_width; x++) {
+            uint32_t r, g, b;
+            if (is_greyscale) {
+                r = g = b = y_row[x];
+            } else {
+                ConvertYCbCrToRGBSample(y_row[x], cb_row[x >> cb.shift_x], cr_row[x >> cr.shift_x], center, max_sample_value, r, g, b);
+            }
+            dst_r[x * step] = static_cast<uint16_t>(r);
+            dst_g[x * step] = static_cast<uint16_t>(g);
+            dst_b[x * step] = static_cast<uint16_t>(b);
+        }
+    });
+    return ROCJPEG_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Converts a CMYK or YCCK picture to interleaved or planar RGB with 8-bit or 16-bit samples.
+ *
+ * The conversion computes the same arithmetic as the ColorConvertCMYKToRGBOriented kernel: a YCCK picture is
+ * first converted to inverted CMY inks, the inks of a picture without an Adobe marker are inverted, and every
+ * color is then scaled by K.
+ *
+ * @param jpeg_stream_params The parsed JPEG stream parameters.
+ * @param is_planar True for planar RGB, false for interleaved RGB.
+ * @param picture_width The width of the picture.
+ * @param picture_height The height of the picture.
+ * @param orientation The EXIF orientation (1 to 8) to apply.
+ * @param destination The destination image.
+ * @return The status of the operation. Returns ROCJPEG_STATUS_INVALID_PARAMETER if a destination channel is missing.
+ */
+RocJpegStatus RocJpegCpuDecoder::ColorConvertCMYKToRGB(const JpegStreamParameters *jpeg_stream_params, bool is_planar, uint32_t picture_width, uint32_t picture_height,
+                                                       uint8_t orientation, RocJpegImage *destination) {
+    uint32_t num_channels = is_planar ? 3 : 1;
+    for (uint32_t c = 0; c < num_channels; c++) {
+        if (destination->channel[c] == nullptr) {
+            ERR("ERROR! the destination channels of the RGB output are not set!");
+            return ROCJPEG_STATUS_INVALID_PARAMETER;
+        }
+    }
+    uint32_t sample_size = sample_size_;
+    uint32_t sample_precision = sample_size == sizeof(uint16_t) ? image_.sample_precision : 8;
+    uint32_t max_sample_value = (1 << sample_precision) - 1;
+    bool is_ycck = jpeg_stream_params->has_adobe_marker && jpeg_stream_params->adobe_color_transform == ADOBE_TRANSFORM_YCCK;
+    bool is_inverted = jpeg_stream_params->has_adobe_marker;
+    const ComponentPlane *planes = components_;
+    auto read_sample = [&](int32_t component, uint32_t x, uint32_t y) -> uint32_t {
+        const uint8_t *sample = planes[component].samples + static_cast<size_t>(y >> planes[component].shift_y) * planes[component].pitch +
+                                (x >> planes[component].shift_x) * sample_size;
+        return sample_size == sizeof(uint16_t) ? *reinterpret_cast<const uint16_t*>(sample) : *sample;
+    };
+
+    WriteOrientedRows(picture_width, picture_height, orientation, num_channels, destination->channel, destination->pitch[0],
+                      (is_planar ? 1 : 3) * sample_size, [&](uint32_t y, uint8_t *const *rows) {
+        uint32_t step = is_planar ? sample_size : 3 * sample_size;
+        uint8_t *dst_r = rows[0];
+        uint8_t *dst_g = is_planar ? rows[1] : rows[0] + sample_size;
+        uint8_t *dst_b = is_planar ? rows[2] : rows[0] + 2 * sample_size;
+        for (uint32_t x = 0; x < picture_width; x++) {
+            uint32_t c = read_sample(0, x, y);
+            uint32_t m = read_sample(1, x, y);
+            uint32_t ye = read_sample(2, x, y);
+            uint32_t k = read_sample(3, x, y);
+            if (is_ycck) {
+                ConvertYCbCrToRGBSample(static_cast<float>(c), static_cast<float>(m), static_cast<float>(ye), static_cast<float>(1 << (sample_precision - 1)),
+                                        static_cast<float>(max_sample_value), c, m, ye);
+                c = max_sample_value - c;
+                m = max_sample_value - m;
+                ye = max_sample_value - ye;
+            } else if (!is_inverted) {
+                c = max_sample_value - c;
+                m = max_sample_value - m;
+                ye = max_sample_value - ye;
+                k = max_sample_value - k;
+            }
+            uint32_t r = (c * k + (max_sample_value >> 1)) / max_sample_value;
+            uint32_t g = (m * k + (max_sample_value >> 1)) / max_sample_value;
+            uint32_t b = (ye * k + (max_sample_value >> 1)) / max_sample_value;
+            size_t dst_idx = static_cast<size_t>(x) * step;
+            if (sample_size == sizeof(uint16_t)) {
+                *reinterpret_cast<uint16_t*>(dst_r + dst_idx) = static_cast<uint16_t>(r);
+                *reinterpret_cast<uint16_t*>(dst_g + dst_idx) = static_cast<uint16_t>(g);
+                *reinterpret_cast<uint16_t*>(dst_b + dst_idx) = static_cast<uint16_t>(b);
+            } else {
+                dst_r[dst_idx] = static_cast<uint8_t>(r);
+                dst_g[dst_idx] = static_cast<uint8_t>(g);
+                dst_b[dst_idx] = static_cast<uint8_t>(b);
+            }
+        }
+    });
+    return ROCJPEG_STATUS_SUCCESS;
+}
@@ -0,0 +1,184 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef ROC_JPEG_CPU_DECODER_H_
+#define ROC_JPEG_CPU_DECODER_H_
+
+#pragma once
+
+#include <vector>
+#include "../api/rocjpeg.h"
+#include "rocjpeg_commons.h"
+#include "rocjpeg_parser.h"
+#include "rocjpeg_entropy_decoder.h"
+#include "rocjpeg_cpu_kernels.h"
+
+/**
+ * @class RocJpegCpuDecoder
+ * @brief A class that decodes JPEG streams entirely on the CPU into destination images in host memory.
+ *
+ * The CPU decoder serves the ROCJPEG_BACKEND_CPU backend. The entropy-coded data is decoded by the software entropy
+ * decoder of the hybrid path, the blocks are transformed by the same islow IDCT into one plane per component, and
+ * the planes are written to the destination image in the requested output format by the row kernels of
+ * RocJpegCpuKernels, which are vectorized with AVX2 or AVX-512 when the CPU supports them. The output, including
+ * the crop rectangle and the orientation, is identical to the output of the hybrid decoder. A target dimension is
+ * served by a scaled decode: reduced-size IDCTs (4x4, 2x2, or DC only) followed by a small bilinear resize.
+ *
+ * A decoder is not synchronized; the same decoder must not be used from multiple threads at the same time.
+ */
+class RocJpegCpuDecoder {
+public:
+   /**
+    * @brief Constructs a RocJpegCpuDecoder object.
+    */
+   RocJpegCpuDecoder();
+
+   /**
+    * @brief Decodes a JPEG stream into a destination image in host memory.
+    * @param jpeg_stream_params The parsed JPEG stream parameters.
+    * @param decode_params The decode parameters (output format, crop rectangle, and target dimension).
+    * @param orientation The EXIF orientation (1 to 8) to apply.
+    * @param destination The destination image; its channels must be in host memory.
+    * @return The status of the decoding operation.
+    */
+   RocJpegStatus Decode(const JpegStreamParameters *jpeg_stream_params, const RocJpegDecodeParams *decode_params, uint8_t orientation,
+                        RocJpegImage *destination);
+
+   /**
+    * @brief Retrieves the number of rows the last successful Decode() wrote to each destination channel.
+    * @param output_format The output format of the decode.
+    * @param orientation The EXIF orientation (1 to 8) of the decode.
+    * @param channel_heights Array of NUM_COMPONENTS entries to store the number of rows of each channel (0 if unused).
+    */
+   void GetOutputChannelHeights(RocJpegOutputFormat output_format, uint8_t orientation, uint32_t *channel_heights) const;
+
+private:
+   /**
+    * @brief Structure locating the cropped samples of a component in its plane.
+    */
+   struct ComponentPlane {
+      const uint8_t *samples; ///< Pointer to the first sample of the crop rectangle.
+      uint32_t pitch; ///< The stride (in bytes) of the plane.
+      uint32_t shift_x; ///< Horizontal subsampling shift of the component.
+      uint32_t shift_y; ///< Vertical subsampling shift of the component.
+   };
+
+   /**
+    * @brief Decodes the entropy-coded data of a stream and writes the inverse DCT of every component to its plane.
+    * @param jpeg_stream_params The parsed JPEG stream parameters.
+    * @param sample_size The size of the samples of the planes in bytes (1 or 2).
+    * @param scale_shift The scaling shift of the IDCT (0 to 3); the planes are decoded at 1/2^scale_shift of the picture size.
+    * @return The status of the operation.
+    */
+   RocJpegStatus DecodePlanes(const JpegStreamParameters *jpeg_stream_params, uint32_t sample_size, uint32_t scale_shift);
+
+   /**
+    * @brief Computes the subsampling shifts of the components and locates the crop rectangle in their planes.
+    * @param top The top coordinate of the crop rectangle.
+    * @param left The left coordinate of the crop rectangle.
+    * @return The status of the operation. Returns ROCJPEG_STATUS_JPEG_NOT_SUPPORTED if the sampling factors are not supported.
+    */
+   RocJpegStatus LocateComponents(uint32_t top, uint32_t left);
+
+   /**
+    * @brief Resizes the cropped planes of the components to the target dimension and points the components at them.
+    * @param width The width of the cropped picture.
+    * @param height The height of the cropped picture.
+    * @param target_width The target width of the picture.
+    * @param target_height The target height of the picture.
+    */
+   void ResizeComponents(uint32_t width, uint32_t height, uint32_t target_width, uint32_t target_height);
+
+   /**
+    * @brief Writes the rows produced by produce_row to the destination channels at their oriented position.
+    * @param width The width of the source picture.
+    * @param height The height of the source picture.
+    * @param orientation The EXIF orientation (1 to 8) to apply.
+    * @param num_channels The number of destination channels written for each row (1 to 3).
+    * @param dst_channels The destination channels.
+    * @param dst_pitch The stride (in bytes) of the destination channels.
+    * @param pixel_size The size (in bytes) of a pixel in each destination channel.
+    * @param produce_row The function writing row y of each channel to the row pointers it is given.
+    */
+   template <typename ProduceRow>
+   void WriteOrientedRows(uint32_t width, uint32_t height, uint8_t orientation, uint32_t num_channels, uint8_t *const *dst_channels,
+                          uint32_t dst_pitch, uint32_t pixel_size, ProduceRow produce_row);
+
+   /**
+    * @brief Copies the cropped samples of a plane to a destination channel.
+    * @param src The description of the source plane.
+    * @param sample_size The size of a sample in bytes.
+    * @param width The width of the plane in samples.
+    * @param height The height of the plane in samples.
+    * @param orientation The EXIF orientation (1 to 8) to apply.
+    * @param dst The destination channel.
+    * @param dst_pitch The stride (in bytes) of the destination channel.
+    */
+   void CopyPlane(const ComponentPlane &src, uint32_t sample_size, uint32_t width, uint32_t height, uint8_t orientation, uint8_t *dst, uint32_t dst_pitch);
+
+   /**
+    * @brief Writes the native output: the planes, or the interleaved layouts of the VCN JPEG decoder for 4:2:2 (YUYV) and 4:2:0 (NV12).
+    * @return The status of the operation. Returns ROCJPEG_STATUS_JPEG_NOT_SUPPORTED for the chroma subsamplings without a native layout.
+    */
+   RocJpegStatus GetNativeOutputFormat(uint32_t picture_width, uint32_t picture_height, uint8_t orientation, RocJpegImage *destination);
+
+   /**
+    * @brief Writes the planes (YUV planar and Y output formats, with 8-bit or 16-bit samples) to the destination channels.
+    */
+   void GetPlanarOutputFormat(uint32_t num_planes, uint32_t picture_width, uint32_t picture_height, uint8_t orientation, RocJpegImage *destination);
+
+   /**
+    * @brief Converts a YCbCr or greyscale picture with 8-bit samples to interleaved or planar RGB.
+    * @return The status of the operation.
+    */
+   RocJpegStatus ColorConvertToRGB(bool is_planar, uint32_t picture_width, uint32_t picture_height, uint8_t orientation, RocJpegImage *destination);
+
+   /**
+    * @brief Converts a YCbCr or greyscale picture with 16-bit samples to interleaved or planar RGB.
+    * @return The status of the operation.
+    */
+   RocJpegStatus ColorConvertToRGB16(bool is_planar, uint32_t picture_width, uint32_t picture_height, uint8_t orientation, RocJpegImage *destination);
+
+   /**
+    * @brief Converts a CMYK or YCCK picture to interleaved or planar RGB with 8-bit or 16-bit samples.
+    * @return The status of the operation.
+    */
+   RocJpegStatus ColorConvertCMYKToRGB(const JpegStreamParameters *jpeg_stream_params, bool is_planar, uint32_t picture_width, uint32_t picture_height,
+                                       uint8_t orientation, RocJpegImage *destination);
+
+   RocJpegEntropyDecoder entropy_decoder_; // The software entropy decoder
+   RocJpegCpuKernels kernels_; // The IDCT, upsampling, and color conversion kernels selected for the CPU
+   JpegCoefficientImage image_; // The layout of the coefficients of the stream being decoded
+   std::vector<int16_t> coefficients_; // The coefficients of the stream being decoded
+   std::vector<uint8_t> planes_buffer_; // The decoded planes, one per component
+   std::vector<uint8_t> resized_buffer_; // The planes resized to the target dimension, one per component
+   std::vector<uint8_t> row_buffer_; // The rows produced before they are written to their oriented position
+   std::vector<uint8_t> chroma_row_buffer_; // The upsampled chroma rows, or the neutral chroma row of a greyscale picture
+   ComponentPlane components_[NUM_COMPONENTS]; // The cropped planes of the components
+   size_t plane_offsets_[NUM_COMPONENTS]; // The offset of the plane of each component in the plane buffer
+   uint32_t plane_pitches_[NUM_COMPONENTS]; // The stride (in bytes) of the plane of each component
+   uint32_t sample_size_; // The size of the samples of the planes in bytes (1 or 2)
+   uint32_t output_width_; // The width of the picture written by the last decode, before the orientation
+   uint32_t output_height_; // The height of the picture written by the last decode, before the orientation
+};
+
+#endif  // ROC_JPEG_CPU_DECODER_H_
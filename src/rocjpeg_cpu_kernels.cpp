@@ -0,0 +1,647 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "rocjpeg_cpu_kernels.h"
+#if ROCJPEG_X86_SIMD
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Rounds a converted sample to the nearest integer (ties to even) and saturates it to [0, 255].
+ *
+ * This matches the float to unsigned byte packing of the GPU color conversion kernels and the conversion
+ * instructions of the vectorized kernels, which use the default rounding mode.
+ */
+static inline uint8_t RoundToSample(float value) {
+    float rounded = std::nearbyint(value);
+    return rounded <= 0.0f ? 0 : (rounded >= 255.0f ? 255 : static_cast<uint8_t>(rounded));
+}
+
+/**
+ * @brief Converts one Y, Cb, and Cr sample to RGB with the BT.709 coefficients of the GPU kernels.
+ */
+static inline void ConvertYCbCrToRGBPixel(uint8_t y, uint8_t cb, uint8_t cr, uint8_t *r, uint8_t *g, uint8_t *b) {
+    float luma = y;
+    float u = cb - 128.0f;
+    float v = cr - 128.0f;
+    *r = RoundToSample(std::fma(1.5748f, v, luma));
+    *g = RoundToSample(std::fma(-0.4681f, v, std::fma(-0.1873f, u, luma)));
+    *b = RoundToSample(std::fma(1.8556f, u, luma));
+}
+
+/**
+ * @brief Scalar kernel for upsampling a row of chroma samples, from the destination sample `begin` on.
+ */
+static void UpsampleRowScalar(const uint8_t *src, uint32_t shift_x, uint32_t begin, uint32_t width, uint8_t *dst) {
+    for (uint32_t x = begin; x < width; x++) {
+        dst[x] = src[x >> shift_x];
+    }
+}
+
+static void UpsampleRowScalar(const uint8_t *src, uint32_t shift_x, uint32_t width, uint8_t *dst) {
+    UpsampleRowScalar(src, shift_x, 0, width, dst);
+}
+
+/**
+ * @brief Scalar kernel for converting a row of Y, Cb, and Cr samples to interleaved RGB.
+ */
+static void YCbCrToRGBRowScalar(const uint8_t *y, const uint8_t *cb, const uint8_t *cr, uint32_t width, uint8_t *dst_rgb) {
+    for (uint32_t x = 0; x < width; x++, dst_rgb += 3) {
+        ConvertYCbCrToRGBPixel(y[x], cb[x], cr[x], dst_rgb, dst_rgb + 1, dst_rgb + 2);
+    }
+}
+
+/**
+ * @brief Scalar kernel for converting a row of Y, Cb, and Cr samples to planar RGB.
+ */
+static void YCbCrToRGBPlanarRowScalar(const uint8_t *y, const uint8_t *cb, const uint8_t *cr, uint32_t width, uint8_t *dst_r, uint8_t *dst_g, uint8_t *dst_b) {
+    for (uint32_t x = 0; x < width; x++) {
+        ConvertYCbCrToRGBPixel(y[x], cb[x], cr[x], dst_r + x, dst_g + x, dst_b + x);
+    }
+}
+
+/**
+ * @brief Scalar kernel for dequantizing a row of blocks of an 8-bit frame and writing their inverse DCT as 8-bit samples.
+ */
+static void DequantizeIdctRowScalar(const int16_t *coefficients, const uint16_t *quantization_table, uint32_t num_blocks, uint8_t *dst,
+                                    uint32_t dst_stride_in_bytes) {
+    for (uint32_t x = 0; x < num_blocks; x++, coefficients += DCT_BLOCK_SIZE, dst += 8) {
+        DequantizeIdct8x8(coefficients, quantization_table, dst, dst_stride_in_bytes, 1);
+    }
+}
+
+#if ROCJPEG_X86_SIMD
+/**
+ * @brief Interleaves 16 red, 16 green, and 16 blue samples into 48 bytes of RGB.
+ *
+ * Each of the three 16-byte outputs gathers its bytes from the three channels with one shuffle per channel.
+ */
+__attribute__((target("ssse3")))
+static inline void StoreInterleavedRGB(__m128i r, __m128i g, __m128i b, uint8_t *dst_rgb) {
+    alignas(16) static const int8_t shuffle_masks[3][3][16] = {
+        {{ 0, -1, -1,  1, -1, -1,  2, -1, -1,  3, -1, -1,  4, -1, -1,  5},
+         {-1,  0, -1, -1,  1, -1, -1,  2, -1, -1,  3, -1, -1,  4, -1, -1},
+         {-1, -1,  0, -1, -1,  1, -1, -1,  2, -1, -1,  3, -1, -1,  4, -1}},
+        {{-1, -1,  6, -1, -1,  7, -1, -1,  8, -1, -1,  9, -1, -1, 10, -1},
+         { 5, -1, -1,  6, -1, -1,  7, -1, -1,  8, -1, -1,  9, -1, -1, 10},
+         {-1,  5, -1, -1,  6, -1, -1,  7, -1, -1,  8, -1, -1,  9, -1, -1}},
+        {{-1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1, -1},
+         {-1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15, -1},
+         {10, -1, -1, 11, -1, -1, 12, -1, -1, 13, -1, -1, 14, -1, -1, 15}},
+    };
+    for (int32_t i = 0; i < 3; i++) {
+        __m128i rgb = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(r, _mm_load_si128(reinterpret_cast<const __m128i*>(shuffle_masks[i][0]))),
+                                                _mm_shuffle_epi8(g, _mm_load_si128(reinterpret_cast<const __m128i*>(shuffle_masks[i][1])))),
+                                   _mm_shuffle_epi8(b, _mm_load_si128(reinterpret_cast<const __m128i*>(shuffle_masks[i][2]))));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst_rgb + 16 * i), rgb);
+    }
+}
+
+/**
+ * @brief AVX2 kernel for upsampling a row of chroma samples; the shifts 1 and 2 write 32 samples per step.
+ */
+__attribute__((target("avx2")))
+static void UpsampleRowAvx2(const uint8_t *src, uint32_t shift_x, uint32_t width, uint8_t *dst) {
+    uint32_t x = 0;
+    if (shift_x == 1) {
+        for (; x + 32 <= width; x += 32) {
+            __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + (x >> 1)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm_unpacklo_epi8(samples, samples));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x + 16), _mm_unpackhi_epi8(samples, samples));
+        }
+    } else if (shift_x == 2) {
+        for (; x + 32 <= width; x += 32) {
+            __m128i samples = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + (x >> 2)));
+            samples = _mm_unpacklo_epi8(samples, samples);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x), _mm_unpacklo_epi8(samples, samples));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + x + 16), _mm_unpackhi_epi8(samples, samples));
+        }
+    }
+    UpsampleRowScalar(src, shift_x, x, width, dst);
+}
+
+/**
+ * @brief Converts two vectors of 8 float samples to 16 unsigned bytes, rounding to nearest even and saturating.
+ */
+__attribute__((target("avx2")))
+static inline __m128i PackSamplesAvx2(__m256 lo, __m256 hi) {
+    // packs_epi32 interleaves the 128-bit lanes of its operands, the permutation restores the order of the samples
+    __m256i words = _mm256_permute4x64_epi64(_mm256_packs_epi32(_mm256_cvtps_epi32(lo), _mm256_cvtps_epi32(hi)), 0xD8);
+    return _mm_packus_epi16(_mm256_castsi256_si128(words), _mm256_extracti128_si256(words, 1));
+}
+
+/**
+ * @brief Converts 16 Y, Cb, and Cr samples to 16 red, green, and blue samples with AVX2 and FMA.
+ */
+__attribute__((target("avx2,fma")))
+static inline void ConvertYCbCrToRGBx16Avx2(const uint8_t *y, const uint8_t *cb, const uint8_t *cr, __m128i *r, __m128i *g, __m128i *b) {
+    const __m256 center = _mm256_set1_ps(128.0f);
+    const __m256 cr_to_r = _mm256_set1_ps(1.5748f);
+    const __m256 cb_to_g = _mm256_set1_ps(-0.1873f);
+    const __m256 cr_to_g = _mm256_set1_ps(-0.4681f);
+    const __m256 cb_to_b = _mm256_set1_ps(1.8556f);
+    __m128i y8 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(y));
+    __m128i cb8 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cb));
+    __m128i cr8 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cr));
+    __m256 y_lo = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(y8));
+    __m256 y_hi = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_unpackhi_epi64(y8, y8)));
+    __m256 u_lo = _mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(cb8)), center);
+    __m256 u_hi = _mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_unpackhi_epi64(cb8, cb8))), center);
+    __m256 v_lo = _mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(cr8)), center);
+    __m256 v_hi = _mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_unpackhi_epi64(cr8, cr8))), center);
+    *r = PackSamplesAvx2(_mm256_fmadd_ps(cr_to_r, v_lo, y_lo), _mm256_fmadd_ps(cr_to_r, v_hi, y_hi));
+    *g = PackSamplesAvx2(_mm256_fmadd_ps(cr_to_g, v_lo, _mm256_fmadd_ps(cb_to_g, u_lo, y_lo)),
+                         _mm256_fmadd_ps(cr_to_g, v_hi, _mm256_fmadd_ps(cb_to_g, u_hi, y_hi)));
+    *b = PackSamplesAvx2(_mm256_fmadd_ps(cb_to_b, u_lo, y_lo), _mm256_fmadd_ps(cb_to_b, u_hi, y_hi));
+}
+
+/**
+ * @brief AVX2 kernel for converting a row of Y, Cb, and Cr samples to interleaved RGB, 16 pixels per step.
+ */
+__attribute__((target("avx2,fma")))
+static void YCbCrToRGBRowAvx2(const uint8_t *y, const uint8_t *cb, const uint8_t *cr, uint32_t width, uint8_t *dst_rgb) {
+    uint32_t x = 0;
+    for (; x + 16 <= width; x += 16) {
+        __m128i r, g, b;
+        ConvertYCbCrToRGBx16Avx2(y + x, cb + x, cr + x, &r, &g, &b);
+        StoreInterleavedRGB(r, g, b, dst_rgb + 3 * x);
+    }
+    YCbCrToRGBRowScalar(y + x, cb + x, cr + x, width - x, dst_rgb + 3 * x);
+}
+
+/**
+ * @brief AVX2 kernel for converting a row of Y, Cb, and Cr samples to planar RGB, 16 pixels per step.
+ */
+__attribute__((target("avx2,fma")))
+static void YCbCrToRGBPlanarRowAvx2(const uint8_t *y, const uint8_t *cb, const uint8_t *cr, uint32_t width, uint8_t *dst_r, uint8_t *dst_g, uint8_t *dst_b) {
+    uint32_t x = 0;
+    for (; x + 16 <= width; x += 16) {
+        __m128i r, g, b;
+        ConvertYCbCrToRGBx16Avx2(y + x, cb + x, cr + x, &r, &g, &b);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst_r + x), r);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst_g + x), g);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst_b + x), b);
+    }
+    YCbCrToRGBPlanarRowScalar(y + x, cb + x, cr + x, width - x, dst_r + x, dst_g + x, dst_b + x);
+}
+
+/**
+ * @brief Converts a vector of 16 float samples to 16 unsigned bytes, rounding to nearest even and saturating.
+ */
+__attribute__((target("avx512f,avx512bw")))
+static inline __m128i PackSamplesAvx512(__m512 value) {
+    // the unsigned saturating narrowing treats negative values as large ones, so they are clamped to 0 first
+    __m512i samples = _mm512_max_epi32(_mm512_cvtps_epi32(value), _mm512_setzero_si512());
+    return _mm512_cvtusepi32_epi8(samples);
+}
+
+/**
+ * @brief Converts 16 Y, Cb, and Cr samples to 16 red, green, and blue samples with AVX-512.
+ */
+__attribute__((target("avx512f,avx512bw,fma")))
+static inline void ConvertYCbCrToRGBx16Avx512(const uint8_t *y, const uint8_t *cb, const uint8_t *cr, __m128i *r, __m128i *g, __m128i *b) {
+    const __m512 center = _mm512_set1_ps(128.0f);
+    __m512 luma = _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(y))));
+    __m512 u = _mm512_sub_ps(_mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cb)))), center);
+    __m512 v = _mm512_sub_ps(_mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(cr)))), center);
+    *r = PackSamplesAvx512(_mm512_fmadd_ps(_mm512_set1_ps(1.5748f), v, luma));
+    *g = PackSamplesAvx512(_mm512_fmadd_ps(_mm512_set1_ps(-0.4681f), v, _mm512_fmadd_ps(_mm512_set1_ps(-0.1873f), u, luma)));
+    *b = PackSamplesAvx512(_mm512_fmadd_ps(_mm512_set1_ps(1.8556f), u, luma));
+}
+
+/**
+ * @brief AVX-512 kernel for converting a row of Y, Cb, and Cr samples to interleaved RGB, 16 pixels per step.
+ */
+__attribute__((target("avx512f,avx512bw,fma")))
+static void YCbCrToRGBRowAvx512(const uint8_t *y, const uint8_t *cb, const uint8_t *cr, uint32_t width, uint8_t *dst_rgb) {
+    uint32_t x = 0;
+    for (; x + 16 <= width; x += 16) {
+        __m128i r, g, b;
+        ConvertYCbCrToRGBx16Avx512(y + x, cb + x, cr + x, &r, &g, &b);
+        StoreInterleavedRGB(r, g, b, dst_rgb + 3 * x);
+    }
+    YCbCrToRGBRowScalar(y + x, cb + x, cr + x, width - x, dst_rgb + 3 * x);
+}
+
+/**
+ * @brief AVX-512 kernel for converting a row of Y, Cb, and Cr samples to planar RGB, 16 pixels per step.
+ */
+__attribute__((target("avx512f,avx512bw,fma")))
+static void YCbCrToRGBPlanarRowAvx512(const uint8_t *y, const uint8_t *cb, const uint8_t *cr, uint32_t width, uint8_t *dst_r, uint8_t *dst_g, uint8_t *dst_b) {
+    uint32_t x = 0;
+    for (; x + 16 <= width; x += 16) {
+        __m128i r, g, b;
+        ConvertYCbCrToRGBx16Avx512(y + x, cb + x, cr + x, &r, &g, &b);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst_r + x), r);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst_g + x), g);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst_b + x), b);
+    }
+    YCbCrToRGBPlanarRowScalar(y + x, cb + x, cr + x, width - x, dst_r + x, dst_g + x, dst_b + x);
+}
+
+typedef int32_t Int32x8 __attribute__((vector_size(32)));
+typedef int32_t Int32x16 __attribute__((vector_size(64)));
+
+/**
+ * @brief The load, transpose, and store steps of the vectorized IDCT with AVX2; a vector holds a row of one block.
+ */
+struct IdctStepsAvx2 {
+    typedef Int32x8 Vector;
+    static constexpr uint32_t kNumBlocks = 1;
+
+    /**
+     * @brief Loads and dequantizes the coefficients of the block, one row per vector.
+     */
+    __attribute__((target("avx2")))
+    static inline void LoadDequantizedRows(const int16_t *coefficients, const uint16_t *quantization_table, Vector rows[8]) {
+        for (int32_t row = 0; row < 8; row++) {
+            __m256i coefficient = _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(coefficients + row * 8)));
+            __m256i quantizer = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(quantization_table + row * 8)));
+            rows[row] = reinterpret_cast<Vector>(_mm256_mullo_epi32(coefficient, quantizer));
+        }
+    }
+
+    /**
+     * @brief Transposes the 8x8 values of the block.
+     */
+    __attribute__((target("avx2")))
+    static inline void Transpose(Vector rows[8]) {
+        __m256i t[8], u[8];
+        for (int32_t i = 0; i < 8; i += 2) {
+            t[i] = _mm256_unpacklo_epi32(reinterpret_cast<__m256i>(rows[i]), reinterpret_cast<__m256i>(rows[i + 1]));
+            t[i + 1] = _mm256_unpackhi_epi32(reinterpret_cast<__m256i>(rows[i]), reinterpret_cast<__m256i>(rows[i + 1]));
+        }
+        for (int32_t i = 0; i < 8; i += 4) {
+            u[i] = _mm256_unpacklo_epi64(t[i], t[i + 2]);
+            u[i + 1] = _mm256_unpackhi_epi64(t[i], t[i + 2]);
+            u[i + 2] = _mm256_unpacklo_epi64(t[i + 1], t[i + 3]);
+            u[i + 3] = _mm256_unpackhi_epi64(t[i + 1], t[i + 3]);
+        }
+        for (int32_t i = 0; i < 4; i++) {
+            rows[i] = reinterpret_cast<Vector>(_mm256_permute2x128_si256(u[i], u[i + 4], 0x20));
+            rows[i + 4] = reinterpret_cast<Vector>(_mm256_permute2x128_si256(u[i], u[i + 4], 0x31));
+        }
+    }
+
+    /**
+     * @brief Saturates the range limited rows of the block to [0, 255] and stores them.
+     */
+    __attribute__((target("avx2")))
+    static inline void StoreRows(const Vector rows[8], uint8_t *dst, uint32_t dst_stride_in_bytes) {
+        const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+        for (int32_t i = 0; i < 8; i += 4) {
+            // the packing interleaves the 128-bit lanes, so the permutation gathers the eight bytes of each row
+            __m256i rows01 = _mm256_packs_epi32(reinterpret_cast<__m256i>(rows[i]), reinterpret_cast<__m256i>(rows[i + 1]));
+            __m256i rows23 = _mm256_packs_epi32(reinterpret_cast<__m256i>(rows[i + 2]), reinterpret_cast<__m256i>(rows[i + 3]));
+            __m256i samples = _mm256_permutevar8x32_epi32(_mm256_packus_epi16(rows01, rows23), order);
+            __m128i lo = _mm256_castsi256_si128(samples);
+            __m128i hi = _mm256_extracti128_si256(samples, 1);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i * dst_stride_in_bytes), lo);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + (i + 1) * dst_stride_in_bytes), _mm_unpackhi_epi64(lo, lo));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + (i + 2) * dst_stride_in_bytes), hi);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + (i + 3) * dst_stride_in_bytes), _mm_unpackhi_epi64(hi, hi));
+        }
+    }
+};
+
+/**
+ * @brief The load, transpose, and store steps of the vectorized IDCT with AVX-512; a vector holds a row of two
+ * horizontally adjacent blocks, the first block in the low 256 bits.
+ */
+struct IdctStepsAvx512 {
+    typedef Int32x16 Vector;
+    static constexpr uint32_t kNumBlocks = 2;
+
+    /**
+     * @brief Loads and dequantizes the coefficients of the two blocks, one row of both blocks per vector.
+     */
+    __attribute__((target("avx512f")))
+    static inline void LoadDequantizedRows(const int16_t *coefficients, const uint16_t *quantization_table, Vector rows[8]) {
+        for (int32_t row = 0; row < 8; row++) {
+            __m256i coefficient = _mm256_loadu2_m128i(reinterpret_cast<const __m128i*>(coefficients + DCT_BLOCK_SIZE + row * 8),
+                                                      reinterpret_cast<const __m128i*>(coefficients + row * 8));
+            __m256i quantizer = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(quantization_table + row * 8)));
+            rows[row] = reinterpret_cast<Vector>(_mm512_mullo_epi32(_mm512_cvtepi16_epi32(coefficient), _mm512_cvtepu16_epi32(quantizer)));
+        }
+    }
+
+    /**
+     * @brief Transposes the 8x8 values of each of the two blocks.
+     */
+    __attribute__((target("avx512f")))
+    static inline void Transpose(Vector rows[8]) {
+        const __m512i low_halves = _mm512_setr_epi64(0, 1, 8, 9, 4, 5, 12, 13);
+        const __m512i high_halves = _mm512_setr_epi64(2, 3, 10, 11, 6, 7, 14, 15);
+        __m512i t[8], u[8];
+        for (int32_t i = 0; i < 8; i += 2) {
+            t[i] = _mm512_unpacklo_epi32(reinterpret_cast<__m512i>(rows[i]), reinterpret_cast<__m512i>(rows[i + 1]));
+            t[i + 1] = _mm512_unpackhi_epi32(reinterpret_cast<__m512i>(rows[i]), reinterpret_cast<__m512i>(rows[i + 1]));
+        }
+        for (int32_t i = 0; i < 8; i += 4) {
+            u[i] = _mm512_unpacklo_epi64(t[i], t[i + 2]);
+            u[i + 1] = _mm512_unpackhi_epi64(t[i], t[i + 2]);
+            u[i + 2] = _mm512_unpacklo_epi64(t[i + 1], t[i + 3]);
+            u[i + 3] = _mm512_unpackhi_epi64(t[i + 1], t[i + 3]);
+        }
+        for (int32_t i = 0; i < 4; i++) {
+            rows[i] = reinterpret_cast<Vector>(_mm512_permutex2var_epi64(u[i], low_halves, u[i + 4]));
+            rows[i + 4] = reinterpret_cast<Vector>(_mm512_permutex2var_epi64(u[i], high_halves, u[i + 4]));
+        }
+    }
+
+    /**
+     * @brief Saturates the range limited rows of the two blocks to [0, 255] and stores them.
+     */
+    __attribute__((target("avx512f")))
+    static inline void StoreRows(const Vector rows[8], uint8_t *dst, uint32_t dst_stride_in_bytes) {
+        for (int32_t i = 0; i < 8; i++) {
+            __m512i clamped = _mm512_min_epi32(_mm512_max_epi32(reinterpret_cast<__m512i>(rows[i]), _mm512_setzero_si512()), _mm512_set1_epi32(255));
+            __m128i samples = _mm512_cvtepi32_epi8(clamped);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i * dst_stride_in_bytes), samples);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i * dst_stride_in_bytes + 8), _mm_unpackhi_epi64(samples, samples));
+        }
+    }
+};
+
+/**
+ * @brief Dequantizes Steps::kNumBlocks blocks of an 8-bit frame and writes their inverse DCT as 8-bit samples.
+ *
+ * This is DequantizeIdct8x8<int32_t> with each 1-D IDCT applied to all the columns (or rows) of the blocks at once:
+ * Idct1D runs on vectors of 32-bit lanes with the same wrapping arithmetic as the scalar kernel, and the blocks are
+ * transposed between the passes and before the store. The range limit of the scalar kernel wraps the value to 10 bits
+ * and clamps it; here the wrap maps the values that clamp to 0 below 0 and the store saturates them.
+ */
+template <typename Steps>
+static inline void DequantizeIdctBlocks(const int16_t *coefficients, const uint16_t *quantization_table, uint8_t *dst, uint32_t dst_stride_in_bytes) {
+    typedef typename Steps::Vector Vector;
+    const int32_t pass1_bits = 2;
+    Vector rows[8];
+    Vector out[8];
+
+    // pass 1: process the columns of all the rows at once
+    Steps::LoadDequantizedRows(coefficients, quantization_table, rows);
+    Idct1D<Vector>(rows[0], rows[1], rows[2], rows[3], rows[4], rows[5], rows[6], rows[7], out);
+    for (int32_t i = 0; i < 8; i++) {
+        rows[i] = (out[i] + (1 << (IDCT_CONST_BITS - pass1_bits - 1))) >> (IDCT_CONST_BITS - pass1_bits);
+    }
+
+    // pass 2: process the rows, which are the columns of the transposed blocks
+    Steps::Transpose(rows);
+    Idct1D<Vector>(rows[0], rows[1], rows[2], rows[3], rows[4], rows[5], rows[6], rows[7], out);
+    for (int32_t i = 0; i < 8; i++) {
+        Vector sample = (out[i] + (1 << (IDCT_CONST_BITS + pass1_bits + 3 - 1))) >> (IDCT_CONST_BITS + pass1_bits + 3);
+        out[i] = ((sample + 512) & 1023) - 384;
+    }
+    Steps::Transpose(out);
+    Steps::StoreRows(out, dst, dst_stride_in_bytes);
+}
+
+/**
+ * @brief AVX2 kernel for dequantizing a row of blocks of an 8-bit frame and writing their inverse DCT, one block per step.
+ */
+__attribute__((target("avx2"), flatten))
+static void DequantizeIdctRowAvx2(const int16_t *coefficients, const uint16_t *quantization_table, uint32_t num_blocks, uint8_t *dst,
+                                  uint32_t dst_stride_in_bytes) {
+    for (uint32_t x = 0; x < num_blocks; x++, coefficients += DCT_BLOCK_SIZE, dst += 8) {
+        DequantizeIdctBlocks<IdctStepsAvx2>(coefficients, quantization_table, dst, dst_stride_in_bytes);
+    }
+}
+
+/**
+ * @brief AVX-512 kernel for dequantizing a row of blocks of an 8-bit frame and writing their inverse DCT, two blocks per step.
+ */
+__attribute__((target("avx512f,avx2"), flatten))
+static void DequantizeIdctRowAvx512(const int16_t *coefficients, const uint16_t *quantization_table, uint32_t num_blocks, uint8_t *dst,
+                                    uint32_t dst_stride_in_bytes) {
+    uint32_t x = 0;
+    for (; x + 2 <= num_blocks; x += 2, coefficients += 2 * DCT_BLOCK_SIZE, dst += 16) {
+        DequantizeIdctBlocks<IdctStepsAvx512>(coefficients, quantization_table, dst, dst_stride_in_bytes);
+    }
+    if (x < num_blocks) {
+        DequantizeIdctBlocks<IdctStepsAvx2>(coefficients, quantization_table, dst, dst_stride_in_bytes);
+    }
+}
+#endif
+
+RocJpegCpuKernels::RocJpegCpuKernels() {
+    SelectKernels(kSimdAvx512);
+}
+
+RocJpegCpuKernels::RocJpegCpuKernels(SimdLevel max_simd_level) {
+    SelectKernels(max_simd_level);
+}
+
+/**
+ * @brief Selects the kernels of the highest SIMD level supported by the CPU, up to max_simd_level.
+ *
+ * The AVX2 and AVX-512 conversions also need the FMA instructions, so the fused multiply-adds round exactly like
+ * the scalar kernels. The AVX-512 level uses the AVX2 upsampling kernel, and the SSE2 level the scalar kernels.
+ *
+ * @param max_simd_level The highest SIMD level to be selected.
+ */
+void RocJpegCpuKernels::SelectKernels(SimdLevel max_simd_level) {
+    dequantize_idct_row_ = DequantizeIdctRowScalar;
+    upsample_row_ = UpsampleRowScalar;
+    ycbcr_to_rgb_row_ = YCbCrToRGBRowScalar;
+    ycbcr_to_rgb_planar_row_ = YCbCrToRGBPlanarRowScalar;
+    simd_level_ = kSimdScalar;
+#if ROCJPEG_X86_SIMD
+    SimdLevel simd_level = std::min(GetSimdLevel(), max_simd_level);
+    if (simd_level >= kSimdAvx2 && __builtin_cpu_supports("fma")) {
+        dequantize_idct_row_ = DequantizeIdctRowAvx2;
+        upsample_row_ = UpsampleRowAvx2;
+        ycbcr_to_rgb_row_ = YCbCrToRGBRowAvx2;
+        ycbcr_to_rgb_planar_row_ = YCbCrToRGBPlanarRowAvx2;
+        simd_level_ = kSimdAvx2;
+        if (simd_level >= kSimdAvx512) {
+            dequantize_idct_row_ = DequantizeIdctRowAvx512;
+            ycbcr_to_rgb_row_ = YCbCrToRGBRowAvx512;
+            ycbcr_to_rgb_planar_row_ = YCbCrToRGBPlanarRowAvx512;
+            simd_level_ = kSimdAvx512;
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Dequantizes the blocks of a color component and writes their inverse DCT to a plane.
+ *
+ * Each block is transformed by the islow IDCT shared with the GPU kernel, so the samples are bit-exact with the
+ * hybrid decoder and with the IJG libjpeg. The blocks of 8-bit frames written as 8-bit samples go through the
+ * selected SIMD kernel, a row of blocks at a time; the other cases use the scalar transform.
+ *
+ * @param coefficients The coefficients of the component, in raster order of the blocks.
+ * @param quantization_table The quantization table of the component, in natural order.
+ * @param sample_precision The number of bits of the samples of the frame (8 or 12).
+ * @param width_in_blocks The number of blocks per row of the component.
+ * @param height_in_blocks The number of block rows of the component.
+ * @param dst Pointer to the first sample of the destination plane.
+ * @param dst_stride_in_bytes The stride (in bytes) of the destination plane.
+ * @param dst_sample_size The size of a destination sample in bytes (1 or 2).
+ */
+void RocJpegCpuKernels::DequantizeIdctComponent(const int16_t *coefficients, const uint16_t *quantization_table, uint32_t sample_precision,
+                                                uint32_t width_in_blocks, uint32_t height_in_blocks, uint8_t *dst, uint32_t dst_stride_in_bytes,
+                                                uint32_t dst_sample_size) const {
+    for (uint32_t y = 0; y < height_in_blocks; y++) {
+        uint8_t *dst_block_row = dst + static_cast<size_t>(y) * 8 * dst_stride_in_bytes;
+        if (sample_precision == 8 && dst_sample_size == 1) {
+            dequantize_idct_row_(coefficients, quantization_table, width_in_blocks, dst_block_row, dst_stride_in_bytes);
+            coefficients += static_cast<size_t>(width_in_blocks) * DCT_BLOCK_SIZE;
+            continue;
+        }
+        for (uint32_t x = 0; x < width_in_blocks; x++, coefficients += DCT_BLOCK_SIZE) {
+            DequantizeIdctBlock(coefficients, quantization_table, sample_precision, dst_block_row + x * 8 * dst_sample_size, dst_stride_in_bytes,
+                                dst_sample_size, dst_sample_size);
+        }
+    }
+}
+
+/**
+ * @brief Dequantizes the blocks of a color component and writes their inverse DCT scaled down by 2^scale_shift to a plane.
+ *
+ * The reduced-size IDCTs compute the 4x4, 2x2, or 1x1 output of each block directly from its coefficients, which
+ * costs a fraction of the full IDCT and of its memory traffic; the samples are bit-exact with the scaled decoding of
+ * the IJG libjpeg.
+ *
+ * @param coefficients The coefficients of the component, in raster order of the blocks.
+ * @param quantization_table The quantization table of the component, in natural order.
+ * @param sample_precision The number of bits of the samples of the frame (8 or 12).
+ * @param scale_shift The scaling shift (0 to 3).
+ * @param width_in_blocks The number of blocks per row of the component.
+ * @param height_in_blocks The number of block rows of the component.
+ * @param dst Pointer to the first sample of the destination plane.
+ * @param dst_stride_in_bytes The stride (in bytes) of the destination plane.
+ * @param dst_sample_size The size of a destination sample in bytes (1 or 2).
+ */
+void RocJpegCpuKernels::DequantizeScaledIdctComponent(const int16_t *coefficients, const uint16_t *quantization_table, uint32_t sample_precision,
+                                                      uint32_t scale_shift, uint32_t width_in_blocks, uint32_t height_in_blocks, uint8_t *dst,
+                                                      uint32_t dst_stride_in_bytes, uint32_t dst_sample_size) const {
+    if (scale_shift == 0) {
+        DequantizeIdctComponent(coefficients, quantization_table, sample_precision, width_in_blocks, height_in_blocks, dst, dst_stride_in_bytes,
+                                dst_sample_size);
+        return;
+    }
+    uint32_t block_size = 8 >> scale_shift;
+    for (uint32_t y = 0; y < height_in_blocks; y++) {
+        uint8_t *dst_block_row = dst + static_cast<size_t>(y) * block_size * dst_stride_in_bytes;
+        for (uint32_t x = 0; x < width_in_blocks; x++, coefficients += DCT_BLOCK_SIZE) {
+            DequantizeScaledIdctBlock(coefficients, quantization_table, sample_precision, scale_shift, dst_block_row + x * block_size * dst_sample_size,
+                                      dst_stride_in_bytes, dst_sample_size);
+        }
+    }
+}
+
+/**
+ * @brief Dequantizes the DC coefficients of a color component and writes one sample per block to a plane.
+ *
+ * The sample of a block is its 1x1 inverse DCT, which is the same as the 1/8 scaled decoding, but the coefficients
+ * are laid out one per block by the DC-only entropy decoding.
+ *
+ * @param dc_coefficients The DC coefficients of the component, in raster order of the blocks.
+ * @param quantization_table The quantization table of the component, in natural order.
+ * @param sample_precision The number of bits of the samples of the frame (8 or 12).
+ * @param width_in_blocks The number of blocks per row of the component.
+ * @param height_in_blocks The number of block rows of the component.
+ * @param dst Pointer to the first sample of the destination plane.
+ * @param dst_stride_in_bytes The stride (in bytes) of the destination plane.
+ * @param dst_sample_size The size of a destination sample in bytes (1 or 2).
+ */
+void RocJpegCpuKernels::DequantizeDcComponent(const int16_t *dc_coefficients, const uint16_t *quantization_table, uint32_t sample_precision,
+                                              uint32_t width_in_blocks, uint32_t height_in_blocks, uint8_t *dst, uint32_t dst_stride_in_bytes,
+                                              uint32_t dst_sample_size) const {
+    for (uint32_t y = 0; y < height_in_blocks; y++) {
+        uint8_t *dst_row = dst + static_cast<size_t>(y) * dst_stride_in_bytes;
+        for (uint32_t x = 0; x < width_in_blocks; x++, dc_coefficients++) {
+            DequantizeScaledIdctBlock(dc_coefficients, quantization_table, sample_precision, 3, dst_row + x * dst_sample_size, dst_stride_in_bytes,
+                                      dst_sample_size);
+        }
+    }
+}
+
+/**
+ * @brief Maps the destination samples of a resize to the two nearest source samples and the weight of the second one.
+ *
+ * The sample centers are aligned (the source coordinate of destination sample i is (i + 0.5) * src_size / dst_size - 0.5),
+ * and the coordinates are clamped to the edges of the source.
+ */
+static void GetResizeTaps(uint32_t src_size, uint32_t dst_size, std::vector<uint32_t> &index, std::vector<uint32_t> &weight) {
+    index.resize(dst_size);
+    weight.resize(dst_size);
+    int64_t max_position = static_cast<int64_t>(src_size - 1) << RESIZE_WEIGHT_BITS;
+    for (uint32_t i = 0; i < dst_size; i++) {
+        int64_t position = ((static_cast<int64_t>(2 * i + 1) * src_size - dst_size) << RESIZE_WEIGHT_BITS) / (2 * static_cast<int64_t>(dst_size));
+        position = std::min(std::max<int64_t>(position, 0), max_position);
+        index[i] = static_cast<uint32_t>(position >> RESIZE_WEIGHT_BITS);
+        weight[i] = static_cast<uint32_t>(position & ((1 << RESIZE_WEIGHT_BITS) - 1));
+    }
+}
+
+template <typename T>
+static void ResizePlaneBilinear(const uint8_t *src, uint32_t src_pitch, uint32_t src_width, uint32_t src_height, uint8_t *dst, uint32_t dst_pitch,
+                                uint32_t dst_width, uint32_t dst_height) {
+    std::vector<uint32_t> x_index, x_weight, y_index, y_weight;
+    GetResizeTaps(src_width, dst_width, x_index, x_weight);
+    GetResizeTaps(src_height, dst_height, y_index, y_weight);
+    const uint32_t one = 1 << RESIZE_WEIGHT_BITS;
+    const uint32_t rounding = 1 << (2 * RESIZE_WEIGHT_BITS - 1);
+    for (uint32_t y = 0; y < dst_height; y++) {
+        const T *row0 = reinterpret_cast<const T*>(src + static_cast<size_t>(y_index[y]) * src_pitch);
+        const T *row1 = reinterpret_cast<const T*>(src + static_cast<size_t>(std::min(y_index[y] + 1, src_height - 1)) * src_pitch);
+        uint32_t wy = y_weight[y];
+        T *dst_row = reinterpret_cast<T*>(dst + static_cast<size_t>(y) * dst_pitch);
+        for (uint32_t x = 0; x < dst_width; x++) {
+            uint32_t x0 = x_index[x];
+            uint32_t x1 = std::min(x0 + 1, src_width - 1);
+            uint32_t wx = x_weight[x];
+            uint32_t top = row0[x0] * (one - wx) + row0[x1] * wx;
+            uint32_t bottom = row1[x0] * (one - wx) + row1[x1] * wx;
+            dst_row[x] = static_cast<T>((top * (one - wy) + bottom * wy + rounding) >> (2 * RESIZE_WEIGHT_BITS));
+        }
+    }
+}
+
+/**
+ * @brief Resizes a plane of 8-bit or 16-bit samples with bilinear interpolation.
+ *
+ * This finishes a scaled decode: the reduced-size IDCT brings the plane within a factor of two of the target size
+ * (down to 1/16 of the decoded size), and every destination sample is interpolated from the 2x2 nearest source samples.
+ *
+ * @param src Pointer to the first sample of the source plane.
+ * @param src_pitch The stride (in bytes) of the source plane.
+ * @param src_width The width of the source plane in samples.
+ * @param src_height The height of the source plane in samples.
+ * @param sample_size The size of a sample in bytes (1 or 2).
+ * @param dst Pointer to the first sample of the destination plane.
+ * @param dst_pitch The stride (in bytes) of the destination plane.
+ * @param dst_width The width of the destination plane in samples.
+ * @param dst_height The height of the destination plane in samples.
+ */
+void RocJpegCpuKernels::ResizePlane(const uint8_t *src, uint32_t src_pitch, uint32_t src_width, uint32_t src_height, uint32_t sample_size, uint8_t *dst,
+                                    uint32_t dst_pitch, uint32_t dst_width, uint32_t dst_height) const {
+    if (sample_size == sizeof(uint16_t)) {
+        ResizePlaneBilinear<uint16_t>(src, src_pitch, src_width, src_height, dst, dst_pitch, dst_width, dst_height);
+    } else {
+        ResizePlaneBilinear<uint8_t>(src, src_pitch, src_width, src_height, dst, dst_pitch, dst_width, dst_height);
+    }
+}
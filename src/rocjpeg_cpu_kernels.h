@@ -0,0 +1,180 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#ifndef ROC_JPEG_CPU_KERNELS_H_
+#define ROC_JPEG_CPU_KERNELS_H_
+
+#pragma once
+
+#include <stdint.h>
+#include "rocjpeg_idct.h"
+#include "rocjpeg_simd_dispatch.h"
+
+#define RESIZE_WEIGHT_BITS 7 // the fractional bits of the bilinear weights of ResizePlane, which keep the 16-bit sums in 32 bits
+
+/**
+ * @class RocJpegCpuKernels
+ * @brief A class holding the row kernels of the CPU backend.
+ *
+ * The chroma upsampling and the YCbCr to RGB conversion are vectorized with AVX2 (16 pixels per step) and AVX-512
+ * (16 pixels per 512-bit register), and the kernels are selected at runtime based on the CPU features, with a
+ * scalar fallback. Every kernel computes the same arithmetic as the color conversion kernels of the GPU: nearest
+ * neighbor chroma upsampling, the BT.709 coefficients applied with fused multiply-adds, and rounding to the nearest
+ * even sample, so the output of every SIMD level is identical to the scalar output and to the GPU output.
+ *
+ * The dequantization and the islow IDCT of 8-bit frames are vectorized the same way, one block per AVX2 register
+ * set and two blocks per AVX-512 register set, with the 32-bit integer arithmetic of the scalar IDCT, so their
+ * samples are bit-exact with the scalar kernel and with libjpeg.
+ */
+class RocJpegCpuKernels {
+    public:
+        /**
+         * @brief Constructs a RocJpegCpuKernels object and selects the kernels for the current CPU.
+         */
+        RocJpegCpuKernels();
+
+        /**
+         * @brief Constructs a RocJpegCpuKernels object with kernels of at most the given SIMD level.
+         * @param max_simd_level The highest SIMD level to be selected; the level is also limited by GetSimdLevel().
+         */
+        explicit RocJpegCpuKernels(SimdLevel max_simd_level);
+
+        /**
+         * @brief Dequantizes the blocks of a color component and writes their inverse DCT to a plane.
+         * @param coefficients The coefficients of the component, 64 per block in natural order, in raster order of the blocks.
+         * @param quantization_table The quantization table of the component, in natural order.
+         * @param sample_precision The number of bits of the samples of the frame (8 or 12).
+         * @param width_in_blocks The number of blocks per row of the component.
+         * @param height_in_blocks The number of block rows of the component.
+         * @param dst Pointer to the first sample of the destination plane.
+         * @param dst_stride_in_bytes The stride (in bytes) of the destination plane.
+         * @param dst_sample_size The size of a destination sample in bytes (1 or 2); one-byte samples of a 12-bit frame are scaled to 8 bits.
+         */
+        void DequantizeIdctComponent(const int16_t *coefficients, const uint16_t *quantization_table, uint32_t sample_precision, uint32_t width_in_blocks,
+                                     uint32_t height_in_blocks, uint8_t *dst, uint32_t dst_stride_in_bytes, uint32_t dst_sample_size) const;
+
+        /**
+         * @brief Dequantizes the blocks of a color component and writes their inverse DCT scaled down by 2^scale_shift to a plane.
+         * @param coefficients The coefficients of the component, 64 per block in natural order, in raster order of the blocks.
+         * @param quantization_table The quantization table of the component, in natural order.
+         * @param sample_precision The number of bits of the samples of the frame (8 or 12).
+         * @param scale_shift The scaling shift (0 to 3); each block is written as (8 >> scale_shift) x (8 >> scale_shift) samples.
+         * @param width_in_blocks The number of blocks per row of the component.
+         * @param height_in_blocks The number of block rows of the component.
+         * @param dst Pointer to the first sample of the destination plane.
+         * @param dst_stride_in_bytes The stride (in bytes) of the destination plane.
+         * @param dst_sample_size The size of a destination sample in bytes (1 or 2); one-byte samples of a 12-bit frame are scaled to 8 bits.
+         */
+        void DequantizeScaledIdctComponent(const int16_t *coefficients, const uint16_t *quantization_table, uint32_t sample_precision, uint32_t scale_shift,
+                                           uint32_t width_in_blocks, uint32_t height_in_blocks, uint8_t *dst, uint32_t dst_stride_in_bytes,
+                                           uint32_t dst_sample_size) const;
+
+        /**
+         * @brief Dequantizes the DC coefficients of a color component and writes one sample per block to a plane.
+         * @param dc_coefficients The DC coefficients of the component, one per block, in raster order of the blocks.
+         * @param quantization_table The quantization table of the component, in natural order.
+         * @param sample_precision The number of bits of the samples of the frame (8 or 12).
+         * @param width_in_blocks The number of blocks per row of the component.
+         * @param height_in_blocks The number of block rows of the component.
+         * @param dst Pointer to the first sample of the destination plane.
+         * @param dst_stride_in_bytes The stride (in bytes) of the destination plane.
+         * @param dst_sample_size The size of a destination sample in bytes (1 or 2); one-byte samples of a 12-bit frame are scaled to 8 bits.
+         */
+        void DequantizeDcComponent(const int16_t *dc_coefficients, const uint16_t *quantization_table, uint32_t sample_precision, uint32_t width_in_blocks,
+                                   uint32_t height_in_blocks, uint8_t *dst, uint32_t dst_stride_in_bytes, uint32_t dst_sample_size) const;
+
+        /**
+         * @brief Resizes a plane of 8-bit or 16-bit samples with bilinear interpolation.
+         * @param src Pointer to the first sample of the source plane.
+         * @param src_pitch The stride (in bytes) of the source plane.
+         * @param src_width The width of the source plane in samples.
+         * @param src_height The height of the source plane in samples.
+         * @param sample_size The size of a sample in bytes (1 or 2).
+         * @param dst Pointer to the first sample of the destination plane.
+         * @param dst_pitch The stride (in bytes) of the destination plane.
+         * @param dst_width The width of the destination plane in samples.
+         * @param dst_height The height of the destination plane in samples.
+         */
+        void ResizePlane(const uint8_t *src, uint32_t src_pitch, uint32_t src_width, uint32_t src_height, uint32_t sample_size, uint8_t *dst,
+                         uint32_t dst_pitch, uint32_t dst_width, uint32_t dst_height) const;
+
+        /**
+         * @brief Upsamples a row of chroma samples horizontally by repeating each sample 2^shift_x times.
+         * @param src Pointer to the first source sample.
+         * @param shift_x The horizontal subsampling shift of the source row (1 or 2 are vectorized).
+         * @param width The number of destination samples.
+         * @param dst Pointer to the destination row.
+         */
+        void UpsampleRow(const uint8_t *src, uint32_t shift_x, uint32_t width, uint8_t *dst) const { upsample_row_(src, shift_x, width, dst); }
+
+        /**
+         * @brief Converts a row of full-resolution Y, Cb, and Cr samples to interleaved RGB.
+         * @param y Pointer to the luma samples.
+         * @param cb Pointer to the Cb samples.
+         * @param cr Pointer to the Cr samples.
+         * @param width The number of pixels.
+         * @param dst_rgb Pointer to the destination row (3 bytes per pixel).
+         */
+        void ConvertYCbCrToRGBRow(const uint8_t *y, const uint8_t *cb, const uint8_t *cr, uint32_t width, uint8_t *dst_rgb) const {
+            ycbcr_to_rgb_row_(y, cb, cr, width, dst_rgb);
+        }
+
+        /**
+         * @brief Converts a row of full-resolution Y, Cb, and Cr samples to planar RGB.
+         * @param y Pointer to the luma samples.
+         * @param cb Pointer to the Cb samples.
+         * @param cr Pointer to the Cr samples.
+         * @param width The number of pixels.
+         * @param dst_r Pointer to the destination red row.
+         * @param dst_g Pointer to the destination green row.
+         * @param dst_b Pointer to the destination blue row.
+         */
+        void ConvertYCbCrToRGBPlanarRow(const uint8_t *y, const uint8_t *cb, const uint8_t *cr, uint32_t width, uint8_t *dst_r, uint8_t *dst_g, uint8_t *dst_b) const {
+            ycbcr_to_rgb_planar_row_(y, cb, cr, width, dst_r, dst_g, dst_b);
+        }
+
+        /**
+         * @brief Returns the SIMD level of the selected kernels.
+         * @return The SIMD level.
+         */
+        SimdLevel GetKernelSimdLevel() const { return simd_level_; }
+
+    private:
+        /**
+         * @brief Selects the kernels of the highest SIMD level supported by the CPU, up to max_simd_level.
+         */
+        void SelectKernels(SimdLevel max_simd_level);
+
+        typedef void (*DequantizeIdctRowFunc)(const int16_t *coefficients, const uint16_t *quantization_table, uint32_t num_blocks, uint8_t *dst,
+                                              uint32_t dst_stride_in_bytes);
+        typedef void (*UpsampleRowFunc)(const uint8_t *src, uint32_t shift_x, uint32_t width, uint8_t *dst);
+        typedef void (*YCbCrToRGBRowFunc)(const uint8_t *y, const uint8_t *cb, const uint8_t *cr, uint32_t width, uint8_t *dst_rgb);
+        typedef void (*YCbCrToRGBPlanarRowFunc)(const uint8_t *y, const uint8_t *cb, const uint8_t *cr, uint32_t width, uint8_t *dst_r, uint8_t *dst_g, uint8_t *dst_b);
+        DequantizeIdctRowFunc dequantize_idct_row_; ///< The selected kernel transforming a row of blocks of an 8-bit frame to 8-bit samples.
+        UpsampleRowFunc upsample_row_; ///< The selected chroma upsampling kernel.
+        YCbCrToRGBRowFunc ycbcr_to_rgb_row_; ///< The selected kernel converting to interleaved RGB.
+        YCbCrToRGBPlanarRowFunc ycbcr_to_rgb_planar_row_; ///< The selected kernel converting to planar RGB.
+        SimdLevel simd_level_; ///< The SIMD level of the selected kernels.
+};
+
+#endif  // ROC_JPEG_CPU_KERNELS_H_
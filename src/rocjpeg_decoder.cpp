@@ -23,9 +23,14 @@ THE SOFTWARE.
 #include "rocjpeg_decoder.h"
 
 RocJpegDecoder::RocJpegDecoder(RocJpegBackend backend, int device_id) :
-    num_devices_{0}, device_id_ {device_id}, hip_stream_ {0}, backend_{backend} {}
+    num_devices_{0}, device_id_ {device_id}, hip_stream_ {0}, backend_{backend}, route_stats_{} {}
 
 RocJpegDecoder::~RocJpegDecoder() {
+    for (uint8_t *staging_buffer : cpu_staging_buffers_) {
+        if (staging_buffer) {
+            hipError_t hip_status = hipHostFree(staging_buffer);
+        }
+    }
     if (hip_stream_) {
         hipError_t hip_status = hipStreamDestroy(hip_stream_);
     }
@@ -64,8 +69,10 @@ RocJpegStatus RocJpegDecoder::InitHIP(int device_id) {
  * @brief Initializes the RocJpegDecoder.
  *
  * This function initializes the RocJpegDecoder by performing the following steps:
- * 1. Initializes the HIP device.
- * 2. If the backend is ROCJPEG_BACKEND_HARDWARE, initializes the VA-API JPEG decoder.
+ * 1. Initializes the HIP device, except for the ROCJPEG_BACKEND_CPU backend, which doesn't use the GPU.
+ * 2. If the backend is ROCJPEG_BACKEND_HARDWARE, initializes the VA-API JPEG decoder. The ROCJPEG_BACKEND_HYBRID
+ *    backend decodes every stream with the hybrid decoder, which only needs the HIP device. The ROCJPEG_BACKEND_CPU
+ *    backend creates one CPU decoder per thread of the thread pool.
  *
  * @return The status of the initialization process.
  *         - ROCJPEG_STATUS_SUCCESS if the initialization is successful.
@@ -73,6 +80,10 @@ RocJpegStatus RocJpegDecoder::InitHIP(int device_id) {
  */
 RocJpegStatus RocJpegDecoder::InitializeDecoder() {
     RocJpegStatus rocjpeg_status = ROCJPEG_STATUS_SUCCESS;
+    if (backend_ == ROCJPEG_BACKEND_CPU) {
+        cpu_decoders_.resize(RocJpegThreadPool::GetInstance().GetNumThreads());
+        return rocjpeg_status;
+    }
     rocjpeg_status = InitHIP(device_id_);
     if (rocjpeg_status != ROCJPEG_STATUS_SUCCESS) {
         ERR("ERROR: Failed to initilize the HIP!");
@@ -84,8 +95,9 @@ RocJpegStatus RocJpegDecoder::InitializeDecoder() {
             ERR("ERROR: Failed to initialize the VA-API JPEG decoder!");
             return rocjpeg_status;
         }
-    } else if (backend_ == ROCJPEG_BACKEND_HYBRID) {
-        return ROCJPEG_STATUS_NOT_IMPLEMENTED;
+    } else if (backend_ != ROCJPEG_BACKEND_HYBRID) {
+        ERR("ERROR: the requested backend is not supported!");
+        return ROCJPEG_STATUS_INVALID_PARAMETER;
     }
     return rocjpeg_status;
 }
@@ -110,13 +122,402 @@ RocJpegStatus RocJpegDecoder::Decode(RocJpegStreamHandle jpeg_stream_handle, con
     auto rocjpeg_stream_handle = static_cast<RocJpegStreamParserHandle*>(jpeg_stream_handle);
     const JpegStreamParameters *jpeg_stream_params = rocjpeg_stream_handle->rocjpeg_stream->GetJpegStreamParameters();
 
-    VASurfaceID current_surface_id;
-    CHECK_ROCJPEG(jpeg_vaapi_decoder_.SubmitDecode(jpeg_stream_params, current_surface_id, decode_params));
+    uint8_t orientation;
+    CHECK_ROCJPEG(GetOutputOrientation(decode_params, jpeg_stream_params, orientation));
+
+    if (backend_ == ROCJPEG_BACKEND_CPU) {
+        CHECK_ROCJPEG(cpu_decoders_[0].Decode(jpeg_stream_params, decode_params, orientation, destination));
+        route_stats_.num_cpu_decodes++;
+        return ROCJPEG_STATUS_SUCCESS;
+    }
+    HipInteropDeviceMem hip_interop_dev_mem = {};
+    DecodeRoute decode_route = GetDecodeRoute(jpeg_stream_params, decode_params);
+    if (decode_route == kDecodeRouteCpu) {
+        int stream_index = 0;
+        CHECK_ROCJPEG(DecodeCpuSubBatch(&jpeg_stream_handle, &stream_index, 1, decode_params, destination));
+    } else if (decode_route == kDecodeRouteHybrid) {
+        CHECK_ROCJPEG(hybrid_decoder_.DecodeToSurface(jpeg_stream_params, Is16BitOutputFormat(decode_params->output_format), decode_params->dc_only, hip_stream_,
+                                                      hip_interop_dev_mem));
+        CHECK_ROCJPEG(OutputDecodedPicture(hip_interop_dev_mem, jpeg_stream_params, decode_params, false, orientation, destination));
+        route_stats_.num_hybrid_decodes++;
+    } else {
+        VASurfaceID current_surface_id;
+        CHECK_ROCJPEG(jpeg_vaapi_decoder_.SubmitDecode(jpeg_stream_params, current_surface_id, decode_params));
+        // the surface goes back to the pool even if the picture can't be output
+        rocjpeg_status = jpeg_vaapi_decoder_.SyncSurface(current_surface_id);
+        if (rocjpeg_status == ROCJPEG_STATUS_SUCCESS) {
+            rocjpeg_status = OutputHardwareDecodedPicture(current_surface_id, jpeg_stream_params, decode_params, destination);
+        }
+        CHECK_ROCJPEG(jpeg_vaapi_decoder_.SetSurfaceAsIdle(current_surface_id));
+        if (rocjpeg_status != ROCJPEG_STATUS_SUCCESS) {
+            return rocjpeg_status;
+        }
+    }
+    CHECK_HIP(hipStreamSynchronize(hip_stream_));
+    return ROCJPEG_STATUS_SUCCESS;
+}
+
+/**
+ * Decodes a batch of JPEG streams using the specified decode parameters and stores the decoded images in the provided destinations.
+ *
+ * Each stream is routed to the VCN JPEG decoder, the hybrid decoder, or the CPU decoder by GetDecodeRoute(), so the
+ * streams the VCN can't decode don't fail the batch. The VCN decodes the hardware streams by sub-batches of one
+ * stream per JPEG core; while a sub-batch is being decoded, the thread pool decodes a sub-batch of the hybrid or CPU
+ * streams, and every image is written to its own entry of the destinations. An image that fails to decode doesn't
+ * stop the batch: the other images are still decoded, every VA surface of a submitted sub-batch is synced and
+ * returned to the pool, and the status of the first failure is returned.
+ *
+ * @param jpeg_streams An array of RocJpegStreamHandle objects representing the JPEG streams to be decoded.
+ * @param batch_size The number of JPEG streams in the batch.
+ * @param decode_params A pointer to RocJpegDecodeParams object containing the decode parameters.
+ * @param destinations An array of RocJpegImage objects where the decoded images will be stored.
+ * @return A RocJpegStatus value indicating the success or failure of the decoding operation.
+ */
+RocJpegStatus RocJpegDecoder::DecodeBatched(RocJpegStreamHandle *jpeg_streams, int batch_size, const RocJpegDecodeParams *decode_params, RocJpegImage *destinations) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (jpeg_streams == nullptr || decode_params == nullptr || destinations == nullptr) {
+        return ROCJPEG_STATUS_INVALID_PARAMETER;
+    }
+    if (backend_ == ROCJPEG_BACKEND_CPU) {
+        return DecodeBatchedOnCpu(jpeg_streams, batch_size, decode_params, destinations);
+    }
+    std::vector<VASurfaceID> current_surface_ids;
+    std::vector<const JpegStreamParameters*> jpeg_streams_params;
+    std::vector<int> hardware_indices;
+    std::vector<int> hybrid_indices;
+    std::vector<int> cpu_indices;
+    hardware_indices.reserve(batch_size);
+    hybrid_indices.reserve(batch_size);
+    VcnJpegSpec current_vcn_jpeg_spec = jpeg_vaapi_decoder_.GetCurrentVcnJpegSpec();
+    RocJpegStatus batch_status = ROCJPEG_STATUS_SUCCESS;
+
+    for (int i = 0; i < batch_size; i++) {
+        auto rocjpeg_stream_handle = static_cast<RocJpegStreamParserHandle*>(jpeg_streams[i]);
+        const JpegStreamParameters *jpeg_stream_params = rocjpeg_stream_handle->rocjpeg_stream->GetJpegStreamParameters();
+        uint8_t orientation;
+        RocJpegStatus rocjpeg_status = GetOutputOrientation(decode_params, jpeg_stream_params, orientation);
+        if (rocjpeg_status != ROCJPEG_STATUS_SUCCESS) {
+            UpdateBatchStatus(rocjpeg_status, batch_status);
+            continue;
+        }
+        switch (GetDecodeRoute(jpeg_stream_params, decode_params)) {
+            case kDecodeRouteCpu:
+                cpu_indices.push_back(i);
+                break;
+            case kDecodeRouteHybrid:
+                hybrid_indices.push_back(i);
+                break;
+            default:
+                hardware_indices.push_back(i);
+                jpeg_streams_params.push_back(jpeg_stream_params);
+                break;
+        }
+    }
+
+    int num_hardware_streams = static_cast<int>(hardware_indices.size());
+    int num_hybrid_streams = static_cast<int>(hybrid_indices.size());
+    int num_cpu_streams = static_cast<int>(cpu_indices.size());
+    int software_batch_size = RocJpegThreadPool::GetInstance().GetNumThreads();
+    int hardware_pos = 0;
+    int hybrid_pos = 0;
+    int cpu_pos = 0;
+    current_surface_ids.assign(num_hardware_streams, VA_INVALID_SURFACE);
+    while (hardware_pos < num_hardware_streams || hybrid_pos < num_hybrid_streams || cpu_pos < num_cpu_streams) {
+        int hardware_end = std::min(hardware_pos + static_cast<int>(current_vcn_jpeg_spec.num_jpeg_cores), num_hardware_streams);
+        bool is_submitted = false;
+        if (hardware_pos < hardware_end) {
+            RocJpegStatus rocjpeg_status = jpeg_vaapi_decoder_.SubmitDecodeBatched(jpeg_streams_params.data() + hardware_pos, hardware_end - hardware_pos,
+                                                                                   decode_params, current_surface_ids.data() + hardware_pos);
+            is_submitted = rocjpeg_status == ROCJPEG_STATUS_SUCCESS;
+            UpdateBatchStatus(rocjpeg_status, batch_status);
+        }
+
+        // the thread pool decodes a sub-batch of the other routes while the VCN decodes the hardware sub-batch
+        if (hybrid_pos < num_hybrid_streams) {
+            int count = std::min(software_batch_size, num_hybrid_streams - hybrid_pos);
+            UpdateBatchStatus(DecodeHybridSubBatch(jpeg_streams, hybrid_indices.data() + hybrid_pos, count, decode_params, destinations), batch_status);
+            hybrid_pos += count;
+        } else if (cpu_pos < num_cpu_streams) {
+            int count = std::min(software_batch_size, num_cpu_streams - cpu_pos);
+            UpdateBatchStatus(DecodeCpuSubBatch(jpeg_streams, cpu_indices.data() + cpu_pos, count, decode_params, destinations), batch_status);
+            cpu_pos += count;
+        }
+
+        // every surface the sub-batch took from the pool is synced and returned to it, even if its picture can't be output
+        for (int k = hardware_pos; k < hardware_end; k++) {
+            VASurfaceID current_surface_id = current_surface_ids[k];
+            if (current_surface_id == VA_INVALID_SURFACE) {
+                continue;
+            }
+            RocJpegStatus rocjpeg_status = jpeg_vaapi_decoder_.SyncSurface(current_surface_id);
+            if (rocjpeg_status == ROCJPEG_STATUS_SUCCESS && is_submitted) {
+                rocjpeg_status = OutputHardwareDecodedPicture(current_surface_id, jpeg_streams_params[k], decode_params, &destinations[hardware_indices[k]]);
+            }
+            UpdateBatchStatus(rocjpeg_status, batch_status);
+            UpdateBatchStatus(jpeg_vaapi_decoder_.SetSurfaceAsIdle(current_surface_id), batch_status);
+        }
+        hardware_pos = hardware_end;
+    }
 
+    CHECK_HIP(hipStreamSynchronize(hip_stream_));
+    return batch_status;
+}
+
+/**
+ * @brief Writes a picture decoded by the VCN JPEG decoder to its destination.
+ *
+ * @param surface_id The synced VA surface holding the decoded picture.
+ * @param jpeg_stream_params The parsed JPEG stream parameters.
+ * @param decode_params The decode parameters for the JPEG image.
+ * @param destination The destination buffer to store the decoded image.
+ * @return The status of the operation.
+ */
+RocJpegStatus RocJpegDecoder::OutputHardwareDecodedPicture(VASurfaceID surface_id, const JpegStreamParameters *jpeg_stream_params,
+                                                           const RocJpegDecodeParams *decode_params, RocJpegImage *destination) {
     HipInteropDeviceMem hip_interop_dev_mem = {};
-    CHECK_ROCJPEG(jpeg_vaapi_decoder_.SyncSurface(current_surface_id));
-    CHECK_ROCJPEG(jpeg_vaapi_decoder_.GetHipInteropMem(current_surface_id, hip_interop_dev_mem));
+    uint8_t orientation;
+    CHECK_ROCJPEG(GetOutputOrientation(decode_params, jpeg_stream_params, orientation));
+    CHECK_ROCJPEG(jpeg_vaapi_decoder_.GetHipInteropMem(surface_id, hip_interop_dev_mem));
+    CHECK_ROCJPEG(OutputDecodedPicture(hip_interop_dev_mem, jpeg_stream_params, decode_params, jpeg_vaapi_decoder_.GetCurrentVcnJpegSpec().can_roi_decode,
+                                       orientation, destination));
+    CountHardwareDecode(jpeg_stream_params);
+    return ROCJPEG_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Keeps the status of the first image of a batch that failed to decode.
+ *
+ * @param rocjpeg_status The status of an image or a sub-batch.
+ * @param batch_status The status of the batch, updated if it is still ROCJPEG_STATUS_SUCCESS.
+ */
+void RocJpegDecoder::UpdateBatchStatus(RocJpegStatus rocjpeg_status, RocJpegStatus &batch_status) {
+    if (batch_status == ROCJPEG_STATUS_SUCCESS) {
+        batch_status = rocjpeg_status;
+    }
+}
+
+/**
+ * @brief Decodes a sub-batch of the streams routed to the hybrid decoder.
+ *
+ * The streams are entropy decoded in parallel, one stream per thread of the pool, and the IDCT of the whole
+ * sub-batch runs in a single kernel launch before each picture is written to its destination.
+ *
+ * @param jpeg_streams The JPEG stream handles of the batch.
+ * @param indices The indices in the batch of the streams to decode.
+ * @param count The number of streams to decode, at most the number of threads of the pool.
+ * @param decode_params The decoding parameters.
+ * @param destinations The destination images of the batch.
+ * @return The status of the decoding operation.
+ */
+RocJpegStatus RocJpegDecoder::DecodeHybridSubBatch(RocJpegStreamHandle *jpeg_streams, const int *indices, int count, const RocJpegDecodeParams *decode_params,
+                                                   RocJpegImage *destinations) {
+    std::vector<const JpegStreamParameters*> hybrid_stream_params(count);
+    std::vector<HipInteropDeviceMem> hybrid_surfaces(count);
+    for (int k = 0; k < count; k++) {
+        auto rocjpeg_stream_handle = static_cast<RocJpegStreamParserHandle*>(jpeg_streams[indices[k]]);
+        hybrid_stream_params[k] = rocjpeg_stream_handle->rocjpeg_stream->GetJpegStreamParameters();
+    }
+    RocJpegStatus sub_batch_status = hybrid_decoder_.DecodeBatchToSurfaces(hybrid_stream_params.data(), count,
+                                                                           Is16BitOutputFormat(decode_params->output_format), decode_params->dc_only,
+                                                                           hip_stream_, hybrid_surfaces.data());
+    if (sub_batch_status != ROCJPEG_STATUS_SUCCESS) {
+        if (count == 1) {
+            return sub_batch_status;
+        }
+        // decode the streams one by one, so that a corrupt stream only fails its own image
+        sub_batch_status = ROCJPEG_STATUS_SUCCESS;
+        for (int k = 0; k < count; k++) {
+            UpdateBatchStatus(DecodeHybridSubBatch(jpeg_streams, indices + k, 1, decode_params, destinations), sub_batch_status);
+        }
+        return sub_batch_status;
+    }
+    for (int k = 0; k < count; k++) {
+        auto rocjpeg_stream_handle = static_cast<RocJpegStreamParserHandle*>(jpeg_streams[indices[k]]);
+        const JpegStreamParameters *jpeg_stream_params = rocjpeg_stream_handle->rocjpeg_stream->GetJpegStreamParameters();
+        uint8_t orientation;
+        RocJpegStatus rocjpeg_status = GetOutputOrientation(decode_params, jpeg_stream_params, orientation);
+        if (rocjpeg_status == ROCJPEG_STATUS_SUCCESS) {
+            rocjpeg_status = OutputDecodedPicture(hybrid_surfaces[k], jpeg_stream_params, decode_params, false, orientation, &destinations[indices[k]]);
+        }
+        if (rocjpeg_status != ROCJPEG_STATUS_SUCCESS) {
+            UpdateBatchStatus(rocjpeg_status, sub_batch_status);
+            continue;
+        }
+        route_stats_.num_hybrid_decodes++;
+    }
+    return sub_batch_status;
+}
+
+/**
+ * @brief Decodes a sub-batch of the streams routed to the CPU by the hardware and hybrid backends.
+ *
+ * Each thread of the pool decodes one stream with its own CPU decoder into a pinned staging image that has the
+ * pitches of the destination, and the rows written by the decoder are then copied to the destination in device
+ * memory on the HIP stream. The staging images are sized for the largest dimension of the (cropped or preview)
+ * picture, which bounds the height of every channel in any orientation.
+ *
+ * @param jpeg_streams The JPEG stream handles of the batch.
+ * @param indices The indices in the batch of the streams to decode.
+ * @param count The number of streams to decode, at most the number of threads of the pool.
+ * @param decode_params The decoding parameters.
+ * @param destinations The destination images of the batch, in device memory.
+ * @return The status of the decoding operation.
+ */
+RocJpegStatus RocJpegDecoder::DecodeCpuSubBatch(RocJpegStreamHandle *jpeg_streams, const int *indices, int count, const RocJpegDecodeParams *decode_params,
+                                                RocJpegImage *destinations) {
+    if (static_cast<int>(cpu_decoders_.size()) < count) {
+        cpu_decoders_.resize(count);
+    }
+    if (static_cast<int>(cpu_staging_buffers_.size()) < count) {
+        cpu_staging_buffers_.resize(count, nullptr);
+        cpu_staging_buffer_sizes_.resize(count, 0);
+    }
+    // the copies of the previous sub-batch may still read the staging buffers
+    CHECK_HIP(hipStreamSynchronize(hip_stream_));
 
+    std::vector<RocJpegImage> staging_images(count);
+    std::vector<uint8_t> orientations(count);
+    std::vector<RocJpegStatus> statuses(count);
+    for (int k = 0; k < count; k++) {
+        auto rocjpeg_stream_handle = static_cast<RocJpegStreamParserHandle*>(jpeg_streams[indices[k]]);
+        const JpegStreamParameters *jpeg_stream_params = rocjpeg_stream_handle->rocjpeg_stream->GetJpegStreamParameters();
+        const PictureParameterBuffer &picture_parameter_buffer = jpeg_stream_params->picture_parameter_buffer;
+        CHECK_ROCJPEG(GetOutputOrientation(decode_params, jpeg_stream_params, orientations[k]));
+
+        uint32_t picture_width = picture_parameter_buffer.picture_width;
+        uint32_t picture_height = picture_parameter_buffer.picture_height;
+        uint32_t roi_width = decode_params->crop_rectangle.right - decode_params->crop_rectangle.left;
+        uint32_t roi_height = decode_params->crop_rectangle.bottom - decode_params->crop_rectangle.top;
+        if (roi_width > 0 && roi_height > 0 && roi_width <= picture_width && roi_height <= picture_height) {
+            picture_width = roi_width;
+            picture_height = roi_height;
+        }
+        if (decode_params->dc_only) {
+            picture_width = (picture_width + 7) >> 3;
+            picture_height = (picture_height + 7) >> 3;
+        }
+        if (decode_params->target_dimension.width != 0 && decode_params->target_dimension.height != 0) {
+            picture_width = decode_params->target_dimension.width;
+            picture_height = decode_params->target_dimension.height;
+        }
+        size_t max_rows = std::max(picture_width, picture_height);
+        const RocJpegImage &destination = destinations[indices[k]];
+        size_t staging_size = 0;
+        for (int c = 0; c < NUM_COMPONENTS; c++) {
+            if (destination.channel[c] != nullptr) {
+                staging_size += destination.pitch[c] * max_rows;
+            }
+        }
+        if (cpu_staging_buffer_sizes_[k] < staging_size) {
+            if (cpu_staging_buffers_[k]) {
+                CHECK_HIP(hipHostFree(cpu_staging_buffers_[k]));
+                cpu_staging_buffers_[k] = nullptr;
+                cpu_staging_buffer_sizes_[k] = 0;
+            }
+            CHECK_HIP(hipHostMalloc(&cpu_staging_buffers_[k], staging_size, 0));
+            cpu_staging_buffer_sizes_[k] = staging_size;
+        }
+        staging_images[k] = {};
+        size_t staging_offset = 0;
+        for (int c = 0; c < NUM_COMPONENTS; c++) {
+            if (destination.channel[c] != nullptr) {
+                staging_images[k].channel[c] = cpu_staging_buffers_[k] + staging_offset;
+                staging_images[k].pitch[c] = destination.pitch[c];
+                staging_offset += destination.pitch[c] * max_rows;
+            }
+        }
+    }
+
+    RocJpegThreadPool::GetInstance().ParallelFor(count, [&](int k) {
+        auto rocjpeg_stream_handle = static_cast<RocJpegStreamParserHandle*>(jpeg_streams[indices[k]]);
+        statuses[k] = cpu_decoders_[k].Decode(rocjpeg_stream_handle->rocjpeg_stream->GetJpegStreamParameters(), decode_params, orientations[k],
+                                              &staging_images[k]);
+    });
+
+    // a stream that fails to decode doesn't keep the other streams of the sub-batch from being copied
+    RocJpegStatus sub_batch_status = ROCJPEG_STATUS_SUCCESS;
+    for (int k = 0; k < count; k++) {
+        if (statuses[k] != ROCJPEG_STATUS_SUCCESS) {
+            UpdateBatchStatus(statuses[k], sub_batch_status);
+            continue;
+        }
+        uint32_t channel_heights[NUM_COMPONENTS];
+        cpu_decoders_[k].GetOutputChannelHeights(decode_params->output_format, orientations[k], channel_heights);
+        const RocJpegImage &destination = destinations[indices[k]];
+        for (int c = 0; c < NUM_COMPONENTS; c++) {
+            if (staging_images[k].channel[c] != nullptr && destination.pitch[c] != 0 && channel_heights[c] != 0) {
+                CHECK_HIP(hipMemcpy2DAsync(destination.channel[c], destination.pitch[c], staging_images[k].channel[c], staging_images[k].pitch[c],
+                                           destination.pitch[c], channel_heights[c], hipMemcpyHostToDevice, hip_stream_));
+            }
+        }
+        route_stats_.num_cpu_decodes++;
+    }
+    return sub_batch_status;
+}
+
+/**
+ * @brief Decodes a batch of JPEG streams with the CPU decoders of the ROCJPEG_BACKEND_CPU backend.
+ *
+ * The streams are decoded by sub-batches of one stream per thread of the pool, each thread decoding its stream
+ * with its own CPU decoder, from the entropy-coded data to the destination image.
+ *
+ * @param jpeg_streams An array of RocJpegStreamHandle objects representing the JPEG streams to be decoded.
+ * @param batch_size The number of JPEG streams in the batch.
+ * @param decode_params A pointer to RocJpegDecodeParams object containing the decode parameters.
+ * @param destinations An array of RocJpegImage objects in host memory where the decoded images will be stored.
+ * @return A RocJpegStatus value indicating the success or failure of the decoding operation.
+ */
+RocJpegStatus RocJpegDecoder::DecodeBatchedOnCpu(RocJpegStreamHandle *jpeg_streams, int batch_size, const RocJpegDecodeParams *decode_params, RocJpegImage *destinations) {
+    int cpu_batch_size = static_cast<int>(cpu_decoders_.size());
+    std::vector<RocJpegStatus> statuses(cpu_batch_size);
+    RocJpegStatus batch_status = ROCJPEG_STATUS_SUCCESS;
+    for (int i = 0; i < batch_size; i += cpu_batch_size) {
+        int batch_end = std::min(i + cpu_batch_size, batch_size);
+        RocJpegThreadPool::GetInstance().ParallelFor(batch_end - i, [&](int k) {
+            auto rocjpeg_stream_handle = static_cast<RocJpegStreamParserHandle*>(jpeg_streams[i + k]);
+            const JpegStreamParameters *jpeg_stream_params = rocjpeg_stream_handle->rocjpeg_stream->GetJpegStreamParameters();
+            uint8_t orientation;
+            statuses[k] = GetOutputOrientation(decode_params, jpeg_stream_params, orientation);
+            if (statuses[k] == ROCJPEG_STATUS_SUCCESS) {
+                statuses[k] = cpu_decoders_[k].Decode(jpeg_stream_params, decode_params, orientation, &destinations[i + k]);
+            }
+        });
+        for (int k = 0; k < batch_end - i; k++) {
+            if (statuses[k] != ROCJPEG_STATUS_SUCCESS) {
+                UpdateBatchStatus(statuses[k], batch_status);
+                continue;
+            }
+            route_stats_.num_cpu_decodes++;
+        }
+    }
+    return batch_status;
+}
+
+/**
+ * @brief Writes a decoded picture to the destination image in the requested output format.
+ *
+ * The picture is read from a surface in the layout of the HIP interop memory of a VA surface, whether it was
+ * decoded by the VCN JPEG decoder or by the hybrid decoder. The crop rectangle is applied here unless the
+ * decoder has already cropped the picture. A DC-only preview is written with the picture size and the crop
+ * rectangle scaled to its size.
+ *
+ * @param hip_interop_dev_mem The HIP interop device memory holding the decoded picture.
+ * @param jpeg_stream_params The parsed JPEG stream parameters.
+ * @param decode_params The decode parameters for the JPEG image.
+ * @param is_roi_decoded True if the decoder has already applied the crop rectangle.
+ * @param orientation The EXIF orientation to apply.
+ * @param destination The destination buffer to store the decoded image.
+ * @return The status of the operation.
+ */
+RocJpegStatus RocJpegDecoder::OutputDecodedPicture(HipInteropDeviceMem &hip_interop_dev_mem, const JpegStreamParameters *jpeg_stream_params, const RocJpegDecodeParams *decode_params,
+                                                   bool is_roi_decoded, uint8_t orientation, RocJpegImage *destination) {
+    JpegStreamParameters preview_stream_params;
+    RocJpegDecodeParams preview_decode_params;
+    if (decode_params->dc_only) {
+        GetPreviewParameters(jpeg_stream_params, decode_params, preview_stream_params, preview_decode_params);
+        jpeg_stream_params = &preview_stream_params;
+        decode_params = &preview_decode_params;
+    }
     uint16_t chroma_height = 0;
     uint16_t picture_width = 0;
     uint16_t picture_height = 0;
@@ -133,163 +534,225 @@ RocJpegStatus RocJpegDecoder::Decode(RocJpegStreamHandle jpeg_stream_handle, con
     picture_width = is_roi_valid ? roi_width : jpeg_stream_params->picture_parameter_buffer.picture_width;
     picture_height = is_roi_valid ? roi_height : jpeg_stream_params->picture_parameter_buffer.picture_height;
 
-    VcnJpegSpec current_vcn_jpeg_spec = jpeg_vaapi_decoder_.GetCurrentVcnJpegSpec();
-    if (is_roi_valid && current_vcn_jpeg_spec.can_roi_decode) {
+    if (is_roi_valid && is_roi_decoded) {
         // Set is_roi_valid to false because in this case, the hardware handles the ROI decode and we don't
         // need to calculate the roi_offset later in the following functions (e.g., CopyChannel, GetPlanarYUVOutputFormat, etc) to copy the crop rectangle
         is_roi_valid = false;
     }
 
+    if (jpeg_stream_params->picture_parameter_buffer.num_components == NUM_COMPONENTS) {
+        // CMYK and YCCK pictures are only decoded by the hybrid decoder, which writes a plane per component
+        CHECK_ROCJPEG(GetFourComponentOutputFormat(hip_interop_dev_mem, jpeg_stream_params, picture_width,
+                                                   picture_height, destination, decode_params, is_roi_valid, orientation));
+        return ROCJPEG_STATUS_SUCCESS;
+    }
+
     switch (decode_params->output_format) {
         case ROCJPEG_OUTPUT_NATIVE:
             // Copy the native decoded output buffers from interop memory directly to the destination buffers
             CHECK_ROCJPEG(GetChromaHeight(hip_interop_dev_mem.surface_format, picture_height, chroma_height));
 
             // Copy Luma (first channel) for any surface format
-            CHECK_ROCJPEG(CopyChannel(hip_interop_dev_mem, picture_height, 0, destination, decode_params, is_roi_valid));
+            CHECK_ROCJPEG(CopyChannel(hip_interop_dev_mem, picture_width, picture_height, 0, destination, decode_params, is_roi_valid, orientation));
 
             if (hip_interop_dev_mem.surface_format == VA_FOURCC_NV12) {
                 // Copy the second channel (UV interleaved) for NV12
-                CHECK_ROCJPEG(CopyChannel(hip_interop_dev_mem, chroma_height, 1, destination, decode_params, is_roi_valid));
+                CHECK_ROCJPEG(CopyChannel(hip_interop_dev_mem, picture_width >> 1, chroma_height, 1, destination, decode_params, is_roi_valid, orientation));
             } else if (hip_interop_dev_mem.surface_format == VA_FOURCC_444P ||
                        hip_interop_dev_mem.surface_format == VA_FOURCC_422V) {
                 // Copy the second and third channels for YUV444 and YUV440 (i.e., YUV422V)
-                CHECK_ROCJPEG(CopyChannel(hip_interop_dev_mem, chroma_height, 1, destination, decode_params, is_roi_valid));
-                CHECK_ROCJPEG(CopyChannel(hip_interop_dev_mem, chroma_height, 2, destination, decode_params, is_roi_valid));
+                CHECK_ROCJPEG(CopyChannel(hip_interop_dev_mem, picture_width, chroma_height, 1, destination, decode_params, is_roi_valid, orientation));
+                CHECK_ROCJPEG(CopyChannel(hip_interop_dev_mem, picture_width, chroma_height, 2, destination, decode_params, is_roi_valid, orientation));
             }
             break;
         case ROCJPEG_OUTPUT_YUV_PLANAR:
             CHECK_ROCJPEG(GetChromaHeight(hip_interop_dev_mem.surface_format, picture_height, chroma_height));
             CHECK_ROCJPEG(GetPlanarYUVOutputFormat(hip_interop_dev_mem, picture_width,
-                                                   picture_height, chroma_height, destination, decode_params, is_roi_valid));
+                                                   picture_height, chroma_height, destination, decode_params, is_roi_valid, orientation));
             break;
         case ROCJPEG_OUTPUT_Y:
             CHECK_ROCJPEG(GetYOutputFormat(hip_interop_dev_mem, picture_width,
-                                           picture_height, destination, decode_params, is_roi_valid));
+                                           picture_height, destination, decode_params, is_roi_valid, orientation));
             break;
         case ROCJPEG_OUTPUT_RGB:
             CHECK_ROCJPEG(ColorConvertToRGB(hip_interop_dev_mem, picture_width,
-                                                    picture_height, destination, decode_params, is_roi_valid));
+                                                    picture_height, destination, decode_params, is_roi_valid, orientation));
             break;
         case ROCJPEG_OUTPUT_RGB_PLANAR:
             CHECK_ROCJPEG(ColorConvertToRGBPlanar(hip_interop_dev_mem, picture_width,
-                                                    picture_height, destination, decode_params, is_roi_valid));
+                                                    picture_height, destination, decode_params, is_roi_valid, orientation));
+            break;
+        case ROCJPEG_OUTPUT_YUV_PLANAR_16:
+        case ROCJPEG_OUTPUT_Y_16:
+            CHECK_ROCJPEG(GetYUV16OutputFormat(hip_interop_dev_mem, jpeg_stream_params, picture_width,
+                                               picture_height, destination, decode_params, is_roi_valid, orientation));
+            break;
+        case ROCJPEG_OUTPUT_RGB_16:
+        case ROCJPEG_OUTPUT_RGB_PLANAR_16:
+            CHECK_ROCJPEG(ColorConvertToRGB16(hip_interop_dev_mem, jpeg_stream_params, picture_width,
+                                              picture_height, destination, decode_params, is_roi_valid, orientation));
             break;
         default:
             break;
     }
 
-    CHECK_ROCJPEG(jpeg_vaapi_decoder_.SetSurfaceAsIdle(current_surface_id));
-    CHECK_HIP(hipStreamSynchronize(hip_stream_));
     return ROCJPEG_STATUS_SUCCESS;
 }
 
 /**
- * Decodes a batch of JPEG streams using the specified decode parameters and stores the decoded images in the provided destinations.
+ * @brief Checks if an output format has 16-bit samples.
  *
- * @param jpeg_streams An array of RocJpegStreamHandle objects representing the JPEG streams to be decoded.
- * @param batch_size The number of JPEG streams in the batch.
- * @param decode_params A pointer to RocJpegDecodeParams object containing the decode parameters.
- * @param destinations An array of RocJpegImage objects where the decoded images will be stored.
- * @return A RocJpegStatus value indicating the success or failure of the decoding operation.
+ * @param output_format The output format.
+ * @return True for the 16-bit output formats, false otherwise.
  */
-RocJpegStatus RocJpegDecoder::DecodeBatched(RocJpegStreamHandle *jpeg_streams, int batch_size, const RocJpegDecodeParams *decode_params, RocJpegImage *destinations) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (jpeg_streams == nullptr || decode_params == nullptr || destinations == nullptr) {
-        return ROCJPEG_STATUS_INVALID_PARAMETER;
-    }
-
-    std::vector<VASurfaceID> current_surface_ids;
-    std::vector<JpegStreamParameters> jpeg_streams_params;
-    current_surface_ids.resize(batch_size);
-    jpeg_streams_params.resize(batch_size);
-    VcnJpegSpec current_vcn_jpeg_spec = jpeg_vaapi_decoder_.GetCurrentVcnJpegSpec();
+bool RocJpegDecoder::Is16BitOutputFormat(RocJpegOutputFormat output_format) {
+    return output_format == ROCJPEG_OUTPUT_YUV_PLANAR_16 || output_format == ROCJPEG_OUTPUT_Y_16 ||
+           output_format == ROCJPEG_OUTPUT_RGB_16 || output_format == ROCJPEG_OUTPUT_RGB_PLANAR_16;
+}
 
-    for (int i = 0; i < batch_size; i += current_vcn_jpeg_spec.num_jpeg_cores) {
-        int batch_end = std::min(i + static_cast<int>(current_vcn_jpeg_spec.num_jpeg_cores), batch_size);
-        int current_batch_size = batch_end - i;
+/**
+ * @brief Selects the path that decodes a JPEG stream.
+ *
+ * The hybrid decoder has no surface layout for the chroma planes of YUV 4:1:1 and of the other subsamplings the
+ * parser doesn't recognize, so the pictures with three such components are decoded by the CPU decoder with every
+ * backend. The ROCJPEG_BACKEND_HYBRID backend decodes the other streams with the hybrid decoder. The VCN JPEG
+ * decoder only decodes the sizes between its minimum and maximum picture sizes, the recognized subsamplings, and the
+ * sequential streams with 8-bit samples and 8-bit quantization tables, and only writes 8-bit samples. The streams
+ * coded in several scans are decoded by the hybrid decoder, since the VCN JPEG decoders are submitted a single slice
+ * per picture. The DC-only previews
+ * are always decoded by the hybrid decoder. The pictures resized to a target dimension are decoded by the CPU decoder,
+ * which is the only one with the reduced-size IDCTs and the resize. The images of the ROCJPEG_BACKEND_HARDWARE backend
+ * routed away from the VCN because of their size or subsampling are counted in the decode route statistics.
+ *
+ * @param jpeg_stream_params The parsed JPEG stream parameters.
+ * @param decode_params The decode parameters for the JPEG image.
+ * @return The decode route of the stream.
+ */
+RocJpegDecoder::DecodeRoute RocJpegDecoder::GetDecodeRoute(const JpegStreamParameters *jpeg_stream_params, const RocJpegDecodeParams *decode_params) {
+    const PictureParameterBuffer &picture_parameter_buffer = jpeg_stream_params->picture_parameter_buffer;
+    bool is_subsampling_supported = jpeg_stream_params->chroma_subsampling != CSS_411 && jpeg_stream_params->chroma_subsampling != CSS_UNKNOWN;
+    bool is_hardware_backend = backend_ == ROCJPEG_BACKEND_HARDWARE;
+    if (picture_parameter_buffer.num_components == 3 && !is_subsampling_supported) {
+        if (is_hardware_backend) {
+            route_stats_.num_subsampling_fallbacks++;
+        }
+        return kDecodeRouteCpu;
+    }
+    if (decode_params->target_dimension.width != 0 || decode_params->target_dimension.height != 0) {
+        return kDecodeRouteCpu;
+    }
+    if (!is_hardware_backend || decode_params->dc_only) {
+        return kDecodeRouteHybrid;
+    }
+    if (!jpeg_vaapi_decoder_.IsResolutionSupported(picture_parameter_buffer.picture_width, picture_parameter_buffer.picture_height)) {
+        route_stats_.num_resolution_fallbacks++;
+        return kDecodeRouteHybrid;
+    }
+    if (!is_subsampling_supported && picture_parameter_buffer.num_components == 1) {
+        route_stats_.num_subsampling_fallbacks++;
+        return kDecodeRouteHybrid;
+    }
+    if (jpeg_stream_params->hardware_limitations != 0 || Is16BitOutputFormat(decode_params->output_format)) {
+        return kDecodeRouteHybrid;
+    }
+    return kDecodeRouteHardware;
+}
 
-        for (int j = i; j < batch_end; j++) {
-            auto rocjpeg_stream_handle = static_cast<RocJpegStreamParserHandle*>(jpeg_streams[j]);
-            const JpegStreamParameters *jpeg_stream_params = rocjpeg_stream_handle->rocjpeg_stream->GetJpegStreamParameters();
-            jpeg_streams_params[j] = std::move(*jpeg_stream_params);
-        }
-
-        CHECK_ROCJPEG(jpeg_vaapi_decoder_.SubmitDecodeBatched(jpeg_streams_params.data() + i, current_batch_size, decode_params, current_surface_ids.data() + i));
-
-        for (int k = 0; k < current_batch_size; k++) {
-            HipInteropDeviceMem hip_interop_dev_mem = {};
-            VASurfaceID current_surface_id = *(current_surface_ids.data() + k + i);
-            const JpegStreamParameters *jpeg_stream_params = jpeg_streams_params.data() + k + i;
-            CHECK_ROCJPEG(jpeg_vaapi_decoder_.SyncSurface(current_surface_id));
-            CHECK_ROCJPEG(jpeg_vaapi_decoder_.GetHipInteropMem(current_surface_id, hip_interop_dev_mem));
-
-            uint16_t chroma_height = 0;
-            uint16_t picture_width = 0;
-            uint16_t picture_height = 0;
-            bool is_roi_valid = false;
-            uint32_t roi_width;
-            uint32_t roi_height;
-            roi_width = decode_params->crop_rectangle.right - decode_params->crop_rectangle.left;
-            roi_height = decode_params->crop_rectangle.bottom - decode_params->crop_rectangle.top;
-    
-            if (roi_width > 0 && roi_height > 0 && roi_width <= jpeg_stream_params->picture_parameter_buffer.picture_width && roi_height <= jpeg_stream_params->picture_parameter_buffer.picture_height) {
-                is_roi_valid = true;
-            }
+/**
+ * @brief Scales the picture size and the crop rectangle of a stream to its DC-only preview.
+ *
+ * The preview has one sample per 8x8 block, so its size is the picture size divided by 8 and rounded up. A valid
+ * crop rectangle starts at the block holding its top-left corner and keeps its size divided by 8 and rounded up,
+ * as the CPU decoder crops the planes decoded at 1/8 scale.
+ *
+ * @param jpeg_stream_params The parsed JPEG stream parameters.
+ * @param decode_params The decode parameters for the JPEG image.
+ * @param preview_stream_params The stream parameters with the size of the preview.
+ * @param preview_decode_params The decode parameters with the crop rectangle in the coordinates of the preview.
+ */
+void RocJpegDecoder::GetPreviewParameters(const JpegStreamParameters *jpeg_stream_params, const RocJpegDecodeParams *decode_params,
+                                          JpegStreamParameters &preview_stream_params, RocJpegDecodeParams &preview_decode_params) {
+    const PictureParameterBuffer &picture_parameter_buffer = jpeg_stream_params->picture_parameter_buffer;
+    uint32_t roi_width = decode_params->crop_rectangle.right - decode_params->crop_rectangle.left;
+    uint32_t roi_height = decode_params->crop_rectangle.bottom - decode_params->crop_rectangle.top;
+    bool is_roi_valid = roi_width > 0 && roi_height > 0 && roi_width <= picture_parameter_buffer.picture_width &&
+                        roi_height <= picture_parameter_buffer.picture_height;
 
-            picture_width = is_roi_valid ? roi_width : jpeg_stream_params->picture_parameter_buffer.picture_width;
-            picture_height = is_roi_valid ? roi_height : jpeg_stream_params->picture_parameter_buffer.picture_height;
+    preview_stream_params = *jpeg_stream_params;
+    preview_stream_params.picture_parameter_buffer.picture_width = (picture_parameter_buffer.picture_width + 7) >> 3;
+    preview_stream_params.picture_parameter_buffer.picture_height = (picture_parameter_buffer.picture_height + 7) >> 3;
+    preview_decode_params = *decode_params;
+    preview_decode_params.crop_rectangle = {};
+    if (is_roi_valid) {
+        preview_decode_params.crop_rectangle.left = decode_params->crop_rectangle.left >> 3;
+        preview_decode_params.crop_rectangle.top = decode_params->crop_rectangle.top >> 3;
+        preview_decode_params.crop_rectangle.right = preview_decode_params.crop_rectangle.left + static_cast<int16_t>((roi_width + 7) >> 3);
+        preview_decode_params.crop_rectangle.bottom = preview_decode_params.crop_rectangle.top + static_cast<int16_t>((roi_height + 7) >> 3);
+    }
+}
 
-            if (is_roi_valid && current_vcn_jpeg_spec.can_roi_decode) {
-                // Set is_roi_valid to false because in this case, the hardware handles the ROI decode and we don't need to calculate the roi_offset
-                // later in the following functions (e.g., CopyChannel, GetPlanarYUVOutputFormat, etc) to copy the crop rectangle
-                is_roi_valid = false;
-            }
+/**
+ * @brief Counts an image decoded by the VCN JPEG decoder in the decode route statistics.
+ *
+ * @param jpeg_stream_params The parsed JPEG stream parameters.
+ */
+void RocJpegDecoder::CountHardwareDecode(const JpegStreamParameters *jpeg_stream_params) {
+    if (jpeg_stream_params->is_huffman_table_remapped) {
+        route_stats_.num_hardware_remapped_decodes++;
+    } else {
+        route_stats_.num_hardware_decodes++;
+    }
+}
 
-            switch (decode_params->output_format) {
-                case ROCJPEG_OUTPUT_NATIVE:
-                    // Copy the native decoded output buffers from interop memory directly to the destination buffers
-                    CHECK_ROCJPEG(GetChromaHeight(hip_interop_dev_mem.surface_format, picture_height, chroma_height));
-                    // Copy Luma (first channel) for any surface format
-                    CHECK_ROCJPEG(CopyChannel(hip_interop_dev_mem, picture_height, 0, &destinations[k + i], decode_params, is_roi_valid));
-                    if (hip_interop_dev_mem.surface_format == VA_FOURCC_NV12) {
-                        // Copy the second channel (UV interleaved) for NV12
-                        CHECK_ROCJPEG(CopyChannel(hip_interop_dev_mem, chroma_height, 1, &destinations[k + i], decode_params, is_roi_valid));
-                    } else if (hip_interop_dev_mem.surface_format == VA_FOURCC_444P ||
-                            hip_interop_dev_mem.surface_format == VA_FOURCC_422V) {
-                        // Copy the second and third channels for YUV444 and YUV440 (i.e., YUV422V)
-                        CHECK_ROCJPEG(CopyChannel(hip_interop_dev_mem, chroma_height, 1, &destinations[k + i], decode_params, is_roi_valid));
-                        CHECK_ROCJPEG(CopyChannel(hip_interop_dev_mem, chroma_height, 2, &destinations[k + i], decode_params, is_roi_valid));
-                    }
-                    break;
-                case ROCJPEG_OUTPUT_YUV_PLANAR:
-                    CHECK_ROCJPEG(GetChromaHeight(hip_interop_dev_mem.surface_format, picture_height, chroma_height));
-                    CHECK_ROCJPEG(GetPlanarYUVOutputFormat(hip_interop_dev_mem, picture_width,
-                                                        picture_height, chroma_height, &destinations[k + i], decode_params, is_roi_valid));
-                    break;
-                case ROCJPEG_OUTPUT_Y:
-                    CHECK_ROCJPEG(GetYOutputFormat(hip_interop_dev_mem, picture_width,
-                                                picture_height, &destinations[k + i], decode_params, is_roi_valid));
-                    break;
-                case ROCJPEG_OUTPUT_RGB:
-                    CHECK_ROCJPEG(ColorConvertToRGB(hip_interop_dev_mem, picture_width,
-                                                            picture_height, &destinations[k + i], decode_params, is_roi_valid));
-                    break;
-                case ROCJPEG_OUTPUT_RGB_PLANAR:
-                    CHECK_ROCJPEG(ColorConvertToRGBPlanar(hip_interop_dev_mem, picture_width,
-                                                            picture_height, &destinations[k + i], decode_params, is_roi_valid));
-                    break;
-                default:
-                    break;
-            }
-            CHECK_ROCJPEG(jpeg_vaapi_decoder_.SetSurfaceAsIdle(current_surface_id));
-        }
+/**
+ * @brief Retrieves the number of images decoded by each decode path.
+ *
+ * @param stats Pointer to store the counts.
+ */
+void RocJpegDecoder::GetDecodeRouteStats(RocJpegDecodeRouteStats *stats) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    *stats = route_stats_;
+}
 
+/**
+ * @brief Decodes the DCT coefficients of a batch of JPEG streams.
+ *
+ * The coefficients are decoded by the software entropy decoder for every backend, so neither the VCN JPEG decoder
+ * nor the IDCT kernel is used. The copies to device memory are queued on the HIP stream of the decoder, which is
+ * synchronized before returning.
+ *
+ * @param jpeg_streams The array of JPEG stream handles.
+ * @param batch_size The number of JPEG streams in the batch.
+ * @param coefficient_params The parameters of the decode.
+ * @param destinations The array of destination coefficient planes.
+ * @return The status of the decoding operation. Returns ROCJPEG_STATUS_INVALID_PARAMETER if the planes are in
+ *         device memory with the ROCJPEG_BACKEND_CPU backend.
+ */
+RocJpegStatus RocJpegDecoder::DecodeCoefficientsBatched(RocJpegStreamHandle *jpeg_streams, int batch_size, const RocJpegCoefficientParams *coefficient_params,
+                                                        RocJpegCoefficientImage *destinations) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (jpeg_streams == nullptr || batch_size <= 0 || coefficient_params == nullptr || destinations == nullptr) {
+        return ROCJPEG_STATUS_INVALID_PARAMETER;
+    }
+    if (backend_ == ROCJPEG_BACKEND_CPU && !coefficient_params->is_host_memory) {
+        ERR("ERROR: the ROCJPEG_BACKEND_CPU backend only writes the coefficients to host memory!");
+        return ROCJPEG_STATUS_INVALID_PARAMETER;
+    }
+    std::vector<const JpegStreamParameters*> stream_params(batch_size);
+    for (int i = 0; i < batch_size; i++) {
+        auto rocjpeg_stream_handle = static_cast<RocJpegStreamParserHandle*>(jpeg_streams[i]);
+        stream_params[i] = rocjpeg_stream_handle->rocjpeg_stream->GetJpegStreamParameters();
+    }
+    RocJpegStatus rocjpeg_status = coefficient_decoder_.DecodeBatch(stream_params.data(), batch_size, coefficient_params, hip_stream_, destinations);
+    if (rocjpeg_status != ROCJPEG_STATUS_SUCCESS) {
+        return rocjpeg_status;
+    }
+    if (!coefficient_params->is_host_memory) {
+        CHECK_HIP(hipStreamSynchronize(hip_stream_));
     }
-
-    CHECK_HIP(hipStreamSynchronize(hip_stream_));
     return ROCJPEG_STATUS_SUCCESS;
 }
+
 /**
  * @brief Retrieves the image information from the JPEG stream.
  *
@@ -311,14 +774,32 @@ RocJpegStatus RocJpegDecoder::GetImageInfo(RocJpegStreamHandle jpeg_stream_handl
     }
     auto rocjpeg_stream_handle = static_cast<RocJpegStreamParserHandle*>(jpeg_stream_handle);
     const JpegStreamParameters *jpeg_stream_params = rocjpeg_stream_handle->rocjpeg_stream->GetJpegStreamParameters();
+    GetImageInfo(*jpeg_stream_params, num_components, subsampling, widths, heights);
+
+    return ROCJPEG_STATUS_SUCCESS;
+}
 
-    *num_components = jpeg_stream_params->picture_parameter_buffer.num_components;
-    widths[0] = jpeg_stream_params->picture_parameter_buffer.picture_width;
-    heights[0] = jpeg_stream_params->picture_parameter_buffer.picture_height;
+/**
+ * @brief Computes the image information from the parsed JPEG stream parameters.
+ *
+ * This function derives the number of components, the chroma subsampling, and the width and height of each
+ * component from the picture parameters. Only the frame header (SOF) fields are used, so it can be called
+ * on parameters obtained from a header-only parse.
+ *
+ * @param jpeg_stream_params The parsed JPEG stream parameters.
+ * @param num_components Pointer to store the number of color components in the image.
+ * @param subsampling Pointer to store the chroma subsampling information.
+ * @param widths Pointer to store the widths of the image components.
+ * @param heights Pointer to store the heights of the image components.
+ */
+void RocJpegDecoder::GetImageInfo(const JpegStreamParameters &jpeg_stream_params, uint8_t *num_components, RocJpegChromaSubsampling *subsampling, uint32_t *widths, uint32_t *heights) {
+    *num_components = jpeg_stream_params.picture_parameter_buffer.num_components;
+    widths[0] = jpeg_stream_params.picture_parameter_buffer.picture_width;
+    heights[0] = jpeg_stream_params.picture_parameter_buffer.picture_height;
     widths[3] = 0;
     heights[3] = 0;
 
-    switch (jpeg_stream_params->chroma_subsampling) {
+    switch (jpeg_stream_params.chroma_subsampling) {
         case CSS_444:
             *subsampling = ROCJPEG_CSS_444;
             widths[2] = widths[1] = widths[0];
@@ -353,8 +834,11 @@ RocJpegStatus RocJpegDecoder::GetImageInfo(RocJpegStreamHandle jpeg_stream_handl
             *subsampling = ROCJPEG_CSS_UNKNOWN;
             break;
     }
-
-    return ROCJPEG_STATUS_SUCCESS;
+    // the K component of a CMYK or YCCK image has the resolution of the first component
+    if (*num_components == NUM_COMPONENTS && *subsampling != ROCJPEG_CSS_UNKNOWN) {
+        widths[3] = widths[0];
+        heights[3] = heights[0];
+    }
 }
 
 /**
@@ -363,13 +847,17 @@ RocJpegStatus RocJpegDecoder::GetImageInfo(RocJpegStreamHandle jpeg_stream_handl
  * This function copies the channel specified by `channel_index` from the `hip_interop_dev_mem` to the `destination` image.
  * The `channel_height` parameter specifies the height of the channel.
  *
+ * If `orientation` is not ROCJPEG_ORIENTATION_NORMAL, the channel is reoriented while it is copied.
+ *
  * @param hip_interop_dev_mem The `HipInteropDeviceMem` object containing the source channel data.
+ * @param channel_width The width of the channel in samples (UV pairs for the interleaved UV channel of NV12).
  * @param channel_height The height of the channel to be copied.
  * @param channel_index The index of the channel to be copied.
  * @param destination The `RocJpegImage` object representing the destination image.
+ * @param orientation The EXIF orientation to apply to the channel.
  * @return The status of the operation. Returns `ROCJPEG_STATUS_SUCCESS` if the channel was copied successfully.
  */
-RocJpegStatus RocJpegDecoder::CopyChannel(HipInteropDeviceMem& hip_interop_dev_mem, uint16_t channel_height, uint8_t channel_index, RocJpegImage *destination, const RocJpegDecodeParams *decode_params, bool is_roi_valid) {
+RocJpegStatus RocJpegDecoder::CopyChannel(HipInteropDeviceMem& hip_interop_dev_mem, uint16_t channel_width, uint16_t channel_height, uint8_t channel_index, RocJpegImage *destination, const RocJpegDecodeParams *decode_params, bool is_roi_valid, uint8_t orientation) {
     if (hip_interop_dev_mem.pitch[channel_index] != 0 && destination->pitch[channel_index] != 0 && destination->channel[channel_index] != nullptr) {
         uint32_t roi_offset = 0;
         if (is_roi_valid) {
@@ -387,7 +875,13 @@ RocJpegStatus RocJpegDecoder::CopyChannel(HipInteropDeviceMem& hip_interop_dev_m
             }
             roi_offset = top * hip_interop_dev_mem.pitch[channel_index] + left;
         }
-        if (destination->pitch[channel_index] == hip_interop_dev_mem.pitch[channel_index]) {
+        if (orientation != ROCJPEG_ORIENTATION_NORMAL) {
+            // the interleaved UV channel of NV12 is reoriented as pairs of bytes
+            uint32_t sample_size = (hip_interop_dev_mem.surface_format == VA_FOURCC_NV12 && channel_index == 1) ? 2 : 1;
+            CopyPlaneOriented(hip_stream_, channel_width, channel_height, orientation, destination->channel[channel_index], destination->pitch[channel_index],
+                              hip_interop_dev_mem.hip_mapped_device_mem + hip_interop_dev_mem.offset[channel_index] + roi_offset, hip_interop_dev_mem.pitch[channel_index],
+                              sample_size, sample_size);
+        } else if (destination->pitch[channel_index] == hip_interop_dev_mem.pitch[channel_index]) {
             uint32_t channel_size = destination->pitch[channel_index] * channel_height;
             CHECK_HIP(hipMemcpyDtoDAsync(destination->channel[channel_index], hip_interop_dev_mem.hip_mapped_device_mem + hip_interop_dev_mem.offset[channel_index] + roi_offset, channel_size, hip_stream_));
         } else {
@@ -444,10 +938,18 @@ RocJpegStatus RocJpegDecoder::GetChromaHeight(uint32_t surface_format, uint16_t
  * @param picture_width The width of the destination image.
  * @param picture_height The height of the destination image.
  * @param destination Pointer to the RocJpegImage object where the converted image will be stored.
+ * @param orientation The EXIF orientation to apply; the orientation is applied by the color conversion kernel.
  * @return The status of the color conversion operation. Returns ROCJPEG_STATUS_SUCCESS if the conversion
  *         is successful. Returns ROCJPEG_STATUS_JPEG_NOT_SUPPORTED if the surface format is not supported.
  */
-RocJpegStatus RocJpegDecoder::ColorConvertToRGB(HipInteropDeviceMem& hip_interop_dev_mem, uint32_t picture_width, uint32_t picture_height, RocJpegImage *destination, const RocJpegDecodeParams *decode_params, bool is_roi_valid) {
+RocJpegStatus RocJpegDecoder::ColorConvertToRGB(HipInteropDeviceMem& hip_interop_dev_mem, uint32_t picture_width, uint32_t picture_height, RocJpegImage *destination, const RocJpegDecodeParams *decode_params, bool is_roi_valid, uint8_t orientation) {
+    if (orientation != ROCJPEG_ORIENTATION_NORMAL) {
+        OrientedSourceImage src_image = {};
+        CHECK_ROCJPEG(GetOrientedSourceImage(hip_interop_dev_mem, decode_params, is_roi_valid, src_image));
+        ColorConvertToRGBOriented(hip_stream_, picture_width, picture_height, orientation, destination->channel[0], destination->channel[0] + 1,
+                                  destination->channel[0] + 2, 3, destination->pitch[0], src_image);
+        return ROCJPEG_STATUS_SUCCESS;
+    }
     uint32_t roi_offset = 0;
     uint32_t roi_uv_offset = 0;
     int16_t top = decode_params->crop_rectangle.top;
@@ -493,6 +995,259 @@ RocJpegStatus RocJpegDecoder::ColorConvertToRGB(HipInteropDeviceMem& hip_interop
     return ROCJPEG_STATUS_SUCCESS;
 }
 
+/**
+ * @brief Describes a ROCJPEG_FOURCC_YUV16 picture written by the hybrid decoder.
+ *
+ * The chroma subsampling shifts are derived from the chroma subsampling of the stream, since each component
+ * of the surface has its own plane at its own resolution.
+ *
+ * @param hip_interop_dev_mem The HipInteropDeviceMem object containing the decoded picture.
+ * @param jpeg_stream_params The parsed JPEG stream parameters.
+ * @param decode_params The decode parameters that specify the crop rectangle.
+ * @param is_roi_valid True if the crop rectangle has to be applied.
+ * @param src_image Reference to store the description of the picture.
+ * @return The status of the operation. Returns ROCJPEG_STATUS_JPEG_NOT_SUPPORTED if the chroma subsampling is not supported.
+ */
+RocJpegStatus RocJpegDecoder::GetYUV16SourceImage(HipInteropDeviceMem& hip_interop_dev_mem, const JpegStreamParameters *jpeg_stream_params, const RocJpegDecodeParams *decode_params,
+                                                  bool is_roi_valid, OrientedSourceImage &src_image) {
+    uint32_t top = is_roi_valid ? decode_params->crop_rectangle.top : 0;
+    uint32_t left = is_roi_valid ? decode_params->crop_rectangle.left : 0;
+    const uint8_t *base = hip_interop_dev_mem.hip_mapped_device_mem;
+
+    if (hip_interop_dev_mem.surface_format != ROCJPEG_FOURCC_YUV16) {
+        ERR("ERROR! surface format is not supported!");
+        return ROCJPEG_STATUS_JPEG_NOT_SUPPORTED;
+    }
+    switch (jpeg_stream_params->chroma_subsampling) {
+        case CSS_444:
+            break;
+        case CSS_440:
+            src_image.uv_shift_y = 1;
+            break;
+        case CSS_422:
+            src_image.uv_shift_x = 1;
+            break;
+        case CSS_420:
+            src_image.uv_shift_x = 1;
+            src_image.uv_shift_y = 1;
+            break;
+        case CSS_411:
+            src_image.uv_shift_x = 2;
+            break;
+        case CSS_400:
+            break;
+        default:
+            ERR("ERROR! chroma subsampling is not supported!");
+            return ROCJPEG_STATUS_JPEG_NOT_SUPPORTED;
+    }
+    src_image.y_image = base + top * hip_interop_dev_mem.pitch[0] + left * sizeof(uint16_t);
+    src_image.y_image_stride_in_bytes = hip_interop_dev_mem.pitch[0];
+    src_image.y_sample_step = sizeof(uint16_t);
+    if (hip_interop_dev_mem.num_layers == 1) {
+        src_image.u_image = nullptr;
+        src_image.v_image = nullptr;
+    } else {
+        uint32_t uv_offset = (top >> src_image.uv_shift_y) * hip_interop_dev_mem.pitch[1] + (left >> src_image.uv_shift_x) * sizeof(uint16_t);
+        src_image.u_image = base + hip_interop_dev_mem.offset[1] + uv_offset;
+        src_image.v_image = base + hip_interop_dev_mem.offset[2] + uv_offset;
+        src_image.uv_image_stride_in_bytes = hip_interop_dev_mem.pitch[1];
+        src_image.uv_sample_step = sizeof(uint16_t);
+    }
+    return ROCJPEG_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Copies the Y, U, and V planes (or only the Y plane) of a ROCJPEG_FOURCC_YUV16 picture to the destination image.
+ *
+ * This function handles the ROCJPEG_OUTPUT_YUV_PLANAR_16 and ROCJPEG_OUTPUT_Y_16 output formats.
+ *
+ * @param hip_interop_dev_mem The HipInteropDeviceMem object containing the decoded picture.
+ * @param jpeg_stream_params The parsed JPEG stream parameters.
+ * @param picture_width The width of the picture.
+ * @param picture_height The height of the picture.
+ * @param destination The destination image.
+ * @param decode_params The decode parameters.
+ * @param is_roi_valid True if the crop rectangle has to be applied.
+ * @param orientation The EXIF orientation to apply.
+ * @return The status of the operation.
+ */
+RocJpegStatus RocJpegDecoder::GetYUV16OutputFormat(HipInteropDeviceMem& hip_interop_dev_mem, const JpegStreamParameters *jpeg_stream_params, uint32_t picture_width, uint32_t picture_height,
+                                                   RocJpegImage *destination, const RocJpegDecodeParams *decode_params, bool is_roi_valid, uint8_t orientation) {
+    OrientedSourceImage src_image = {};
+    CHECK_ROCJPEG(GetYUV16SourceImage(hip_interop_dev_mem, jpeg_stream_params, decode_params, is_roi_valid, src_image));
+    const uint8_t *src_planes[3] = {src_image.y_image, src_image.u_image, src_image.v_image};
+    uint32_t num_planes = (decode_params->output_format == ROCJPEG_OUTPUT_Y_16 || src_image.u_image == nullptr) ? 1 : 3;
+
+    for (uint32_t i = 0; i < num_planes; i++) {
+        if (destination->channel[i] == nullptr || destination->pitch[i] == 0) {
+            continue;
+        }
+        uint32_t plane_width = i == 0 ? picture_width : picture_width >> src_image.uv_shift_x;
+        uint32_t plane_height = i == 0 ? picture_height : picture_height >> src_image.uv_shift_y;
+        uint32_t src_pitch = i == 0 ? src_image.y_image_stride_in_bytes : src_image.uv_image_stride_in_bytes;
+        if (orientation != ROCJPEG_ORIENTATION_NORMAL) {
+            CopyPlaneOriented(hip_stream_, plane_width, plane_height, orientation, destination->channel[i], destination->pitch[i],
+                              src_planes[i], src_pitch, sizeof(uint16_t), sizeof(uint16_t));
+        } else {
+            CHECK_HIP(hipMemcpy2DAsync(destination->channel[i], destination->pitch[i], src_planes[i], src_pitch,
+                                       plane_width * sizeof(uint16_t), plane_height, hipMemcpyDeviceToDevice, hip_stream_));
+        }
+    }
+    return ROCJPEG_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Converts a ROCJPEG_FOURCC_YUV16 picture to interleaved or planar RGB with 16-bit samples.
+ *
+ * This function handles the ROCJPEG_OUTPUT_RGB_16 and ROCJPEG_OUTPUT_RGB_PLANAR_16 output formats.
+ *
+ * @param hip_interop_dev_mem The HipInteropDeviceMem object containing the decoded picture.
+ * @param jpeg_stream_params The parsed JPEG stream parameters.
+ * @param picture_width The width of the picture.
+ * @param picture_height The height of the picture.
+ * @param destination The destination image.
+ * @param decode_params The decode parameters.
+ * @param is_roi_valid True if the crop rectangle has to be applied.
+ * @param orientation The EXIF orientation to apply.
+ * @return The status of the operation.
+ */
+RocJpegStatus RocJpegDecoder::ColorConvertToRGB16(HipInteropDeviceMem& hip_interop_dev_mem, const JpegStreamParameters *jpeg_stream_params, uint32_t picture_width, uint32_t picture_height,
+                                                  RocJpegImage *destination, const RocJpegDecodeParams *decode_params, bool is_roi_valid, uint8_t orientation) {
+    OrientedSourceImage src_image = {};
+    CHECK_ROCJPEG(GetYUV16SourceImage(hip_interop_dev_mem, jpeg_stream_params, decode_params, is_roi_valid, src_image));
+    if (decode_params->output_format == ROCJPEG_OUTPUT_RGB_16) {
+        ColorConvertToRGB16Oriented(hip_stream_, picture_width, picture_height, orientation, jpeg_stream_params->sample_precision, destination->channel[0],
+                                    destination->channel[0] + 2, destination->channel[0] + 4, 6, destination->pitch[0], src_image);
+    } else {
+        if (destination->pitch[0] != destination->pitch[1] || destination->pitch[0] != destination->pitch[2]) {
+            ERR("ERROR! the pitches of the RGB planes must be equal!");
+            return ROCJPEG_STATUS_INVALID_PARAMETER;
+        }
+        ColorConvertToRGB16Oriented(hip_stream_, picture_width, picture_height, orientation, jpeg_stream_params->sample_precision, destination->channel[0],
+                                    destination->channel[1], destination->channel[2], 2, destination->pitch[0], src_image);
+    }
+    return ROCJPEG_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Describes a picture with four components (CMYK or YCCK) written by the hybrid decoder.
+ *
+ * Each component has its own plane at its own resolution, so its subsampling shifts are derived from its sampling
+ * factors relative to the largest ones. The samples are 16-bit and keep the precision of the stream on a
+ * ROCJPEG_FOURCC_YUV16 surface, and are 8-bit on a ROCJPEG_FOURCC_CMYK surface.
+ *
+ * @param hip_interop_dev_mem The HipInteropDeviceMem object containing the decoded picture.
+ * @param jpeg_stream_params The parsed JPEG stream parameters.
+ * @param decode_params The decode parameters that specify the crop rectangle.
+ * @param is_roi_valid True if the crop rectangle has to be applied.
+ * @param src_image Reference to store the description of the picture.
+ * @return The status of the operation. Returns ROCJPEG_STATUS_JPEG_NOT_SUPPORTED if the sampling factors are not supported.
+ */
+RocJpegStatus RocJpegDecoder::GetCmykSourceImage(HipInteropDeviceMem& hip_interop_dev_mem, const JpegStreamParameters *jpeg_stream_params, const RocJpegDecodeParams *decode_params,
+                                                 bool is_roi_valid, OrientedCmykSourceImage &src_image) {
+    uint32_t top = is_roi_valid ? decode_params->crop_rectangle.top : 0;
+    uint32_t left = is_roi_valid ? decode_params->crop_rectangle.left : 0;
+    const PictureParameterBuffer &picture_parameter_buffer = jpeg_stream_params->picture_parameter_buffer;
+
+    if ((hip_interop_dev_mem.surface_format != ROCJPEG_FOURCC_CMYK && hip_interop_dev_mem.surface_format != ROCJPEG_FOURCC_YUV16) ||
+        hip_interop_dev_mem.num_layers != NUM_COMPONENTS) {
+        ERR("ERROR! surface format is not supported!");
+        return ROCJPEG_STATUS_JPEG_NOT_SUPPORTED;
+    }
+    uint32_t max_h_factor = 1;
+    uint32_t max_v_factor = 1;
+    for (int i = 0; i < NUM_COMPONENTS; i++) {
+        max_h_factor = std::max<uint32_t>(max_h_factor, picture_parameter_buffer.components[i].h_sampling_factor);
+        max_v_factor = std::max<uint32_t>(max_v_factor, picture_parameter_buffer.components[i].v_sampling_factor);
+    }
+    src_image.sample_size = hip_interop_dev_mem.surface_format == ROCJPEG_FOURCC_YUV16 ? sizeof(uint16_t) : sizeof(uint8_t);
+    src_image.sample_precision = src_image.sample_size == sizeof(uint16_t) ? jpeg_stream_params->sample_precision : 8;
+    for (int i = 0; i < NUM_COMPONENTS; i++) {
+        uint32_t h_factor = picture_parameter_buffer.components[i].h_sampling_factor;
+        uint32_t v_factor = picture_parameter_buffer.components[i].v_sampling_factor;
+        uint32_t shift_x = 0;
+        uint32_t shift_y = 0;
+        while ((h_factor << shift_x) < max_h_factor) {
+            shift_x++;
+        }
+        while ((v_factor << shift_y) < max_v_factor) {
+            shift_y++;
+        }
+        if ((h_factor << shift_x) != max_h_factor || (v_factor << shift_y) != max_v_factor) {
+            ERR("ERROR! the sampling factors of the JPEG components are not supported!");
+            return ROCJPEG_STATUS_JPEG_NOT_SUPPORTED;
+        }
+        src_image.shift_x[i] = shift_x;
+        src_image.shift_y[i] = shift_y;
+        src_image.image_strides_in_bytes[i] = hip_interop_dev_mem.pitch[i];
+        src_image.images[i] = hip_interop_dev_mem.hip_mapped_device_mem + hip_interop_dev_mem.offset[i] +
+                              (top >> shift_y) * hip_interop_dev_mem.pitch[i] + (left >> shift_x) * src_image.sample_size;
+    }
+    src_image.is_ycck = jpeg_stream_params->has_adobe_marker && jpeg_stream_params->adobe_color_transform == ADOBE_TRANSFORM_YCCK;
+    src_image.is_inverted = jpeg_stream_params->has_adobe_marker;
+    return ROCJPEG_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Outputs a picture with four components (CMYK or YCCK) in any output format.
+ *
+ * The native, YUV planar, and Y output formats copy the component planes (C, M, Y, and K, or Y, Cb, Cr, and K)
+ * at their own resolution, or only the first one for the Y formats. The RGB output formats convert the picture
+ * to RGB with the ColorConvertCMYKToRGBOriented kernel.
+ *
+ * @param hip_interop_dev_mem The HipInteropDeviceMem object containing the decoded picture.
+ * @param jpeg_stream_params The parsed JPEG stream parameters.
+ * @param picture_width The width of the picture.
+ * @param picture_height The height of the picture.
+ * @param destination The destination image.
+ * @param decode_params The decode parameters.
+ * @param is_roi_valid True if the crop rectangle has to be applied.
+ * @param orientation The EXIF orientation to apply.
+ * @return The status of the operation.
+ */
+RocJpegStatus RocJpegDecoder::GetFourComponentOutputFormat(HipInteropDeviceMem& hip_interop_dev_mem, const JpegStreamParameters *jpeg_stream_params, uint32_t picture_width, uint32_t picture_height,
+                                                           RocJpegImage *destination, const RocJpegDecodeParams *decode_params, bool is_roi_valid, uint8_t orientation) {
+    OrientedCmykSourceImage src_image = {};
+    CHECK_ROCJPEG(GetCmykSourceImage(hip_interop_dev_mem, jpeg_stream_params, decode_params, is_roi_valid, src_image));
+    uint32_t sample_size = src_image.sample_size;
+
+    switch (decode_params->output_format) {
+        case ROCJPEG_OUTPUT_RGB:
+        case ROCJPEG_OUTPUT_RGB_16:
+            ColorConvertCMYKToRGBOriented(hip_stream_, picture_width, picture_height, orientation, destination->channel[0], destination->channel[0] + sample_size,
+                                          destination->channel[0] + 2 * sample_size, 3 * sample_size, destination->pitch[0], src_image);
+            break;
+        case ROCJPEG_OUTPUT_RGB_PLANAR:
+        case ROCJPEG_OUTPUT_RGB_PLANAR_16:
+            if (destination->pitch[0] != destination->pitch[1] || destination->pitch[0] != destination->pitch[2]) {
+                ERR("ERROR! the pitches of the RGB planes must be equal!");
+                return ROCJPEG_STATUS_INVALID_PARAMETER;
+            }
+            ColorConvertCMYKToRGBOriented(hip_stream_, picture_width, picture_height, orientation, destination->channel[0], destination->channel[1],
+                                          destination->channel[2], sample_size, destination->pitch[0], src_image);
+            break;
+        default: {
+            uint32_t num_planes = (decode_params->output_format == ROCJPEG_OUTPUT_Y || decode_params->output_format == ROCJPEG_OUTPUT_Y_16) ? 1 : NUM_COMPONENTS;
+            for (uint32_t i = 0; i < num_planes; i++) {
+                if (destination->channel[i] == nullptr || destination->pitch[i] == 0) {
+                    continue;
+                }
+                uint32_t plane_width = picture_width >> src_image.shift_x[i];
+                uint32_t plane_height = picture_height >> src_image.shift_y[i];
+                if (orientation != ROCJPEG_ORIENTATION_NORMAL) {
+                    CopyPlaneOriented(hip_stream_, plane_width, plane_height, orientation, destination->channel[i], destination->pitch[i],
+                                      src_image.images[i], src_image.image_strides_in_bytes[i], sample_size, sample_size);
+                } else {
+                    CHECK_HIP(hipMemcpy2DAsync(destination->channel[i], destination->pitch[i], src_image.images[i], src_image.image_strides_in_bytes[i],
+                                               plane_width * sample_size, plane_height, hipMemcpyDeviceToDevice, hip_stream_));
+                }
+            }
+            break;
+        }
+    }
+    return ROCJPEG_STATUS_SUCCESS;
+}
+
 /**
  * @brief Converts the color format of the input image to RGB planar format.
  *
@@ -504,11 +1259,19 @@ RocJpegStatus RocJpegDecoder::ColorConvertToRGB(HipInteropDeviceMem& hip_interop
  * @param picture_width The width of the destination image.
  * @param picture_height The height of the destination image.
  * @param destination Pointer to the RocJpegImage object where the converted image will be stored.
+ * @param orientation The EXIF orientation to apply; the orientation is applied by the color conversion kernel.
  * @return RocJpegStatus The status of the color conversion operation.
  *         Returns ROCJPEG_STATUS_SUCCESS if the conversion is successful.
  *         Returns ROCJPEG_STATUS_JPEG_NOT_SUPPORTED if the surface format is not supported.
  */
-RocJpegStatus RocJpegDecoder::ColorConvertToRGBPlanar(HipInteropDeviceMem& hip_interop_dev_mem, uint32_t picture_width, uint32_t picture_height, RocJpegImage *destination, const RocJpegDecodeParams *decode_params, bool is_roi_valid) {
+RocJpegStatus RocJpegDecoder::ColorConvertToRGBPlanar(HipInteropDeviceMem& hip_interop_dev_mem, uint32_t picture_width, uint32_t picture_height, RocJpegImage *destination, const RocJpegDecodeParams *decode_params, bool is_roi_valid, uint8_t orientation) {
+    if (orientation != ROCJPEG_ORIENTATION_NORMAL && hip_interop_dev_mem.surface_format != VA_FOURCC_RGBP) {
+        OrientedSourceImage src_image = {};
+        CHECK_ROCJPEG(GetOrientedSourceImage(hip_interop_dev_mem, decode_params, is_roi_valid, src_image));
+        ColorConvertToRGBOriented(hip_stream_, picture_width, picture_height, orientation, destination->channel[0], destination->channel[1],
+                                  destination->channel[2], 1, destination->pitch[0], src_image);
+        return ROCJPEG_STATUS_SUCCESS;
+    }
     uint32_t roi_offset = 0;
     uint32_t roi_uv_offset = 0;
     int16_t top = decode_params->crop_rectangle.top;
@@ -546,7 +1309,7 @@ RocJpegStatus RocJpegDecoder::ColorConvertToRGBPlanar(HipInteropDeviceMem& hip_i
         case VA_FOURCC_RGBP:
             // Copy red, green, and blue channels from the interop memory into the destination
             for (uint8_t channel_index = 0; channel_index < 3; channel_index++) {
-                CHECK_ROCJPEG(CopyChannel(hip_interop_dev_mem, picture_height, channel_index, destination, decode_params, is_roi_valid));
+                CHECK_ROCJPEG(CopyChannel(hip_interop_dev_mem, picture_width, picture_height, channel_index, destination, decode_params, is_roi_valid, orientation));
             }
            break;
         default:
@@ -571,9 +1334,10 @@ RocJpegStatus RocJpegDecoder::ColorConvertToRGBPlanar(HipInteropDeviceMem& hip_i
  * @param picture_height The height of the input picture.
  * @param chroma_height The height of the chroma channels.
  * @param destination Pointer to the RocJpegImage object where the converted image data will be stored.
+ * @param orientation The EXIF orientation to apply to each channel.
  * @return The status of the operation. Returns ROCJPEG_STATUS_SUCCESS if successful.
  */
-RocJpegStatus RocJpegDecoder::GetPlanarYUVOutputFormat(HipInteropDeviceMem& hip_interop_dev_mem, uint32_t picture_width, uint32_t picture_height, uint16_t chroma_height, RocJpegImage *destination, const RocJpegDecodeParams *decode_params, bool is_roi_valid) {
+RocJpegStatus RocJpegDecoder::GetPlanarYUVOutputFormat(HipInteropDeviceMem& hip_interop_dev_mem, uint32_t picture_width, uint32_t picture_height, uint16_t chroma_height, RocJpegImage *destination, const RocJpegDecodeParams *decode_params, bool is_roi_valid, uint8_t orientation) {
     uint32_t roi_offset = 0;
     if (is_roi_valid) {
          int16_t top = decode_params->crop_rectangle.top;
@@ -584,21 +1348,37 @@ RocJpegStatus RocJpegDecoder::GetPlanarYUVOutputFormat(HipInteropDeviceMem& hip_
             roi_offset = top * hip_interop_dev_mem.pitch[0] + (left * 2);
          }
     }
-    if (hip_interop_dev_mem.surface_format == ROCJPEG_FOURCC_YUYV) {
+    if (hip_interop_dev_mem.surface_format == ROCJPEG_FOURCC_YUYV && orientation != ROCJPEG_ORIENTATION_NORMAL) {
+        // Extract the Y, U, and V samples of the packed YUYV while reorienting them.
+        const uint8_t *src_yuyv_image = hip_interop_dev_mem.hip_mapped_device_mem + roi_offset;
+        CopyPlaneOriented(hip_stream_, picture_width, picture_height, orientation, destination->channel[0], destination->pitch[0],
+                          src_yuyv_image, hip_interop_dev_mem.pitch[0], 2, 1);
+        CopyPlaneOriented(hip_stream_, picture_width >> 1, picture_height, orientation, destination->channel[1], destination->pitch[1],
+                          src_yuyv_image + 1, hip_interop_dev_mem.pitch[0], 4, 1);
+        CopyPlaneOriented(hip_stream_, picture_width >> 1, picture_height, orientation, destination->channel[2], destination->pitch[2],
+                          src_yuyv_image + 3, hip_interop_dev_mem.pitch[0], 4, 1);
+    } else if (hip_interop_dev_mem.surface_format == ROCJPEG_FOURCC_YUYV) {
         // Extract the packed YUYV and copy them into the first, second, and third channels of the destination.
         ConvertPackedYUYVToPlanarYUV(hip_stream_, picture_width, picture_height, destination->channel[0], destination->channel[1], destination->channel[2],
                                                   destination->pitch[0], destination->pitch[1], hip_interop_dev_mem.hip_mapped_device_mem + roi_offset, hip_interop_dev_mem.pitch[0]);
     } else {
         // Copy Luma
-        CHECK_ROCJPEG(CopyChannel(hip_interop_dev_mem, picture_height, 0, destination, decode_params, is_roi_valid));
-        if (hip_interop_dev_mem.surface_format == VA_FOURCC_NV12) {
+        CHECK_ROCJPEG(CopyChannel(hip_interop_dev_mem, picture_width, picture_height, 0, destination, decode_params, is_roi_valid, orientation));
+        if (hip_interop_dev_mem.surface_format == VA_FOURCC_NV12 && orientation != ROCJPEG_ORIENTATION_NORMAL) {
+            // Extract the interleaved UV channels while reorienting them.
+            const uint8_t *src_uv_image = hip_interop_dev_mem.hip_mapped_device_mem + hip_interop_dev_mem.offset[1] + roi_offset;
+            CopyPlaneOriented(hip_stream_, picture_width >> 1, picture_height >> 1, orientation, destination->channel[1], destination->pitch[1],
+                              src_uv_image, hip_interop_dev_mem.pitch[1], 2, 1);
+            CopyPlaneOriented(hip_stream_, picture_width >> 1, picture_height >> 1, orientation, destination->channel[2], destination->pitch[1],
+                              src_uv_image + 1, hip_interop_dev_mem.pitch[1], 2, 1);
+        } else if (hip_interop_dev_mem.surface_format == VA_FOURCC_NV12) {
             // Extract the interleaved UV channels and copy them into the second and third channels of the destination.
             ConvertInterleavedUVToPlanarUV(hip_stream_, picture_width >> 1, picture_height >> 1, destination->channel[1], destination->channel[2],
                 destination->pitch[1], hip_interop_dev_mem.hip_mapped_device_mem + hip_interop_dev_mem.offset[1] + roi_offset, hip_interop_dev_mem.pitch[1]);
         } else if (hip_interop_dev_mem.surface_format == VA_FOURCC_444P ||
                    hip_interop_dev_mem.surface_format == VA_FOURCC_422V) {
-            CHECK_ROCJPEG(CopyChannel(hip_interop_dev_mem, chroma_height, 1, destination, decode_params, is_roi_valid));
-            CHECK_ROCJPEG(CopyChannel(hip_interop_dev_mem, chroma_height, 2, destination, decode_params, is_roi_valid));
+            CHECK_ROCJPEG(CopyChannel(hip_interop_dev_mem, picture_width, chroma_height, 1, destination, decode_params, is_roi_valid, orientation));
+            CHECK_ROCJPEG(CopyChannel(hip_interop_dev_mem, picture_width, chroma_height, 2, destination, decode_params, is_roi_valid, orientation));
         }
     }
     return ROCJPEG_STATUS_SUCCESS;
@@ -615,9 +1395,10 @@ RocJpegStatus RocJpegDecoder::GetPlanarYUVOutputFormat(HipInteropDeviceMem& hip_
  * @param picture_width The width of the picture.
  * @param picture_height The height of the picture.
  * @param destination Pointer to the RocJpegImage object where the extracted Y component will be stored.
+ * @param orientation The EXIF orientation to apply to the Y component.
  * @return The status of the operation. Returns ROCJPEG_STATUS_SUCCESS if successful.
  */
-RocJpegStatus RocJpegDecoder::GetYOutputFormat(HipInteropDeviceMem& hip_interop_dev_mem, uint32_t picture_width, uint32_t picture_height, RocJpegImage *destination, const RocJpegDecodeParams *decode_params, bool is_roi_valid) {
+RocJpegStatus RocJpegDecoder::GetYOutputFormat(HipInteropDeviceMem& hip_interop_dev_mem, uint32_t picture_width, uint32_t picture_height, RocJpegImage *destination, const RocJpegDecodeParams *decode_params, bool is_roi_valid, uint8_t orientation) {
     uint32_t roi_offset = 0; 
     if (hip_interop_dev_mem.surface_format == ROCJPEG_FOURCC_YUYV) {
         // calculate offset and add to hip_mapped_device_mem
@@ -626,11 +1407,115 @@ RocJpegStatus RocJpegDecoder::GetYOutputFormat(HipInteropDeviceMem& hip_interop_
                 int16_t left = decode_params->crop_rectangle.left * 2;
                 roi_offset = top * hip_interop_dev_mem.pitch[0] + left;
         }
-        ExtractYFromPackedYUYV(hip_stream_, picture_width, picture_height, destination->channel[0], destination->pitch[0],
-                              hip_interop_dev_mem.hip_mapped_device_mem + roi_offset, hip_interop_dev_mem.pitch[0]);
+        if (orientation != ROCJPEG_ORIENTATION_NORMAL) {
+            CopyPlaneOriented(hip_stream_, picture_width, picture_height, orientation, destination->channel[0], destination->pitch[0],
+                              hip_interop_dev_mem.hip_mapped_device_mem + roi_offset, hip_interop_dev_mem.pitch[0], 2, 1);
+        } else {
+            ExtractYFromPackedYUYV(hip_stream_, picture_width, picture_height, destination->channel[0], destination->pitch[0],
+                                  hip_interop_dev_mem.hip_mapped_device_mem + roi_offset, hip_interop_dev_mem.pitch[0]);
+        }
     } else {
         // Copy Luma
-        CHECK_ROCJPEG(CopyChannel(hip_interop_dev_mem, picture_height, 0, destination, decode_params, is_roi_valid));
+        CHECK_ROCJPEG(CopyChannel(hip_interop_dev_mem, picture_width, picture_height, 0, destination, decode_params, is_roi_valid, orientation));
+    }
+    return ROCJPEG_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Determines the orientation to apply to the output of a JPEG stream.
+ *
+ * ROCJPEG_ORIENTATION_NONE leaves the image as stored, ROCJPEG_ORIENTATION_EXIF selects the orientation found in the EXIF data
+ * of the stream, and the values 1 to 8 are applied as given.
+ *
+ * @param decode_params The decode parameters.
+ * @param jpeg_stream_params The parsed JPEG stream parameters.
+ * @param orientation Reference to store the EXIF orientation (1 to 8) to apply.
+ * @return The status of the operation. Returns ROCJPEG_STATUS_INVALID_PARAMETER if the requested orientation is invalid, or
+ *         ROCJPEG_STATUS_JPEG_NOT_SUPPORTED if the orientation can't be applied to the native output of a 4:2:2 image.
+ */
+RocJpegStatus RocJpegDecoder::GetOutputOrientation(const RocJpegDecodeParams *decode_params, const JpegStreamParameters *jpeg_stream_params, uint8_t &orientation) {
+    if (decode_params->orientation == ROCJPEG_ORIENTATION_NONE) {
+        orientation = ROCJPEG_ORIENTATION_NORMAL;
+    } else if (decode_params->orientation == ROCJPEG_ORIENTATION_EXIF) {
+        orientation = jpeg_stream_params->orientation;
+    } else if (decode_params->orientation >= ROCJPEG_ORIENTATION_NORMAL && decode_params->orientation <= ROCJPEG_ORIENTATION_ROTATE_270) {
+        orientation = static_cast<uint8_t>(decode_params->orientation);
+    } else {
+        ERR("ERROR: invalid orientation!");
+        return ROCJPEG_STATUS_INVALID_PARAMETER;
+    }
+    // The packed YUYV layout of 4:2:2 images can't be reoriented in place (the pixel pairs would share their chroma vertically).
+    if (orientation != ROCJPEG_ORIENTATION_NORMAL && decode_params->output_format == ROCJPEG_OUTPUT_NATIVE && jpeg_stream_params->chroma_subsampling == CSS_422) {
+        ERR("ERROR: the orientation is not supported for the native output of YUV 4:2:2 images!");
+        return ROCJPEG_STATUS_JPEG_NOT_SUPPORTED;
     }
     return ROCJPEG_STATUS_SUCCESS;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Describes the decoded picture in the interop memory for the oriented color conversion kernel.
+ *
+ * @param hip_interop_dev_mem The HipInteropDeviceMem object containing the decoded picture.
+ * @param decode_params The decode parameters that specify the crop rectangle.
+ * @param is_roi_valid True if the crop rectangle has to be applied.
+ * @param src_image Reference to store the description of the picture.
+ * @return The status of the operation. Returns ROCJPEG_STATUS_JPEG_NOT_SUPPORTED if the surface format is not supported.
+ */
+RocJpegStatus RocJpegDecoder::GetOrientedSourceImage(HipInteropDeviceMem& hip_interop_dev_mem, const RocJpegDecodeParams *decode_params, bool is_roi_valid, OrientedSourceImage &src_image) {
+    uint32_t top = is_roi_valid ? decode_params->crop_rectangle.top : 0;
+    uint32_t left = is_roi_valid ? decode_params->crop_rectangle.left : 0;
+    const uint8_t *base = hip_interop_dev_mem.hip_mapped_device_mem;
+
+    src_image.y_image_stride_in_bytes = hip_interop_dev_mem.pitch[0];
+    src_image.y_sample_step = 1;
+    src_image.uv_image_stride_in_bytes = hip_interop_dev_mem.pitch[1];
+    src_image.uv_sample_step = 1;
+    switch (hip_interop_dev_mem.surface_format) {
+        case VA_FOURCC_444P:
+            src_image.y_image = base + top * hip_interop_dev_mem.pitch[0] + left;
+            src_image.u_image = base + hip_interop_dev_mem.offset[1] + top * hip_interop_dev_mem.pitch[1] + left;
+            src_image.v_image = base + hip_interop_dev_mem.offset[2] + top * hip_interop_dev_mem.pitch[2] + left;
+            break;
+        case VA_FOURCC_422V:
+            src_image.y_image = base + top * hip_interop_dev_mem.pitch[0] + left;
+            src_image.u_image = base + hip_interop_dev_mem.offset[1] + (top >> 1) * hip_interop_dev_mem.pitch[1] + left;
+            src_image.v_image = base + hip_interop_dev_mem.offset[2] + (top >> 1) * hip_interop_dev_mem.pitch[2] + left;
+            src_image.uv_shift_y = 1;
+            break;
+        case ROCJPEG_FOURCC_YUYV:
+            src_image.y_image = base + top * hip_interop_dev_mem.pitch[0] + left * 2;
+            src_image.u_image = src_image.y_image + 1;
+            src_image.v_image = src_image.y_image + 3;
+            src_image.y_sample_step = 2;
+            src_image.uv_image_stride_in_bytes = hip_interop_dev_mem.pitch[0];
+            src_image.uv_sample_step = 4;
+            src_image.uv_shift_x = 1;
+            break;
+        case VA_FOURCC_NV12:
+            src_image.y_image = base + top * hip_interop_dev_mem.pitch[0] + left;
+            src_image.u_image = base + hip_interop_dev_mem.offset[1] + (top >> 1) * hip_interop_dev_mem.pitch[1] + left;
+            src_image.v_image = src_image.u_image + 1;
+            src_image.uv_sample_step = 2;
+            src_image.uv_shift_x = 1;
+            src_image.uv_shift_y = 1;
+            break;
+        case VA_FOURCC_Y800:
+            src_image.y_image = base + top * hip_interop_dev_mem.pitch[0] + left;
+            src_image.u_image = nullptr;
+            src_image.v_image = nullptr;
+            break;
+        case VA_FOURCC_RGBA:
+            src_image.y_image = base + top * hip_interop_dev_mem.pitch[0] + left * 4;
+            src_image.u_image = src_image.y_image + 1;
+            src_image.v_image = src_image.y_image + 2;
+            src_image.y_sample_step = 4;
+            src_image.uv_image_stride_in_bytes = hip_interop_dev_mem.pitch[0];
+            src_image.uv_sample_step = 4;
+            src_image.is_rgb = true;
+            break;
+        default:
+            ERR("ERROR! surface format is not supported!");
+            return ROCJPEG_STATUS_JPEG_NOT_SUPPORTED;
+    }
+    return ROCJPEG_STATUS_SUCCESS;
+}
@@ -25,6 +25,7 @@ THE SOFTWARE.
 
 #include <unistd.h>
 #include <vector>
+#include <algorithm>
 #include <mutex>
 #include <queue>
 #include "../api/rocjpeg.h"
@@ -32,6 +33,9 @@ THE SOFTWARE.
 #include "rocjpeg_parser.h"
 #include "rocjpeg_commons.h"
 #include "rocjpeg_vaapi_decoder.h"
+#include "rocjpeg_hybrid_decoder.h"
+#include "rocjpeg_cpu_decoder.h"
+#include "rocjpeg_coefficient_decoder.h"
 #include "rocjpeg_hip_kernels.h"
 
 /**
@@ -75,6 +79,16 @@ public:
     */
    RocJpegStatus GetImageInfo(RocJpegStreamHandle jpeg_stream, uint8_t *num_components, RocJpegChromaSubsampling *subsampling, uint32_t *widths, uint32_t *heights);
 
+   /**
+    * @brief Computes the image information from the parsed JPEG stream parameters.
+    * @param jpeg_stream_params The parsed JPEG stream parameters (only the frame header fields are used).
+    * @param num_components Pointer to store the number of color components in the image.
+    * @param subsampling Pointer to store the chroma subsampling information.
+    * @param widths Pointer to store the widths of the image components.
+    * @param heights Pointer to store the heights of the image components.
+    */
+   static void GetImageInfo(const JpegStreamParameters &jpeg_stream_params, uint8_t *num_components, RocJpegChromaSubsampling *subsampling, uint32_t *widths, uint32_t *heights);
+
    /**
     * @brief Decodes the JPEG image.
     * @param jpeg_stream The handle to the JPEG stream.
@@ -99,6 +113,23 @@ public:
     */
    RocJpegStatus DecodeBatched(RocJpegStreamHandle *jpeg_streams, int batch_size, const RocJpegDecodeParams *decode_params, RocJpegImage *destinations);
 
+   /**
+    * @brief Retrieves the number of images decoded by each decode path.
+    * @param stats Pointer to store the counts.
+    */
+   void GetDecodeRouteStats(RocJpegDecodeRouteStats *stats);
+
+   /**
+    * @brief Decodes the DCT coefficients of a batch of JPEG streams.
+    * @param jpeg_streams The array of JPEG stream handles.
+    * @param batch_size The number of JPEG streams in the batch.
+    * @param coefficient_params The parameters of the decode.
+    * @param destinations The array of destination coefficient planes.
+    * @return The status of the decoding operation.
+    */
+   RocJpegStatus DecodeCoefficientsBatched(RocJpegStreamHandle *jpeg_streams, int batch_size, const RocJpegCoefficientParams *coefficient_params,
+                                           RocJpegCoefficientImage *destinations);
+
 private:
    /**
     * @brief Initializes the HIP framework.
@@ -119,12 +150,14 @@ private:
    /**
     * @brief Copies a channel from the HIP interop device memory to the destination image.
     * @param hip_interop The HIP interop device memory.
+    * @param channel_width The width of the channel in samples.
     * @param channel_height The height of the channel.
     * @param channel_index The index of the channel.
     * @param destination Pointer to the destination image.
+    * @param orientation The EXIF orientation to apply.
     * @return The status of the operation.
     */
-   RocJpegStatus CopyChannel(HipInteropDeviceMem& hip_interop, uint16_t channel_height, uint8_t channel_index, RocJpegImage *destination, const RocJpegDecodeParams *decode_params, bool is_roi_valid);
+   RocJpegStatus CopyChannel(HipInteropDeviceMem& hip_interop, uint16_t channel_width, uint16_t channel_height, uint8_t channel_index, RocJpegImage *destination, const RocJpegDecodeParams *decode_params, bool is_roi_valid, uint8_t orientation);
 
    /**
     * @brief Converts the image to RGB color space.
@@ -132,9 +165,10 @@ private:
     * @param picture_width The width of the picture.
     * @param picture_height The height of the picture.
     * @param destination Pointer to the destination image.
+    * @param orientation The EXIF orientation to apply.
     * @return The status of the operation.
     */
-   RocJpegStatus ColorConvertToRGB(HipInteropDeviceMem& hip_interop, uint32_t picture_width, uint32_t picture_height, RocJpegImage *destination, const RocJpegDecodeParams *decode_params, bool is_roi_valid);
+   RocJpegStatus ColorConvertToRGB(HipInteropDeviceMem& hip_interop, uint32_t picture_width, uint32_t picture_height, RocJpegImage *destination, const RocJpegDecodeParams *decode_params, bool is_roi_valid, uint8_t orientation);
 
    /**
     * @brief Converts the image to RGB planar color space.
@@ -142,9 +176,10 @@ private:
     * @param picture_width The width of the picture.
     * @param picture_height The height of the picture.
     * @param destination Pointer to the destination image.
+    * @param orientation The EXIF orientation to apply.
     * @return The status of the operation.
     */
-   RocJpegStatus ColorConvertToRGBPlanar(HipInteropDeviceMem& hip_interop, uint32_t picture_width, uint32_t picture_height, RocJpegImage *destination, const RocJpegDecodeParams *decode_params, bool is_roi_valid);
+   RocJpegStatus ColorConvertToRGBPlanar(HipInteropDeviceMem& hip_interop, uint32_t picture_width, uint32_t picture_height, RocJpegImage *destination, const RocJpegDecodeParams *decode_params, bool is_roi_valid, uint8_t orientation);
 
    /**
     * @brief Retrieves the output format for planar YUV images.
@@ -153,9 +188,29 @@ private:
     * @param picture_height The height of the picture.
     * @param chroma_height The height of the chroma channel.
     * @param destination Pointer to the destination image.
+    * @param orientation The EXIF orientation to apply.
+    * @return The status of the operation.
+    */
+   RocJpegStatus GetPlanarYUVOutputFormat(HipInteropDeviceMem& hip_interop, uint32_t picture_width, uint32_t picture_height, uint16_t chroma_height, RocJpegImage *destination, const RocJpegDecodeParams *decode_params, bool is_roi_valid, uint8_t orientation);
+
+   /**
+    * @brief Determines the EXIF orientation (1 to 8) to apply to the output of a JPEG stream.
+    * @param decode_params The decoding parameters.
+    * @param jpeg_stream_params The parsed JPEG stream parameters.
+    * @param orientation Reference to store the orientation.
     * @return The status of the operation.
     */
-   RocJpegStatus GetPlanarYUVOutputFormat(HipInteropDeviceMem& hip_interop, uint32_t picture_width, uint32_t picture_height, uint16_t chroma_height, RocJpegImage *destination, const RocJpegDecodeParams *decode_params, bool is_roi_valid);
+   RocJpegStatus GetOutputOrientation(const RocJpegDecodeParams *decode_params, const JpegStreamParameters *jpeg_stream_params, uint8_t &orientation);
+
+   /**
+    * @brief Describes the decoded picture in the HIP interop device memory for the oriented color conversion.
+    * @param hip_interop The HIP interop device memory.
+    * @param decode_params The decoding parameters.
+    * @param is_roi_valid True if the crop rectangle has to be applied.
+    * @param src_image Reference to store the description of the picture.
+    * @return The status of the operation.
+    */
+   RocJpegStatus GetOrientedSourceImage(HipInteropDeviceMem& hip_interop, const RocJpegDecodeParams *decode_params, bool is_roi_valid, OrientedSourceImage &src_image);
 
    /**
     * @brief Retrieves the output format for Y images.
@@ -163,9 +218,172 @@ private:
     * @param picture_width The width of the picture.
     * @param picture_height The height of the picture.
     * @param destination Pointer to the destination image.
+    * @param orientation The EXIF orientation to apply.
+    * @return The status of the operation.
+    */
+   RocJpegStatus GetYOutputFormat(HipInteropDeviceMem& hip_interop, uint32_t picture_width, uint32_t picture_height, RocJpegImage *destination, const RocJpegDecodeParams *decode_params, bool is_roi_valid, uint8_t orientation);
+
+   /**
+    * @brief Writes a decoded picture to the destination image in the requested output format.
+    * @param hip_interop The HIP interop device memory holding the decoded picture.
+    * @param jpeg_stream_params The parsed JPEG stream parameters.
+    * @param decode_params The decoding parameters.
+    * @param is_roi_decoded True if the decoder has already applied the crop rectangle.
+    * @param orientation The EXIF orientation to apply.
+    * @param destination Pointer to the destination image.
+    * @return The status of the operation.
+    */
+   RocJpegStatus OutputDecodedPicture(HipInteropDeviceMem& hip_interop, const JpegStreamParameters *jpeg_stream_params, const RocJpegDecodeParams *decode_params, bool is_roi_decoded, uint8_t orientation, RocJpegImage *destination);
+
+   /**
+    * @brief Checks if an output format has 16-bit samples.
+    * @param output_format The output format.
+    * @return True for the 16-bit output formats, false otherwise.
+    */
+   static bool Is16BitOutputFormat(RocJpegOutputFormat output_format);
+
+   /**
+    * @brief The paths that decode the images of the hardware and hybrid backends.
+    */
+   enum DecodeRoute {
+      kDecodeRouteHardware = 0, ///< Decoded by the VCN JPEG decoder.
+      kDecodeRouteHybrid = 1, ///< Entropy decoded on the CPU, with the IDCT and the output stage on the GPU.
+      kDecodeRouteCpu = 2, ///< Decoded on the CPU into host memory, then copied to the destination.
+   };
+
+   /**
+    * @brief Selects the path that decodes a JPEG stream and counts the images routed away from the VCN JPEG decoder.
+    * @param jpeg_stream_params The parsed JPEG stream parameters.
+    * @param decode_params The decoding parameters.
+    * @return The decode route of the stream.
+    */
+   DecodeRoute GetDecodeRoute(const JpegStreamParameters *jpeg_stream_params, const RocJpegDecodeParams *decode_params);
+
+   /**
+    * @brief Decodes a sub-batch of the streams routed to the hybrid decoder, one stream per thread of the pool.
+    * @param jpeg_streams The JPEG stream handles of the batch.
+    * @param indices The indices in the batch of the streams to decode.
+    * @param count The number of streams to decode.
+    * @param decode_params The decoding parameters.
+    * @param destinations The destination images of the batch.
+    * @return The status of the decoding operation.
+    */
+   RocJpegStatus DecodeHybridSubBatch(RocJpegStreamHandle *jpeg_streams, const int *indices, int count, const RocJpegDecodeParams *decode_params,
+                                      RocJpegImage *destinations);
+
+   /**
+    * @brief Decodes a sub-batch of the streams routed to the CPU, one stream per thread of the pool, and copies them to their destinations.
+    * @param jpeg_streams The JPEG stream handles of the batch.
+    * @param indices The indices in the batch of the streams to decode.
+    * @param count The number of streams to decode.
+    * @param decode_params The decoding parameters.
+    * @param destinations The destination images of the batch, in device memory.
+    * @return The status of the decoding operation.
+    */
+   RocJpegStatus DecodeCpuSubBatch(RocJpegStreamHandle *jpeg_streams, const int *indices, int count, const RocJpegDecodeParams *decode_params,
+                                   RocJpegImage *destinations);
+
+   /**
+    * @brief Scales the picture size and the crop rectangle of a stream to its DC-only preview (one sample per 8x8 block).
+    * @param jpeg_stream_params The parsed JPEG stream parameters.
+    * @param decode_params The decoding parameters.
+    * @param preview_stream_params The stream parameters with the size of the preview.
+    * @param preview_decode_params The decoding parameters with the crop rectangle in the coordinates of the preview.
+    */
+   static void GetPreviewParameters(const JpegStreamParameters *jpeg_stream_params, const RocJpegDecodeParams *decode_params,
+                                    JpegStreamParameters &preview_stream_params, RocJpegDecodeParams &preview_decode_params);
+
+   /**
+    * @brief Counts an image decoded by the VCN JPEG decoder in the decode route statistics.
+    * @param jpeg_stream_params The parsed JPEG stream parameters.
+    */
+   void CountHardwareDecode(const JpegStreamParameters *jpeg_stream_params);
+
+   /**
+    * @brief Writes a picture decoded by the VCN JPEG decoder to its destination and counts it in the decode route statistics.
+    * @param surface_id The synced VA surface holding the decoded picture.
+    * @param jpeg_stream_params The parsed JPEG stream parameters.
+    * @param decode_params The decoding parameters.
+    * @param destination The destination image.
+    * @return The status of the operation.
+    */
+   RocJpegStatus OutputHardwareDecodedPicture(VASurfaceID surface_id, const JpegStreamParameters *jpeg_stream_params, const RocJpegDecodeParams *decode_params,
+                                              RocJpegImage *destination);
+
+   /**
+    * @brief Keeps the status of the first image of a batch that failed to decode.
+    * @param rocjpeg_status The status of an image or a sub-batch.
+    * @param batch_status The status of the batch, updated if it is still ROCJPEG_STATUS_SUCCESS.
+    */
+   static void UpdateBatchStatus(RocJpegStatus rocjpeg_status, RocJpegStatus &batch_status);
+
+   /**
+    * @brief Decodes a batch of JPEG streams with the CPU decoders of the ROCJPEG_BACKEND_CPU backend.
+    * @param jpeg_streams The JPEG stream handles.
+    * @param batch_size The number of JPEG streams in the batch.
+    * @param decode_params The decoding parameters.
+    * @param destinations The destination images, in host memory.
+    * @return The status of the decoding operation.
+    */
+   RocJpegStatus DecodeBatchedOnCpu(RocJpegStreamHandle *jpeg_streams, int batch_size, const RocJpegDecodeParams *decode_params, RocJpegImage *destinations);
+
+   /**
+    * @brief Describes a ROCJPEG_FOURCC_YUV16 picture written by the hybrid decoder.
+    * @param hip_interop The HIP interop device memory.
+    * @param jpeg_stream_params The parsed JPEG stream parameters.
+    * @param decode_params The decoding parameters.
+    * @param is_roi_valid True if the crop rectangle has to be applied.
+    * @param src_image Reference to store the description of the picture.
+    * @return The status of the operation.
+    */
+   RocJpegStatus GetYUV16SourceImage(HipInteropDeviceMem& hip_interop, const JpegStreamParameters *jpeg_stream_params, const RocJpegDecodeParams *decode_params, bool is_roi_valid, OrientedSourceImage &src_image);
+
+   /**
+    * @brief Describes a picture with four components (CMYK or YCCK) written by the hybrid decoder.
+    * @param hip_interop The HIP interop device memory.
+    * @param jpeg_stream_params The parsed JPEG stream parameters.
+    * @param decode_params The decoding parameters.
+    * @param is_roi_valid True if the crop rectangle has to be applied.
+    * @param src_image Reference to store the description of the picture.
+    * @return The status of the operation.
+    */
+   RocJpegStatus GetCmykSourceImage(HipInteropDeviceMem& hip_interop, const JpegStreamParameters *jpeg_stream_params, const RocJpegDecodeParams *decode_params, bool is_roi_valid, OrientedCmykSourceImage &src_image);
+
+   /**
+    * @brief Retrieves the output of a picture with four components (CMYK or YCCK) for any output format.
+    * @param hip_interop The HIP interop device memory.
+    * @param jpeg_stream_params The parsed JPEG stream parameters.
+    * @param picture_width The width of the picture.
+    * @param picture_height The height of the picture.
+    * @param destination Pointer to the destination image.
+    * @param orientation The EXIF orientation to apply.
+    * @return The status of the operation.
+    */
+   RocJpegStatus GetFourComponentOutputFormat(HipInteropDeviceMem& hip_interop, const JpegStreamParameters *jpeg_stream_params, uint32_t picture_width, uint32_t picture_height, RocJpegImage *destination, const RocJpegDecodeParams *decode_params, bool is_roi_valid, uint8_t orientation);
+
+   /**
+    * @brief Retrieves the output for the ROCJPEG_OUTPUT_YUV_PLANAR_16 and ROCJPEG_OUTPUT_Y_16 formats.
+    * @param hip_interop The HIP interop device memory.
+    * @param jpeg_stream_params The parsed JPEG stream parameters.
+    * @param picture_width The width of the picture.
+    * @param picture_height The height of the picture.
+    * @param destination Pointer to the destination image.
+    * @param orientation The EXIF orientation to apply.
+    * @return The status of the operation.
+    */
+   RocJpegStatus GetYUV16OutputFormat(HipInteropDeviceMem& hip_interop, const JpegStreamParameters *jpeg_stream_params, uint32_t picture_width, uint32_t picture_height, RocJpegImage *destination, const RocJpegDecodeParams *decode_params, bool is_roi_valid, uint8_t orientation);
+
+   /**
+    * @brief Converts the image to RGB or RGB planar with 16-bit samples.
+    * @param hip_interop The HIP interop device memory.
+    * @param jpeg_stream_params The parsed JPEG stream parameters.
+    * @param picture_width The width of the picture.
+    * @param picture_height The height of the picture.
+    * @param destination Pointer to the destination image.
+    * @param orientation The EXIF orientation to apply.
     * @return The status of the operation.
     */
-   RocJpegStatus GetYOutputFormat(HipInteropDeviceMem& hip_interop, uint32_t picture_width, uint32_t picture_height, RocJpegImage *destination, const RocJpegDecodeParams *decode_params, bool is_roi_valid);
+   RocJpegStatus ColorConvertToRGB16(HipInteropDeviceMem& hip_interop, const JpegStreamParameters *jpeg_stream_params, uint32_t picture_width, uint32_t picture_height, RocJpegImage *destination, const RocJpegDecodeParams *decode_params, bool is_roi_valid, uint8_t orientation);
 
    int num_devices_; // Number of available devices
    int device_id_; // ID of the device to be used
@@ -174,6 +392,12 @@ private:
    std::mutex mutex_; // Mutex for thread safety
    RocJpegBackend backend_; // RocJpeg backend
    RocJpegVappiDecoder jpeg_vaapi_decoder_; // RocJpeg VAAPI decoder object
+   RocJpegHybridDecoder hybrid_decoder_; // Decoder for the streams the VCN JPEG decoder can't decode
+   std::vector<RocJpegCpuDecoder> cpu_decoders_; // Decoders of the ROCJPEG_BACKEND_CPU backend and of the CPU route, one per thread of the pool
+   std::vector<uint8_t*> cpu_staging_buffers_; // Pinned host images of the streams of the CPU route, one per thread of the pool
+   std::vector<size_t> cpu_staging_buffer_sizes_; // The size in bytes of each staging buffer
+   RocJpegCoefficientDecoder coefficient_decoder_; // Decoder of the DCT coefficients of rocJpegDecodeCoefficients()
+   RocJpegDecodeRouteStats route_stats_; // Number of images decoded by each decode path
 };
 
 #endif //ROC_JPEG_DECODER_H_
\ No newline at end of file
@@ -0,0 +1,996 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include "rocjpeg_entropy_decoder.h"
+
+/**
+ * @brief The natural (row-major) position of the coefficients in zigzag order.
+ *
+ * The extra entries let a corrupt run length index past the last coefficient without leaving the block,
+ * as in the IJG libjpeg.
+ */
+static const uint8_t kZigzagToNatural[DCT_BLOCK_SIZE + 16] = {
+     0,  1,  8, 16,  9,  2,  3, 10,
+    17, 24, 32, 25, 18, 11,  4,  5,
+    12, 19, 26, 33, 40, 48, 41, 34,
+    27, 20, 13,  6,  7, 14, 21, 28,
+    35, 42, 49, 56, 57, 50, 43, 36,
+    29, 22, 15, 23, 30, 37, 44, 51,
+    58, 59, 52, 45, 38, 31, 39, 46,
+    53, 60, 61, 54, 47, 55, 62, 63,
+    63, 63, 63, 63, 63, 63, 63, 63,
+    63, 63, 63, 63, 63, 63, 63, 63
+};
+
+RocJpegEntropyDecoder::RocJpegEntropyDecoder() : jpeg_stream_params_{nullptr}, frame_{}, component_seen_{}, decode_tables_id_{0},
+    is_decode_table_built_{}, thread_pool_{&RocJpegThreadPool::GetInstance()}, is_dc_only_{false} {}
+
+/**
+ * @brief Copies a quantization table of the parser, in zigzag order, to a component in natural order.
+ *
+ * @param quantiser_table The quantization table, in zigzag order.
+ * @param component The component.
+ */
+static void SetQuantizationTable(const uint16_t *quantiser_table, JpegCoefficientComponent &component) {
+    for (int32_t k = 0; k < DCT_BLOCK_SIZE; k++) {
+        component.quantization_table[kZigzagToNatural[k]] = quantiser_table[k];
+    }
+}
+
+/**
+ * @brief Sets the stream to decode and computes the layout of its coefficients.
+ *
+ * The frame header parsed by the stream parser gives the dimensions and the sampling factors of the components,
+ * from which the size of the blocks of each component, padded to a whole number of MCUs, and their offset in the
+ * coefficient buffer are computed. The scans and the tables in effect for each of them are taken from the stream
+ * parameters as well, so the stream isn't parsed again.
+ *
+ * @param jpeg_stream_params The parameters of the stream, which must stay valid until the coefficients are decoded.
+ * @param image The layout of the coefficients of the frame.
+ * @return True if the stream parameters describe a frame the decoder supports, false otherwise.
+ */
+bool RocJpegEntropyDecoder::SetStreamParameters(const JpegStreamParameters *jpeg_stream_params, JpegCoefficientImage &image) {
+    jpeg_stream_params_ = nullptr;
+    if (jpeg_stream_params == nullptr || jpeg_stream_params->slice_data_buffer == nullptr || jpeg_stream_params->scans == nullptr ||
+        jpeg_stream_params->num_scans == 0) {
+        ERR("the JPEG stream is not completely parsed!");
+        return false;
+    }
+    const PictureParameterBuffer &picture_parameter_buffer = jpeg_stream_params->picture_parameter_buffer;
+    frame_ = {};
+    frame_.coding_process = jpeg_stream_params->coding_process;
+    frame_.sample_precision = jpeg_stream_params->sample_precision;
+    frame_.width = picture_parameter_buffer.picture_width;
+    frame_.height = picture_parameter_buffer.picture_height;
+    frame_.num_components = picture_parameter_buffer.num_components;
+    // 12-bit samples are only allowed by the extended and progressive processes
+    if (frame_.sample_precision != 8 && (frame_.sample_precision != 12 || frame_.coding_process == CODING_PROCESS_BASELINE)) {
+        ERR("unsupported sample precision!");
+        return false;
+    }
+    if (frame_.width == 0 || frame_.height == 0) {
+        ERR("invalid image size!");
+        return false;
+    }
+    if (frame_.num_components == 0 || frame_.num_components > NUM_COMPONENTS) {
+        ERR("invalid number of JPEG components!");
+        return false;
+    }
+    for (int32_t i = 0; i < frame_.num_components; i++) {
+        JpegCoefficientComponent &component = frame_.components[i];
+        component.component_id = picture_parameter_buffer.components[i].component_id;
+        component.h_sampling_factor = picture_parameter_buffer.components[i].h_sampling_factor;
+        component.v_sampling_factor = picture_parameter_buffer.components[i].v_sampling_factor;
+        component.quantiser_table_selector = picture_parameter_buffer.components[i].quantiser_table_selector;
+        if (component.h_sampling_factor < 1 || component.h_sampling_factor > 4 ||
+            component.v_sampling_factor < 1 || component.v_sampling_factor > 4) {
+            ERR("invalid sampling factor!");
+            return false;
+        }
+        if (component.quantiser_table_selector >= NUM_COMPONENTS) {
+            ERR("invalid number of the quantization table!");
+            return false;
+        }
+        for (int32_t j = 0; j < i; j++) {
+            if (frame_.components[j].component_id == component.component_id) {
+                ERR("duplicate component id!");
+                return false;
+            }
+        }
+        frame_.max_h_sampling_factor = std::max(frame_.max_h_sampling_factor, component.h_sampling_factor);
+        frame_.max_v_sampling_factor = std::max(frame_.max_v_sampling_factor, component.v_sampling_factor);
+    }
+    frame_.mcus_per_row = (frame_.width + frame_.max_h_sampling_factor * 8 - 1) / (frame_.max_h_sampling_factor * 8);
+    frame_.mcu_rows = (frame_.height + frame_.max_v_sampling_factor * 8 - 1) / (frame_.max_v_sampling_factor * 8);
+    frame_.coefficients_per_block = is_dc_only_ ? 1 : DCT_BLOCK_SIZE;
+    size_t coefficient_offset = 0;
+    for (int32_t i = 0; i < frame_.num_components; i++) {
+        JpegCoefficientComponent &component = frame_.components[i];
+        component.width = (frame_.width * component.h_sampling_factor + frame_.max_h_sampling_factor - 1) / frame_.max_h_sampling_factor;
+        component.height = (frame_.height * component.v_sampling_factor + frame_.max_v_sampling_factor - 1) / frame_.max_v_sampling_factor;
+        component.width_in_blocks = frame_.mcus_per_row * component.h_sampling_factor;
+        component.height_in_blocks = frame_.mcu_rows * component.v_sampling_factor;
+        component.coefficient_offset = coefficient_offset;
+        coefficient_offset += static_cast<size_t>(component.width_in_blocks) * component.height_in_blocks * frame_.coefficients_per_block;
+    }
+    frame_.num_coefficients = coefficient_offset;
+
+    jpeg_stream_params_ = jpeg_stream_params;
+    image = frame_;
+    return true;
+}
+
+/**
+ * @brief Decodes all the scans of the stream into DCT coefficients.
+ *
+ * The scans located by the stream parser are decoded in order into the coefficient buffer, each with the tables in
+ * effect when it starts. The quantization table of a component is the table in effect at the first scan of the
+ * component; the components that aren't part of any scan get the tables of the last scan.
+ *
+ * @param image The layout of the coefficients returned by SetStreamParameters.
+ * @param coefficients The coefficient buffer.
+ * @return True if all the scans are valid, false otherwise.
+ */
+bool RocJpegEntropyDecoder::DecodeCoefficients(JpegCoefficientImage &image, int16_t *coefficients) {
+    if (jpeg_stream_params_ == nullptr || coefficients == nullptr) {
+        ERR("invalid argument!");
+        return false;
+    }
+    std::memset(coefficients, 0, frame_.num_coefficients * sizeof(int16_t));
+    std::memset(component_seen_, 0, sizeof(component_seen_));
+
+    const JpegScan *scans = jpeg_stream_params_->scans;
+    uint32_t num_scans = jpeg_stream_params_->num_scans;
+    for (uint32_t i = 0; i < num_scans; i++) {
+        if (!DecodeScan(scans[i], frame_, coefficients))
+            return false;
+    }
+
+    // the components that aren't part of any scan keep zero coefficients
+    const QuantizationTableSet *quantization_tables = scans[num_scans - 1].quantization_tables;
+    for (int32_t i = 0; i < frame_.num_components; i++) {
+        JpegCoefficientComponent &component = frame_.components[i];
+        if (!component_seen_[i]) {
+            SetQuantizationTable(quantization_tables->quantiser_table[component.quantiser_table_selector], component);
+        }
+    }
+    image = frame_;
+    return true;
+}
+
+/**
+ * @brief Returns the decoding table of a Huffman table of a scan.
+ *
+ * The decoding tables are keyed on the ID of the Huffman tables of the scan in the table cache, the same way the
+ * VA-API decoder reuses its Huffman table buffer: while the scans and the streams decoded in a row use the same
+ * tables, each decoding table is only built the first time it is used. Another ID discards the decoding tables.
+ *
+ * @param jpeg_scan The scan, as located by the parser.
+ * @param table_class The class of the table: 0 for a DC table, 1 for an AC table.
+ * @param table_selector The ID of the table.
+ * @return The decoding table, or nullptr if the table is undefined or invalid.
+ */
+const HuffmanDecodeTable* RocJpegEntropyDecoder::GetDecodeTable(const JpegScan &jpeg_scan, uint8_t table_class, uint8_t table_selector) {
+    if (decode_tables_id_ == 0 || decode_tables_id_ != jpeg_scan.huffman_table_id) {
+        std::memset(is_decode_table_built_, 0, sizeof(is_decode_table_built_));
+        decode_tables_id_ = jpeg_scan.huffman_table_id;
+    }
+    const HuffmanTable &huffman_table = table_class ? jpeg_scan.huffman_tables->ac_tables[table_selector] : jpeg_scan.huffman_tables->dc_tables[table_selector];
+    if (!huffman_table.is_defined) {
+        return nullptr;
+    }
+    HuffmanDecodeTable &decode_table = decode_tables_[table_class][table_selector];
+    if (!is_decode_table_built_[table_class][table_selector]) {
+        BuildHuffmanDecodeTable(huffman_table, table_class, decode_table);
+        is_decode_table_built_[table_class][table_selector] = true;
+    }
+    return decode_table.is_defined ? &decode_table : nullptr;
+}
+
+/**
+ * @brief Refills the bit buffer.
+ *
+ * The bytes that fit in the buffer are usually loaded with one 64-bit read: unless one of them is 0xFF, they are
+ * inserted all at once. Otherwise they are loaded one at a time, and the stuffed zero byte that follows a 0xFF data
+ * byte is removed as it is read. When a marker is reached, the reader stops in front of it and feeds zeros, as the
+ * IJG libjpeg does for corrupt or truncated data. Both ways load the same bits.
+ *
+ * @param reader The bit reader.
+ */
+void RocJpegEntropyDecoder::FillBitBuffer(BitReader &reader) {
+    int32_t bits_left = reader.bits_left;
+    if (!reader.marker_found && reader.end - reader.position >= 8) {
+        uint64_t word;
+        std::memcpy(&word, reader.position, sizeof(word));
+        word = __builtin_bswap64(word);
+        int32_t num_bytes = (64 - bits_left) >> 3;
+        uint64_t mask = ~0ULL << (64 - 8 * num_bytes);
+        // a byte of the word is 0xFF if it is zero in ~word; bytes below a zero byte may be flagged too, which only
+        // sends the refill to the byte-wise loop
+        if (((~word - 0x0101010101010101ULL) & word & 0x8080808080808080ULL & mask) == 0) {
+            reader.bit_buffer |= (word & mask) >> bits_left;
+            reader.position += num_bytes;
+            reader.bits_left += 8 * num_bytes;
+            reader.bits_loaded += 8 * num_bytes;
+            return;
+        }
+    }
+    while (reader.bits_left <= 56) {
+        uint64_t byte = 0;
+        if (!reader.marker_found && reader.position < reader.end) {
+            byte = *reader.position;
+            if (byte != 0xFF) {
+                reader.position++;
+            } else if (reader.position + 1 < reader.end && reader.position[1] == 0) {
+                reader.position += 2;
+            } else {
+                reader.marker_found = true;
+                byte = 0;
+            }
+        }
+        reader.bit_buffer |= byte << (56 - reader.bits_left);
+        reader.bits_left += 8;
+    }
+    reader.bits_loaded += reader.bits_left - bits_left;
+}
+
+uint32_t RocJpegEntropyDecoder::GetBits(BitReader &reader, int32_t n) {
+    if (reader.bits_left < n) {
+        FillBitBuffer(reader);
+    }
+    uint32_t bits = static_cast<uint32_t>(reader.bit_buffer >> (64 - n));
+    reader.bit_buffer <<= n;
+    reader.bits_left -= n;
+    return bits;
+}
+
+int32_t RocJpegEntropyDecoder::ReceiveExtend(BitReader &reader, int32_t n) {
+    int32_t value = static_cast<int32_t>(GetBits(reader, n));
+    return value < (1 << (n - 1)) ? value - (1 << n) + 1 : value;
+}
+
+int32_t RocJpegEntropyDecoder::DecodeSymbol(BitReader &reader, const HuffmanDecodeTable &table) {
+    if (reader.bits_left < 16) {
+        FillBitBuffer(reader);
+    }
+    uint16_t entry = table.lookup[reader.bit_buffer >> (64 - HUFFMAN_LOOKAHEAD_BITS)];
+    if (entry != 0) {
+        int32_t length = entry >> 8;
+        reader.bit_buffer <<= length;
+        reader.bits_left -= length;
+        return entry & 0xFF;
+    }
+    int32_t length = HUFFMAN_LOOKAHEAD_BITS + 1;
+    int32_t code = static_cast<int32_t>(reader.bit_buffer >> (64 - length));
+    while (code > table.max_code[length]) {
+        length++;
+        code = static_cast<int32_t>(reader.bit_buffer >> (64 - length));
+    }
+    if (length > 16) {
+        // corrupt data: no code matches, so skip the bits and return a zero symbol
+        reader.bit_buffer <<= 16;
+        reader.bits_left -= 16;
+        return 0;
+    }
+    reader.bit_buffer <<= length;
+    reader.bits_left -= length;
+    return table.values[(code + table.value_offset[length]) & 0xFF];
+}
+
+/**
+ * @brief Decodes a DC difference: the Huffman symbol of its size, and its extra bits.
+ *
+ * The symbol and the extra bits are decoded with a single lookup of the fast table when they fit in its lookahead,
+ * which is the case of most DC differences. A size above 15 is corrupt data and gives a difference of 0.
+ *
+ * @param reader The bit reader.
+ * @param table The DC table.
+ * @return The DC difference.
+ */
+inline int32_t RocJpegEntropyDecoder::DecodeDcDifference(BitReader &reader, const HuffmanDecodeTable &table) {
+    if (reader.bits_left < 16) {
+        FillBitBuffer(reader);
+    }
+    int32_t entry = table.fast[reader.bit_buffer >> (64 - HUFFMAN_FAST_LOOKAHEAD_BITS)];
+    if (entry & 0xFF) {
+        reader.bit_buffer <<= entry & 0xFF;
+        reader.bits_left -= entry & 0xFF;
+        return entry >> 16;
+    }
+    int32_t s = DecodeSymbol(reader, table);
+    if (s > 15) {
+        s = 0;
+    }
+    return s ? ReceiveExtend(reader, s) : 0;
+}
+
+/**
+ * @brief Decodes an AC symbol, which gives a run of zero coefficients and the size of the next coefficient, and the
+ *        extra bits of the coefficient.
+ *
+ * The symbol and the extra bits are decoded with a single lookup of the fast table when they fit in its lookahead,
+ * which is the case of most AC coefficients.
+ *
+ * @param reader The bit reader.
+ * @param table The AC table.
+ * @param run Set to the run of zero coefficients of the symbol.
+ * @return The coefficient, or 0 if the symbol has a size of 0 (an EOB, EOBn, or ZRL symbol).
+ */
+inline int32_t RocJpegEntropyDecoder::DecodeAcCoefficient(BitReader &reader, const HuffmanDecodeTable &table, int32_t &run) {
+    if (reader.bits_left < 16) {
+        FillBitBuffer(reader);
+    }
+    int32_t entry = table.fast[reader.bit_buffer >> (64 - HUFFMAN_FAST_LOOKAHEAD_BITS)];
+    if (entry & 0xFF) {
+        reader.bit_buffer <<= entry & 0xFF;
+        reader.bits_left -= entry & 0xFF;
+        run = (entry >> 8) & 15;
+        return entry >> 16;
+    }
+    int32_t rs = DecodeSymbol(reader, table);
+    run = rs >> 4;
+    return (rs & 15) ? ReceiveExtend(reader, rs & 15) : 0;
+}
+
+/**
+ * @brief Handles the end of a restart interval.
+ *
+ * The remaining bits of the interval are discarded and the RSTn marker, if it is found, is skipped. A missing
+ * marker isn't an error; decoding continues with the data that follows.
+ *
+ * @param reader The bit reader.
+ */
+void RocJpegEntropyDecoder::ProcessRestart(BitReader &reader) {
+    reader.bit_buffer = 0;
+    reader.bits_left = 0;
+    const uint8_t *position = reader.position;
+    while (position < reader.end && *position == 0xFF && position + 1 < reader.end && position[1] == 0xFF) {
+        position++;
+    }
+    if (position + 1 < reader.end && position[0] == 0xFF && position[1] >= RST0 && position[1] <= RST7) {
+        reader.position = position + 2;
+        reader.marker_found = false;
+    }
+}
+
+/**
+ * @brief Decodes a scan.
+ *
+ * The scan header selects the components of the scan and, for a progressive frame, the spectral band (Ss to Se) and the
+ * successive approximation bits (Ah, Al) that the scan codes. The blocks are visited in MCU order; an interleaved scan
+ * covers the padded MCUs of the frame, while a scan of a single component only covers the blocks of the component
+ * that hold samples of the image. A large scan with a restart interval is decoded one restart interval per job.
+ *
+ * @param jpeg_scan The scan, as located by the stream parser.
+ * @param image The layout of the coefficients.
+ * @param coefficients The coefficient buffer.
+ * @return True if the scan header is valid, false otherwise.
+ */
+bool RocJpegEntropyDecoder::DecodeScan(const JpegScan &jpeg_scan, JpegCoefficientImage &image, int16_t *coefficients) {
+    if (jpeg_scan.num_components == 0 || jpeg_scan.num_components > image.num_components) {
+        ERR("invalid SOS marker!");
+        return false;
+    }
+    ScanParameters scan;
+    scan.components = image.components;
+    scan.coefficients = coefficients;
+    scan.coefficients_per_block = image.coefficients_per_block;
+    scan.num_scan_components = jpeg_scan.num_components;
+    scan.spectral_start = jpeg_scan.spectral_start;
+    scan.spectral_end = jpeg_scan.spectral_end;
+    scan.approximation_high = jpeg_scan.approximation_high;
+    scan.approximation_low = jpeg_scan.approximation_low;
+    scan.restart_interval = jpeg_scan.restart_interval;
+
+    scan.is_progressive = image.coding_process == CODING_PROCESS_PROGRESSIVE;
+    bool is_dc_scan = scan.spectral_start == 0;
+    if (scan.is_progressive) {
+        if (scan.spectral_end > 63 || scan.spectral_start > scan.spectral_end || (is_dc_scan && scan.spectral_end != 0) ||
+            (!is_dc_scan && scan.num_scan_components != 1) || scan.approximation_high > 13 || scan.approximation_low > 13) {
+            ERR("invalid progressive scan parameters!");
+            return false;
+        }
+    } else {
+        // the spectral selection and successive approximation fields are ignored by sequential decoding
+        scan.spectral_start = 0;
+        scan.spectral_end = 63;
+        scan.approximation_high = 0;
+        scan.approximation_low = 0;
+    }
+
+    for (uint32_t i = 0; i < scan.num_scan_components; i++) {
+        uint8_t component_id = jpeg_scan.components[i].component_selector;
+        uint8_t dc_table_selector = jpeg_scan.components[i].dc_table_selector;
+        uint8_t ac_table_selector = jpeg_scan.components[i].ac_table_selector;
+        int32_t component_index = -1;
+        for (int32_t j = 0; j < image.num_components; j++) {
+            if (image.components[j].component_id == component_id) {
+                component_index = j;
+            }
+        }
+        for (uint32_t j = 0; j < i; j++) {
+            if (scan.scan_components[j] == component_index) {
+                component_index = -1;
+            }
+        }
+        if (component_index < 0) {
+            ERR("invalid component id in the SOS marker!");
+            return false;
+        }
+        if (dc_table_selector >= ENTROPY_HUFFMAN_TABLES || ac_table_selector >= ENTROPY_HUFFMAN_TABLES) {
+            ERR("invalid number of Huffman table!");
+            return false;
+        }
+        scan.scan_components[i] = component_index;
+        bool needs_dc_table = is_dc_scan && scan.approximation_high == 0;
+        bool needs_ac_table = !is_dc_scan || !scan.is_progressive;
+        scan.dc_tables[i] = needs_dc_table ? GetDecodeTable(jpeg_scan, 0, dc_table_selector) : nullptr;
+        scan.ac_tables[i] = needs_ac_table ? GetDecodeTable(jpeg_scan, 1, ac_table_selector) : nullptr;
+        if ((needs_dc_table && scan.dc_tables[i] == nullptr) || (needs_ac_table && scan.ac_tables[i] == nullptr)) {
+            ERR("the scan uses an undefined or invalid Huffman table!");
+            return false;
+        }
+        JpegCoefficientComponent &component = image.components[component_index];
+        if (!component_seen_[component_index]) {
+            if (!jpeg_scan.quantization_tables->load_quantiser_table[component.quantiser_table_selector]) {
+                ERR("the scan uses an undefined quantization table!");
+                return false;
+            }
+            SetQuantizationTable(jpeg_scan.quantization_tables->quantiser_table[component.quantiser_table_selector], component);
+            component_seen_[component_index] = true;
+        }
+    }
+
+    if (scan.is_progressive && !is_dc_scan && scan.coefficients_per_block == 1) {
+        // the AC coefficients aren't kept
+        return true;
+    }
+
+    // the MCUs of the scan and the blocks of each MCU
+    scan.blocks_per_mcu = 0;
+    if (scan.num_scan_components == 1) {
+        const JpegCoefficientComponent &component = image.components[scan.scan_components[0]];
+        scan.mcus_per_row = (component.width + 7) / 8;
+        scan.num_mcus = scan.mcus_per_row * ((component.height + 7) / 8);
+        scan.block_component[0] = 0;
+        scan.block_offset_x[0] = 0;
+        scan.block_offset_y[0] = 0;
+        scan.blocks_per_mcu = 1;
+    } else {
+        scan.mcus_per_row = image.mcus_per_row;
+        scan.num_mcus = image.mcus_per_row * image.mcu_rows;
+        for (uint32_t i = 0; i < scan.num_scan_components; i++) {
+            const JpegCoefficientComponent &component = image.components[scan.scan_components[i]];
+            for (int32_t y = 0; y < component.v_sampling_factor; y++) {
+                for (int32_t x = 0; x < component.h_sampling_factor; x++) {
+                    scan.block_component[scan.blocks_per_mcu] = i;
+                    scan.block_offset_x[scan.blocks_per_mcu] = x;
+                    scan.block_offset_y[scan.blocks_per_mcu] = y;
+                    scan.blocks_per_mcu++;
+                }
+            }
+        }
+    }
+
+    const uint8_t *scan_data = jpeg_stream_params_->slice_data_buffer + jpeg_scan.data_offset;
+    scan.data_end = scan_data + jpeg_scan.data_size;
+    if (thread_pool_ != nullptr && thread_pool_->GetNumThreads() > 1 && scan.restart_interval != 0 && scan.num_mcus > scan.restart_interval &&
+        static_cast<uint64_t>(scan.num_mcus) * scan.blocks_per_mcu >= ENTROPY_PARALLEL_MIN_BLOCKS &&
+        DecodeRestartIntervals(scan, scan_data)) {
+        return true;
+    }
+    if (thread_pool_ != nullptr && thread_pool_->GetNumThreads() > 1 && !scan.is_progressive && scan.restart_interval == 0 &&
+        DecodeScanSpeculatively(scan, scan_data)) {
+        return true;
+    }
+    BitReader reader = {scan_data, scan.data_end, 0, 0, false, 0};
+    DecodeMcus(scan, reader, 0, scan.num_mcus);
+    return true;
+}
+
+/**
+ * @brief Decodes the restart intervals of a scan concurrently.
+ *
+ * The restart intervals are taken from the restart marker index of the parser, or located by searching the RSTn
+ * markers of the scan when the index doesn't record every interval. Every restart interval starts with empty
+ * predictions and a new bit reader, so each interval is decoded by its own reader, limited to the entropy-coded
+ * data in front of the next marker, and writes its own blocks of the coefficient buffer. The intervals are grouped
+ * into a few jobs per thread of contiguous intervals, which the pool hands out to the threads as they become free.
+ * The output is the same as decoding the scan sequentially; for corrupt data, each interval still restarts at its
+ * own marker.
+ *
+ * If the number of RSTn markers doesn't match the restart interval, or the markers are out of sequence, the
+ * scan is left to the sequential decoding, which resynchronizes the same way as the IJG libjpeg.
+ *
+ * @param scan The parameters of the scan.
+ * @param scan_data A pointer to the entropy-coded data of the scan.
+ * @return True if the scan was decoded, false if the scan must be decoded sequentially.
+ */
+bool RocJpegEntropyDecoder::DecodeRestartIntervals(const ScanParameters &scan, const uint8_t *scan_data) {
+    uint32_t num_intervals = (scan.num_mcus + scan.restart_interval - 1) / scan.restart_interval;
+    if (!GetIndexedRestartIntervals(scan, scan_data, num_intervals) && !FindRestartIntervals(scan, scan_data, num_intervals)) {
+        return false;
+    }
+
+    int32_t num_jobs = static_cast<int32_t>(std::min<uint32_t>(num_intervals, thread_pool_->GetNumThreads() * 4));
+    thread_pool_->ParallelFor(num_jobs, [&](int job) {
+        uint32_t first_interval = static_cast<uint32_t>(static_cast<uint64_t>(num_intervals) * job / num_jobs);
+        uint32_t end_interval = static_cast<uint32_t>(static_cast<uint64_t>(num_intervals) * (job + 1) / num_jobs);
+        for (uint32_t i = first_interval; i < end_interval; i++) {
+            BitReader reader = {interval_starts_[i], interval_ends_[i], 0, 0, false, 0};
+            uint32_t first_mcu = i * scan.restart_interval;
+            DecodeMcus(scan, reader, first_mcu, std::min(first_mcu + scan.restart_interval, scan.num_mcus));
+        }
+    });
+    return true;
+}
+
+/**
+ * @brief Takes the restart intervals of a scan from the restart marker index of the parser.
+ *
+ * The index is only used when it covers the scan and records every restart interval: the scan is the single
+ * scan of the frame, the index isn't decimated, and it has one entry per RSTn marker. The RSTn marker in front
+ * of each recorded offset is checked, so an index that doesn't match the scan is never trusted.
+ *
+ * @param scan The parameters of the scan.
+ * @param scan_data A pointer to the entropy-coded data of the scan.
+ * @param num_intervals The number of restart intervals of the scan.
+ * @return True if interval_starts_ and interval_ends_ hold the restart intervals, false if the index can't be used.
+ */
+bool RocJpegEntropyDecoder::GetIndexedRestartIntervals(const ScanParameters &scan, const uint8_t *scan_data, uint32_t num_intervals) {
+    const JpegStreamParameters *params = jpeg_stream_params_;
+    if (params->restart_markers == nullptr || params->restart_marker_stride != 1 || params->num_scans != 1 ||
+        scan_data != params->slice_data_buffer || params->num_restart_markers != num_intervals - 1) {
+        return false;
+    }
+    interval_starts_.clear();
+    interval_ends_.clear();
+    const uint8_t *position = scan_data;
+    size_t scan_size = scan.data_end - scan_data;
+    for (uint32_t i = 0; i <= params->num_restart_markers; i++) {
+        const uint8_t *marker = scan.data_end;
+        if (i < params->num_restart_markers) {
+            const RestartMarker &restart_marker = params->restart_markers[i];
+            if (restart_marker.mcu_index != (i + 1) * scan.restart_interval || restart_marker.byte_offset > scan_size ||
+                restart_marker.byte_offset < static_cast<size_t>(position - scan_data) + 2) {
+                return false;
+            }
+            marker = scan_data + restart_marker.byte_offset - 2;
+            if (marker[0] != 0xFF || marker[1] != RST0 + (i & 7)) {
+                return false;
+            }
+        }
+        // the fill bytes in front of the marker aren't part of the interval
+        const uint8_t *data_end = marker;
+        while (data_end > position && data_end[-1] == 0xFF) {
+            data_end--;
+        }
+        interval_starts_.push_back(position);
+        interval_ends_.push_back(data_end);
+        position = marker + 2;
+    }
+    return true;
+}
+
+/**
+ * @brief Locates the restart intervals of a scan by searching its RSTn markers.
+ *
+ * @param scan The parameters of the scan.
+ * @param scan_data A pointer to the entropy-coded data of the scan.
+ * @param num_intervals The number of restart intervals of the scan.
+ * @return True if interval_starts_ and interval_ends_ hold the restart intervals, false if the RSTn markers are
+ * missing or out of sequence.
+ */
+bool RocJpegEntropyDecoder::FindRestartIntervals(const ScanParameters &scan, const uint8_t *scan_data, uint32_t num_intervals) {
+    interval_starts_.clear();
+    interval_ends_.clear();
+    const uint8_t *position = scan_data;
+    while (true) {
+        const uint8_t *marker = marker_scanner_.FindNextMarker(position, scan.data_end);
+        // the fill bytes in front of the marker aren't part of the interval
+        const uint8_t *data_end = marker;
+        while (data_end > position && data_end[-1] == 0xFF) {
+            data_end--;
+        }
+        interval_starts_.push_back(position);
+        interval_ends_.push_back(data_end);
+        bool is_restart_marker = scan.data_end - marker >= 2 && marker[1] >= RST0 && marker[1] <= RST7;
+        if (!is_restart_marker || interval_starts_.size() == num_intervals) {
+            break;
+        }
+        if (marker[1] != RST0 + ((interval_starts_.size() - 1) & 7)) {
+            return false;
+        }
+        position = marker + 2;
+    }
+    return interval_starts_.size() == num_intervals;
+}
+
+/**
+ * @brief Decodes a range of MCUs of a scan.
+ *
+ * The predictions and the end-of-band run start empty at first_mcu, which must be the first MCU of the scan or of a
+ * restart interval; the restart intervals that start inside the range are handled by the reader.
+ *
+ * @param scan The parameters of the scan.
+ * @param reader The bit reader, positioned at the entropy-coded data of first_mcu.
+ * @param first_mcu The first MCU to decode.
+ * @param end_mcu The MCU after the last MCU to decode.
+ */
+void RocJpegEntropyDecoder::DecodeMcus(const ScanParameters &scan, BitReader &reader, uint32_t first_mcu, uint32_t end_mcu) {
+    const bool is_dc_scan = scan.spectral_start == 0;
+    const int32_t spectral_start = scan.spectral_start;
+    const int32_t spectral_end = scan.spectral_end;
+    const int32_t approximation_high = scan.approximation_high;
+    const int32_t approximation_low = scan.approximation_low;
+    int32_t dc_predictors[NUM_COMPONENTS] = {};
+    uint32_t eob_run = 0;
+    const int32_t p1 = 1 << approximation_low;
+    const int32_t m1 = -1 * (1 << approximation_low);
+
+    for (uint32_t mcu = first_mcu; mcu < end_mcu; mcu++) {
+        if (scan.restart_interval != 0 && mcu != first_mcu && mcu % scan.restart_interval == 0) {
+            ProcessRestart(reader);
+            std::memset(dc_predictors, 0, sizeof(dc_predictors));
+            eob_run = 0;
+        }
+        uint32_t mcu_x = mcu % scan.mcus_per_row;
+        uint32_t mcu_y = mcu / scan.mcus_per_row;
+        for (uint32_t b = 0; b < scan.blocks_per_mcu; b++) {
+            int32_t i = scan.block_component[b];
+            const JpegCoefficientComponent &component = scan.components[scan.scan_components[i]];
+            uint32_t block_x, block_y;
+            if (scan.num_scan_components == 1) {
+                block_x = mcu_x;
+                block_y = mcu_y;
+            } else {
+                block_x = mcu_x * component.h_sampling_factor + scan.block_offset_x[b];
+                block_y = mcu_y * component.v_sampling_factor + scan.block_offset_y[b];
+            }
+            int16_t *block = scan.coefficients + component.coefficient_offset +
+                             (static_cast<size_t>(block_y) * component.width_in_blocks + block_x) * scan.coefficients_per_block;
+
+            if (!scan.is_progressive) {
+                DecodeSequentialBlock<true>(scan, reader, b, dc_predictors, block);
+            } else if (is_dc_scan && approximation_high == 0) {
+                // progressive DC first scan
+                dc_predictors[i] += DecodeDcDifference(reader, *scan.dc_tables[i]);
+                block[0] = static_cast<int16_t>(dc_predictors[i] * (1 << approximation_low));
+            } else if (is_dc_scan) {
+                // progressive DC refinement scan: one bit per block
+                if (GetBits(reader, 1)) {
+                    block[0] |= p1;
+                }
+            } else if (approximation_high == 0) {
+                // progressive AC first scan
+                if (eob_run > 0) {
+                    eob_run--;
+                    continue;
+                }
+                for (int32_t k = spectral_start; k <= spectral_end; k++) {
+                    int32_t r;
+                    int32_t value = DecodeAcCoefficient(reader, *scan.ac_tables[i], r);
+                    if (value) {
+                        k += r;
+                        block[kZigzagToNatural[k]] = static_cast<int16_t>(value * (1 << approximation_low));
+                    } else if (r == 15) {
+                        k += 15;
+                    } else {
+                        eob_run = 1 << r;
+                        if (r) {
+                            eob_run += GetBits(reader, r);
+                        }
+                        eob_run--;
+                        break;
+                    }
+                }
+            } else {
+                // progressive AC refinement scan, following the procedure of the IJG libjpeg
+                int32_t k = spectral_start;
+                if (eob_run == 0) {
+                    for (; k <= spectral_end; k++) {
+                        int32_t rs = DecodeSymbol(reader, *scan.ac_tables[i]);
+                        int32_t r = rs >> 4;
+                        int32_t s = rs & 15;
+                        if (s) {
+                            // the size of a newly nonzero coefficient is always 1
+                            s = GetBits(reader, 1) ? p1 : m1;
+                        } else if (r != 15) {
+                            eob_run = 1 << r;
+                            if (r) {
+                                eob_run += GetBits(reader, r);
+                            }
+                            break;
+                        }
+                        // skip r zero coefficients, appending a correction bit to the nonzero coefficients passed over
+                        do {
+                            int16_t *coefficient = block + kZigzagToNatural[k];
+                            if (*coefficient != 0) {
+                                if (GetBits(reader, 1) && (*coefficient & p1) == 0) {
+                                    *coefficient += *coefficient >= 0 ? p1 : m1;
+                                }
+                            } else if (--r < 0) {
+                                break;
+                            }
+                            k++;
+                        } while (k <= spectral_end);
+                        if (s) {
+                            block[kZigzagToNatural[k]] = static_cast<int16_t>(s);
+                        }
+                    }
+                }
+                if (eob_run > 0) {
+                    // the rest of the band only gets correction bits
+                    for (; k <= spectral_end; k++) {
+                        int16_t *coefficient = block + kZigzagToNatural[k];
+                        if (*coefficient != 0 && GetBits(reader, 1) && (*coefficient & p1) == 0) {
+                            *coefficient += *coefficient >= 0 ? p1 : m1;
+                        }
+                    }
+                    eob_run--;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Decodes one block of a sequential scan: the DC difference followed by the run-length coded AC coefficients.
+ *
+ * When kStoreCoefficients is false, the block is only parsed: the symbols and the extra bits are read exactly as when
+ * the coefficients are stored, so the reader ends at the same position, and the DC prediction is updated.
+ *
+ * @param scan The parameters of the scan.
+ * @param reader The bit reader, positioned at the first bit of the block.
+ * @param block_in_mcu The index of the block in its MCU.
+ * @param dc_predictors The DC predictions of the components of the scan.
+ * @param block The coefficients of the block, cleared, in natural order; only the DC coefficient is stored if the scan
+ *              keeps one coefficient per block.
+ */
+template <bool kStoreCoefficients>
+inline void RocJpegEntropyDecoder::DecodeSequentialBlock(const ScanParameters &scan, BitReader &reader, uint32_t block_in_mcu, int32_t *dc_predictors, int16_t *block) {
+    if (kStoreCoefficients && scan.coefficients_per_block == 1) {
+        // only the DC coefficient is kept; the AC coefficients are parsed to reach the next block
+        DecodeSequentialBlock<false>(scan, reader, block_in_mcu, dc_predictors, nullptr);
+        block[0] = static_cast<int16_t>(dc_predictors[scan.block_component[block_in_mcu]]);
+        return;
+    }
+    int32_t i = scan.block_component[block_in_mcu];
+    dc_predictors[i] += DecodeDcDifference(reader, *scan.dc_tables[i]);
+    if (kStoreCoefficients) {
+        block[0] = static_cast<int16_t>(dc_predictors[i]);
+    }
+    const HuffmanDecodeTable &ac_table = *scan.ac_tables[i];
+    for (int32_t k = 1; k < DCT_BLOCK_SIZE; k++) {
+        int32_t r;
+        int32_t value = DecodeAcCoefficient(reader, ac_table, r);
+        if (value) {
+            k += r;
+            if (kStoreCoefficients) {
+                block[kZigzagToNatural[k]] = static_cast<int16_t>(value);
+            }
+        } else {
+            if (r != 15) {
+                break;
+            }
+            k += 15;
+        }
+    }
+}
+
+int16_t* RocJpegEntropyDecoder::GetScanBlock(const ScanParameters &scan, uint32_t mcu, uint32_t block_in_mcu) {
+    const JpegCoefficientComponent &component = scan.components[scan.scan_components[scan.block_component[block_in_mcu]]];
+    uint32_t mcu_x = mcu % scan.mcus_per_row;
+    uint32_t mcu_y = mcu / scan.mcus_per_row;
+    uint32_t block_x, block_y;
+    if (scan.num_scan_components == 1) {
+        block_x = mcu_x;
+        block_y = mcu_y;
+    } else {
+        block_x = mcu_x * component.h_sampling_factor + scan.block_offset_x[block_in_mcu];
+        block_y = mcu_y * component.v_sampling_factor + scan.block_offset_y[block_in_mcu];
+    }
+    return scan.coefficients + component.coefficient_offset + (static_cast<size_t>(block_y) * component.width_in_blocks + block_x) * scan.coefficients_per_block;
+}
+
+/**
+ * @brief Decodes a sequential scan without a restart interval in parallel, by speculation.
+ *
+ * Without RSTn markers, the state of the decoder at any point of the entropy-coded data (the bit position, and the
+ * block of the MCU that is decoded there) is only known by decoding everything in front of it. Huffman codes tend to
+ * resynchronize, though: a decoder that starts at a wrong bit position soon reaches a block boundary that the actual
+ * decoding also goes through, in the same block of an MCU, and from there both decode the same blocks. The scan is
+ * decoded in four passes:
+ *
+ * 1. The entropy-coded data is split into one chunk per thread. Every chunk is parsed concurrently, as if it started
+ *    at the first block of an MCU, and the state at its first block boundaries is recorded, as well as the state at
+ *    the first block that starts after the chunk and the number of blocks in front of it.
+ * 2. The actual state at the start of each chunk is propagated from chunk to chunk: from the actual state at the end
+ *    of the previous chunk, the chunk is parsed until a recorded block boundary is reached, after which the recorded
+ *    state at the end of the chunk is the actual one. A chunk that doesn't synchronize is parsed to its end instead.
+ *    When every block of the MCU uses the same tables, the block boundaries only need to match in bit offset.
+ * 3. The chunks are decoded concurrently from their actual starting state into the coefficient buffer, with the DC
+ *    predictions starting at zero; the sum of the DC differences of each chunk is kept.
+ * 4. The DC coefficients of each chunk are offset by the sum of the DC differences of the chunks in front of it.
+ *
+ * The output is identical to the sequential decoding, including for corrupt data. The data is parsed about twice,
+ * so the speedup is about half the number of threads.
+ *
+ * @param scan The parameters of the scan.
+ * @param scan_data A pointer to the entropy-coded data of the scan.
+ * @return True if the scan was decoded, false if the scan is too small and must be decoded sequentially.
+ */
+bool RocJpegEntropyDecoder::DecodeScanSpeculatively(const ScanParameters &scan, const uint8_t *scan_data) {
+    const uint8_t *data_end = marker_scanner_.FindNextMarker(scan_data, scan.data_end);
+    size_t data_size = data_end - scan_data;
+    int32_t num_chunks = static_cast<int32_t>(std::min<size_t>(thread_pool_->GetNumThreads(), data_size / ENTROPY_SPECULATIVE_MIN_CHUNK_SIZE));
+    if (num_chunks < 2) {
+        return false;
+    }
+    const uint64_t num_blocks = static_cast<uint64_t>(scan.num_mcus) * scan.blocks_per_mcu;
+    // when all the blocks use the same tables, the block of the MCU doesn't change the parsing and a bit offset is enough to synchronize
+    bool has_uniform_tables = true;
+    for (uint32_t i = 1; i < scan.num_scan_components; i++) {
+        has_uniform_tables &= scan.dc_tables[i] == scan.dc_tables[0] && scan.ac_tables[i] == scan.ac_tables[0];
+    }
+    const uint64_t sync_mask = has_uniform_tables ? ~static_cast<uint64_t>(63) : ~static_cast<uint64_t>(0);
+    chunks_.resize(num_chunks);
+    for (int32_t i = 0; i < num_chunks; i++) {
+        const uint8_t *start = scan_data + data_size * i / num_chunks;
+        // don't split a stuffed 0xFF00 pair
+        if (i > 0 && start[-1] == 0xFF) {
+            start++;
+        }
+        chunks_[i].start = start;
+        if (i > 0) {
+            chunks_[i - 1].end = start;
+        }
+    }
+    chunks_[num_chunks - 1].end = data_end;
+
+    // pass 1: parse every chunk from a guessed state
+    thread_pool_->ParallelFor(num_chunks, [&](int i) {
+        SpeculateChunk(scan, num_blocks, chunks_[i]);
+    });
+    for (int32_t i = 1; i < num_chunks; i++) {
+        chunks_[i].base_bit = chunks_[i - 1].base_bit + chunks_[i - 1].num_bits;
+        chunks_[i].exit.base_bit = chunks_[i].base_bit;
+    }
+
+    // pass 2: propagate the actual state; the first chunk starts at the actual state
+    chunks_[0].entry = {{scan_data, scan.data_end, 0, 0, false, 0}, 0, 0, 0};
+    BlockState state = chunks_[0].exit;
+    for (int32_t i = 1; i < num_chunks; i++) {
+        SpeculativeChunk &chunk = chunks_[i];
+        state.block_index = std::min(state.block_index, num_blocks);
+        chunk.entry = state;
+        const uint64_t chunk_end_bit = chunk.base_bit + chunk.num_bits;
+        const uint64_t sync_offset = chunk.base_bit << 6;
+        int32_t dc_predictors[NUM_COMPONENTS] = {};
+        size_t j = 0;
+        bool is_synchronized = false;
+        while (state.block_index < num_blocks) {
+            uint64_t bit = state.base_bit + state.reader.bits_loaded - state.reader.bits_left;
+            if (bit >= chunk_end_bit) {
+                break;
+            }
+            uint64_t sync_point = ((bit << 6) | state.block_in_mcu) & sync_mask;
+            while (j < chunk.sync_points.size() && ((chunk.sync_points[j] + sync_offset) & sync_mask) < sync_point) {
+                j++;
+            }
+            if (j < chunk.sync_points.size() && ((chunk.sync_points[j] + sync_offset) & sync_mask) == sync_point) {
+                is_synchronized = true;
+                break;
+            }
+            DecodeSequentialBlock<false>(scan, state.reader, state.block_in_mcu, dc_predictors, nullptr);
+            state.block_in_mcu = state.block_in_mcu + 1 == scan.blocks_per_mcu ? 0 : state.block_in_mcu + 1;
+            state.block_index++;
+        }
+        if (is_synchronized) {
+            // the recorded state at the end of the chunk is j blocks behind the actual one
+            uint64_t block_index = state.block_index + chunk.exit.block_index - j;
+            state = chunk.exit;
+            state.block_index = block_index;
+            state.block_in_mcu = static_cast<uint32_t>(block_index % scan.blocks_per_mcu);
+        }
+    }
+
+    // pass 3: decode the chunks from their actual state
+    thread_pool_->ParallelFor(num_chunks, [&](int i) {
+        SpeculativeChunk &chunk = chunks_[i];
+        uint64_t end_block = i + 1 < num_chunks ? chunks_[i + 1].entry.block_index : num_blocks;
+        BitReader reader = chunk.entry.reader;
+        std::memset(chunk.dc_deltas, 0, sizeof(chunk.dc_deltas));
+        uint32_t mcu = static_cast<uint32_t>(chunk.entry.block_index / scan.blocks_per_mcu);
+        uint32_t block_in_mcu = static_cast<uint32_t>(chunk.entry.block_index % scan.blocks_per_mcu);
+        for (uint64_t b = chunk.entry.block_index; b < end_block; b++) {
+            DecodeSequentialBlock<true>(scan, reader, block_in_mcu, chunk.dc_deltas, GetScanBlock(scan, mcu, block_in_mcu));
+            if (++block_in_mcu == scan.blocks_per_mcu) {
+                block_in_mcu = 0;
+                mcu++;
+            }
+        }
+    });
+
+    // pass 4: offset the DC coefficients by the DC prediction at the start of each chunk
+    thread_pool_->ParallelFor(num_chunks - 1, [&](int job) {
+        int32_t i = job + 1;
+        int32_t dc_offsets[NUM_COMPONENTS] = {};
+        for (int32_t c = 0; c < i; c++) {
+            for (uint32_t k = 0; k < scan.num_scan_components; k++) {
+                dc_offsets[k] += chunks_[c].dc_deltas[k];
+            }
+        }
+        uint64_t end_block = i + 1 < num_chunks ? chunks_[i + 1].entry.block_index : num_blocks;
+        uint32_t mcu = static_cast<uint32_t>(chunks_[i].entry.block_index / scan.blocks_per_mcu);
+        uint32_t block_in_mcu = static_cast<uint32_t>(chunks_[i].entry.block_index % scan.blocks_per_mcu);
+        for (uint64_t b = chunks_[i].entry.block_index; b < end_block; b++) {
+            int16_t *block = GetScanBlock(scan, mcu, block_in_mcu);
+            block[0] = static_cast<int16_t>(block[0] + dc_offsets[scan.block_component[block_in_mcu]]);
+            if (++block_in_mcu == scan.blocks_per_mcu) {
+                block_in_mcu = 0;
+                mcu++;
+            }
+        }
+    });
+    return true;
+}
+
+/**
+ * @brief Parses a chunk of a sequential scan from a guessed state.
+ *
+ * The chunk is parsed as if its first byte started the first block of an MCU. The bit offset and the block of the
+ * MCU at the first ENTROPY_SPECULATIVE_MAX_SYNC_POINTS block boundaries are recorded, and the parsing stops at the
+ * first block that starts after the chunk, whose state is kept.
+ *
+ * @param scan The parameters of the scan.
+ * @param num_blocks The number of blocks of the scan.
+ * @param chunk The chunk.
+ */
+void RocJpegEntropyDecoder::SpeculateChunk(const ScanParameters &scan, uint64_t num_blocks, SpeculativeChunk &chunk) const {
+    uint64_t num_stuffed_bytes = 0;
+    for (const uint8_t *position = chunk.start; position < chunk.end; position += 2) {
+        position = marker_scanner_.FindMarkerPrefix(position, chunk.end);
+        num_stuffed_bytes += position < chunk.end;
+    }
+    chunk.base_bit = 0;
+    chunk.num_bits = (chunk.end - chunk.start - num_stuffed_bytes) * 8;
+    chunk.sync_points.clear();
+
+    BlockState state = {{chunk.start, scan.data_end, 0, 0, false, 0}, 0, 0, 0};
+    int32_t dc_predictors[NUM_COMPONENTS] = {};
+    // a chunk can't hold more blocks than the scan, whatever the guessed state
+    while (state.block_index <= num_blocks) {
+        uint64_t bit = state.reader.bits_loaded - state.reader.bits_left;
+        if (bit >= chunk.num_bits) {
+            break;
+        }
+        if (chunk.sync_points.size() < ENTROPY_SPECULATIVE_MAX_SYNC_POINTS) {
+            chunk.sync_points.push_back((bit << 6) | state.block_in_mcu);
+        }
+        DecodeSequentialBlock<false>(scan, state.reader, state.block_in_mcu, dc_predictors, nullptr);
+        state.block_in_mcu = state.block_in_mcu + 1 == scan.blocks_per_mcu ? 0 : state.block_in_mcu + 1;
+        state.block_index++;
+    }
+    chunk.exit = state;
+}
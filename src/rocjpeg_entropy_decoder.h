@@ -0,0 +1,326 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef ROC_JPEG_ENTROPY_DECODER_H_
+#define ROC_JPEG_ENTROPY_DECODER_H_
+
+#pragma once
+
+#include <stdint.h>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "rocjpeg_commons.h"
+#include "rocjpeg_parser.h"
+#include "rocjpeg_marker_scanner.h"
+#include "rocjpeg_idct.h"
+#include "rocjpeg_thread_pool.h"
+#include "rocjpeg_huffman_table.h"
+
+#define ENTROPY_HUFFMAN_TABLES 4
+#define ENTROPY_PARALLEL_MIN_BLOCKS 4096 // the smallest scan, in blocks, whose restart intervals are decoded in parallel
+#define ENTROPY_SPECULATIVE_MIN_CHUNK_SIZE (256 * 1024) // the smallest chunk, in bytes, of a scan decoded speculatively
+#define ENTROPY_SPECULATIVE_MAX_SYNC_POINTS 16384 // the number of block boundaries of a chunk that are kept to synchronize with
+
+/**
+ * @brief Structure representing the DCT coefficients of a color component.
+ *
+ * The blocks of the component are stored in raster order, padded to a whole number of MCUs, and the
+ * 64 coefficients of a block are stored in natural (row-major) order, or only the DC coefficient of each block
+ * when the decoder is set to decode the DC coefficients only.
+ */
+typedef struct JpegCoefficientComponentType {
+    uint8_t component_id; /**< The ID of the color component. */
+    uint8_t h_sampling_factor; /**< The horizontal sampling factor. */
+    uint8_t v_sampling_factor; /**< The vertical sampling factor. */
+    uint8_t quantiser_table_selector; /**< The quantiser table selector. */
+    uint32_t width; /**< The width of the component in samples. */
+    uint32_t height; /**< The height of the component in samples. */
+    uint32_t width_in_blocks; /**< The number of blocks per row, including the MCU padding. */
+    uint32_t height_in_blocks; /**< The number of block rows, including the MCU padding. */
+    size_t coefficient_offset; /**< The offset of the first block in the coefficient buffer, in coefficients. */
+    uint16_t quantization_table[DCT_BLOCK_SIZE]; /**< The quantization table of the component, in natural order. */
+} JpegCoefficientComponent;
+
+/**
+ * @brief Structure representing the layout of the DCT coefficients of a JPEG frame.
+ */
+typedef struct JpegCoefficientImageType {
+    uint16_t width; /**< The width of the image. */
+    uint16_t height; /**< The height of the image. */
+    JpegCodingProcess coding_process; /**< The coding process of the frame. */
+    uint8_t sample_precision; /**< The number of bits of the samples (8 or 12). */
+    uint8_t num_components; /**< The number of color components. */
+    uint8_t max_h_sampling_factor; /**< The largest horizontal sampling factor of the components. */
+    uint8_t max_v_sampling_factor; /**< The largest vertical sampling factor of the components. */
+    uint32_t mcus_per_row; /**< The number of MCUs per row of an interleaved scan. */
+    uint32_t mcu_rows; /**< The number of MCU rows of an interleaved scan. */
+    JpegCoefficientComponent components[NUM_COMPONENTS]; /**< The color components. */
+    uint32_t coefficients_per_block; /**< The number of coefficients stored per block: DCT_BLOCK_SIZE, or 1 if only the DC coefficients are decoded. */
+    size_t num_coefficients; /**< The total number of coefficients of all the components. */
+} JpegCoefficientImage;
+
+/**
+ * @class RocJpegEntropyDecoder
+ * @brief A class that decodes the entropy-coded data of a JPEG stream into DCT coefficients on the CPU.
+ *
+ * The entropy decoder handles the streams the VCN JPEG decoder can't decode, such as progressive streams and
+ * streams with 12-bit samples. It takes the frame header, the scans, and the tables in effect for each scan from the
+ * stream parameters of the parser, so the stream isn't parsed again, and decodes every scan into the coefficient buffer; the dequantization and the IDCT are left to
+ * the caller, which runs them on the GPU.
+ *
+ * When a scan has a restart interval, its RSTn markers split the entropy-coded data into segments that can be decoded
+ * independently; the segments of a large scan are decoded concurrently on a thread pool, directly into the coefficient
+ * buffer. A large sequential scan without a restart interval is split into chunks of entropy-coded data that are
+ * decoded speculatively, from a guessed state, until the decoding of each chunk synchronizes with the decoding of
+ * the previous one; the chunks are then decoded concurrently from their actual starting state.
+ *
+ * The Huffman tables of the DHT markers are interned in the table cache, which builds their decoding tables once for
+ * all the streams that define them. The bit buffer is refilled 64 bits at a time, and most codes are decoded together
+ * with the extra bits of their coefficient in one lookup.
+ *
+ * A decoder is not synchronized; the same decoder must not be used from multiple threads at the same time.
+ */
+class RocJpegEntropyDecoder {
+    public:
+        /**
+         * @brief Default constructor for RocJpegEntropyDecoder.
+         */
+        RocJpegEntropyDecoder();
+
+        /**
+         * @brief Sets the parsed JPEG stream to decode and computes the layout of its coefficients.
+         * @param jpeg_stream_params The parameters of the stream returned by the parser; they must stay valid until the coefficients are decoded.
+         * @param image The layout of the coefficients; the quantization tables are set by DecodeCoefficients.
+         * @return True if the frame is supported, false otherwise.
+         */
+        bool SetStreamParameters(const JpegStreamParameters *jpeg_stream_params, JpegCoefficientImage &image);
+
+        /**
+         * @brief Decodes all the scans of the stream passed to SetStreamParameters.
+         * @param image The layout returned by SetStreamParameters; the quantization tables of the components are filled in.
+         * @param coefficients The coefficient buffer of image.num_coefficients coefficients. It is cleared before decoding.
+         * @return True if the scans are successfully decoded, false otherwise. Corrupt entropy-coded data is not an error.
+         */
+        bool DecodeCoefficients(JpegCoefficientImage &image, int16_t *coefficients);
+
+        /**
+         * @brief Sets the thread pool used to decode the restart intervals of a scan concurrently.
+         * @param thread_pool The thread pool, or nullptr to decode every scan on the calling thread. The process-wide pool is used by default.
+         */
+        void SetThreadPool(RocJpegThreadPool *thread_pool) { thread_pool_ = thread_pool; }
+
+        /**
+         * @brief Sets the decoder to keep only the DC coefficient of each block, for the streams passed to the next calls to SetStreamParameters.
+         * @param is_dc_only True to lay out and decode one coefficient per block: the AC coefficients of the sequential scans are
+         *                   parsed without being stored, and the AC scans of the progressive frames are skipped.
+         */
+        void SetDcOnly(bool is_dc_only) { is_dc_only_ = is_dc_only; }
+
+    private:
+        /**
+         * @brief Structure representing the bit reader of the entropy-coded data.
+         */
+        struct BitReader {
+            const uint8_t *position; ///< The next byte to read.
+            const uint8_t *end; ///< The end of the stream.
+            uint64_t bit_buffer; ///< The buffered bits, left-aligned.
+            int32_t bits_left; ///< The number of buffered bits.
+            bool marker_found; ///< True if a marker ended the entropy-coded data; zeros are read past it.
+            uint64_t bits_loaded; ///< The number of bits loaded into the bit buffer since the reader started, without the stuffed bytes.
+        };
+
+        /**
+         * @brief Structure representing the parameters of a scan, read from its header.
+         */
+        struct ScanParameters {
+            const JpegCoefficientComponent *components; ///< The components of the frame.
+            int16_t *coefficients; ///< The coefficient buffer.
+            uint32_t coefficients_per_block; ///< The number of coefficients stored per block (DCT_BLOCK_SIZE, or 1 for the DC coefficient only).
+            uint32_t num_scan_components; ///< The number of components of the scan.
+            int32_t scan_components[NUM_COMPONENTS]; ///< The index of each component of the scan in the frame.
+            const HuffmanDecodeTable *dc_tables[NUM_COMPONENTS]; ///< The DC table of each component of the scan.
+            const HuffmanDecodeTable *ac_tables[NUM_COMPONENTS]; ///< The AC table of each component of the scan.
+            int32_t spectral_start; ///< The first coefficient of the band, in zigzag order.
+            int32_t spectral_end; ///< The last coefficient of the band, in zigzag order.
+            int32_t approximation_high; ///< The successive approximation bit position high (Ah).
+            int32_t approximation_low; ///< The successive approximation bit position low (Al).
+            bool is_progressive; ///< True if the frame is progressive.
+            uint32_t mcus_per_row; ///< The number of MCUs per row.
+            uint32_t num_mcus; ///< The number of MCUs of the scan.
+            uint32_t restart_interval; ///< The restart interval, in MCUs, or 0.
+            uint32_t blocks_per_mcu; ///< The number of blocks of an MCU.
+            int32_t block_component[NUM_COMPONENTS * 16]; ///< The scan component of each block of an MCU.
+            int32_t block_offset_x[NUM_COMPONENTS * 16]; ///< The horizontal position of each block in the MCU, in blocks.
+            int32_t block_offset_y[NUM_COMPONENTS * 16]; ///< The vertical position of each block in the MCU, in blocks.
+            const uint8_t *data_end; ///< The end of the entropy-coded data of the scan.
+        };
+
+        /**
+         * @brief Structure representing the state of the decoding of a sequential scan at the start of a block.
+         */
+        struct BlockState {
+            BitReader reader; ///< The bit reader, positioned at the first bit of the block.
+            uint64_t base_bit; ///< The offset, in bits of unstuffed data from the start of the scan, of the first bit read by the reader.
+            uint32_t block_in_mcu; ///< The index of the block in its MCU.
+            uint64_t block_index; ///< The index of the block in the scan, counting the blocks of all the MCUs.
+        };
+
+        /**
+         * @brief Structure representing a chunk of the entropy-coded data of a scan that is decoded speculatively.
+         */
+        struct SpeculativeChunk {
+            const uint8_t *start; ///< The first byte of the chunk.
+            const uint8_t *end; ///< The end of the chunk.
+            uint64_t base_bit; ///< The offset of the chunk, in bits of unstuffed data from the start of the scan.
+            uint64_t num_bits; ///< The size of the chunk, in bits of unstuffed data.
+            std::vector<uint64_t> sync_points; ///< The (bit offset in the chunk << 6) | block in MCU of the first blocks decoded speculatively.
+            BlockState exit; ///< The speculative state at the first block that starts after the end of the chunk; block_index is relative to the chunk.
+            BlockState entry; ///< The actual state at the first block that starts in the chunk.
+            int32_t dc_deltas[NUM_COMPONENTS]; ///< The sum of the DC differences of each component of the blocks of the chunk.
+        };
+
+        /**
+         * @brief Returns the decoding table of a Huffman table of a scan, built the first time it is used with the Huffman tables of the scan.
+         * @param jpeg_scan The scan, as located by the parser.
+         * @param table_class The class of the table: 0 for a DC table, 1 for an AC table.
+         * @param table_selector The ID of the table.
+         * @return The decoding table, or nullptr if the table is undefined or invalid.
+         */
+        const HuffmanDecodeTable* GetDecodeTable(const JpegScan &jpeg_scan, uint8_t table_class, uint8_t table_selector);
+
+        /**
+         * @brief Decodes the entropy-coded data of a scan.
+         * @param jpeg_scan The scan, as located by the parser.
+         * @param image The layout of the coefficients.
+         * @param coefficients The coefficient buffer.
+         * @return True if the scan is successfully decoded, false otherwise.
+         */
+        bool DecodeScan(const JpegScan &jpeg_scan, JpegCoefficientImage &image, int16_t *coefficients);
+
+        /**
+         * @brief Decodes the restart intervals of a scan concurrently on the thread pool.
+         * @param scan The parameters of the scan.
+         * @param scan_data The pointer to the entropy-coded data of the scan.
+         * @return True if the scan is decoded, false if its RSTn markers don't match the restart interval; nothing is decoded then.
+         */
+        bool DecodeRestartIntervals(const ScanParameters &scan, const uint8_t *scan_data);
+
+        /**
+         * @brief Fills interval_starts_ and interval_ends_ from the restart marker index of the parser.
+         * @return True if the index records every restart interval of the scan, false if the intervals must be searched.
+         */
+        bool GetIndexedRestartIntervals(const ScanParameters &scan, const uint8_t *scan_data, uint32_t num_intervals);
+
+        /**
+         * @brief Fills interval_starts_ and interval_ends_ by searching the RSTn markers of the scan.
+         * @return True if the scan has one RSTn marker in sequence per restart interval, false otherwise.
+         */
+        bool FindRestartIntervals(const ScanParameters &scan, const uint8_t *scan_data, uint32_t num_intervals);
+
+        /**
+         * @brief Decodes the MCUs [first_mcu, end_mcu) of a scan, handling the restart intervals that start after first_mcu.
+         */
+        static void DecodeMcus(const ScanParameters &scan, BitReader &reader, uint32_t first_mcu, uint32_t end_mcu);
+
+        /**
+         * @brief Decodes a sequential scan without a restart interval by splitting it into chunks decoded speculatively and concurrently on the thread pool.
+         * @param scan The parameters of the scan.
+         * @param scan_data The pointer to the entropy-coded data of the scan.
+         * @return True if the scan is decoded, false if it is too small to be split; nothing is decoded then.
+         */
+        bool DecodeScanSpeculatively(const ScanParameters &scan, const uint8_t *scan_data);
+
+        /**
+         * @brief Decodes a chunk from the start of an MCU, recording the state at each block boundary, until the first block that starts after the chunk.
+         */
+        void SpeculateChunk(const ScanParameters &scan, uint64_t num_blocks, SpeculativeChunk &chunk) const;
+
+        /**
+         * @brief Decodes one block of a sequential scan, storing its coefficients if kStoreCoefficients is true.
+         * @param scan The parameters of the scan.
+         * @param reader The bit reader.
+         * @param block_in_mcu The index of the block in its MCU, which selects the component and the tables.
+         * @param dc_predictors The DC predictions of the components of the scan.
+         * @param block The coefficients of the block, which must be cleared; not used if kStoreCoefficients is false, and only the DC
+         *              coefficient is stored if the scan keeps one coefficient per block.
+         */
+        template <bool kStoreCoefficients>
+        static void DecodeSequentialBlock(const ScanParameters &scan, BitReader &reader, uint32_t block_in_mcu, int32_t *dc_predictors, int16_t *block);
+
+        /**
+         * @brief Returns the coefficients of a block of a scan.
+         */
+        static int16_t* GetScanBlock(const ScanParameters &scan, uint32_t mcu, uint32_t block_in_mcu);
+
+        /**
+         * @brief Refills the bit buffer so that at least 57 bits are buffered, with a single 64-bit read when no byte needs unstuffing.
+         */
+        static void FillBitBuffer(BitReader &reader);
+
+        /**
+         * @brief Reads n bits (n <= 16) as an unsigned value.
+         */
+        static uint32_t GetBits(BitReader &reader, int32_t n);
+
+        /**
+         * @brief Reads n bits (1 <= n <= 16) and extends them to a signed value, as in the EXTEND procedure of the JPEG standard.
+         */
+        static int32_t ReceiveExtend(BitReader &reader, int32_t n);
+
+        /**
+         * @brief Decodes one Huffman symbol.
+         */
+        static int32_t DecodeSymbol(BitReader &reader, const HuffmanDecodeTable &table);
+
+        /**
+         * @brief Decodes a DC difference, with a single lookup of the fast table when the code and the extra bits fit in its lookahead.
+         */
+        static int32_t DecodeDcDifference(BitReader &reader, const HuffmanDecodeTable &table);
+
+        /**
+         * @brief Decodes an AC symbol and the coefficient of its extra bits, with a single lookup of the fast table when they fit in its lookahead.
+         * @param run Set to the run of zero coefficients of the symbol.
+         * @return The coefficient, or 0 for a symbol of size 0 (EOB, EOBn, or ZRL).
+         */
+        static int32_t DecodeAcCoefficient(BitReader &reader, const HuffmanDecodeTable &table, int32_t &run);
+
+        /**
+         * @brief Skips the RSTn marker that ends a restart interval, and resets the bit reader.
+         */
+        static void ProcessRestart(BitReader &reader);
+
+        const JpegStreamParameters *jpeg_stream_params_; ///< The stream parameters passed to SetStreamParameters.
+        JpegCoefficientImage frame_; ///< The layout computed from the frame header.
+        bool component_seen_[NUM_COMPONENTS]; ///< True if the component was part of a decoded scan.
+        uint64_t decode_tables_id_; ///< The ID of the Huffman tables in the table cache from which decode_tables_ are built, or 0.
+        HuffmanDecodeTable decode_tables_[2][ENTROPY_HUFFMAN_TABLES]; ///< The decoding tables of the DC (0) and AC (1) Huffman tables of decode_tables_id_.
+        bool is_decode_table_built_[2][ENTROPY_HUFFMAN_TABLES]; ///< True if the decoding table was built for decode_tables_id_.
+        RocJpegMarkerScanner marker_scanner_; ///< Scanner used to locate the markers in the entropy-coded data of the scans.
+        RocJpegThreadPool *thread_pool_; ///< The pool decoding the restart intervals, or nullptr.
+        bool is_dc_only_; ///< True if only the DC coefficients are decoded.
+        std::vector<const uint8_t*> interval_starts_; ///< The first byte of each restart interval of the scan being decoded.
+        std::vector<const uint8_t*> interval_ends_; ///< The end of the entropy-coded data of each restart interval.
+        std::vector<SpeculativeChunk> chunks_; ///< The chunks of the scan being decoded speculatively.
+};
+
+#endif  // ROC_JPEG_ENTROPY_DECODER_H_
@@ -21,6 +21,7 @@ THE SOFTWARE.
 */
 
 #include "rocjpeg_hip_kernels.h"
+#include "rocjpeg_idct.h"
 
 __device__ __forceinline__ uint32_t hipPack(float4 src) {
     return __builtin_amdgcn_cvt_pk_u8_f32(src.w, 3,
@@ -2243,4 +2244,408 @@ void ConvertPackedYUYVToPlanarYUV(hipStream_t stream, uint32_t dst_width, uint32
     ConvertPackedYUYVToPlanarYUVKernel<<<dim3(ceil(static_cast<float>(global_threads_x) / local_threads_x), ceil(static_cast<float>(global_threads_y) / local_threads_y)),
                                     dim3(local_threads_x, local_threads_y), 0, stream>>>(dst_width, dst_height, destination_y, destination_u,
                                     destination_v, dst_luma_stride_in_bytes, dst_chroma_stride_in_bytes, src_image, src_image_stride_in_bytes, dst_width_comp);
-}
\ No newline at end of file
+}
+
+__device__ __forceinline__ void GetOrientedSourceCoordinates(uint32_t orientation, int32_t x, int32_t y, uint32_t src_width, uint32_t src_height,
+    int32_t &src_x, int32_t &src_y) {
+    switch (orientation) {
+        case 2: // flip horizontal
+            src_x = src_width - 1 - x;
+            src_y = y;
+            break;
+        case 3: // rotate 180
+            src_x = src_width - 1 - x;
+            src_y = src_height - 1 - y;
+            break;
+        case 4: // flip vertical
+            src_x = x;
+            src_y = src_height - 1 - y;
+            break;
+        case 5: // transpose
+            src_x = y;
+            src_y = x;
+            break;
+        case 6: // rotate 90 clockwise
+            src_x = y;
+            src_y = src_height - 1 - x;
+            break;
+        case 7: // transverse
+            src_x = src_width - 1 - y;
+            src_y = src_height - 1 - x;
+            break;
+        case 8: // rotate 270 clockwise
+            src_x = src_width - 1 - y;
+            src_y = x;
+            break;
+        default:
+            src_x = x;
+            src_y = y;
+            break;
+    }
+}
+
+__global__ void ColorConvertToRGBOrientedKernel(uint32_t dst_width, uint32_t dst_height, uint32_t src_width, uint32_t src_height, uint32_t orientation,
+    uint8_t *dst_image_r, uint8_t *dst_image_g, uint8_t *dst_image_b, uint32_t dst_pixel_step, uint32_t dst_image_stride_in_bytes,
+    OrientedSourceImage src_image) {
+
+    int32_t x = hipBlockDim_x * hipBlockIdx_x + hipThreadIdx_x;
+    int32_t y = hipBlockDim_y * hipBlockIdx_y + hipThreadIdx_y;
+
+    if (x >= dst_width || y >= dst_height) {
+        return;
+    }
+
+    int32_t src_x, src_y;
+    GetOrientedSourceCoordinates(orientation, x, y, src_width, src_height, src_x, src_y);
+
+    uint8_t r, g, b;
+    uint8_t luma = src_image.y_image[src_y * src_image.y_image_stride_in_bytes + src_x * src_image.y_sample_step];
+    if (src_image.u_image == nullptr) {
+        r = g = b = luma;
+    } else {
+        uint32_t src_uv_idx = (src_y >> src_image.uv_shift_y) * src_image.uv_image_stride_in_bytes + (src_x >> src_image.uv_shift_x) * src_image.uv_sample_step;
+        if (src_image.is_rgb) {
+            r = luma;
+            g = src_image.u_image[src_uv_idx];
+            b = src_image.v_image[src_uv_idx];
+        } else {
+            // same arithmetic as the non-oriented color conversion kernels, so both produce identical pixels
+            float2 cr = make_float2( 0.0000f,  1.5748f);
+            float2 cg = make_float2(-0.1873f, -0.4681f);
+            float2 cb = make_float2( 1.8556f,  0.0000f);
+            float3 yuv = make_float3(luma, src_image.u_image[src_uv_idx], src_image.v_image[src_uv_idx]);
+            yuv.y -= 128.0f;
+            yuv.z -= 128.0f;
+            float4 f;
+            f.x = fmaf(cr.y, yuv.z, yuv.x);
+            f.y = fmaf(cg.x, yuv.y, yuv.x);
+            f.y = fmaf(cg.y, yuv.z, f.y);
+            f.z = fmaf(cb.x, yuv.y, yuv.x);
+            f.w = 0.0f;
+            uint32_t rgb = hipPack(f);
+            r = rgb & 0xFF;
+            g = (rgb >> 8) & 0xFF;
+            b = (rgb >> 16) & 0xFF;
+        }
+    }
+
+    uint32_t dst_idx = y * dst_image_stride_in_bytes + x * dst_pixel_step;
+    dst_image_r[dst_idx] = r;
+    dst_image_g[dst_idx] = g;
+    dst_image_b[dst_idx] = b;
+}
+
+/**
+ * @brief Converts a decoded picture to RGB while applying an EXIF orientation.
+ *
+ * This function launches the ColorConvertToRGBOrientedKernel HIP kernel with one thread per destination pixel.
+ *
+ * @param stream The HIP stream to be used for the conversion.
+ * @param src_width The width of the source picture.
+ * @param src_height The height of the source picture.
+ * @param orientation The EXIF orientation (1 to 8) to apply.
+ * @param dst_image_r Pointer to the first red sample of the destination image.
+ * @param dst_image_g Pointer to the first green sample of the destination image.
+ * @param dst_image_b Pointer to the first blue sample of the destination image.
+ * @param dst_pixel_step The distance (in bytes) between two adjacent destination pixels.
+ * @param dst_image_stride_in_bytes The stride (in bytes) of the destination image.
+ * @param src_image The description of the source picture.
+ */
+void ColorConvertToRGBOriented(hipStream_t stream, uint32_t src_width, uint32_t src_height, uint32_t orientation,
+    uint8_t *dst_image_r, uint8_t *dst_image_g, uint8_t *dst_image_b, uint32_t dst_pixel_step, uint32_t dst_image_stride_in_bytes,
+    const OrientedSourceImage &src_image) {
+    bool is_transposed = orientation >= 5;
+    uint32_t dst_width = is_transposed ? src_height : src_width;
+    uint32_t dst_height = is_transposed ? src_width : src_height;
+
+    int32_t local_threads_x = 16;
+    int32_t local_threads_y = 16;
+    int32_t global_threads_x = dst_width;
+    int32_t global_threads_y = dst_height;
+
+    ColorConvertToRGBOrientedKernel<<<dim3(ceil(static_cast<float>(global_threads_x) / local_threads_x), ceil(static_cast<float>(global_threads_y) / local_threads_y)),
+                        dim3(local_threads_x, local_threads_y), 0, stream>>>(dst_width, dst_height, src_width, src_height, orientation,
+                        dst_image_r, dst_image_g, dst_image_b, dst_pixel_step, dst_image_stride_in_bytes, src_image);
+}
+
+__global__ void CopyPlaneOrientedKernel(uint32_t dst_width, uint32_t dst_height, uint32_t src_width, uint32_t src_height, uint32_t orientation,
+    uint8_t *dst_image, uint32_t dst_image_stride_in_bytes, const uint8_t *src_image, uint32_t src_image_stride_in_bytes,
+    uint32_t src_sample_step, uint32_t sample_size) {
+
+    int32_t x = hipBlockDim_x * hipBlockIdx_x + hipThreadIdx_x;
+    int32_t y = hipBlockDim_y * hipBlockIdx_y + hipThreadIdx_y;
+
+    if (x >= dst_width || y >= dst_height) {
+        return;
+    }
+
+    int32_t src_x, src_y;
+    GetOrientedSourceCoordinates(orientation, x, y, src_width, src_height, src_x, src_y);
+
+    const uint8_t *src = &src_image[src_y * src_image_stride_in_bytes + src_x * src_sample_step];
+    uint8_t *dst = &dst_image[y * dst_image_stride_in_bytes + x * sample_size];
+    dst[0] = src[0];
+    if (sample_size == 2) {
+        dst[1] = src[1];
+    }
+}
+
+/**
+ * @brief Copies a plane of samples while applying an EXIF orientation.
+ *
+ * This function launches the CopyPlaneOrientedKernel HIP kernel with one thread per destination sample.
+ *
+ * @param stream The HIP stream to be used for the copy.
+ * @param src_width The width of the source plane in samples.
+ * @param src_height The height of the source plane in samples.
+ * @param orientation The EXIF orientation (1 to 8) to apply.
+ * @param dst_image Pointer to the destination plane.
+ * @param dst_image_stride_in_bytes The stride (in bytes) of the destination plane.
+ * @param src_image Pointer to the first sample of the source plane.
+ * @param src_image_stride_in_bytes The stride (in bytes) of the source plane.
+ * @param src_sample_step The distance (in bytes) between two horizontally adjacent source samples.
+ * @param sample_size The size of a sample in bytes (1 or 2).
+ */
+void CopyPlaneOriented(hipStream_t stream, uint32_t src_width, uint32_t src_height, uint32_t orientation,
+    uint8_t *dst_image, uint32_t dst_image_stride_in_bytes, const uint8_t *src_image, uint32_t src_image_stride_in_bytes,
+    uint32_t src_sample_step, uint32_t sample_size) {
+    bool is_transposed = orientation >= 5;
+    uint32_t dst_width = is_transposed ? src_height : src_width;
+    uint32_t dst_height = is_transposed ? src_width : src_height;
+
+    int32_t local_threads_x = 16;
+    int32_t local_threads_y = 16;
+    int32_t global_threads_x = dst_width;
+    int32_t global_threads_y = dst_height;
+
+    CopyPlaneOrientedKernel<<<dim3(ceil(static_cast<float>(global_threads_x) / local_threads_x), ceil(static_cast<float>(global_threads_y) / local_threads_y)),
+                        dim3(local_threads_x, local_threads_y), 0, stream>>>(dst_width, dst_height, src_width, src_height, orientation,
+                        dst_image, dst_image_stride_in_bytes, src_image, src_image_stride_in_bytes, src_sample_step, sample_size);
+}
+
+__global__ void DequantizeIdctBatchedKernel(const int16_t *coefficients, const IdctComponentDesc *components, uint32_t num_components,
+    uint32_t num_blocks, uint8_t *dst_surfaces) {
+
+    uint32_t block_index = hipBlockDim_x * hipBlockIdx_x + hipThreadIdx_x;
+    if (block_index >= num_blocks) {
+        return;
+    }
+
+    // the components are sorted by their first block, so the component holding the block is found by a binary search
+    uint32_t first = 0;
+    uint32_t last = num_components - 1;
+    while (first < last) {
+        uint32_t middle = (first + last + 1) / 2;
+        if (components[middle].first_block <= block_index) {
+            first = middle;
+        } else {
+            last = middle - 1;
+        }
+    }
+    const IdctComponentDesc &component = components[first];
+    uint32_t index = block_index - component.first_block;
+    uint32_t x = index % component.width_in_blocks;
+    uint32_t y = index / component.width_in_blocks;
+
+    const int16_t *block = coefficients + component.coefficient_offset + static_cast<size_t>(index) * DCT_BLOCK_SIZE;
+    uint8_t *dst = dst_surfaces + component.dst_offset + static_cast<size_t>(y) * 8 * component.dst_image_stride_in_bytes + x * 8 * component.dst_sample_step;
+    DequantizeIdctBlock(block, component.quantization_table.values, component.sample_precision, dst, component.dst_image_stride_in_bytes,
+                        component.dst_sample_step, component.dst_sample_size);
+}
+
+/**
+ * @brief Dequantizes the DCT coefficients of the color components of a batch of frames and computes their inverse DCT.
+ *
+ * This function launches the DequantizeIdctBatchedKernel HIP kernel with one thread per 8x8 block of the batch.
+ *
+ * @param stream The HIP stream to be used for the transform.
+ * @param coefficients Pointer to the coefficient buffer of the batch.
+ * @param components Pointer to the descriptions of the components in device memory, sorted by their first block.
+ * @param num_components The number of components of the batch.
+ * @param num_blocks The total number of blocks of the batch.
+ * @param dst_surfaces Pointer to the surface buffer of the batch.
+ */
+void DequantizeIdctBatched(hipStream_t stream, const int16_t *coefficients, const IdctComponentDesc *components, uint32_t num_components,
+    uint32_t num_blocks, uint8_t *dst_surfaces) {
+    if (num_blocks == 0) {
+        return;
+    }
+    int32_t local_threads_x = 64;
+    int32_t global_threads_x = num_blocks;
+
+    DequantizeIdctBatchedKernel<<<dim3(ceil(static_cast<float>(global_threads_x) / local_threads_x)), dim3(local_threads_x), 0, stream>>>(
+                        coefficients, components, num_components, num_blocks, dst_surfaces);
+}
+
+__global__ void ColorConvertToRGB16OrientedKernel(uint32_t dst_width, uint32_t dst_height, uint32_t src_width, uint32_t src_height, uint32_t orientation,
+    uint32_t sample_precision, uint8_t *dst_image_r, uint8_t *dst_image_g, uint8_t *dst_image_b, uint32_t dst_pixel_step, uint32_t dst_image_stride_in_bytes,
+    OrientedSourceImage src_image) {
+
+    int32_t x = hipBlockDim_x * hipBlockIdx_x + hipThreadIdx_x;
+    int32_t y = hipBlockDim_y * hipBlockIdx_y + hipThreadIdx_y;
+
+    if (x >= dst_width || y >= dst_height) {
+        return;
+    }
+
+    int32_t src_x, src_y;
+    GetOrientedSourceCoordinates(orientation, x, y, src_width, src_height, src_x, src_y);
+
+    uint16_t r, g, b;
+    uint16_t luma = *reinterpret_cast<const uint16_t*>(src_image.y_image + src_y * src_image.y_image_stride_in_bytes + src_x * src_image.y_sample_step);
+    if (src_image.u_image == nullptr) {
+        r = g = b = luma;
+    } else {
+        uint32_t src_uv_idx = (src_y >> src_image.uv_shift_y) * src_image.uv_image_stride_in_bytes + (src_x >> src_image.uv_shift_x) * src_image.uv_sample_step;
+        uint16_t u = *reinterpret_cast<const uint16_t*>(src_image.u_image + src_uv_idx);
+        uint16_t v = *reinterpret_cast<const uint16_t*>(src_image.v_image + src_uv_idx);
+        if (src_image.is_rgb) {
+            r = luma;
+            g = u;
+            b = v;
+        } else {
+            // same coefficients as the 8-bit color conversion kernels, with the chroma offset and the clamping of the sample precision
+            float max_sample_value = static_cast<float>((1 << sample_precision) - 1);
+            float center = static_cast<float>(1 << (sample_precision - 1));
+            float fu = u - center;
+            float fv = v - center;
+            r = static_cast<uint16_t>(fminf(fmaxf(fmaf(1.5748f, fv, luma) + 0.5f, 0.0f), max_sample_value));
+            g = static_cast<uint16_t>(fminf(fmaxf(fmaf(-0.4681f, fv, fmaf(-0.1873f, fu, luma)) + 0.5f, 0.0f), max_sample_value));
+            b = static_cast<uint16_t>(fminf(fmaxf(fmaf(1.8556f, fu, luma) + 0.5f, 0.0f), max_sample_value));
+        }
+    }
+
+    uint32_t dst_idx = y * dst_image_stride_in_bytes + x * dst_pixel_step;
+    *reinterpret_cast<uint16_t*>(dst_image_r + dst_idx) = r;
+    *reinterpret_cast<uint16_t*>(dst_image_g + dst_idx) = g;
+    *reinterpret_cast<uint16_t*>(dst_image_b + dst_idx) = b;
+}
+
+/**
+ * @brief Converts a decoded picture with 16-bit samples to 16-bit RGB while applying an EXIF orientation.
+ *
+ * This function launches the ColorConvertToRGB16OrientedKernel HIP kernel with one thread per destination pixel.
+ *
+ * @param stream The HIP stream to be used for the conversion.
+ * @param src_width The width of the source picture.
+ * @param src_height The height of the source picture.
+ * @param orientation The EXIF orientation (1 to 8) to apply.
+ * @param sample_precision The number of bits of the samples (8 or 12).
+ * @param dst_image_r Pointer to the first red sample of the destination image.
+ * @param dst_image_g Pointer to the first green sample of the destination image.
+ * @param dst_image_b Pointer to the first blue sample of the destination image.
+ * @param dst_pixel_step The distance (in bytes) between two adjacent destination pixels.
+ * @param dst_image_stride_in_bytes The stride (in bytes) of the destination image.
+ * @param src_image The description of the source picture.
+ */
+void ColorConvertToRGB16Oriented(hipStream_t stream, uint32_t src_width, uint32_t src_height, uint32_t orientation, uint32_t sample_precision,
+    uint8_t *dst_image_r, uint8_t *dst_image_g, uint8_t *dst_image_b, uint32_t dst_pixel_step, uint32_t dst_image_stride_in_bytes,
+    const OrientedSourceImage &src_image) {
+    bool is_transposed = orientation >= 5;
+    uint32_t dst_width = is_transposed ? src_height : src_width;
+    uint32_t dst_height = is_transposed ? src_width : src_height;
+
+    int32_t local_threads_x = 16;
+    int32_t local_threads_y = 16;
+    int32_t global_threads_x = dst_width;
+    int32_t global_threads_y = dst_height;
+
+    ColorConvertToRGB16OrientedKernel<<<dim3(ceil(static_cast<float>(global_threads_x) / local_threads_x), ceil(static_cast<float>(global_threads_y) / local_threads_y)),
+                        dim3(local_threads_x, local_threads_y), 0, stream>>>(dst_width, dst_height, src_width, src_height, orientation,
+                        sample_precision, dst_image_r, dst_image_g, dst_image_b, dst_pixel_step, dst_image_stride_in_bytes, src_image);
+}
+
+__device__ __forceinline__ uint32_t ReadCmykSample(const OrientedCmykSourceImage &src_image, int32_t component, int32_t x, int32_t y) {
+    const uint8_t *sample = src_image.images[component] + (y >> src_image.shift_y[component]) * src_image.image_strides_in_bytes[component] +
+                            (x >> src_image.shift_x[component]) * src_image.sample_size;
+    return src_image.sample_size == 2 ? *reinterpret_cast<const uint16_t*>(sample) : *sample;
+}
+
+__global__ void ColorConvertCMYKToRGBOrientedKernel(uint32_t dst_width, uint32_t dst_height, uint32_t src_width, uint32_t src_height, uint32_t orientation,
+    uint8_t *dst_image_r, uint8_t *dst_image_g, uint8_t *dst_image_b, uint32_t dst_pixel_step, uint32_t dst_image_stride_in_bytes,
+    OrientedCmykSourceImage src_image) {
+
+    int32_t x = hipBlockDim_x * hipBlockIdx_x + hipThreadIdx_x;
+    int32_t y = hipBlockDim_y * hipBlockIdx_y + hipThreadIdx_y;
+
+    if (x >= dst_width || y >= dst_height) {
+        return;
+    }
+
+    int32_t src_x, src_y;
+    GetOrientedSourceCoordinates(orientation, x, y, src_width, src_height, src_x, src_y);
+
+    uint32_t max_sample_value = (1 << src_image.sample_precision) - 1;
+    uint32_t c = ReadCmykSample(src_image, 0, src_x, src_y);
+    uint32_t m = ReadCmykSample(src_image, 1, src_x, src_y);
+    uint32_t ye = ReadCmykSample(src_image, 2, src_x, src_y);
+    uint32_t k = ReadCmykSample(src_image, 3, src_x, src_y);
+    if (src_image.is_ycck) {
+        // same coefficients as the YCbCr color conversion kernels; as in libjpeg, the converted samples are the C, M, and Y
+        // inks, which are inverted below to match the inverted K of the Adobe convention
+        float max_value = static_cast<float>(max_sample_value);
+        float center = static_cast<float>(1 << (src_image.sample_precision - 1));
+        float luma = static_cast<float>(c);
+        float fu = static_cast<float>(m) - center;
+        float fv = static_cast<float>(ye) - center;
+        c = static_cast<uint32_t>(fminf(fmaxf(fmaf(1.5748f, fv, luma) + 0.5f, 0.0f), max_value));
+        m = static_cast<uint32_t>(fminf(fmaxf(fmaf(-0.4681f, fv, fmaf(-0.1873f, fu, luma)) + 0.5f, 0.0f), max_value));
+        ye = static_cast<uint32_t>(fminf(fmaxf(fmaf(1.8556f, fu, luma) + 0.5f, 0.0f), max_value));
+        c = max_sample_value - c;
+        m = max_sample_value - m;
+        ye = max_sample_value - ye;
+    } else if (!src_image.is_inverted) {
+        c = max_sample_value - c;
+        m = max_sample_value - m;
+        ye = max_sample_value - ye;
+        k = max_sample_value - k;
+    }
+    // c, m, ye, and k are now the fractions of light that the inks don't absorb
+    uint32_t r = (c * k + (max_sample_value >> 1)) / max_sample_value;
+    uint32_t g = (m * k + (max_sample_value >> 1)) / max_sample_value;
+    uint32_t b = (ye * k + (max_sample_value >> 1)) / max_sample_value;
+
+    uint32_t dst_idx = y * dst_image_stride_in_bytes + x * dst_pixel_step;
+    if (src_image.sample_size == 2) {
+        *reinterpret_cast<uint16_t*>(dst_image_r + dst_idx) = r;
+        *reinterpret_cast<uint16_t*>(dst_image_g + dst_idx) = g;
+        *reinterpret_cast<uint16_t*>(dst_image_b + dst_idx) = b;
+    } else {
+        dst_image_r[dst_idx] = r;
+        dst_image_g[dst_idx] = g;
+        dst_image_b[dst_idx] = b;
+    }
+}
+
+/**
+ * @brief Converts a decoded CMYK or YCCK picture to RGB while applying an EXIF orientation.
+ *
+ * This function launches the ColorConvertCMYKToRGBOrientedKernel HIP kernel with one thread per destination pixel.
+ *
+ * @param stream The HIP stream to be used for the conversion.
+ * @param src_width The width of the source picture.
+ * @param src_height The height of the source picture.
+ * @param orientation The EXIF orientation (1 to 8) to apply.
+ * @param dst_image_r Pointer to the first red sample of the destination image.
+ * @param dst_image_g Pointer to the first green sample of the destination image.
+ * @param dst_image_b Pointer to the first blue sample of the destination image.
+ * @param dst_pixel_step The distance (in bytes) between two adjacent destination pixels.
+ * @param dst_image_stride_in_bytes The stride (in bytes) of the destination image.
+ * @param src_image The description of the source picture.
+ */
+void ColorConvertCMYKToRGBOriented(hipStream_t stream, uint32_t src_width, uint32_t src_height, uint32_t orientation,
+    uint8_t *dst_image_r, uint8_t *dst_image_g, uint8_t *dst_image_b, uint32_t dst_pixel_step, uint32_t dst_image_stride_in_bytes,
+    const OrientedCmykSourceImage &src_image) {
+    bool is_transposed = orientation >= 5;
+    uint32_t dst_width = is_transposed ? src_height : src_width;
+    uint32_t dst_height = is_transposed ? src_width : src_height;
+
+    int32_t local_threads_x = 16;
+    int32_t local_threads_y = 16;
+    int32_t global_threads_x = dst_width;
+    int32_t global_threads_y = dst_height;
+
+    ColorConvertCMYKToRGBOrientedKernel<<<dim3(ceil(static_cast<float>(global_threads_x) / local_threads_x), ceil(static_cast<float>(global_threads_y) / local_threads_y)),
+                        dim3(local_threads_x, local_threads_y), 0, stream>>>(dst_width, dst_height, src_width, src_height, orientation,
+                        dst_image_r, dst_image_g, dst_image_b, dst_pixel_step, dst_image_stride_in_bytes, src_image);
+}
@@ -301,6 +301,176 @@ void ConvertPackedYUYVToPlanarYUV(hipStream_t stream, uint32_t dst_width, uint32
     uint8_t *destination_y, uint8_t *destination_u, uint8_t *destination_v, uint32_t dst_luma_stride_in_bytes,
     uint32_t dst_chroma_stride_in_bytes, const uint8_t *src_image, uint32_t src_image_stride_in_bytes);
 
+/**
+ * @brief Structure describing where the samples of a decoded picture are read by the oriented conversion kernels.
+ *
+ * The luma (or red) sample of pixel (x, y) is read at y_image[y * y_image_stride_in_bytes + x * y_sample_step], and the
+ * chroma (or green and blue) samples are read in the same way at (x >> uv_shift_x, y >> uv_shift_y) in u_image and v_image.
+ * If u_image is nullptr, the picture is greyscale.
+ */
+typedef struct OrientedSourceImageType {
+    const uint8_t *y_image; /**< Pointer to the first luma (or red) sample. */
+    uint32_t y_image_stride_in_bytes; /**< The stride (in bytes) of the luma (or red) samples. */
+    uint32_t y_sample_step; /**< The distance (in bytes) between two horizontally adjacent luma (or red) samples. */
+    const uint8_t *u_image; /**< Pointer to the first U (or green) sample, or nullptr for a greyscale picture. */
+    const uint8_t *v_image; /**< Pointer to the first V (or blue) sample. */
+    uint32_t uv_image_stride_in_bytes; /**< The stride (in bytes) of the chroma (or green and blue) samples. */
+    uint32_t uv_sample_step; /**< The distance (in bytes) between two horizontally adjacent chroma (or green and blue) samples. */
+    uint32_t uv_shift_x; /**< Horizontal chroma subsampling shift. */
+    uint32_t uv_shift_y; /**< Vertical chroma subsampling shift. */
+    bool is_rgb; /**< True if the samples are R, G, and B instead of Y, U, and V. */
+} OrientedSourceImage;
+
+/**
+ * @brief Converts a decoded picture to RGB while applying an EXIF orientation.
+ *
+ * This function reads the samples described by `src_image`, converts them to RGB, and writes them to their
+ * reoriented position, so the orientation doesn't cost an extra pass over the picture. For orientations 5 to 8
+ * the destination is `src_height` pixels wide and `src_width` pixels high.
+ *
+ * @param stream The HIP stream to be used for the conversion.
+ * @param src_width The width of the source picture.
+ * @param src_height The height of the source picture.
+ * @param orientation The EXIF orientation (1 to 8) to apply.
+ * @param dst_image_r Pointer to the first red sample of the destination image.
+ * @param dst_image_g Pointer to the first green sample of the destination image.
+ * @param dst_image_b Pointer to the first blue sample of the destination image.
+ * @param dst_pixel_step The distance (in bytes) between two adjacent destination pixels (3 for interleaved RGB, 1 for planar RGB).
+ * @param dst_image_stride_in_bytes The stride (in bytes) of the destination image.
+ * @param src_image The description of the source picture.
+ */
+void ColorConvertToRGBOriented(hipStream_t stream, uint32_t src_width, uint32_t src_height, uint32_t orientation,
+    uint8_t *dst_image_r, uint8_t *dst_image_g, uint8_t *dst_image_b, uint32_t dst_pixel_step, uint32_t dst_image_stride_in_bytes,
+    const OrientedSourceImage &src_image);
+
+/**
+ * @brief Copies a plane of samples while applying an EXIF orientation.
+ *
+ * A sample is one or two bytes wide (e.g., two bytes for the interleaved UV plane of NV12), and the source samples may
+ * be interleaved with other data (e.g., the Y samples of a packed YUYV image). For orientations 5 to 8 the destination
+ * is `src_height` samples wide and `src_width` samples high.
+ *
+ * @param stream The HIP stream to be used for the copy.
+ * @param src_width The width of the source plane in samples.
+ * @param src_height The height of the source plane in samples.
+ * @param orientation The EXIF orientation (1 to 8) to apply.
+ * @param dst_image Pointer to the destination plane.
+ * @param dst_image_stride_in_bytes The stride (in bytes) of the destination plane.
+ * @param src_image Pointer to the first sample of the source plane.
+ * @param src_image_stride_in_bytes The stride (in bytes) of the source plane.
+ * @param src_sample_step The distance (in bytes) between two horizontally adjacent source samples.
+ * @param sample_size The size of a sample in bytes (1 or 2).
+ */
+void CopyPlaneOriented(hipStream_t stream, uint32_t src_width, uint32_t src_height, uint32_t orientation,
+    uint8_t *dst_image, uint32_t dst_image_stride_in_bytes, const uint8_t *src_image, uint32_t src_image_stride_in_bytes,
+    uint32_t src_sample_step, uint32_t sample_size);
+
+/**
+ * @brief Structure holding a quantization table in natural order for the IDCT kernel.
+ */
+typedef struct IdctQuantizationTableType {
+    uint16_t values[64]; /**< The quantization values, in natural (row-major) order. */
+} IdctQuantizationTable;
+
+/**
+ * @brief Structure describing a color component of a frame of a batch decoded by the hybrid decoder.
+ *
+ * The samples of the component are written to a plane of a decoded picture. The destination samples may be
+ * interleaved with other data (e.g., the U samples of an NV12 picture), so that the picture can be laid out like
+ * the surfaces of the VCN JPEG decoder.
+ */
+typedef struct IdctComponentDescType {
+    size_t coefficient_offset; /**< The offset of the first block of the component in the coefficient buffer of the batch, in coefficients. */
+    size_t dst_offset; /**< The offset of the first sample of the component in the surface buffer of the batch, in bytes. */
+    uint32_t first_block; /**< The index of the first block of the component among all the blocks of the batch. */
+    uint32_t width_in_blocks; /**< The number of blocks per row of the component. */
+    uint32_t height_in_blocks; /**< The number of block rows of the component. */
+    uint32_t sample_precision; /**< The number of bits of the samples of the frame (8 or 12). */
+    uint32_t dst_image_stride_in_bytes; /**< The stride (in bytes) of the destination plane. */
+    uint32_t dst_sample_step; /**< The distance (in bytes) between two horizontally adjacent samples of the destination plane. */
+    uint32_t dst_sample_size; /**< The size of a destination sample in bytes (1 or 2). */
+    IdctQuantizationTable quantization_table; /**< The quantization table of the component. */
+} IdctComponentDesc;
+
+/**
+ * @brief Dequantizes the DCT coefficients of the color components of a batch of frames and computes their inverse DCT.
+ *
+ * This function writes the samples of all the blocks of a batch, decoded on the CPU by the software entropy
+ * decoder, into the decoded pictures with a single kernel launch. One-byte destination samples of a 12-bit frame
+ * are scaled to 8 bits; two-byte destination samples keep the precision of the frame.
+ *
+ * @param stream The HIP stream to be used for the transform.
+ * @param coefficients Pointer to the coefficient buffer of the batch; the 64 coefficients of each block are in natural order.
+ * @param components Pointer to the descriptions of the components in device memory, sorted by their first block.
+ * @param num_components The number of components of the batch.
+ * @param num_blocks The total number of blocks of the batch.
+ * @param dst_surfaces Pointer to the surface buffer of the batch.
+ */
+void DequantizeIdctBatched(hipStream_t stream, const int16_t *coefficients, const IdctComponentDesc *components, uint32_t num_components,
+    uint32_t num_blocks, uint8_t *dst_surfaces);
+
+/**
+ * @brief Converts a decoded picture with 16-bit samples to 16-bit RGB while applying an EXIF orientation.
+ *
+ * The samples described by `src_image` are 16-bit values of `sample_precision` bits; the strides and sample steps
+ * are in bytes. The RGB samples have the same precision. For orientations 5 to 8 the destination is `src_height`
+ * pixels wide and `src_width` pixels high.
+ *
+ * @param stream The HIP stream to be used for the conversion.
+ * @param src_width The width of the source picture.
+ * @param src_height The height of the source picture.
+ * @param orientation The EXIF orientation (1 to 8) to apply.
+ * @param sample_precision The number of bits of the samples (8 or 12).
+ * @param dst_image_r Pointer to the first red sample of the destination image.
+ * @param dst_image_g Pointer to the first green sample of the destination image.
+ * @param dst_image_b Pointer to the first blue sample of the destination image.
+ * @param dst_pixel_step The distance (in bytes) between two adjacent destination pixels (6 for interleaved RGB, 2 for planar RGB).
+ * @param dst_image_stride_in_bytes The stride (in bytes) of the destination image.
+ * @param src_image The description of the source picture.
+ */
+void ColorConvertToRGB16Oriented(hipStream_t stream, uint32_t src_width, uint32_t src_height, uint32_t orientation, uint32_t sample_precision,
+    uint8_t *dst_image_r, uint8_t *dst_image_g, uint8_t *dst_image_b, uint32_t dst_pixel_step, uint32_t dst_image_stride_in_bytes,
+    const OrientedSourceImage &src_image);
+
+/**
+ * @brief Structure describing where the samples of a decoded picture with four components are read by the CMYK conversion kernel.
+ *
+ * The sample of component i for pixel (x, y) is read at images[i][(y >> shift_y[i]) * image_strides_in_bytes[i] + (x >> shift_x[i]) * sample_size].
+ * The components are C, M, Y, and K, or Y, Cb, Cr, and K for a YCCK picture.
+ */
+typedef struct OrientedCmykSourceImageType {
+    const uint8_t *images[4]; /**< Pointers to the first sample of each component. */
+    uint32_t image_strides_in_bytes[4]; /**< The stride (in bytes) of each component. */
+    uint32_t shift_x[4]; /**< Horizontal subsampling shift of each component. */
+    uint32_t shift_y[4]; /**< Vertical subsampling shift of each component. */
+    uint32_t sample_size; /**< The size of a sample in bytes (1 or 2). */
+    uint32_t sample_precision; /**< The number of bits of the samples (8 or 12). */
+    bool is_ycck; /**< True if the first three components are YCbCr, which convert to the C, M, and Y inks. */
+    bool is_inverted; /**< True if the C, M, Y, and K samples are inverted (0 is full ink), as written by Adobe applications. */
+} OrientedCmykSourceImage;
+
+/**
+ * @brief Converts a decoded CMYK or YCCK picture to RGB while applying an EXIF orientation.
+ *
+ * Each RGB sample is the product of the light not absorbed by the matching ink and by the K ink. The RGB samples
+ * have the size and the precision of the source samples. For orientations 5 to 8 the destination is `src_height`
+ * pixels wide and `src_width` pixels high.
+ *
+ * @param stream The HIP stream to be used for the conversion.
+ * @param src_width The width of the source picture.
+ * @param src_height The height of the source picture.
+ * @param orientation The EXIF orientation (1 to 8) to apply.
+ * @param dst_image_r Pointer to the first red sample of the destination image.
+ * @param dst_image_g Pointer to the first green sample of the destination image.
+ * @param dst_image_b Pointer to the first blue sample of the destination image.
+ * @param dst_pixel_step The distance (in bytes) between two adjacent destination pixels.
+ * @param dst_image_stride_in_bytes The stride (in bytes) of the destination image.
+ * @param src_image The description of the source picture.
+ */
+void ColorConvertCMYKToRGBOriented(hipStream_t stream, uint32_t src_width, uint32_t src_height, uint32_t orientation,
+    uint8_t *dst_image_r, uint8_t *dst_image_g, uint8_t *dst_image_b, uint32_t dst_pixel_step, uint32_t dst_image_stride_in_bytes,
+    const OrientedCmykSourceImage &src_image);
+
 /**
  * @brief Structure representing an array of 6 unsigned integers.
  *
@@ -0,0 +1,84 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include <cstring>
+#include "rocjpeg_huffman_table.h"
+
+/**
+ * @brief Expands a Huffman table into a decoding table.
+ *
+ * The codes are assigned canonically, in increasing order of length, as in Annex C of the JPEG standard. In the fast
+ * table, the symbol of a DC table is the size of the DC difference (a size above 15 is read as 0, as by the
+ * decoder), and the symbol of an AC table is the run of zeros and the size of the coefficient; a symbol of size 0
+ * has a value of 0 and only its run, so the decoder tells an EOB or ZRL symbol apart by its value.
+ *
+ * @param huffman_table The Huffman table.
+ * @param table_class The class of the table: 0 for a DC table, 1 for an AC table.
+ * @param table The decoding table.
+ * @return True if the code lengths describe a valid prefix code, false otherwise.
+ */
+bool BuildHuffmanDecodeTable(const HuffmanTable &huffman_table, uint8_t table_class, HuffmanDecodeTable &table) {
+    std::memset(table.fast, 0, sizeof(table.fast));
+    std::memset(table.lookup, 0, sizeof(table.lookup));
+    table.is_defined = false;
+    int32_t code = 0;
+    int32_t num_values = 0;
+    for (int32_t length = 1; length <= 16; length++) {
+        int32_t count = huffman_table.num_codes[length - 1];
+        table.value_offset[length] = num_values - code;
+        // the codes of each length must fit in that length, and the all-ones code is reserved
+        if (code + count >= (1 << length)) {
+            return false;
+        }
+        for (int32_t i = 0; i < count; i++) {
+            uint8_t symbol = huffman_table.values[num_values + i];
+            table.values[num_values + i] = symbol;
+            if (length <= HUFFMAN_LOOKAHEAD_BITS) {
+                int32_t shift = HUFFMAN_LOOKAHEAD_BITS - length;
+                uint16_t entry = static_cast<uint16_t>((length << 8) | symbol);
+                for (int32_t j = 0; j < (1 << shift); j++) {
+                    table.lookup[((code + i) << shift) + j] = entry;
+                }
+            }
+            int32_t run = table_class ? symbol >> 4 : 0;
+            int32_t size = table_class ? symbol & 15 : (symbol > 15 ? 0 : symbol);
+            if (length + size <= HUFFMAN_FAST_LOOKAHEAD_BITS) {
+                // every lookahead that starts with the code holds the extra bits in its next size bits
+                int32_t shift = HUFFMAN_FAST_LOOKAHEAD_BITS - length;
+                for (int32_t j = 0; j < (1 << shift); j++) {
+                    int32_t value = 0;
+                    if (size) {
+                        value = j >> (shift - size);
+                        value = value < (1 << (size - 1)) ? value - (1 << size) + 1 : value;
+                    }
+                    table.fast[((code + i) << shift) + j] = value * 65536 + (run << 8) + length + size;
+                }
+            }
+        }
+        code += count;
+        num_values += count;
+        table.max_code[length] = count ? code - 1 : -1;
+        code <<= 1;
+    }
+    table.max_code[17] = INT32_MAX;
+    table.is_defined = true;
+    return true;
+}
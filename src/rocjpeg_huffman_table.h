@@ -0,0 +1,61 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef ROC_JPEG_HUFFMAN_TABLE_H_
+#define ROC_JPEG_HUFFMAN_TABLE_H_
+
+#pragma once
+
+#include <stdint.h>
+#include "rocjpeg_parser.h"
+
+#define HUFFMAN_LOOKAHEAD_BITS 9
+#define HUFFMAN_FAST_LOOKAHEAD_BITS 11
+
+/**
+ * @brief Structure representing a Huffman table expanded for decoding.
+ *
+ * The table is decoded at three speeds. The fast table decodes, with a single lookup of the next
+ * HUFFMAN_FAST_LOOKAHEAD_BITS bits, a code and the extra bits that follow it when both fit in the lookahead: it gives
+ * the run, the sign-extended value, and the number of bits to consume. The other codes of up to HUFFMAN_LOOKAHEAD_BITS
+ * bits are decoded with a single lookup of the symbol, and the longer codes with the canonical maximum code of each
+ * code length.
+ */
+typedef struct HuffmanDecodeTableType {
+    int32_t fast[1 << HUFFMAN_FAST_LOOKAHEAD_BITS]; /**< (value << 16) | (run << 8) | number of bits, or 0 if the code and its extra bits don't fit. */
+    uint16_t lookup[1 << HUFFMAN_LOOKAHEAD_BITS]; /**< (code length << 8) | symbol, or 0 for longer codes. */
+    int32_t max_code[18]; /**< The largest code of each length, or -1 if there is none; max_code[17] is a sentinel. */
+    int32_t value_offset[17]; /**< The index of the first symbol of each length minus the first code of that length. */
+    uint8_t values[256]; /**< The symbols, in code order. */
+    bool is_defined; /**< True if the code lengths of the table describe a valid prefix code. */
+} HuffmanDecodeTable;
+
+/**
+ * @brief Expands a Huffman table into a decoding table.
+ * @param huffman_table The Huffman table.
+ * @param table_class The class of the table: 0 for a DC table, 1 for an AC table.
+ * @param table The decoding table.
+ * @return True if the code lengths describe a valid prefix code, false otherwise.
+ */
+bool BuildHuffmanDecodeTable(const HuffmanTable &huffman_table, uint8_t table_class, HuffmanDecodeTable &table);
+
+#endif  // ROC_JPEG_HUFFMAN_TABLE_H_
@@ -0,0 +1,421 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "rocjpeg_hybrid_decoder.h"
+
+RocJpegHybridDecoder::RocJpegHybridDecoder() : host_coefficients_{nullptr}, device_coefficients_{nullptr}, coefficient_buffer_size_{0},
+    host_components_{nullptr}, device_components_{nullptr}, component_buffer_size_{0}, device_surface_{nullptr}, surface_buffer_size_{0},
+    host_surface_{nullptr}, host_surface_buffer_size_{0}, is_validation_enabled_{false} {
+    char validate[16];
+    if (GetEnv("ROCJPEG_HYBRID_VALIDATE", validate, sizeof(validate))) {
+        is_validation_enabled_ = atoi(validate) != 0;
+    }
+}
+
+RocJpegHybridDecoder::~RocJpegHybridDecoder() {
+    if (host_coefficients_) {
+        hipError_t hip_status = hipHostFree(host_coefficients_);
+    }
+    if (device_coefficients_) {
+        hipError_t hip_status = hipFree(device_coefficients_);
+    }
+    if (host_components_) {
+        hipError_t hip_status = hipHostFree(host_components_);
+    }
+    if (device_components_) {
+        hipError_t hip_status = hipFree(device_components_);
+    }
+    if (device_surface_) {
+        hipError_t hip_status = hipFree(device_surface_);
+    }
+    if (host_surface_) {
+        hipError_t hip_status = hipHostFree(host_surface_);
+    }
+}
+
+/**
+ * @brief Decodes a JPEG stream into a surface in device memory.
+ *
+ * This function decodes the stream as a batch of one stream.
+ *
+ * @param jpeg_stream_params The parsed JPEG stream parameters.
+ * @param is_16bit_surface True to write a ROCJPEG_FOURCC_YUV16 surface, false to write 8-bit samples.
+ * @param is_dc_only True to decode a preview from the DC coefficients only.
+ * @param hip_stream The HIP stream to be used for the copy and the IDCT.
+ * @param surface The description of the decoded surface.
+ * @return The status of the decoding operation.
+ */
+RocJpegStatus RocJpegHybridDecoder::DecodeToSurface(const JpegStreamParameters *jpeg_stream_params, bool is_16bit_surface, bool is_dc_only,
+                                                    hipStream_t hip_stream, HipInteropDeviceMem &surface) {
+    return DecodeBatchToSurfaces(&jpeg_stream_params, 1, is_16bit_surface, is_dc_only, hip_stream, &surface);
+}
+
+/**
+ * @brief Decodes a batch of JPEG streams into surfaces in device memory.
+ *
+ * This function lays out the coefficients and the surfaces of all the streams in shared buffers, decodes the
+ * entropy-coded data of the streams in parallel on the rocJPEG thread pool into the pinned coefficient buffer,
+ * copies the coefficients and the description of the components to the device, and launches the IDCT kernel once
+ * for the whole batch. The HIP stream is synchronized first, because the pinned buffers may still be read by the
+ * copies queued for the previous batch.
+ *
+ * For DC-only previews, the entropy decoders keep one coefficient per block, and each thread writes the sample of
+ * every block of its stream to a surface in pinned host memory as soon as the stream is decoded; the surfaces are
+ * then copied to the device, and the IDCT kernel isn't launched.
+ *
+ * @param jpeg_streams_params The parsed parameters of the JPEG streams.
+ * @param batch_size The number of JPEG streams in the batch.
+ * @param is_16bit_surface True to write ROCJPEG_FOURCC_YUV16 surfaces, false to write 8-bit samples.
+ * @param is_dc_only True to decode previews from the DC coefficients only.
+ * @param hip_stream The HIP stream to be used for the copy and the IDCT.
+ * @param surfaces The descriptions of the decoded surfaces.
+ * @return The status of the decoding operation.
+ *         - ROCJPEG_STATUS_BAD_JPEG if a stream can't be decoded.
+ *         - ROCJPEG_STATUS_JPEG_NOT_SUPPORTED if the sampling factors of a frame have no matching surface format.
+ */
+RocJpegStatus RocJpegHybridDecoder::DecodeBatchToSurfaces(const JpegStreamParameters *const *jpeg_streams_params, int batch_size,
+                                                          bool is_16bit_surface, bool is_dc_only, hipStream_t hip_stream, HipInteropDeviceMem *surfaces) {
+    if (batch_size <= 0) {
+        return ROCJPEG_STATUS_INVALID_PARAMETER;
+    }
+    if (entropy_decoders_.size() < static_cast<size_t>(batch_size)) {
+        entropy_decoders_.resize(batch_size);
+    }
+    images_.resize(batch_size);
+    planes_.assign(batch_size * NUM_COMPONENTS, {});
+    coefficient_offsets_.resize(batch_size);
+    surface_offsets_.resize(batch_size);
+
+    size_t num_coefficients = 0;
+    size_t surface_size = 0;
+    uint32_t num_components = 0;
+    uint32_t block_size = is_dc_only ? 1 : 8;
+    for (int i = 0; i < batch_size; i++) {
+        entropy_decoders_[i].SetDcOnly(is_dc_only);
+        if (!entropy_decoders_[i].SetStreamParameters(jpeg_streams_params[i], images_[i])) {
+            return ROCJPEG_STATUS_BAD_JPEG;
+        }
+        surfaces[i] = {};
+        CHECK_ROCJPEG(GetSurfaceLayout(images_[i], is_16bit_surface, block_size, surfaces[i], &planes_[i * NUM_COMPONENTS]));
+        coefficient_offsets_[i] = num_coefficients;
+        num_coefficients += images_[i].num_coefficients;
+        // keep every surface aligned like a separately allocated buffer
+        surface_offsets_[i] = surface_size;
+        surface_size += (surfaces[i].size + 255) & ~static_cast<size_t>(255);
+        num_components += images_[i].num_components;
+    }
+
+    CHECK_HIP(hipStreamSynchronize(hip_stream));
+    CHECK_ROCJPEG(AllocateBuffers(num_coefficients, surface_size, num_components, is_dc_only));
+    std::vector<uint8_t> is_decoded(batch_size, 0);
+    RocJpegThreadPool::GetInstance().ParallelFor(batch_size, [&](int i) {
+        is_decoded[i] = entropy_decoders_[i].DecodeCoefficients(images_[i], host_coefficients_ + coefficient_offsets_[i]);
+        if (is_decoded[i] && is_dc_only) {
+            WriteDcSurface(images_[i], host_coefficients_ + coefficient_offsets_[i], &planes_[i * NUM_COMPONENTS], host_surface_ + surface_offsets_[i]);
+        }
+    });
+    for (int i = 0; i < batch_size; i++) {
+        if (!is_decoded[i]) {
+            return ROCJPEG_STATUS_BAD_JPEG;
+        }
+    }
+    if (is_dc_only) {
+        CHECK_HIP(hipMemcpyHtoDAsync(device_surface_, host_surface_, surface_size, hip_stream));
+        for (int i = 0; i < batch_size; i++) {
+            surfaces[i].hip_mapped_device_mem = device_surface_ + surface_offsets_[i];
+        }
+        return ROCJPEG_STATUS_SUCCESS;
+    }
+
+    // the quantization tables are only known once the scans are decoded
+    uint32_t num_blocks = 0;
+    IdctComponentDesc *component_desc = host_components_;
+    for (int i = 0; i < batch_size; i++) {
+        for (int32_t c = 0; c < images_[i].num_components; c++, component_desc++) {
+            const JpegCoefficientComponent &component = images_[i].components[c];
+            const ComponentPlane &plane = planes_[i * NUM_COMPONENTS + c];
+            component_desc->coefficient_offset = coefficient_offsets_[i] + component.coefficient_offset;
+            component_desc->dst_offset = surface_offsets_[i] + plane.offset;
+            component_desc->first_block = num_blocks;
+            component_desc->width_in_blocks = component.width_in_blocks;
+            component_desc->height_in_blocks = component.height_in_blocks;
+            component_desc->sample_precision = images_[i].sample_precision;
+            component_desc->dst_image_stride_in_bytes = plane.pitch;
+            component_desc->dst_sample_step = plane.sample_step;
+            component_desc->dst_sample_size = plane.sample_size;
+            std::memcpy(component_desc->quantization_table.values, component.quantization_table, sizeof(component_desc->quantization_table.values));
+            num_blocks += component.width_in_blocks * component.height_in_blocks;
+        }
+    }
+    CHECK_HIP(hipMemcpyHtoDAsync(device_coefficients_, host_coefficients_, num_coefficients * sizeof(int16_t), hip_stream));
+    CHECK_HIP(hipMemcpyHtoDAsync(device_components_, host_components_, num_components * sizeof(IdctComponentDesc), hip_stream));
+    DequantizeIdctBatched(hip_stream, device_coefficients_, device_components_, num_components, num_blocks, device_surface_);
+    CHECK_HIP(hipGetLastError());
+    if (is_validation_enabled_) {
+        CHECK_ROCJPEG(ValidateSurfaces(num_components, surface_size, hip_stream));
+    }
+
+    for (int i = 0; i < batch_size; i++) {
+        surfaces[i].hip_mapped_device_mem = device_surface_ + surface_offsets_[i];
+    }
+    return ROCJPEG_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Compares the surfaces written by the IDCT kernel with the IDCT computed on the CPU.
+ *
+ * This function is enabled by setting the ROCJPEG_HYBRID_VALIDATE environment variable to a non-zero value. It
+ * waits for the IDCT kernel, copies the surfaces back to the host, and compares every sample of every block with
+ * the samples computed from the pinned coefficients by the same islow IDCT built for the CPU, which is bit-exact
+ * with the IJG libjpeg.
+ *
+ * @param num_components The number of components of the batch.
+ * @param surface_size The size of the surfaces of the batch in bytes.
+ * @param hip_stream The HIP stream the IDCT was queued on.
+ * @return The status of the operation. Returns ROCJPEG_STATUS_EXECUTION_FAILED if a sample differs.
+ */
+RocJpegStatus RocJpegHybridDecoder::ValidateSurfaces(uint32_t num_components, size_t surface_size, hipStream_t hip_stream) {
+    std::vector<uint8_t> decoded_surfaces(surface_size);
+    CHECK_HIP(hipStreamSynchronize(hip_stream));
+    CHECK_HIP(hipMemcpy(decoded_surfaces.data(), device_surface_, surface_size, hipMemcpyDeviceToHost));
+
+    uint8_t reference[DCT_BLOCK_SIZE * sizeof(uint16_t)];
+    for (uint32_t c = 0; c < num_components; c++) {
+        const IdctComponentDesc &component = host_components_[c];
+        uint32_t sample_size = component.dst_sample_size;
+        for (uint32_t y = 0; y < component.height_in_blocks; y++) {
+            for (uint32_t x = 0; x < component.width_in_blocks; x++) {
+                const int16_t *block = host_coefficients_ + component.coefficient_offset + (static_cast<size_t>(y) * component.width_in_blocks + x) * DCT_BLOCK_SIZE;
+                DequantizeIdctBlock(block, component.quantization_table.values, component.sample_precision, reference, 8 * sample_size, sample_size, sample_size);
+                const uint8_t *decoded = decoded_surfaces.data() + component.dst_offset + static_cast<size_t>(y) * 8 * component.dst_image_stride_in_bytes +
+                                         x * 8 * component.dst_sample_step;
+                for (int32_t row = 0; row < 8; row++) {
+                    for (int32_t i = 0; i < 8; i++) {
+                        if (std::memcmp(decoded + row * component.dst_image_stride_in_bytes + i * component.dst_sample_step,
+                                        reference + (row * 8 + i) * sample_size, sample_size) != 0) {
+                            ERR("ERROR: the IDCT of component " + TOSTR(c) + " block (" + TOSTR(x) + ", " + TOSTR(y) +
+                                ") doesn't match the CPU reference!");
+                            return ROCJPEG_STATUS_EXECUTION_FAILED;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return ROCJPEG_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Writes the DC-only preview of a stream to its surface in host memory.
+ *
+ * The sample of each block is its 1x1 inverse DCT, the dequantized DC coefficient scaled down by 8 and level
+ * shifted, which is the sample the 1/8 scaled decoding of the IJG libjpeg gives.
+ *
+ * @param image The layout of the DC coefficients of the frame.
+ * @param dc_coefficients The DC coefficients of the frame, one per block.
+ * @param planes The location of each component in the surface.
+ * @param surface Pointer to the first byte of the surface.
+ */
+void RocJpegHybridDecoder::WriteDcSurface(const JpegCoefficientImage &image, const int16_t *dc_coefficients, const ComponentPlane *planes, uint8_t *surface) {
+    for (int32_t c = 0; c < image.num_components; c++) {
+        const JpegCoefficientComponent &component = image.components[c];
+        const ComponentPlane &plane = planes[c];
+        const int16_t *coefficient = dc_coefficients + component.coefficient_offset;
+        for (uint32_t y = 0; y < component.height_in_blocks; y++) {
+            uint8_t *dst = surface + plane.offset + static_cast<size_t>(y) * plane.pitch;
+            for (uint32_t x = 0; x < component.width_in_blocks; x++, coefficient++, dst += plane.sample_step) {
+                DequantizeScaledIdctBlock(coefficient, component.quantization_table, image.sample_precision, 3, dst, plane.pitch, plane.sample_size);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Selects the surface format of a frame and locates its components in the surface.
+ *
+ * The format is selected from the size of the chroma components relative to the luma component, as the VCN JPEG
+ * decoder does: the same size gives 444P, half the height 422V (YUV 4:4:0), half the width packed YUYV, and half
+ * both NV12. A ROCJPEG_FOURCC_YUV16 surface has one plane of 16-bit samples per component instead, and so has a
+ * ROCJPEG_FOURCC_CMYK surface with 8-bit samples, which holds the frames with four components. The component
+ * planes are padded to whole MCUs, so the IDCT writes complete blocks. A DC-only preview is laid out the same way
+ * with one sample per block.
+ *
+ * @param image The layout of the coefficients of the frame.
+ * @param is_16bit_surface True to lay out a ROCJPEG_FOURCC_YUV16 surface.
+ * @param block_size The number of samples per row and column of a block (8 or 1).
+ * @param surface The description of the surface.
+ * @param planes The location of each component in the surface.
+ * @return The status of the operation. Returns ROCJPEG_STATUS_JPEG_NOT_SUPPORTED if no surface format matches the frame.
+ */
+RocJpegStatus RocJpegHybridDecoder::GetSurfaceLayout(const JpegCoefficientImage &image, bool is_16bit_surface, uint32_t block_size,
+                                                     HipInteropDeviceMem &surface, ComponentPlane *planes) {
+    uint32_t width = image.components[0].width_in_blocks * block_size;
+    uint32_t height = image.components[0].height_in_blocks * block_size;
+    surface.width = width;
+    surface.height = height;
+    surface.num_layers = 1;
+
+    if (is_16bit_surface || image.num_components == NUM_COMPONENTS) {
+        if (image.num_components == 2) {
+            ERR("ERROR: the number of JPEG components is not supported!");
+            return ROCJPEG_STATUS_JPEG_NOT_SUPPORTED;
+        }
+        uint32_t sample_size = is_16bit_surface ? sizeof(uint16_t) : sizeof(uint8_t);
+        surface.surface_format = is_16bit_surface ? ROCJPEG_FOURCC_YUV16 : ROCJPEG_FOURCC_CMYK;
+        surface.num_layers = image.num_components;
+        for (int32_t i = 0; i < image.num_components; i++) {
+            surface.offset[i] = surface.size;
+            surface.pitch[i] = image.components[i].width_in_blocks * block_size * sample_size;
+            surface.size += surface.pitch[i] * image.components[i].height_in_blocks * block_size;
+            planes[i] = {surface.offset[i], surface.pitch[i], sample_size, sample_size};
+        }
+        return ROCJPEG_STATUS_SUCCESS;
+    }
+
+    if (image.num_components == 1) {
+        surface.surface_format = VA_FOURCC_Y800;
+        surface.pitch[0] = width;
+        surface.size = width * height;
+        planes[0] = {0, width, 1, 1};
+        return ROCJPEG_STATUS_SUCCESS;
+    }
+
+    const JpegCoefficientComponent &u = image.components[1];
+    const JpegCoefficientComponent &v = image.components[2];
+    if (image.num_components != 3 || u.h_sampling_factor != v.h_sampling_factor || u.v_sampling_factor != v.v_sampling_factor) {
+        ERR("ERROR: the sampling factors of the JPEG components are not supported!");
+        return ROCJPEG_STATUS_JPEG_NOT_SUPPORTED;
+    }
+    uint32_t chroma_width = u.width_in_blocks * block_size;
+    uint32_t chroma_height = u.height_in_blocks * block_size;
+    if (chroma_width == width && chroma_height == height) {
+        surface.surface_format = VA_FOURCC_444P;
+        surface.offset[1] = width * height;
+        surface.offset[2] = 2 * width * height;
+        surface.pitch[0] = surface.pitch[1] = surface.pitch[2] = width;
+        surface.size = 3 * width * height;
+        planes[0] = {0, width, 1, 1};
+        planes[1] = {surface.offset[1], width, 1, 1};
+        planes[2] = {surface.offset[2], width, 1, 1};
+    } else if (chroma_width == width && chroma_height * 2 == height) {
+        surface.surface_format = VA_FOURCC_422V;
+        surface.offset[1] = width * height;
+        surface.offset[2] = width * height + width * chroma_height;
+        surface.pitch[0] = surface.pitch[1] = surface.pitch[2] = width;
+        surface.size = width * height + 2 * width * chroma_height;
+        planes[0] = {0, width, 1, 1};
+        planes[1] = {surface.offset[1], width, 1, 1};
+        planes[2] = {surface.offset[2], width, 1, 1};
+    } else if (chroma_width * 2 == width && chroma_height == height) {
+        surface.surface_format = ROCJPEG_FOURCC_YUYV;
+        surface.pitch[0] = 2 * width;
+        surface.size = 2 * width * height;
+        planes[0] = {0, 2 * width, 2, 1};
+        planes[1] = {1, 2 * width, 4, 1};
+        planes[2] = {3, 2 * width, 4, 1};
+    } else if (chroma_width * 2 == width && chroma_height * 2 == height) {
+        surface.surface_format = VA_FOURCC_NV12;
+        surface.offset[1] = width * height;
+        surface.pitch[0] = surface.pitch[1] = width;
+        surface.size = width * height + width * chroma_height;
+        planes[0] = {0, width, 1, 1};
+        planes[1] = {surface.offset[1], width, 2, 1};
+        planes[2] = {surface.offset[1] + 1, width, 2, 1};
+    } else {
+        ERR("ERROR: the sampling factors of the JPEG components are not supported!");
+        return ROCJPEG_STATUS_JPEG_NOT_SUPPORTED;
+    }
+    return ROCJPEG_STATUS_SUCCESS;
+}
+
+/**
+ * @brief Grows the coefficient, component, and surface buffers.
+ *
+ * The buffers are only reallocated when a batch doesn't fit, so a sequence of batches of similar size reuses them.
+ *
+ * @param num_coefficients The number of coefficients of the batch.
+ * @param surface_size The size of the surfaces of the batch in bytes.
+ * @param num_components The number of components of the batch.
+ * @param is_host_surface_required True if the surfaces are computed on the host.
+ * @return The status of the operation. Returns ROCJPEG_STATUS_OUTOF_MEMORY if a buffer can't be allocated.
+ */
+RocJpegStatus RocJpegHybridDecoder::AllocateBuffers(size_t num_coefficients, size_t surface_size, uint32_t num_components, bool is_host_surface_required) {
+    if (num_coefficients > coefficient_buffer_size_) {
+        if (host_coefficients_) {
+            CHECK_HIP(hipHostFree(host_coefficients_));
+            host_coefficients_ = nullptr;
+        }
+        if (device_coefficients_) {
+            CHECK_HIP(hipFree(device_coefficients_));
+            device_coefficients_ = nullptr;
+        }
+        coefficient_buffer_size_ = 0;
+        if (hipHostMalloc(reinterpret_cast<void**>(&host_coefficients_), num_coefficients * sizeof(int16_t)) != hipSuccess ||
+            hipMalloc(reinterpret_cast<void**>(&device_coefficients_), num_coefficients * sizeof(int16_t)) != hipSuccess) {
+            ERR("ERROR: failed to allocate the coefficient buffers!");
+            return ROCJPEG_STATUS_OUTOF_MEMORY;
+        }
+        coefficient_buffer_size_ = num_coefficients;
+    }
+    if (num_components > component_buffer_size_) {
+        if (host_components_) {
+            CHECK_HIP(hipHostFree(host_components_));
+            host_components_ = nullptr;
+        }
+        if (device_components_) {
+            CHECK_HIP(hipFree(device_components_));
+            device_components_ = nullptr;
+        }
+        component_buffer_size_ = 0;
+        if (hipHostMalloc(reinterpret_cast<void**>(&host_components_), num_components * sizeof(IdctComponentDesc)) != hipSuccess ||
+            hipMalloc(reinterpret_cast<void**>(&device_components_), num_components * sizeof(IdctComponentDesc)) != hipSuccess) {
+            ERR("ERROR: failed to allocate the component buffers!");
+            return ROCJPEG_STATUS_OUTOF_MEMORY;
+        }
+        component_buffer_size_ = num_components;
+    }
+    if (surface_size > surface_buffer_size_) {
+        if (device_surface_) {
+            CHECK_HIP(hipFree(device_surface_));
+            device_surface_ = nullptr;
+        }
+        surface_buffer_size_ = 0;
+        if (hipMalloc(reinterpret_cast<void**>(&device_surface_), surface_size) != hipSuccess) {
+            ERR("ERROR: failed to allocate the surface buffer!");
+            return ROCJPEG_STATUS_OUTOF_MEMORY;
+        }
+        surface_buffer_size_ = surface_size;
+    }
+    if (is_host_surface_required && surface_size > host_surface_buffer_size_) {
+        if (host_surface_) {
+            CHECK_HIP(hipHostFree(host_surface_));
+            host_surface_ = nullptr;
+        }
+        host_surface_buffer_size_ = 0;
+        if (hipHostMalloc(reinterpret_cast<void**>(&host_surface_), surface_size) != hipSuccess) {
+            ERR("ERROR: failed to allocate the host surface buffer!");
+            return ROCJPEG_STATUS_OUTOF_MEMORY;
+        }
+        host_surface_buffer_size_ = surface_size;
+    }
+    return ROCJPEG_STATUS_SUCCESS;
+}
@@ -0,0 +1,180 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef ROC_JPEG_HYBRID_DECODER_H_
+#define ROC_JPEG_HYBRID_DECODER_H_
+
+#pragma once
+
+#include <hip/hip_runtime.h>
+#include <vector>
+#include "../api/rocjpeg.h"
+#include "rocjpeg_commons.h"
+#include "rocjpeg_entropy_decoder.h"
+#include "rocjpeg_vaapi_decoder.h"
+#include "rocjpeg_hip_kernels.h"
+#include "rocjpeg_thread_pool.h"
+
+/**
+ * @brief Fourcc of the planar surface with 16-bit samples written by the hybrid decoder ('Y', 'U', '1', '6').
+ *
+ * Each component has its own plane at its own resolution; the samples keep the precision of the frame.
+ */
+#define ROCJPEG_FOURCC_YUV16 0x36315559
+
+/**
+ * @brief Fourcc of the planar surface with 8-bit samples written by the hybrid decoder for the frames with four components ('C', 'M', 'Y', 'K').
+ *
+ * Each component (C, M, Y, and K, or Y, Cb, Cr, and K) has its own plane at its own resolution.
+ */
+#define ROCJPEG_FOURCC_CMYK 0x4B594D43
+
+/**
+ * @class RocJpegHybridDecoder
+ * @brief A class that decodes JPEG streams with the entropy decoding on the CPU and the IDCT on the GPU.
+ *
+ * The hybrid decoder handles the streams the VCN JPEG decoder can't decode, and all the streams of the
+ * ROCJPEG_BACKEND_HYBRID backend. The streams of a batch are entropy decoded in parallel on the rocJPEG thread pool
+ * into pinned host memory; the coefficients of the whole batch are copied to the GPU and transformed by a single
+ * launch of the IDCT kernel, each picture into a device buffer that is laid out like a surface of the VCN JPEG
+ * decoder (Y800, NV12, YUYV, 444P, or 422V),
+ * so the decoded picture goes through the same output stage (color conversion, crop, and orientation) as the
+ * pictures decoded by the hardware. For the 16-bit output formats, the picture is written to a planar surface
+ * with 16-bit samples (ROCJPEG_FOURCC_YUV16) instead, and the frames with four components are written to a planar
+ * surface with one plane per component (ROCJPEG_FOURCC_CMYK, or ROCJPEG_FOURCC_YUV16 with four layers).
+ *
+ * For the DC-only previews, only the DC coefficients are entropy decoded, and the surfaces, with one sample per
+ * block, are computed on the CPU and copied to the device instead of being written by the IDCT kernel.
+ */
+class RocJpegHybridDecoder {
+public:
+   /**
+    * @brief Constructs a RocJpegHybridDecoder object.
+    */
+   RocJpegHybridDecoder();
+
+   /**
+    * @brief Destroys the RocJpegHybridDecoder object and releases its buffers.
+    */
+   ~RocJpegHybridDecoder();
+
+   /**
+    * @brief Decodes a JPEG stream into a surface in device memory.
+    *
+    * The work on the GPU is queued on the HIP stream. The surface stays valid until the next call.
+    *
+    * @param jpeg_stream_params The parsed JPEG stream parameters.
+    * @param is_16bit_surface True to write a ROCJPEG_FOURCC_YUV16 surface, false to write 8-bit samples (12-bit samples are scaled).
+    * @param is_dc_only True to decode a preview with one sample per block from the DC coefficients only.
+    * @param hip_stream The HIP stream to be used for the copy and the IDCT.
+    * @param surface The description of the decoded surface, in the layout of the HIP interop memory of a VA surface.
+    * @return The status of the decoding operation.
+    */
+   RocJpegStatus DecodeToSurface(const JpegStreamParameters *jpeg_stream_params, bool is_16bit_surface, bool is_dc_only, hipStream_t hip_stream,
+                                 HipInteropDeviceMem &surface);
+
+   /**
+    * @brief Decodes a batch of JPEG streams into surfaces in device memory.
+    *
+    * The work on the GPU is queued on the HIP stream. The surfaces stay valid until the next call.
+    *
+    * @param jpeg_streams_params The parsed parameters of the JPEG streams.
+    * @param batch_size The number of JPEG streams in the batch.
+    * @param is_16bit_surface True to write ROCJPEG_FOURCC_YUV16 surfaces, false to write 8-bit samples (12-bit samples are scaled).
+    * @param is_dc_only True to decode previews with one sample per block from the DC coefficients only.
+    * @param hip_stream The HIP stream to be used for the copy and the IDCT.
+    * @param surfaces The descriptions of the decoded surfaces, one per stream.
+    * @return The status of the decoding operation.
+    */
+   RocJpegStatus DecodeBatchToSurfaces(const JpegStreamParameters *const *jpeg_streams_params, int batch_size, bool is_16bit_surface,
+                                       bool is_dc_only, hipStream_t hip_stream, HipInteropDeviceMem *surfaces);
+
+private:
+   /**
+    * @brief Structure locating the samples of a component in the decoded surface.
+    */
+   struct ComponentPlane {
+      uint32_t offset; ///< Offset of the first sample of the component in the surface.
+      uint32_t pitch; ///< The stride (in bytes) of the component.
+      uint32_t sample_step; ///< The distance (in bytes) between two horizontally adjacent samples of the component.
+      uint32_t sample_size; ///< The size of a sample in bytes (1 or 2).
+   };
+
+   /**
+    * @brief Selects the surface format matching the sampling factors of a frame and locates its components in the surface.
+    * @param image The layout of the coefficients of the frame.
+    * @param is_16bit_surface True to lay out a ROCJPEG_FOURCC_YUV16 surface.
+    * @param block_size The number of samples per row and column of a block (8, or 1 for a DC-only preview).
+    * @param surface The description of the surface; the device memory pointer isn't set.
+    * @param planes The location of each component in the surface.
+    * @return The status of the operation. Returns ROCJPEG_STATUS_JPEG_NOT_SUPPORTED if no surface format matches the frame.
+    */
+   RocJpegStatus GetSurfaceLayout(const JpegCoefficientImage &image, bool is_16bit_surface, uint32_t block_size, HipInteropDeviceMem &surface,
+                                  ComponentPlane *planes);
+
+   /**
+    * @brief Writes the DC-only preview of a stream to its surface in host memory, one sample per block.
+    * @param image The layout of the DC coefficients of the frame.
+    * @param dc_coefficients The DC coefficients of the frame.
+    * @param planes The location of each component in the surface.
+    * @param surface Pointer to the first byte of the surface.
+    */
+   static void WriteDcSurface(const JpegCoefficientImage &image, const int16_t *dc_coefficients, const ComponentPlane *planes, uint8_t *surface);
+
+   /**
+    * @brief Grows the coefficient, component, and surface buffers if they are too small.
+    * @param num_coefficients The number of coefficients of the batch.
+    * @param surface_size The size of the surfaces of the batch in bytes.
+    * @param num_components The number of components of the batch.
+    * @param is_host_surface_required True if the surfaces are computed on the host (DC-only previews).
+    * @return The status of the operation.
+    */
+   RocJpegStatus AllocateBuffers(size_t num_coefficients, size_t surface_size, uint32_t num_components, bool is_host_surface_required);
+
+   /**
+    * @brief Compares the surfaces written by the IDCT kernel with the IDCT computed on the CPU.
+    * @param num_components The number of components of the batch.
+    * @param surface_size The size of the surfaces of the batch in bytes.
+    * @param hip_stream The HIP stream the IDCT was queued on.
+    * @return The status of the operation. Returns ROCJPEG_STATUS_EXECUTION_FAILED if a sample differs.
+    */
+   RocJpegStatus ValidateSurfaces(uint32_t num_components, size_t surface_size, hipStream_t hip_stream);
+
+   std::vector<RocJpegEntropyDecoder> entropy_decoders_; // The software entropy decoders, one per stream of a batch
+   std::vector<JpegCoefficientImage> images_; // The layout of the coefficients of each stream of a batch
+   std::vector<ComponentPlane> planes_; // The location of the components of each stream of a batch in its surface
+   std::vector<size_t> coefficient_offsets_; // The offset of the coefficients of each stream of a batch in the coefficient buffers
+   std::vector<size_t> surface_offsets_; // The offset of the surface of each stream of a batch in the surface buffer
+   int16_t *host_coefficients_; // The coefficients decoded on the CPU, in pinned host memory
+   int16_t *device_coefficients_; // The coefficients copied to the device
+   size_t coefficient_buffer_size_; // The number of coefficients the buffers can hold
+   IdctComponentDesc *host_components_; // The components of a batch passed to the IDCT kernel, in pinned host memory
+   IdctComponentDesc *device_components_; // The components copied to the device
+   uint32_t component_buffer_size_; // The number of components the buffers can hold
+   uint8_t *device_surface_; // The decoded surfaces
+   size_t surface_buffer_size_; // The size of the surface buffer in bytes
+   uint8_t *host_surface_; // The DC-only surfaces computed on the CPU, in pinned host memory
+   size_t host_surface_buffer_size_; // The size of the host surface buffer in bytes
+   bool is_validation_enabled_; // True if the output of the IDCT kernel is compared with the IDCT computed on the CPU (ROCJPEG_HYBRID_VALIDATE)
+};
+
+#endif  // ROC_JPEG_HYBRID_DECODER_H_
@@ -0,0 +1,387 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef ROC_JPEG_IDCT_H_
+#define ROC_JPEG_IDCT_H_
+
+#pragma once
+
+#include <stdint.h>
+
+/* The IDCT is shared by the HIP kernels and the host code, so that both produce the same samples. */
+#if defined(__HIPCC__) || defined(__HIP__)
+    #define ROCJPEG_HOST_DEVICE __host__ __device__
+#else
+    #define ROCJPEG_HOST_DEVICE
+#endif
+
+#define DCT_BLOCK_SIZE 64
+#define IDCT_CONST_BITS 13
+
+#define IDCT_FIX_0_298631336 2446
+#define IDCT_FIX_0_390180644 3196
+#define IDCT_FIX_0_541196100 4433
+#define IDCT_FIX_0_765366865 6270
+#define IDCT_FIX_0_899976223 7373
+#define IDCT_FIX_1_175875602 9633
+#define IDCT_FIX_1_501321110 12299
+#define IDCT_FIX_1_847759065 15137
+#define IDCT_FIX_1_961570560 16069
+#define IDCT_FIX_2_053119869 16819
+#define IDCT_FIX_2_562915447 20995
+#define IDCT_FIX_3_072711026 25172
+
+// the constants of the reduced-size IDCTs (4x4 and 2x2 outputs)
+#define IDCT_FIX_0_211164243 1730
+#define IDCT_FIX_0_509795579 4176
+#define IDCT_FIX_0_601344887 4926
+#define IDCT_FIX_0_720959822 5906
+#define IDCT_FIX_0_850430095 6967
+#define IDCT_FIX_1_061594337 8697
+#define IDCT_FIX_1_272758580 10426
+#define IDCT_FIX_1_451774981 11893
+#define IDCT_FIX_2_172734803 17799
+#define IDCT_FIX_3_624509785 29692
+
+/**
+ * @brief Divides by 2^n with rounding (arithmetic right shift).
+ */
+template <typename T>
+ROCJPEG_HOST_DEVICE inline T IdctDescale(T x, int32_t n) {
+    return (x + (static_cast<T>(1) << (n - 1))) >> n;
+}
+
+/**
+ * @brief Converts the output of the IDCT to a sample of the given precision.
+ *
+ * The value is wrapped and clamped exactly like the range limit table of the IJG libjpeg (for 8-bit samples, the
+ * value is masked to 10 bits, so the clamping only applies to [-512, 511]), which keeps the output identical to
+ * libjpeg even for coefficients that are out of range.
+ */
+ROCJPEG_HOST_DEVICE inline int32_t IdctRangeLimit(int32_t x, int32_t sample_precision) {
+    int32_t num_levels = 1 << sample_precision;
+    int32_t v = x & (4 * num_levels - 1);
+    return v < num_levels / 2 ? v + num_levels / 2 : (v < 2 * num_levels ? num_levels - 1 : (v < 4 * num_levels - num_levels / 2 ? 0 : v - (4 * num_levels - num_levels / 2)));
+}
+
+/**
+ * @brief Performs the even and odd parts of the 1-D islow IDCT on eight values.
+ *
+ * The outputs are left scaled by 2^IDCT_CONST_BITS and are descaled by the caller. T may also be a vector of 32-bit
+ * integers (the SIMD kernels of the CPU backend), which is why the inputs are passed by reference.
+ */
+template <typename T>
+ROCJPEG_HOST_DEVICE inline void Idct1D(const T &in0, const T &in1, const T &in2, const T &in3, const T &in4, const T &in5, const T &in6, const T &in7,
+                                       T out[8]) {
+    // even part
+    T z1 = (in2 + in6) * IDCT_FIX_0_541196100;
+    T tmp2 = z1 + in6 * (-IDCT_FIX_1_847759065);
+    T tmp3 = z1 + in2 * IDCT_FIX_0_765366865;
+    T tmp0 = (in0 + in4) * (1 << IDCT_CONST_BITS);
+    T tmp1 = (in0 - in4) * (1 << IDCT_CONST_BITS);
+    T tmp10 = tmp0 + tmp3;
+    T tmp13 = tmp0 - tmp3;
+    T tmp11 = tmp1 + tmp2;
+    T tmp12 = tmp1 - tmp2;
+
+    // odd part
+    tmp0 = in7;
+    tmp1 = in5;
+    tmp2 = in3;
+    tmp3 = in1;
+    z1 = tmp0 + tmp3;
+    T z2 = tmp1 + tmp2;
+    T z3 = tmp0 + tmp2;
+    T z4 = tmp1 + tmp3;
+    T z5 = (z3 + z4) * IDCT_FIX_1_175875602;
+    tmp0 = tmp0 * IDCT_FIX_0_298631336;
+    tmp1 = tmp1 * IDCT_FIX_2_053119869;
+    tmp2 = tmp2 * IDCT_FIX_3_072711026;
+    tmp3 = tmp3 * IDCT_FIX_1_501321110;
+    z1 = z1 * (-IDCT_FIX_0_899976223);
+    z2 = z2 * (-IDCT_FIX_2_562915447);
+    z3 = z3 * (-IDCT_FIX_1_961570560) + z5;
+    z4 = z4 * (-IDCT_FIX_0_390180644) + z5;
+    tmp0 += z1 + z3;
+    tmp1 += z2 + z4;
+    tmp2 += z2 + z3;
+    tmp3 += z1 + z4;
+
+    out[0] = tmp10 + tmp3;
+    out[7] = tmp10 - tmp3;
+    out[1] = tmp11 + tmp2;
+    out[6] = tmp11 - tmp2;
+    out[2] = tmp12 + tmp1;
+    out[5] = tmp12 - tmp1;
+    out[3] = tmp13 + tmp0;
+    out[4] = tmp13 - tmp0;
+}
+
+/**
+ * @brief Dequantizes an 8x8 block of DCT coefficients and computes its inverse DCT.
+ *
+ * This is the accurate integer IDCT (islow) of the IJG libjpeg; the result is bit-exact with libjpeg's jpeg_idct_islow
+ * built for the same sample precision. The 8-bit transform is computed with 32-bit integers; the 12-bit transform
+ * needs 64-bit integers (T), because its dequantized coefficients can exceed 16 bits.
+ *
+ * @param coefficients The 64 coefficients of the block, in natural (row-major) order.
+ * @param quantization_table The quantization table of the block, in natural order.
+ * @param sample_precision The number of bits of the samples (8 or 12).
+ * @param samples The 64 samples of the block, in row-major order.
+ */
+template <typename T>
+ROCJPEG_HOST_DEVICE inline void DequantizeIdct8x8(const int16_t *coefficients, const uint16_t *quantization_table, int32_t sample_precision,
+                                                  int32_t samples[DCT_BLOCK_SIZE]) {
+    // libjpeg keeps one bit less of fractional precision between the passes for 12-bit samples
+    int32_t pass1_bits = sample_precision == 8 ? 2 : 1;
+    T workspace[DCT_BLOCK_SIZE];
+    T out[8];
+
+    // pass 1: process the columns and store the results in the workspace, scaled up by 2^pass1_bits
+    for (int32_t col = 0; col < 8; col++) {
+        const int16_t *in = coefficients + col;
+        const uint16_t *q = quantization_table + col;
+        Idct1D<T>(static_cast<T>(in[0]) * q[0], static_cast<T>(in[8]) * q[8], static_cast<T>(in[16]) * q[16], static_cast<T>(in[24]) * q[24],
+                  static_cast<T>(in[32]) * q[32], static_cast<T>(in[40]) * q[40], static_cast<T>(in[48]) * q[48], static_cast<T>(in[56]) * q[56], out);
+        for (int32_t i = 0; i < 8; i++) {
+            workspace[i * 8 + col] = IdctDescale<T>(out[i], IDCT_CONST_BITS - pass1_bits);
+        }
+    }
+
+    // pass 2: process the rows of the workspace and remove the scaling and the DC level shift
+    for (int32_t row = 0; row < 8; row++) {
+        const T *ws = workspace + row * 8;
+        Idct1D<T>(ws[0], ws[1], ws[2], ws[3], ws[4], ws[5], ws[6], ws[7], out);
+        for (int32_t i = 0; i < 8; i++) {
+            samples[row * 8 + i] = IdctRangeLimit(static_cast<int32_t>(IdctDescale<T>(out[i], IDCT_CONST_BITS + pass1_bits + 3)), sample_precision);
+        }
+    }
+}
+
+/**
+ * @brief Dequantizes an 8x8 block of DCT coefficients of an 8-bit frame and writes its samples to a plane.
+ *
+ * @param coefficients The 64 coefficients of the block, in natural (row-major) order.
+ * @param quantization_table The quantization table of the block, in natural order.
+ * @param dst Pointer to the first sample of the block in the destination plane.
+ * @param dst_stride_in_bytes The stride (in bytes) of the destination plane.
+ * @param dst_sample_step The distance (in bytes) between two horizontally adjacent samples of the destination plane.
+ */
+ROCJPEG_HOST_DEVICE inline void DequantizeIdct8x8(const int16_t *coefficients, const uint16_t *quantization_table,
+                                                  uint8_t *dst, uint32_t dst_stride_in_bytes, uint32_t dst_sample_step) {
+    int32_t samples[DCT_BLOCK_SIZE];
+    DequantizeIdct8x8<int32_t>(coefficients, quantization_table, 8, samples);
+    for (int32_t row = 0; row < 8; row++) {
+        uint8_t *dst_row = dst + row * dst_stride_in_bytes;
+        for (int32_t i = 0; i < 8; i++) {
+            dst_row[i * dst_sample_step] = static_cast<uint8_t>(samples[row * 8 + i]);
+        }
+    }
+}
+
+/**
+ * @brief Dequantizes an 8x8 block of DCT coefficients and writes its samples to a plane of 8-bit or 16-bit samples.
+ *
+ * The destination samples may be interleaved with other data (e.g., the U samples of an NV12 picture). One-byte
+ * samples of a 12-bit frame are scaled to 8 bits; two-byte samples keep the precision of the frame.
+ *
+ * @param coefficients The 64 coefficients of the block, in natural (row-major) order.
+ * @param quantization_table The quantization table of the block, in natural order.
+ * @param sample_precision The number of bits of the samples of the frame (8 or 12).
+ * @param dst Pointer to the first sample of the block in the destination plane.
+ * @param dst_stride_in_bytes The stride (in bytes) of the destination plane.
+ * @param dst_sample_step The distance (in bytes) between two horizontally adjacent samples of the destination plane.
+ * @param dst_sample_size The size of a destination sample in bytes (1 or 2).
+ */
+ROCJPEG_HOST_DEVICE inline void DequantizeIdctBlock(const int16_t *coefficients, const uint16_t *quantization_table, int32_t sample_precision,
+                                                    uint8_t *dst, uint32_t dst_stride_in_bytes, uint32_t dst_sample_step, uint32_t dst_sample_size) {
+    if (sample_precision == 8 && dst_sample_size == 1) {
+        DequantizeIdct8x8(coefficients, quantization_table, dst, dst_stride_in_bytes, dst_sample_step);
+        return;
+    }
+
+    int32_t samples[DCT_BLOCK_SIZE];
+    if (sample_precision == 8) {
+        DequantizeIdct8x8<int32_t>(coefficients, quantization_table, 8, samples);
+    } else {
+        DequantizeIdct8x8<int64_t>(coefficients, quantization_table, sample_precision, samples);
+    }
+    int32_t max_sample_value = (1 << sample_precision) - 1;
+    for (int32_t row = 0; row < 8; row++) {
+        uint8_t *dst_row = dst + row * dst_stride_in_bytes;
+        for (int32_t i = 0; i < 8; i++) {
+            int32_t sample = samples[row * 8 + i];
+            if (dst_sample_size == 2) {
+                *reinterpret_cast<uint16_t*>(dst_row + i * dst_sample_step) = static_cast<uint16_t>(sample);
+            } else {
+                dst_row[i * dst_sample_step] = static_cast<uint8_t>((sample * 255 + max_sample_value / 2) / max_sample_value);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Performs the 1-D reduced-size IDCT producing four values from the coefficients 0, 1, 2, 3, 5, 6, and 7.
+ *
+ * The outputs are left scaled by 2^(IDCT_CONST_BITS + 1) and are descaled by the caller.
+ */
+template <typename T>
+ROCJPEG_HOST_DEVICE inline void Idct1D4(T in0, T in1, T in2, T in3, T in5, T in6, T in7, T out[4]) {
+    // even part
+    T tmp0 = in0 * (static_cast<T>(1) << (IDCT_CONST_BITS + 1));
+    T tmp2 = in2 * IDCT_FIX_1_847759065 + in6 * (-IDCT_FIX_0_765366865);
+    T tmp10 = tmp0 + tmp2;
+    T tmp12 = tmp0 - tmp2;
+
+    // odd part
+    tmp0 = in7 * (-IDCT_FIX_0_211164243) + in5 * IDCT_FIX_1_451774981 + in3 * (-IDCT_FIX_2_172734803) + in1 * IDCT_FIX_1_061594337;
+    tmp2 = in7 * (-IDCT_FIX_0_509795579) + in5 * (-IDCT_FIX_0_601344887) + in3 * IDCT_FIX_0_899976223 + in1 * IDCT_FIX_2_562915447;
+
+    out[0] = tmp10 + tmp2;
+    out[3] = tmp10 - tmp2;
+    out[1] = tmp12 + tmp0;
+    out[2] = tmp12 - tmp0;
+}
+
+/**
+ * @brief Performs the 1-D reduced-size IDCT producing two values from the coefficients 0, 1, 3, 5, and 7.
+ *
+ * The outputs are left scaled by 2^(IDCT_CONST_BITS + 2) and are descaled by the caller.
+ */
+template <typename T>
+ROCJPEG_HOST_DEVICE inline void Idct1D2(T in0, T in1, T in3, T in5, T in7, T out[2]) {
+    T tmp10 = in0 * (static_cast<T>(1) << (IDCT_CONST_BITS + 2));
+    T tmp0 = in7 * (-IDCT_FIX_0_720959822) + in5 * IDCT_FIX_0_850430095 + in3 * (-IDCT_FIX_1_272758580) + in1 * IDCT_FIX_3_624509785;
+    out[0] = tmp10 + tmp0;
+    out[1] = tmp10 - tmp0;
+}
+
+/**
+ * @brief Dequantizes an 8x8 block of DCT coefficients and computes its inverse DCT scaled down by 2^scale_shift.
+ *
+ * These are the reduced-size IDCTs of the IJG libjpeg (jpeg_idct_4x4, jpeg_idct_2x2, and jpeg_idct_1x1), which
+ * compute a 4x4, 2x2, or 1x1 output directly from the coefficients of the block, so the result is bit-exact with
+ * libjpeg decoding with scale_denom 2, 4, or 8. The 1x1 output is the DC coefficient alone. A scale_shift of 0
+ * computes the full 8x8 islow IDCT.
+ *
+ * @param coefficients The 64 coefficients of the block, in natural (row-major) order.
+ * @param quantization_table The quantization table of the block, in natural order.
+ * @param sample_precision The number of bits of the samples (8 or 12).
+ * @param scale_shift The scaling shift of the output (0 to 3); the block has (8 >> scale_shift) samples per row and column.
+ * @param samples The samples of the block, in row-major order with (8 >> scale_shift) samples per row.
+ */
+template <typename T>
+ROCJPEG_HOST_DEVICE inline void DequantizeScaledIdct(const int16_t *coefficients, const uint16_t *quantization_table, int32_t sample_precision,
+                                                     uint32_t scale_shift, int32_t samples[DCT_BLOCK_SIZE]) {
+    int32_t pass1_bits = sample_precision == 8 ? 2 : 1;
+    T workspace[DCT_BLOCK_SIZE];
+    T out[4];
+    auto dequantize = [&](int32_t i) { return static_cast<T>(coefficients[i]) * quantization_table[i]; };
+
+    switch (scale_shift) {
+        case 0:
+            DequantizeIdct8x8<T>(coefficients, quantization_table, sample_precision, samples);
+            break;
+        case 1:
+            // pass 1: the columns (column 4 isn't used by the second pass)
+            for (int32_t col = 0; col < 8; col++) {
+                if (col == 4) {
+                    continue;
+                }
+                Idct1D4<T>(dequantize(col), dequantize(8 + col), dequantize(16 + col), dequantize(24 + col), dequantize(40 + col), dequantize(48 + col),
+                           dequantize(56 + col), out);
+                for (int32_t i = 0; i < 4; i++) {
+                    workspace[i * 8 + col] = IdctDescale<T>(out[i], IDCT_CONST_BITS - pass1_bits + 1);
+                }
+            }
+            // pass 2: the four rows
+            for (int32_t row = 0; row < 4; row++) {
+                const T *ws = workspace + row * 8;
+                Idct1D4<T>(ws[0], ws[1], ws[2], ws[3], ws[5], ws[6], ws[7], out);
+                for (int32_t i = 0; i < 4; i++) {
+                    samples[row * 4 + i] = IdctRangeLimit(static_cast<int32_t>(IdctDescale<T>(out[i], IDCT_CONST_BITS + pass1_bits + 3 + 1)), sample_precision);
+                }
+            }
+            break;
+        case 2:
+            // pass 1: the odd columns and column 0 (the columns 2, 4, and 6 aren't used by the second pass)
+            for (int32_t col = 0; col < 8; col++) {
+                if (col == 2 || col == 4 || col == 6) {
+                    continue;
+                }
+                Idct1D2<T>(dequantize(col), dequantize(8 + col), dequantize(24 + col), dequantize(40 + col), dequantize(56 + col), out);
+                workspace[col] = IdctDescale<T>(out[0], IDCT_CONST_BITS - pass1_bits + 2);
+                workspace[8 + col] = IdctDescale<T>(out[1], IDCT_CONST_BITS - pass1_bits + 2);
+            }
+            // pass 2: the two rows
+            for (int32_t row = 0; row < 2; row++) {
+                const T *ws = workspace + row * 8;
+                Idct1D2<T>(ws[0], ws[1], ws[3], ws[5], ws[7], out);
+                samples[row * 2] = IdctRangeLimit(static_cast<int32_t>(IdctDescale<T>(out[0], IDCT_CONST_BITS + pass1_bits + 3 + 2)), sample_precision);
+                samples[row * 2 + 1] = IdctRangeLimit(static_cast<int32_t>(IdctDescale<T>(out[1], IDCT_CONST_BITS + pass1_bits + 3 + 2)), sample_precision);
+            }
+            break;
+        default:
+            samples[0] = IdctRangeLimit(static_cast<int32_t>(IdctDescale<T>(dequantize(0), 3)), sample_precision);
+            break;
+    }
+}
+
+/**
+ * @brief Dequantizes an 8x8 block of DCT coefficients and writes its inverse DCT scaled down by 2^scale_shift to a plane.
+ *
+ * One-byte samples of a 12-bit frame are scaled to 8 bits; two-byte samples keep the precision of the frame.
+ *
+ * @param coefficients The 64 coefficients of the block, in natural (row-major) order.
+ * @param quantization_table The quantization table of the block, in natural order.
+ * @param sample_precision The number of bits of the samples of the frame (8 or 12).
+ * @param scale_shift The scaling shift of the output (0 to 3).
+ * @param dst Pointer to the first sample of the block in the destination plane.
+ * @param dst_stride_in_bytes The stride (in bytes) of the destination plane.
+ * @param dst_sample_size The size of a destination sample in bytes (1 or 2).
+ */
+ROCJPEG_HOST_DEVICE inline void DequantizeScaledIdctBlock(const int16_t *coefficients, const uint16_t *quantization_table, int32_t sample_precision,
+                                                          uint32_t scale_shift, uint8_t *dst, uint32_t dst_stride_in_bytes, uint32_t dst_sample_size) {
+    int32_t samples[DCT_BLOCK_SIZE];
+    if (sample_precision == 8) {
+        DequantizeScaledIdct<int32_t>(coefficients, quantization_table, 8, scale_shift, samples);
+    } else {
+        DequantizeScaledIdct<int64_t>(coefficients, quantization_table, sample_precision, scale_shift, samples);
+    }
+    int32_t block_size = 8 >> scale_shift;
+    int32_t max_sample_value = (1 << sample_precision) - 1;
+    for (int32_t row = 0; row < block_size; row++) {
+        uint8_t *dst_row = dst + row * dst_stride_in_bytes;
+        for (int32_t i = 0; i < block_size; i++) {
+            int32_t sample = samples[row * block_size + i];
+            if (dst_sample_size == 2) {
+                reinterpret_cast<uint16_t*>(dst_row)[i] = static_cast<uint16_t>(sample);
+            } else if (sample_precision == 8) {
+                dst_row[i] = static_cast<uint8_t>(sample);
+            } else {
+                dst_row[i] = static_cast<uint8_t>((sample * 255 + max_sample_value / 2) / max_sample_value);
+            }
+        }
+    }
+}
+
+#endif  // ROC_JPEG_IDCT_H_
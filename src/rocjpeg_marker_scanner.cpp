@@ -0,0 +1,158 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include <cstring>
+#include "rocjpeg_marker_scanner.h"
+#if ROCJPEG_X86_SIMD
+#include <immintrin.h>
+#endif
+
+/**
+ * @brief Scalar kernel for finding the first 0xFF byte in the range [begin, end).
+ */
+static const uint8_t* FindMarkerPrefixScalar(const uint8_t *begin, const uint8_t *end) {
+    if (begin >= end) {
+        return end;
+    }
+    const void *marker_prefix = std::memchr(begin, 0xFF, end - begin);
+    return marker_prefix ? static_cast<const uint8_t*>(marker_prefix) : end;
+}
+
+#if ROCJPEG_X86_SIMD
+/**
+ * @brief SSE2 kernel for finding the first 0xFF byte in the range [begin, end).
+ *
+ * The range is processed in 64-byte blocks made of four 16-byte strides, then in 16-byte strides,
+ * and the remaining tail is handled by the scalar kernel.
+ */
+__attribute__((target("sse2")))
+static const uint8_t* FindMarkerPrefixSse2(const uint8_t *begin, const uint8_t *end) {
+    const __m128i ff = _mm_set1_epi8(static_cast<char>(0xFF));
+    const uint8_t *ptr = begin;
+    while (end - ptr >= 64) {
+        __m128i cmp0 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)), ff);
+        __m128i cmp1 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + 16)), ff);
+        __m128i cmp2 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + 32)), ff);
+        __m128i cmp3 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + 48)), ff);
+        __m128i any = _mm_or_si128(_mm_or_si128(cmp0, cmp1), _mm_or_si128(cmp2, cmp3));
+        if (_mm_movemask_epi8(any)) {
+            break;
+        }
+        ptr += 64;
+    }
+    while (end - ptr >= 16) {
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)), ff)));
+        if (mask) {
+            return ptr + __builtin_ctz(mask);
+        }
+        ptr += 16;
+    }
+    return FindMarkerPrefixScalar(ptr, end);
+}
+
+/**
+ * @brief AVX2 kernel for finding the first 0xFF byte in the range [begin, end).
+ *
+ * The range is processed in 64-byte blocks made of two 32-byte strides, then in 32-byte strides,
+ * and the remaining tail is handled by the SSE2 kernel.
+ */
+__attribute__((target("avx2")))
+static const uint8_t* FindMarkerPrefixAvx2(const uint8_t *begin, const uint8_t *end) {
+    const __m256i ff = _mm256_set1_epi8(static_cast<char>(0xFF));
+    const uint8_t *ptr = begin;
+    while (end - ptr >= 64) {
+        __m256i cmp0 = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr)), ff);
+        __m256i cmp1 = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr + 32)), ff);
+        if (_mm256_movemask_epi8(_mm256_or_si256(cmp0, cmp1))) {
+            break;
+        }
+        ptr += 64;
+    }
+    while (end - ptr >= 32) {
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr)), ff)));
+        if (mask) {
+            return ptr + __builtin_ctz(mask);
+        }
+        ptr += 32;
+    }
+    return FindMarkerPrefixSse2(ptr, end);
+}
+#endif
+
+RocJpegMarkerScanner::RocJpegMarkerScanner() : find_marker_prefix_{FindMarkerPrefixScalar}, simd_level_{kSimdScalar} {
+#if ROCJPEG_X86_SIMD
+    SimdLevel simd_level = GetSimdLevel();
+    if (simd_level >= kSimdAvx2) {
+        find_marker_prefix_ = FindMarkerPrefixAvx2;
+        simd_level_ = kSimdAvx2;
+    } else if (simd_level >= kSimdSse2) {
+        find_marker_prefix_ = FindMarkerPrefixSse2;
+        simd_level_ = kSimdSse2;
+    }
+#endif
+}
+
+/**
+ * @brief Finds the next marker in the range [begin, end).
+ *
+ * This function jumps from one 0xFF candidate to the next using the selected kernel. A candidate followed by
+ * 0x00 is a stuffed byte and a candidate followed by 0xFF is a fill byte; both are skipped. Any other
+ * candidate is the start of a marker.
+ *
+ * @param begin The pointer to the first byte of the range.
+ * @param end The pointer past the last byte of the range.
+ * @return The pointer to the 0xFF byte of the marker, or end if no marker is found.
+ */
+const uint8_t* RocJpegMarkerScanner::FindNextMarker(const uint8_t *begin, const uint8_t *end) const {
+    const uint8_t *ptr = begin;
+    while (end - ptr >= 2) {
+        // only search the positions that are followed by at least one byte
+        ptr = find_marker_prefix_(ptr, end - 1);
+        if (ptr == end - 1) {
+            break;
+        }
+        uint8_t marker = ptr[1];
+        if (marker == 0xFF) {
+            ptr += 1;
+        } else if (marker == 0x00) {
+            ptr += 2;
+        } else {
+            return ptr;
+        }
+    }
+    return end;
+}
+
+/**
+ * @brief Finds the next occurrence of a specific marker in the range [begin, end).
+ *
+ * @param begin The pointer to the first byte of the range.
+ * @param end The pointer past the last byte of the range.
+ * @param marker The marker code to look for.
+ * @return The pointer to the 0xFF byte of the marker, or end if the marker is not found.
+ */
+const uint8_t* RocJpegMarkerScanner::FindMarker(const uint8_t *begin, const uint8_t *end, uint8_t marker) const {
+    const uint8_t *ptr = FindNextMarker(begin, end);
+    while (ptr != end && ptr[1] != marker) {
+        ptr = FindNextMarker(ptr + 2, end);
+    }
+    return ptr;
+}
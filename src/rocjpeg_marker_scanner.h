@@ -0,0 +1,87 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef ROC_JPEG_MARKER_SCANNER_H_
+#define ROC_JPEG_MARKER_SCANNER_H_
+
+#pragma once
+
+#include <stdint.h>
+#include "rocjpeg_simd_dispatch.h"
+
+/**
+ * @class RocJpegMarkerScanner
+ * @brief A class for locating JPEG markers inside a byte stream.
+ *
+ * Every JPEG marker starts with a 0xFF byte. Inside the entropy-coded segment, a literal 0xFF is always
+ * followed by a stuffed 0x00 byte, and any number of 0xFF fill bytes may precede a marker. The scanner finds
+ * 0xFF candidates in 16-byte (SSE2) or 32-byte (AVX2) strides and only inspects the byte following a candidate
+ * to classify it. The vectorized kernel is selected at runtime based on the CPU features, with a scalar fallback.
+ */
+class RocJpegMarkerScanner {
+    public:
+        /**
+         * @brief Constructs a RocJpegMarkerScanner object and selects the scanning kernel for the current CPU.
+         */
+        RocJpegMarkerScanner();
+
+        /**
+         * @brief Finds the first 0xFF byte in the range [begin, end).
+         * @param begin The pointer to the first byte of the range.
+         * @param end The pointer past the last byte of the range.
+         * @return The pointer to the first 0xFF byte, or end if there is none.
+         */
+        const uint8_t* FindMarkerPrefix(const uint8_t *begin, const uint8_t *end) const { return find_marker_prefix_(begin, end); }
+
+        /**
+         * @brief Finds the next marker in the range [begin, end).
+         *
+         * Stuffed bytes (0xFF00) are skipped, and for a run of fill bytes the pointer to the last 0xFF is returned.
+         *
+         * @param begin The pointer to the first byte of the range.
+         * @param end The pointer past the last byte of the range.
+         * @return The pointer to the 0xFF byte of the marker, or end if no marker is found.
+         */
+        const uint8_t* FindNextMarker(const uint8_t *begin, const uint8_t *end) const;
+
+        /**
+         * @brief Finds the next occurrence of a specific marker in the range [begin, end).
+         * @param begin The pointer to the first byte of the range.
+         * @param end The pointer past the last byte of the range.
+         * @param marker The marker code (the byte following 0xFF) to look for.
+         * @return The pointer to the 0xFF byte of the marker, or end if the marker is not found.
+         */
+        const uint8_t* FindMarker(const uint8_t *begin, const uint8_t *end, uint8_t marker) const;
+
+        /**
+         * @brief Returns the SIMD level of the selected scanning kernel.
+         * @return The SIMD level.
+         */
+        SimdLevel GetScannerSimdLevel() const { return simd_level_; }
+
+    private:
+        typedef const uint8_t* (*FindMarkerPrefixFunc)(const uint8_t *begin, const uint8_t *end);
+        FindMarkerPrefixFunc find_marker_prefix_; ///< The selected kernel for finding 0xFF bytes.
+        SimdLevel simd_level_; ///< The SIMD level of the selected kernel.
+};
+
+#endif  // ROC_JPEG_MARKER_SCANNER_H_
@@ -19,10 +19,39 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 */
+#include <algorithm>
 #include "rocjpeg_parser.h"
+#include "rocjpeg_table_cache.h"
+
+/**
+ * @brief Returns the default size limit of the restart marker index.
+ *
+ * The limit is the value of the ROCJPEG_RESTART_INDEX_SIZE environment variable if set, otherwise
+ * RESTART_MARKER_INDEX_MAX_ENTRIES. The variable is read once per process.
+ *
+ * @return The maximum number of entries of the restart marker index; 0 disables the index.
+ */
+static uint32_t GetDefaultRestartMarkerIndexLimit() {
+    static const uint32_t max_entries = [] {
+        uint32_t limit = RESTART_MARKER_INDEX_MAX_ENTRIES;
+        char requested_max_entries[16];
+        if (GetEnv("ROCJPEG_RESTART_INDEX_SIZE", requested_max_entries, sizeof(requested_max_entries))) {
+            int value = atoi(requested_max_entries);
+            if (value >= 0) {
+                limit = static_cast<uint32_t>(value);
+            }
+        }
+        return limit;
+    }();
+    return max_entries;
+}
 
 RocJpegStreamParser::RocJpegStreamParser() : stream_{nullptr}, stream_end_{nullptr}, stream_length_{0},
-    jpeg_stream_parameters_{{}} {
+    jpeg_stream_parameters_{{}}, quantization_tables_{}, huffman_tables_{}, quantization_matrix_buffer_{}, huffman_table_buffer_{}, marker_scanner_{},
+    restart_marker_index_limit_{GetDefaultRestartMarkerIndexLimit()}, restart_marker_stride_{1}, num_restart_segments_{0},
+    incremental_parse_state_{PARSE_STATE_IDLE}, resume_offset_{0},
+    scan_offset_{0}, dht_marker_found_{false}, dqt_marker_found_{false} {
+    jpeg_stream_parameters_.orientation = EXIF_ORIENTATION_NORMAL;
 }
 
 RocJpegStreamParser::~RocJpegStreamParser() {
@@ -41,7 +70,195 @@ RocJpegStreamParser::~RocJpegStreamParser() {
  * @return True if the JPEG stream was successfully parsed, false otherwise.
  */
 bool RocJpegStreamParser::ParseJpegStream(const uint8_t *jpeg_stream, uint32_t jpeg_stream_size) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    bool sos_marker_found = false;
+    bool dht_marker_found = false;
+    bool dqt_marker_found = false;
+
+    incremental_parse_state_ = PARSE_STATE_IDLE;
+    if (!ParseMarkers(jpeg_stream, jpeg_stream_size, SOS, sos_marker_found, dht_marker_found, dqt_marker_found)) {
+        return false;
+    }
+
+    if (!dht_marker_found) {
+        ERR("didn't find any Huffman table!");
+        return false;
+    }
+    if (!dqt_marker_found) {
+        ERR("didn't find any quantization table!");
+        return false;
+    }
+    if (!sos_marker_found) {
+        ERR("didn't find the SOS marker!");
+        return false;
+    }
+    InternTables();
+
+    if (!ParseEOI())
+        return false;
+    if (!ParseScans())
+        return false;
+
+    return true;
+}
+
+/**
+ * @brief Parses the header of a JPEG stream up to the SOF marker.
+ *
+ * This function runs the marker loop only until the frame header (SOF) is parsed, so the picture dimensions,
+ * the number of components, and the chroma subsampling are available without scanning the entropy-coded data.
+ * The remaining fields of the JPEG stream parameters are not valid after this call.
+ *
+ * @param jpeg_stream A pointer to the JPEG stream.
+ * @param jpeg_stream_size The size of the JPEG stream in bytes.
+ * @return True if the SOF marker was found and successfully parsed, false otherwise.
+ */
+bool RocJpegStreamParser::PeekJpegStream(const uint8_t *jpeg_stream, uint32_t jpeg_stream_size) {
+    bool sof_marker_found = false;
+    bool dht_marker_found = false;
+    bool dqt_marker_found = false;
+
+    incremental_parse_state_ = PARSE_STATE_IDLE;
+    if (!ParseMarkers(jpeg_stream, jpeg_stream_size, SOF, sof_marker_found, dht_marker_found, dqt_marker_found)) {
+        return false;
+    }
+    if (!sof_marker_found) {
+        ERR("didn't find the SOF marker!");
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Appends a chunk of a JPEG stream and parses as much of the stream as the received data allows.
+ *
+ * While the header is incomplete, only the complete marker segments are parsed and the parse resumes at the
+ * first incomplete segment when the next chunk arrives. Once the SOS marker segment is parsed, the header is
+ * complete and the scan data received so far is searched for the EOI marker; the search resumes where it
+ * stopped, except for the last byte, which may be the first byte of a marker that is split between two chunks.
+ *
+ * @param chunk A pointer to the chunk.
+ * @param chunk_size The size of the chunk in bytes.
+ * @param first_chunk True if the chunk starts a new JPEG stream.
+ * @param last_chunk True if no more data follows the chunk.
+ * @return True if the data received so far is valid, false otherwise.
+ */
+bool RocJpegStreamParser::AppendJpegStreamChunk(const uint8_t *chunk, uint32_t chunk_size, bool first_chunk, bool last_chunk) {
+    if (chunk == nullptr && chunk_size != 0) {
+        ERR("invalid argument!");
+        return false;
+    }
+    if (first_chunk) {
+        chunk_buffer_.clear();
+        jpeg_stream_parameters_ = {};
+        jpeg_stream_parameters_.orientation = EXIF_ORIENTATION_NORMAL;
+        ResetTables();
+        embedded_images_.clear();
+        scans_.clear();
+        restart_markers_.clear();
+        restart_marker_stride_ = 1;
+        num_restart_segments_ = 0;
+        resume_offset_ = 0;
+        scan_offset_ = 0;
+        dht_marker_found_ = false;
+        dqt_marker_found_ = false;
+        incremental_parse_state_ = PARSE_STATE_HEADER;
+    } else if (incremental_parse_state_ != PARSE_STATE_HEADER && incremental_parse_state_ != PARSE_STATE_SCAN) {
+        ERR("no incremental parse in progress!");
+        return false;
+    }
+    if (chunk_size > UINT32_MAX - chunk_buffer_.size()) {
+        ERR("JPEG stream is too large!");
+        incremental_parse_state_ = PARSE_STATE_FAILED;
+        return false;
+    }
+
+    chunk_buffer_.insert(chunk_buffer_.end(), chunk, chunk + chunk_size);
+    const uint8_t *chunk_buffer = chunk_buffer_.data();
+    stream_length_ = static_cast<uint32_t>(chunk_buffer_.size());
+    stream_end_ = chunk_buffer + stream_length_;
+    stream_ = chunk_buffer + resume_offset_;
+
+    if (incremental_parse_state_ == PARSE_STATE_HEADER) {
+        if (resume_offset_ == 0) {
+            if (stream_length_ < 4) {
+                if (last_chunk) {
+                    ERR("Invalid JPEG!");
+                    incremental_parse_state_ = PARSE_STATE_FAILED;
+                    return false;
+                }
+                return true;
+            }
+            // The first two bytes of a JPEG must be 0XFFD8
+            if (*stream_ != 0xFF || *(stream_ + 1) != SOI) {
+                ERR("Invalid JPEG!");
+                incremental_parse_state_ = PARSE_STATE_FAILED;
+                return false;
+            }
+            stream_ += 2;
+        }
+
+        bool sos_marker_found = false;
+        if (!ParseMarkerSegments(SOS, !last_chunk, sos_marker_found, dht_marker_found_, dqt_marker_found_)) {
+            incremental_parse_state_ = PARSE_STATE_FAILED;
+            return false;
+        }
+        resume_offset_ = stream_ - chunk_buffer;
+        if (!sos_marker_found) {
+            if (last_chunk) {
+                ERR("didn't find the SOS marker!");
+                incremental_parse_state_ = PARSE_STATE_FAILED;
+                return false;
+            }
+            return true;
+        }
+        if (!dht_marker_found_) {
+            ERR("didn't find any Huffman table!");
+            incremental_parse_state_ = PARSE_STATE_FAILED;
+            return false;
+        }
+        if (!dqt_marker_found_) {
+            ERR("didn't find any quantization table!");
+            incremental_parse_state_ = PARSE_STATE_FAILED;
+            return false;
+        }
+        InternTables();
+        scan_offset_ = resume_offset_;
+        incremental_parse_state_ = PARSE_STATE_SCAN;
+    }
+
+    const uint8_t *slice_data = chunk_buffer + scan_offset_;
+    const uint8_t *slice_data_end = FindEndOfScan(slice_data, chunk_buffer + resume_offset_);
+    if (slice_data_end == stream_end_ && !last_chunk) {
+        resume_offset_ = std::max(resume_offset_, stream_length_ - 1);
+        return true;
+    }
+    SetSliceData(slice_data, slice_data_end);
+    if (!ParseScans()) {
+        incremental_parse_state_ = PARSE_STATE_FAILED;
+        return false;
+    }
+    incremental_parse_state_ = PARSE_STATE_COMPLETE;
+
+    return true;
+}
+
+/**
+ * @brief Runs the marker loop of a JPEG stream.
+ *
+ * This function validates the SOI marker and parses the marker segments until the `stop_marker` segment
+ * has been parsed or the end of the stream is reached.
+ *
+ * @param jpeg_stream A pointer to the JPEG stream.
+ * @param jpeg_stream_size The size of the JPEG stream in bytes.
+ * @param stop_marker The marker after which the loop stops.
+ * @param stop_marker_found Set to true if the `stop_marker` segment was parsed.
+ * @param dht_marker_found Set to true if a DHT segment was parsed.
+ * @param dqt_marker_found Set to true if a DQT segment was parsed.
+ * @return True if all the visited marker segments were successfully parsed, false otherwise.
+ */
+bool RocJpegStreamParser::ParseMarkers(const uint8_t *jpeg_stream, uint32_t jpeg_stream_size, JpegMarkers stop_marker,
+                                       bool &stop_marker_found, bool &dht_marker_found, bool &dqt_marker_found) {
     if (jpeg_stream == nullptr) {
         ERR("invalid argument!");
         return false;
@@ -52,16 +269,14 @@ bool RocJpegStreamParser::ParseJpegStream(const uint8_t *jpeg_stream, uint32_t j
     stream_end_ = stream_ + stream_length_;
 
     jpeg_stream_parameters_ = {};
+    jpeg_stream_parameters_.orientation = EXIF_ORIENTATION_NORMAL;
+    ResetTables();
+    embedded_images_.clear();
+    scans_.clear();
     bool soi_marker_found = false;
-    bool sos_marker_found = false;
-    bool dht_marker_found = false;
-    bool dqt_marker_found = false;
-    uint8_t marker;
-    const uint8_t *next_chunck;
-    int32_t chuck_len;
 
     // The first two bytes of a JPEG must be 0XFFD8
-    if (*stream_ != 0xFF || *(stream_ + 1) != SOI) {
+    if (stream_length_ < 4 || *stream_ != 0xFF || *(stream_ + 1) != SOI) {
         ERR("Invalid JPEG!");
         return false;
     }
@@ -71,17 +286,62 @@ bool RocJpegStreamParser::ParseJpegStream(const uint8_t *jpeg_stream, uint32_t j
         ERR("failed to find the SOI marker!");
     }
 
-    while (!sos_marker_found  && stream_ <= stream_end_) {
-        while ((*stream_ == 0xFF))
-            stream_++;
+    return ParseMarkerSegments(stop_marker, false, stop_marker_found, dht_marker_found, dqt_marker_found);
+}
+
+/**
+ * @brief Parses the marker segments of a JPEG stream.
+ *
+ * This function parses the marker segments from the current stream position until the `stop_marker` segment
+ * has been parsed or the end of the data is reached. When `wait_for_data` is set, the data is the beginning of
+ * a stream that is still being received: a segment that isn't completely received yet is left unparsed and
+ * the stream position is set to its start.
+ *
+ * @param stop_marker The marker after which the loop stops.
+ * @param wait_for_data True if more data may follow the end of the data.
+ * @param stop_marker_found Set to true if the `stop_marker` segment was parsed.
+ * @param dht_marker_found Set to true if a DHT segment was parsed.
+ * @param dqt_marker_found Set to true if a DQT segment was parsed.
+ * @return True if all the visited marker segments were successfully parsed, false otherwise.
+ */
+bool RocJpegStreamParser::ParseMarkerSegments(JpegMarkers stop_marker, bool wait_for_data, bool &stop_marker_found,
+                                              bool &dht_marker_found, bool &dqt_marker_found) {
+    uint8_t marker;
+    const uint8_t *segment_start;
+    const uint8_t *next_chunck;
+    int32_t chuck_len;
+
+    while (!stop_marker_found && stream_end_ - stream_ >= 4) {
+        segment_start = stream_;
+        // skip any fill bytes and locate the 0xFF of the next marker
+        stream_ = marker_scanner_.FindNextMarker(stream_, stream_end_);
+        if (stream_end_ - stream_ < 4) {
+            if (wait_for_data) {
+                stream_ = segment_start;
+            }
+            break;
+        }
+        stream_++;
         marker = *stream_++;
         chuck_len = swap_bytes(stream_);
+        if (chuck_len >= 2 && chuck_len > stream_end_ - stream_ && wait_for_data) {
+            stream_ = segment_start;
+            break;
+        }
+        if (chuck_len < 2 || chuck_len > stream_end_ - stream_) {
+            ERR("invalid marker segment length!");
+            return false;
+        }
         next_chunck = stream_ + chuck_len;
 
         switch (marker) {
             case SOF:
-                if (!ParseSOF())
+            case SOF1:
+            case SOF2:
+                if (!ParseSOF(marker))
                     return false;
+                // any frame header ends a header-only parse
+                marker = SOF;
                 break;
             case DHT:
                 if (!ParseDHT())
@@ -97,36 +357,49 @@ bool RocJpegStreamParser::ParseJpegStream(const uint8_t *jpeg_stream, uint32_t j
                 if (!ParseDRI())
                     return false;
                 break;
-            case SOS:
-                if (!ParseSOS())
+            case APP1:
+                if (!ParseAPP1())
+                    return false;
+                break;
+            case APP2:
+                if (!ParseAPP2())
+                    return false;
+                break;
+            case APP14:
+                if (!ParseAPP14())
                     return false;
-                sos_marker_found = true;
                 break;
+            case SOS: {
+                scans_.assign(1, {});
+                if (!ParseSOS(scans_[0]))
+                    return false;
+                // the slice parameter buffer describes the first scan to the VCN JPEG decoder
+                SliceParameterBuffer &slice_parameter_buffer = jpeg_stream_parameters_.slice_parameter_buffer;
+                slice_parameter_buffer.num_components = scans_[0].num_components;
+                for (int32_t i = 0; i < scans_[0].num_components; i++) {
+                    slice_parameter_buffer.components[i].component_selector = scans_[0].components[i].component_selector;
+                    slice_parameter_buffer.components[i].dc_table_selector = scans_[0].components[i].dc_table_selector;
+                    slice_parameter_buffer.components[i].ac_table_selector = scans_[0].components[i].ac_table_selector;
+                }
+                break;
+            }
             default:
                 break;
         }
+        if (marker == stop_marker) {
+            stop_marker_found = true;
+        }
         stream_ = next_chunck;
     }
 
-    if (!dht_marker_found) {
-        ERR("didn't find any Huffman table!");
-        return false;
-    }
-    if (!dqt_marker_found) {
-        ERR("didn't find any quantization table!");
-        return false;
-    }
-
-    if (!ParseEOI())
-        return false;
-
     return true;
 }
 
 /**
  * @brief Parses the Start of Image (SOI) marker in the JPEG stream.
  *
- * This function searches for the SOI marker (0xFFD8) in the JPEG stream and updates the stream pointer accordingly.
+ * This function searches for the SOI marker (0xFFD8) in the JPEG stream using the marker scanner and
+ * updates the stream pointer accordingly.
  *
  * @return true if the SOI marker is found and the stream pointer is updated, false otherwise.
  */
@@ -134,14 +407,11 @@ bool RocJpegStreamParser::ParseSOI() {
     if (stream_ == nullptr) {
         return false;
     }
-    while (!(*stream_ == 0xFF  && *(stream_ + 1) == SOI)) {
-        if (stream_ <= stream_end_) {
-            stream_++;
-            continue;
-        } else
-            return false;
+    const uint8_t *soi_marker = marker_scanner_.FindMarker(stream_, stream_end_, SOI);
+    if (soi_marker == stream_end_) {
+        return false;
     }
-    stream_ += 2;
+    stream_ = soi_marker + 2;
 
     return true;
 }
@@ -153,11 +423,12 @@ bool RocJpegStreamParser::ParseSOI() {
  * information such as picture height, picture width, number of components, component
  * IDs, sampling factors, and quantization table selectors. It also calculates the
  * number of MCU (Minimum Coded Unit) blocks in the image and determines the chroma
- * subsampling scheme.
+ * subsampling scheme. The SOF marker selects the coding process of the frame.
  *
+ * @param marker The SOF marker of the frame (SOF, SOF1, or SOF2).
  * @return true if the SOF marker is successfully parsed, false otherwise.
  */
-bool RocJpegStreamParser::ParseSOF() {
+bool RocJpegStreamParser::ParseSOF(uint8_t marker) {
     uint32_t component_id, sampling_factor;
     uint8_t quantiser_table_selector;
 
@@ -165,14 +436,38 @@ bool RocJpegStreamParser::ParseSOF() {
         return false;
     }
 
+    switch (marker) {
+        case SOF1:
+            jpeg_stream_parameters_.coding_process = CODING_PROCESS_EXTENDED;
+            break;
+        case SOF2:
+            jpeg_stream_parameters_.coding_process = CODING_PROCESS_PROGRESSIVE;
+            jpeg_stream_parameters_.hardware_limitations |= HW_LIMITATION_CODING_PROCESS;
+            break;
+        default:
+            jpeg_stream_parameters_.coding_process = CODING_PROCESS_BASELINE;
+            break;
+    }
+    jpeg_stream_parameters_.sample_precision = stream_[2];
+    if (jpeg_stream_parameters_.sample_precision != 8 &&
+        (jpeg_stream_parameters_.sample_precision != 12 || jpeg_stream_parameters_.coding_process == CODING_PROCESS_BASELINE)) {
+        ERR("invalid sample precision!");
+        return false;
+    }
+    if (jpeg_stream_parameters_.sample_precision != 8) {
+        jpeg_stream_parameters_.hardware_limitations |= HW_LIMITATION_SAMPLE_PRECISION;
+    }
     jpeg_stream_parameters_.picture_parameter_buffer.picture_height = swap_bytes(stream_ + 3);
     jpeg_stream_parameters_.picture_parameter_buffer.picture_width = swap_bytes(stream_ + 5);
     jpeg_stream_parameters_.picture_parameter_buffer.num_components = stream_[7];
 
-    if (jpeg_stream_parameters_.picture_parameter_buffer.num_components > NUM_COMPONENTS - 1) {
+    if (jpeg_stream_parameters_.picture_parameter_buffer.num_components > NUM_COMPONENTS) {
         ERR("invalid number of JPEG components!");
         return false;
     }
+    if (jpeg_stream_parameters_.picture_parameter_buffer.num_components == NUM_COMPONENTS) {
+        jpeg_stream_parameters_.hardware_limitations |= HW_LIMITATION_NUM_COMPONENTS;
+    }
 
     stream_ += 8;
 
@@ -203,6 +498,12 @@ bool RocJpegStreamParser::ParseSOF() {
                                                                       jpeg_stream_parameters_.picture_parameter_buffer.components[0].v_sampling_factor,
                                                                       jpeg_stream_parameters_.picture_parameter_buffer.components[1].v_sampling_factor,
                                                                       jpeg_stream_parameters_.picture_parameter_buffer.components[2].v_sampling_factor);
+    // the K component of a CMYK or YCCK frame must have the sampling factors of the first component
+    if (jpeg_stream_parameters_.picture_parameter_buffer.num_components == NUM_COMPONENTS &&
+        (jpeg_stream_parameters_.picture_parameter_buffer.components[3].h_sampling_factor != max_h_factor ||
+         jpeg_stream_parameters_.picture_parameter_buffer.components[3].v_sampling_factor != max_v_factor)) {
+        jpeg_stream_parameters_.chroma_subsampling = CSS_UNKNOWN;
+    }
     return true;
 }
 
@@ -210,7 +511,7 @@ bool RocJpegStreamParser::ParseSOF() {
  * @brief Parses the DQT (Define Quantization Table) segment of a JPEG stream.
  *
  * This function reads the quantization tables from the JPEG stream and stores them in the
- * `jpeg_stream_parameters_.quantization_matrix_buffer` data structure.
+ * `quantization_tables_` data structure, with the precision of the DQT marker.
  *
  * @return `true` if the DQT segment is successfully parsed, `false` otherwise.
  */
@@ -227,19 +528,36 @@ bool RocJpegStreamParser::ParseDQT() {
 
     while (stream_ < dqt_block_end) {
         quantization_table_index = *stream_++;
-        if (quantization_table_index >> 4) {
-            ERR("16 bits quantization table is not supported!");
+        int32_t quantization_table_precision = quantization_table_index >> 4;
+        quantization_table_index &= 0x0F;
+        if (quantization_table_precision > 1) {
+            ERR("invalid precision of quantization table!");
             return false;
         }
         if (quantization_table_index >= 4) {
             ERR("invalid number of quantization table!");
             return false;
         }
+        if (dqt_block_end - stream_ < 64 << quantization_table_precision) {
+            ERR("invalid DQT marker segment length!");
+            return false;
+        }
 
-        std::memcpy(jpeg_stream_parameters_.quantization_matrix_buffer.quantiser_table[quantization_table_index & 0x0F], stream_, 64);
-        jpeg_stream_parameters_.quantization_matrix_buffer.load_quantiser_table[quantization_table_index & 0x0F] = 1;
-
-        stream_ += 64;
+        uint16_t *quantiser_table = quantization_tables_.quantiser_table[quantization_table_index];
+        if (quantization_table_precision == 0) {
+            for (int32_t i = 0; i < 64; i++) {
+                quantiser_table[i] = *stream_++;
+            }
+        } else {
+            // a 16-bit table is decoded by the VCN only if all its values fit in 8 bits
+            for (int32_t i = 0; i < 64; i++, stream_ += 2) {
+                quantiser_table[i] = swap_bytes(stream_);
+                if (quantiser_table[i] > 0xFF) {
+                    jpeg_stream_parameters_.hardware_limitations |= HW_LIMITATION_QUANTIZATION_TABLE;
+                }
+            }
+        }
+        quantization_tables_.load_quantiser_table[quantization_table_index] = 1;
     }
 
     return true;
@@ -249,7 +567,8 @@ bool RocJpegStreamParser::ParseDQT() {
  * @brief Parses the Define Huffman Table (DHT) segment in the JPEG stream.
  *
  * This function reads and processes the DHT segment in the JPEG stream. It extracts the Huffman table
- * information and stores it in the `jpeg_stream_parameters_.huffman_table_buffer` data structure.
+ * information and stores it in the DC or AC tables of `huffman_tables_`; the tables referenced by the first scan are
+ * assigned to the slots of the `huffman_table_buffer_` once the SOS marker is parsed.
  *
  * @return `true` if the DHT segment is successfully parsed, `false` otherwise.
  */
@@ -266,6 +585,10 @@ bool RocJpegStreamParser::ParseDHT() {
     stream_ += 2;
 
     while (length > 0) {
+        if (length < 17) {
+            ERR("invalid Huffman table!");
+            return false;
+        }
         index = *stream_++;
 
         ac_huffman_table = index & 0xF0;
@@ -276,32 +599,28 @@ bool RocJpegStreamParser::ParseDHT() {
             return false;
         }
 
-        if (ac_huffman_table) {
-            std::memcpy(jpeg_stream_parameters_.huffman_table_buffer.huffman_table[huffman_table_id].num_ac_codes, stream_, 16);
-        } else {
-            std::memcpy(jpeg_stream_parameters_.huffman_table_buffer.huffman_table[huffman_table_id].num_dc_codes, stream_, 16);
-        }
+        HuffmanTable &huffman_table = ac_huffman_table ? huffman_tables_.ac_tables[huffman_table_id] : huffman_tables_.dc_tables[huffman_table_id];
+        std::memcpy(huffman_table.num_codes, stream_, 16);
 
         count = 0;
         for (i = 0; i < 16; i++) {
             count += *stream_++;
         }
 
-        if (ac_huffman_table) {
-            if (count > AC_HUFFMAN_TABLE_VALUES_SIZE) {
+        // the DC tables of 12-bit frames have up to 16 values and their AC tables up to 226 values
+        if (count > HUFFMAN_TABLE_VALUES_MAX_SIZE || count > static_cast<uint32_t>(length - 17)) {
+            if (ac_huffman_table) {
                 ERR("invalid AC Huffman table!");
-                return false;
-            }
-            std::memcpy(jpeg_stream_parameters_.huffman_table_buffer.huffman_table[huffman_table_id].ac_values, stream_, count);
-            jpeg_stream_parameters_.huffman_table_buffer.load_huffman_table[huffman_table_id] = 1;
-        } else {
-            if (count > DC_HUFFMAN_TABLE_VALUES_SIZE) {
+            } else {
                 ERR("invlaid DC Huffman table!")
-                return false;
             }
-            std::memcpy(jpeg_stream_parameters_.huffman_table_buffer.huffman_table[huffman_table_id].dc_values, stream_, count);
-            jpeg_stream_parameters_.huffman_table_buffer.load_huffman_table[huffman_table_id] = 1;
+            return false;
         }
+        std::memcpy(huffman_table.values, stream_, count);
+        // a redefined table doesn't keep the values of the previous one, so identical tables have identical bytes
+        std::memset(huffman_table.values + count, 0, HUFFMAN_TABLE_VALUES_MAX_SIZE - count);
+        huffman_table.num_values = count;
+        huffman_table.is_defined = true;
 
         length -= 1;
         length -= 16;
@@ -316,33 +635,40 @@ bool RocJpegStreamParser::ParseDHT() {
  * @brief Parses the Start of Scan (SOS) marker in the JPEG stream.
  *
  * This function reads and processes the SOS marker in the JPEG stream.
- * It extracts the component IDs and Huffman table selectors for each component,
- * and performs various checks for validity.
+ * It extracts the component IDs and Huffman table selectors for each component, the spectral selection and the
+ * successive approximation of the scan, and performs various checks for validity. The scan gets the restart
+ * interval in effect.
  *
+ * @param scan The scan that receives the components, the Huffman table selectors, and the spectral selection of the scan header.
  * @return true if the SOS marker is successfully parsed, false otherwise.
  */
-bool RocJpegStreamParser::ParseSOS() {
+bool RocJpegStreamParser::ParseSOS(JpegScan &scan) {
     uint32_t component_id, table;
 
     if (stream_ == nullptr) {
         return false;
     }
 
+    uint32_t length = swap_bytes(stream_);
     uint32_t num_components = stream_[2];
 
-    if (num_components > NUM_COMPONENTS - 1) {
+    if (num_components == 0 || num_components > NUM_COMPONENTS) {
         ERR("invalid number of component!")
         return false;
     }
-    jpeg_stream_parameters_.slice_parameter_buffer.num_components = num_components;
+    if (length < 6 + 2 * num_components) {
+        ERR("invalid SOS marker segment length!");
+        return false;
+    }
+    scan.num_components = num_components;
 
     stream_ += 3;
-    for (int32_t i = 0; i < num_components; i++) {
+    for (uint32_t i = 0; i < num_components; i++) {
         component_id = *stream_++;
         table = *stream_++;
-        jpeg_stream_parameters_.slice_parameter_buffer.components[i].component_selector = component_id;
-        jpeg_stream_parameters_.slice_parameter_buffer.components[i].dc_table_selector = ((table >> 4) & 0x0F);
-        jpeg_stream_parameters_.slice_parameter_buffer.components[i].ac_table_selector = (table & 0x0F);
+        scan.components[i].component_selector = component_id;
+        scan.components[i].dc_table_selector = ((table >> 4) & 0x0F);
+        scan.components[i].ac_table_selector = (table & 0x0F);
 
         if ((table & 0xF) >= 4) {
             ERR("invalid number of AC Huffman table!");
@@ -352,11 +678,27 @@ bool RocJpegStreamParser::ParseSOS() {
             ERR("invalid number of DC Huffman table!");
             return false;
         }
-        if (component_id != jpeg_stream_parameters_.picture_parameter_buffer.components[i].component_id) {
+        if (jpeg_stream_parameters_.coding_process == CODING_PROCESS_PROGRESSIVE ||
+            num_components < jpeg_stream_parameters_.picture_parameter_buffer.num_components) {
+            // the scans of a progressive frame, and of a sequential frame coded in several scans, may hold any subset of the components
+            bool component_found = false;
+            for (int32_t j = 0; j < jpeg_stream_parameters_.picture_parameter_buffer.num_components; j++) {
+                component_found |= component_id == jpeg_stream_parameters_.picture_parameter_buffer.components[j].component_id;
+            }
+            if (!component_found) {
+                ERR("component id of the SOS marker not found in the SOF marker!");
+                return false;
+            }
+        } else if (component_id != jpeg_stream_parameters_.picture_parameter_buffer.components[i].component_id) {
             ERR("component id mismatch between SOS and SOF marker!");
             return false;
         }
     }
+    scan.spectral_start = stream_[0];
+    scan.spectral_end = stream_[1];
+    scan.approximation_high = stream_[2] >> 4;
+    scan.approximation_low = stream_[2] & 0x0F;
+    scan.restart_interval = jpeg_stream_parameters_.slice_parameter_buffer.restart_interval;
     stream_ += 3;
 
     return true;
@@ -389,13 +731,308 @@ bool RocJpegStreamParser::ParseDRI() {
     return true;
 }
 
+/**
+ * @brief Reads a 16-bit value of an EXIF (TIFF) structure in the given byte order.
+ */
+static inline uint16_t ReadExifUint16(const uint8_t *data, bool big_endian) {
+    return big_endian ? static_cast<uint16_t>((data[0] << 8) | data[1]) : static_cast<uint16_t>((data[1] << 8) | data[0]);
+}
+
+/**
+ * @brief Reads a 32-bit value of an EXIF (TIFF) structure in the given byte order.
+ */
+static inline uint32_t ReadExifUint32(const uint8_t *data, bool big_endian) {
+    return big_endian ? (static_cast<uint32_t>(ReadExifUint16(data, true)) << 16) | ReadExifUint16(data + 2, true) :
+                        (static_cast<uint32_t>(ReadExifUint16(data + 2, false)) << 16) | ReadExifUint16(data, false);
+}
+
+/**
+ * @brief Validates a TIFF header and reads its byte order and the offset of the first image file directory.
+ */
+static bool ParseTiffHeader(const uint8_t *tiff, uint32_t tiff_length, bool &big_endian, uint32_t &ifd_offset) {
+    if (tiff_length < 8 + 2) {
+        return false;
+    }
+    if (tiff[0] == 'M' && tiff[1] == 'M') {
+        big_endian = true;
+    } else if (tiff[0] == 'I' && tiff[1] == 'I') {
+        big_endian = false;
+    } else {
+        return false;
+    }
+    if (ReadExifUint16(tiff + 2, big_endian) != 42) {
+        return false;
+    }
+    ifd_offset = ReadExifUint32(tiff + 4, big_endian);
+    return true;
+}
+
+/**
+ * @brief Looks up a tag in an image file directory (IFD) of a TIFF structure.
+ *
+ * The entries that don't fit in the TIFF structure are ignored. If `next_ifd_offset` isn't null, it receives the
+ * offset of the next IFD, or 0 if there is none or the IFD is truncated.
+ *
+ * @return The pointer to the 12-byte entry of the tag, or nullptr if the tag isn't found.
+ */
+static const uint8_t* FindTiffTag(const uint8_t *tiff, uint32_t tiff_length, uint32_t ifd_offset, bool big_endian,
+                                  uint16_t tag, uint32_t *next_ifd_offset) {
+    if (next_ifd_offset != nullptr) {
+        *next_ifd_offset = 0;
+    }
+    if (ifd_offset < 8 || ifd_offset > tiff_length - 2) {
+        return nullptr;
+    }
+    uint32_t num_entries = ReadExifUint16(tiff + ifd_offset, big_endian);
+    uint32_t max_entries = (tiff_length - ifd_offset - 2) / 12;
+    if (next_ifd_offset != nullptr && num_entries <= max_entries &&
+        ifd_offset + 2 + num_entries * 12 + 4 <= tiff_length) {
+        *next_ifd_offset = ReadExifUint32(tiff + ifd_offset + 2 + num_entries * 12, big_endian);
+    }
+    num_entries = std::min(num_entries, max_entries);
+    for (uint32_t i = 0; i < num_entries; i++) {
+        const uint8_t *entry = tiff + ifd_offset + 2 + i * 12;
+        if (ReadExifUint16(entry, big_endian) == tag) {
+            return entry;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Reads the value of a TIFF entry that holds a single SHORT (type 3) or LONG (type 4) value.
+ * @return True if the entry holds a single SHORT or LONG value, false otherwise.
+ */
+static bool ReadTiffInteger(const uint8_t *entry, bool big_endian, uint32_t &value) {
+    uint16_t type = ReadExifUint16(entry + 2, big_endian);
+    if (ReadExifUint32(entry + 4, big_endian) != 1) {
+        return false;
+    }
+    if (type == 3) {
+        value = ReadExifUint16(entry + 8, big_endian);
+        return true;
+    }
+    if (type == 4) {
+        value = ReadExifUint32(entry + 8, big_endian);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Reads the frame size of a JPEG image by walking its marker segments up to the first SOFn marker.
+ * @return True if a SOFn marker is found and the frame size is not zero, false otherwise.
+ */
+static bool GetJpegFrameSize(const uint8_t *image, uint32_t length, uint16_t &width, uint16_t &height) {
+    const uint8_t *end = image + length;
+    const uint8_t *pos = image + 2;
+    while (end - pos >= 4) {
+        if (pos[0] != 0xFF) {
+            return false;
+        }
+        uint8_t marker = pos[1];
+        if (marker == 0xFF) {
+            pos++;
+            continue;
+        }
+        if (marker >= 0xC0 && marker <= 0xCF && marker != DHT && marker != 0xC8 && marker != 0xCC) {
+            if (end - pos < 2 + 7) {
+                return false;
+            }
+            height = swap_bytes(pos + 5);
+            width = swap_bytes(pos + 7);
+            return width != 0 && height != 0;
+        }
+        if (marker == SOS || marker == EOI) {
+            return false;
+        }
+        uint32_t segment_length = swap_bytes(pos + 2);
+        if (segment_length < 2 || segment_length > end - pos - 2) {
+            return false;
+        }
+        pos += 2 + segment_length;
+    }
+    return false;
+}
+
+/**
+ * @brief Records an embedded JPEG image.
+ *
+ * The image must be completely contained in the stream, start with an SOI marker, and have a readable frame size;
+ * otherwise it is ignored. At most EMBEDDED_IMAGE_MAX_ENTRIES images are recorded.
+ *
+ * @param source Where the image is stored.
+ * @param image The pointer to the SOI marker of the image.
+ * @param length The length of the image in bytes.
+ */
+void RocJpegStreamParser::AddEmbeddedImage(EmbeddedImageSource source, const uint8_t *image, uint32_t length) {
+    const uint8_t *stream_begin = stream_end_ - stream_length_;
+    if (embedded_images_.size() >= EMBEDDED_IMAGE_MAX_ENTRIES || image < stream_begin || image > stream_end_ ||
+        length < 4 || length > stream_end_ - image || image[0] != 0xFF || image[1] != SOI) {
+        return;
+    }
+    EmbeddedImage embedded_image = {};
+    if (!GetJpegFrameSize(image, length, embedded_image.width, embedded_image.height)) {
+        return;
+    }
+    embedded_image.source = source;
+    embedded_image.offset = static_cast<uint32_t>(image - stream_begin);
+    embedded_image.length = length;
+    embedded_images_.push_back(embedded_image);
+}
+
+/**
+ * @brief Parses the APP14 marker in the JPEG stream.
+ *
+ * This function checks whether the APP14 segment is an Adobe marker ("Adobe" followed by the version, two flag
+ * words, and the color transform) and, if so, records its color transform. Other APP14 segments and Adobe markers
+ * with an unknown color transform are skipped without failing the parse.
+ *
+ * @return true if the APP14 marker is successfully parsed, false otherwise.
+ */
+bool RocJpegStreamParser::ParseAPP14() {
+    static const uint8_t adobe_identifier[5] = {'A', 'd', 'o', 'b', 'e'};
+
+    if (stream_ == nullptr) {
+        return false;
+    }
+    uint32_t length = swap_bytes(stream_);
+    if (length < 2 + 12 || std::memcmp(stream_ + 2, adobe_identifier, sizeof(adobe_identifier)) != 0) {
+        return true;
+    }
+    uint8_t transform = stream_[2 + 11];
+    if (transform > ADOBE_TRANSFORM_YCCK) {
+        return true;
+    }
+    jpeg_stream_parameters_.has_adobe_marker = true;
+    jpeg_stream_parameters_.adobe_color_transform = static_cast<AdobeColorTransform>(transform);
+
+    return true;
+}
+
+/**
+ * @brief Parses the APP1 marker in the JPEG stream.
+ *
+ * This function checks whether the APP1 segment holds EXIF data ("Exif\0\0" followed by a TIFF header) and, if so,
+ * looks up the orientation tag (0x0112) in the first image file directory (IFD0). If IFD0 links to a second IFD
+ * (IFD1), the JPEG thumbnail it describes (tags 0x0201 and 0x0202) is recorded as an embedded image. Other APP1
+ * segments (e.g., XMP) and EXIF data that is truncated or malformed are skipped without failing the parse.
+ *
+ * @return true if the APP1 marker is successfully parsed, false otherwise.
+ */
+bool RocJpegStreamParser::ParseAPP1() {
+    static const uint8_t exif_identifier[6] = {'E', 'x', 'i', 'f', 0, 0};
+
+    if (stream_ == nullptr) {
+        return false;
+    }
+
+    uint32_t length = swap_bytes(stream_);
+    // the EXIF identifier, the TIFF header (8 bytes), and the IFD0 entry count must fit in the segment
+    if (length < 2 + sizeof(exif_identifier) + 8 + 2 || memcmp(stream_ + 2, exif_identifier, sizeof(exif_identifier)) != 0) {
+        return true;
+    }
+    const uint8_t *tiff = stream_ + 2 + sizeof(exif_identifier);
+    uint32_t tiff_length = length - 2 - sizeof(exif_identifier);
+
+    bool big_endian;
+    uint32_t ifd_offset;
+    if (!ParseTiffHeader(tiff, tiff_length, big_endian, ifd_offset)) {
+        return true;
+    }
+
+    uint32_t ifd1_offset;
+    const uint8_t *entry = FindTiffTag(tiff, tiff_length, ifd_offset, big_endian, EXIF_ORIENTATION_TAG, &ifd1_offset);
+    if (entry != nullptr) {
+        // the orientation is a single SHORT (type 3) stored in the value field of the entry
+        uint16_t type = ReadExifUint16(entry + 2, big_endian);
+        uint32_t count = ReadExifUint32(entry + 4, big_endian);
+        uint16_t orientation = ReadExifUint16(entry + 8, big_endian);
+        if (type == 3 && count == 1 && orientation >= EXIF_ORIENTATION_NORMAL && orientation <= EXIF_ORIENTATION_MAX) {
+            jpeg_stream_parameters_.orientation = static_cast<uint8_t>(orientation);
+        }
+    }
+
+    // IFD1 describes the thumbnail; its offset is relative to the TIFF header and the data must lie in the segment
+    if (ifd1_offset != 0) {
+        const uint8_t *offset_entry = FindTiffTag(tiff, tiff_length, ifd1_offset, big_endian, EXIF_JPEG_INTERCHANGE_FORMAT_TAG, nullptr);
+        const uint8_t *length_entry = FindTiffTag(tiff, tiff_length, ifd1_offset, big_endian, EXIF_JPEG_INTERCHANGE_FORMAT_LENGTH_TAG, nullptr);
+        uint32_t thumbnail_offset, thumbnail_length;
+        if (offset_entry != nullptr && length_entry != nullptr && ReadTiffInteger(offset_entry, big_endian, thumbnail_offset) &&
+            ReadTiffInteger(length_entry, big_endian, thumbnail_length) && thumbnail_offset <= tiff_length &&
+            thumbnail_length <= tiff_length - thumbnail_offset) {
+            AddEmbeddedImage(EMBEDDED_IMAGE_EXIF_THUMBNAIL, tiff + thumbnail_offset, thumbnail_length);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Parses the APP2 marker in the JPEG stream.
+ *
+ * This function checks whether the APP2 segment holds Multi-Picture Format data ("MPF\0" followed by a TIFF header)
+ * and, if so, reads the MP entries (tag 0xB002) of the MP Index IFD. Each entry gives the size and the offset of an
+ * individual image, relative to the TIFF header; the images other than the primary image (offset 0) that are stored
+ * as JPEG data are recorded as embedded images. The individual images follow the EOI marker of the primary image,
+ * so they are only found if they are part of the parsed data. Other APP2 segments (e.g., ICC profiles) and MPF data
+ * that is truncated or malformed are skipped without failing the parse.
+ *
+ * @return true if the APP2 marker is successfully parsed, false otherwise.
+ */
+bool RocJpegStreamParser::ParseAPP2() {
+    static const uint8_t mpf_identifier[4] = {'M', 'P', 'F', 0};
+
+    if (stream_ == nullptr) {
+        return false;
+    }
+
+    uint32_t length = swap_bytes(stream_);
+    if (length < 2 + sizeof(mpf_identifier) + 8 + 2 || memcmp(stream_ + 2, mpf_identifier, sizeof(mpf_identifier)) != 0) {
+        return true;
+    }
+    const uint8_t *tiff = stream_ + 2 + sizeof(mpf_identifier);
+    uint32_t tiff_length = length - 2 - sizeof(mpf_identifier);
+
+    bool big_endian;
+    uint32_t ifd_offset;
+    if (!ParseTiffHeader(tiff, tiff_length, big_endian, ifd_offset)) {
+        return true;
+    }
+    const uint8_t *entry = FindTiffTag(tiff, tiff_length, ifd_offset, big_endian, MPF_MP_ENTRY_TAG, nullptr);
+    if (entry == nullptr || ReadExifUint16(entry + 2, big_endian) != 7) {
+        return true;
+    }
+    // the MP entries (UNDEFINED, 16 bytes per image) don't fit in the value field, which holds their offset
+    uint32_t entries_size = ReadExifUint32(entry + 4, big_endian);
+    uint32_t entries_offset = ReadExifUint32(entry + 8, big_endian);
+    if (entries_size < MPF_MP_ENTRY_SIZE || entries_offset > tiff_length || entries_size > tiff_length - entries_offset) {
+        return true;
+    }
+    for (uint32_t i = 0; i < entries_size / MPF_MP_ENTRY_SIZE; i++) {
+        const uint8_t *mp_entry = tiff + entries_offset + i * MPF_MP_ENTRY_SIZE;
+        uint32_t attribute = ReadExifUint32(mp_entry, big_endian);
+        uint32_t image_size = ReadExifUint32(mp_entry + 4, big_endian);
+        uint32_t image_offset = ReadExifUint32(mp_entry + 8, big_endian);
+        // bits 24-26 of the attribute give the image data format, 0 being JPEG
+        if (image_offset == 0 || ((attribute >> 24) & 0x7) != 0 || image_offset > stream_end_ - tiff) {
+            continue;
+        }
+        AddEmbeddedImage(EMBEDDED_IMAGE_MPF, tiff + image_offset, image_size);
+    }
+
+    return true;
+}
+
 /**
  * @brief Parses the End of Image (EOI) marker in the JPEG stream.
  *
- * This function searches for the EOI marker in the JPEG stream and updates the slice data buffer
- * and slice data size in the jpeg_stream_parameters_ structure.
+ * This function searches for the EOI marker in the JPEG stream using the marker scanner and updates the
+ * slice data buffer and slice data size in the jpeg_stream_parameters_ structure. If the EOI marker is missing,
+ * the slice data extends to the end of the stream. When the stream has a restart interval, the RSTn markers
+ * visited in the same pass are recorded in the restart marker index.
  *
- * @return true if the EOI marker is found and the slice data buffer is updated successfully, false otherwise.
+ * @return true if the slice data buffer is updated successfully, false otherwise.
  */
 bool RocJpegStreamParser::ParseEOI() {
 
@@ -403,18 +1040,394 @@ bool RocJpegStreamParser::ParseEOI() {
         return false;
     }
 
-    const uint8_t *stream_temp = stream_;
-    while (stream_temp <= stream_end_ && !(*stream_temp == 0xFF  && *(stream_temp + 1) == EOI)) {
-        stream_temp++;
-        continue;
+    restart_markers_.clear();
+    restart_marker_stride_ = 1;
+    num_restart_segments_ = 0;
+
+    SetSliceData(stream_, FindEndOfScan(stream_, stream_));
+
+    return true;
+}
+
+/**
+ * @brief Searches the scan data for the EOI marker.
+ *
+ * This function walks the markers of the scan data with the marker scanner, starting at `begin`, until the
+ * EOI marker or the end of the stream is reached. When the stream has a restart interval, the RSTn markers
+ * that are visited are recorded in the restart marker index; the number of visited RSTn markers is kept
+ * across calls, so the search can be resumed on a stream that is still being received.
+ *
+ * @param slice_data A pointer to the start of the scan data.
+ * @param begin A pointer where the search starts.
+ * @return A pointer to the EOI marker, or stream_end_ if the EOI marker is not found.
+ */
+const uint8_t* RocJpegStreamParser::FindEndOfScan(const uint8_t *slice_data, const uint8_t *begin) {
+    uint16_t restart_interval = jpeg_stream_parameters_.slice_parameter_buffer.restart_interval;
+    // the restart segments of a progressive or multi-scan frame are spread over several scans and aren't indexed
+    bool build_restart_marker_index = restart_interval != 0 && restart_marker_index_limit_ != 0 &&
+                                      jpeg_stream_parameters_.coding_process != CODING_PROCESS_PROGRESSIVE && !IsMultiScanFrame();
+
+    const uint8_t *stream_temp = marker_scanner_.FindNextMarker(begin, stream_end_);
+    while (stream_temp != stream_end_ && stream_temp[1] != EOI) {
+        if (build_restart_marker_index && stream_temp[1] >= RST0 && stream_temp[1] <= RST7) {
+            AddRestartMarker(stream_temp + 2 - slice_data, ++num_restart_segments_);
+        }
+        stream_temp = marker_scanner_.FindNextMarker(stream_temp + 2, stream_end_);
     }
 
-    jpeg_stream_parameters_.slice_parameter_buffer.slice_data_size = stream_temp - stream_;
-    jpeg_stream_parameters_.slice_data_buffer = stream_;
+    return stream_temp;
+}
+
+/**
+ * @brief Sets the slice data of the JPEG stream parameters.
+ *
+ * This function updates the slice data buffer and slice data size in the jpeg_stream_parameters_ structure and
+ * points the stream parameters to the restart marker index.
+ *
+ * @param slice_data A pointer to the start of the scan data.
+ * @param slice_data_end A pointer past the end of the scan data.
+ */
+void RocJpegStreamParser::SetSliceData(const uint8_t *slice_data, const uint8_t *slice_data_end) {
+    jpeg_stream_parameters_.slice_parameter_buffer.slice_data_size = slice_data_end - slice_data;
+    jpeg_stream_parameters_.slice_data_buffer = slice_data;
+    jpeg_stream_parameters_.restart_markers = restart_markers_.empty() ? nullptr : restart_markers_.data();
+    jpeg_stream_parameters_.num_restart_markers = restart_markers_.size();
+    jpeg_stream_parameters_.restart_marker_stride = restart_marker_stride_;
+}
 
+/**
+ * @brief Checks if the parsed frame is a sequential frame whose components are coded in several scans.
+ *
+ * Each component of a sequential frame is coded in exactly one scan, so the frame has several scans when its
+ * first scan doesn't hold all the components (non-interleaved scans, for example).
+ *
+ * @return True if the components of the frame are coded in several scans, false otherwise.
+ */
+bool RocJpegStreamParser::IsMultiScanFrame() const {
+    return jpeg_stream_parameters_.coding_process != CODING_PROCESS_PROGRESSIVE &&
+           jpeg_stream_parameters_.slice_parameter_buffer.num_components < jpeg_stream_parameters_.picture_parameter_buffer.num_components;
+}
+
+/**
+ * @brief Locates the scans of the frame in the slice data and records the tables in effect for each scan.
+ *
+ * A sequential frame whose first scan holds all the components has a single scan that spans the slice data. The
+ * slice data of a progressive frame, and of a multi-scan sequential frame, spans all the scans up to the EOI marker:
+ * this function walks it from the first scan, locates the entropy-coded data of each scan, and parses the marker
+ * segments between the scans (DHT, DQT, DRI, and SOS) on the way. The tables that a DHT or DQT marker redefines
+ * are interned again at the next scan, so each scan references the tables in effect when it starts. The VA-API
+ * takes a single set of tables per picture, so redefining a table that an earlier scan references sets the
+ * HW_LIMITATION_HUFFMAN_TABLE or HW_LIMITATION_QUANTIZATION_TABLE flag. A multi-scan sequential frame sets the
+ * HW_LIMITATION_MULTI_SCAN flag, which routes it to the hybrid path, since the VCN JPEG decoder is submitted a single
+ * slice per picture.
+ *
+ * @return True if the scans are successfully parsed, false otherwise.
+ */
+bool RocJpegStreamParser::ParseScans() {
+    const PictureParameterBuffer &picture_parameter_buffer = jpeg_stream_parameters_.picture_parameter_buffer;
+    const uint8_t *slice_data = jpeg_stream_parameters_.slice_data_buffer;
+    const uint8_t *slice_data_end = slice_data + jpeg_stream_parameters_.slice_parameter_buffer.slice_data_size;
+    uint16_t first_restart_interval = jpeg_stream_parameters_.slice_parameter_buffer.restart_interval;
+    bool is_multi_scan = IsMultiScanFrame();
+
+    scan_quantization_table_refs_.clear();
+    scan_huffman_table_refs_.clear();
+    JpegScan scan = scans_[0];
+    scan.data_offset = 0;
+    scan.huffman_tables = &huffman_table_ref_->buffer;
+    scan.huffman_table_id = huffman_table_ref_->id;
+    scan.quantization_tables = &quantization_table_ref_->buffer;
+    scan.quantization_table_id = quantization_table_ref_->id;
+    scans_.clear();
+    if (!is_multi_scan && jpeg_stream_parameters_.coding_process != CODING_PROCESS_PROGRESSIVE) {
+        scan.data_size = jpeg_stream_parameters_.slice_parameter_buffer.slice_data_size;
+        scans_.push_back(scan);
+        jpeg_stream_parameters_.scans = scans_.data();
+        jpeg_stream_parameters_.num_scans = 1;
+        return true;
+    }
+
+    uint32_t scanned_components = 0;
+    uint32_t referenced_dc_tables = 0, referenced_ac_tables = 0, referenced_quantization_tables = 0;
+    bool is_huffman_table_redefined = false, is_quantization_table_redefined = false;
+    const uint8_t *scan_data = slice_data;
+    while (true) {
+        for (int32_t i = 0; i < scan.num_components; i++) {
+            int32_t component_index = 0;
+            while (picture_parameter_buffer.components[component_index].component_id != scan.components[i].component_selector) {
+                component_index++;
+            }
+            if (is_multi_scan && (scanned_components & (1 << component_index))) {
+                ERR("a component is coded in more than one scan!");
+                return false;
+            }
+            scanned_components |= 1 << component_index;
+            referenced_dc_tables |= 1 << scan.components[i].dc_table_selector;
+            referenced_ac_tables |= 1 << scan.components[i].ac_table_selector;
+            referenced_quantization_tables |= 1 << picture_parameter_buffer.components[component_index].quantiser_table_selector;
+        }
+        // the entropy-coded data of the scan ends at the first marker that isn't a RSTn marker
+        const uint8_t *scan_end = marker_scanner_.FindNextMarker(scan_data, slice_data_end);
+        while (scan_end != slice_data_end && scan_end[1] >= RST0 && scan_end[1] <= RST7) {
+            scan_end = marker_scanner_.FindNextMarker(scan_end + 2, slice_data_end);
+        }
+        scan.data_offset = scan_data - slice_data;
+        scan.data_size = scan_end - scan_data;
+        scans_.push_back(scan);
+
+        // parse the marker segments up to the SOS marker of the next scan
+        bool sos_marker_found = false;
+        stream_ = scan_end;
+        while (!sos_marker_found && slice_data_end - stream_ >= 4) {
+            stream_ = marker_scanner_.FindNextMarker(stream_, slice_data_end);
+            if (slice_data_end - stream_ < 4) {
+                break;
+            }
+            uint8_t marker = stream_[1];
+            stream_ += 2;
+            int32_t length = swap_bytes(stream_);
+            if (length < 2 || length > slice_data_end - stream_) {
+                ERR("invalid marker segment length!");
+                return false;
+            }
+            const uint8_t *next_segment = stream_ + length;
+            switch (marker) {
+                case DHT: {
+                    HuffmanTableSet huffman_tables;
+                    std::memcpy(&huffman_tables, &huffman_tables_, sizeof(huffman_tables));
+                    if (!ParseDHT())
+                        return false;
+                    for (int32_t id = 0; id < HUFFMAN_TABLES; id++) {
+                        if (((referenced_dc_tables >> id) & 1 && std::memcmp(&huffman_tables.dc_tables[id], &huffman_tables_.dc_tables[id], sizeof(HuffmanTable)) != 0) ||
+                            ((referenced_ac_tables >> id) & 1 && std::memcmp(&huffman_tables.ac_tables[id], &huffman_tables_.ac_tables[id], sizeof(HuffmanTable)) != 0)) {
+                            jpeg_stream_parameters_.hardware_limitations |= HW_LIMITATION_HUFFMAN_TABLE;
+                        }
+                    }
+                    is_huffman_table_redefined = true;
+                    break;
+                }
+                case DQT: {
+                    QuantizationTableSet quantization_tables = quantization_tables_;
+                    if (!ParseDQT())
+                        return false;
+                    for (int32_t id = 0; id < NUM_COMPONENTS; id++) {
+                        if ((referenced_quantization_tables >> id) & 1 &&
+                            std::memcmp(quantization_tables.quantiser_table[id], quantization_tables_.quantiser_table[id], sizeof(quantization_tables.quantiser_table[id])) != 0) {
+                            jpeg_stream_parameters_.hardware_limitations |= HW_LIMITATION_QUANTIZATION_TABLE;
+                        }
+                    }
+                    is_quantization_table_redefined = true;
+                    break;
+                }
+                case DRI:
+                    if (!ParseDRI())
+                        return false;
+                    break;
+                case SOS: {
+                    JpegScan next_scan = {};
+                    if (!ParseSOS(next_scan))
+                        return false;
+                    // the scan shares the interned tables of the previous scan unless a table was redefined
+                    RocJpegTableCache &table_cache = RocJpegTableCache::GetInstance();
+                    if (is_huffman_table_redefined) {
+                        scan_huffman_table_refs_.push_back(table_cache.Intern(huffman_tables_));
+                        scan.huffman_tables = &scan_huffman_table_refs_.back()->buffer;
+                        scan.huffman_table_id = scan_huffman_table_refs_.back()->id;
+                        is_huffman_table_redefined = false;
+                    }
+                    if (is_quantization_table_redefined) {
+                        scan_quantization_table_refs_.push_back(table_cache.Intern(quantization_tables_));
+                        scan.quantization_tables = &scan_quantization_table_refs_.back()->buffer;
+                        scan.quantization_table_id = scan_quantization_table_refs_.back()->id;
+                        is_quantization_table_redefined = false;
+                    }
+                    std::memcpy(scan.components, next_scan.components, sizeof(scan.components));
+                    scan.num_components = next_scan.num_components;
+                    scan.spectral_start = next_scan.spectral_start;
+                    scan.spectral_end = next_scan.spectral_end;
+                    scan.approximation_high = next_scan.approximation_high;
+                    scan.approximation_low = next_scan.approximation_low;
+                    scan.restart_interval = next_scan.restart_interval;
+                    scan_data = next_segment;
+                    sos_marker_found = true;
+                    break;
+                }
+                default:
+                    break;
+            }
+            if (!sos_marker_found) {
+                stream_ = next_segment;
+            }
+        }
+        if (!sos_marker_found) {
+            break;
+        }
+    }
+    jpeg_stream_parameters_.slice_parameter_buffer.restart_interval = first_restart_interval;
+
+    if (is_multi_scan) {
+        jpeg_stream_parameters_.hardware_limitations |= HW_LIMITATION_MULTI_SCAN;
+    }
+    jpeg_stream_parameters_.scans = scans_.data();
+    jpeg_stream_parameters_.num_scans = scans_.size();
     return true;
 }
 
+/**
+ * @brief Records a restart segment in the restart marker index.
+ *
+ * Only the segments whose index is a multiple of the current stride are recorded. When the index reaches its
+ * size limit, every other entry is dropped and the stride is doubled, so the recorded segments remain evenly
+ * spread over the scan and the memory used by the index stays bounded for huge images.
+ *
+ * @param byte_offset The offset of the restart segment relative to the start of the slice data.
+ * @param segment_index The index of the restart segment (the first segment after SOS has index 0).
+ */
+void RocJpegStreamParser::AddRestartMarker(uint32_t byte_offset, uint32_t segment_index) {
+    if (segment_index % restart_marker_stride_ != 0) {
+        return;
+    }
+    if (restart_markers_.size() >= restart_marker_index_limit_) {
+        // keep the entries of the segments that are multiples of the doubled stride (every other entry)
+        size_t num_kept = 0;
+        for (size_t i = 1; i < restart_markers_.size(); i += 2) {
+            restart_markers_[num_kept++] = restart_markers_[i];
+        }
+        restart_markers_.resize(num_kept);
+        restart_marker_stride_ <<= 1;
+        if (segment_index % restart_marker_stride_ != 0) {
+            return;
+        }
+    }
+    uint32_t mcu_index = segment_index * jpeg_stream_parameters_.slice_parameter_buffer.restart_interval;
+    restart_markers_.push_back({byte_offset, mcu_index});
+}
+
+/**
+ * @brief Resets the quantization and Huffman tables.
+ *
+ * The tables are zero-filled, so that the entries not defined by the stream don't depend on the previous stream
+ * and identical tables are interned as the same table. The references to the tables of the previous stream are
+ * released.
+ */
+void RocJpegStreamParser::ResetTables() {
+    std::memset(&quantization_tables_, 0, sizeof(quantization_tables_));
+    std::memset(&huffman_tables_, 0, sizeof(huffman_tables_));
+    quantization_matrix_buffer_ = {};
+    huffman_table_buffer_ = {};
+    quantization_table_ref_.reset();
+    huffman_table_ref_.reset();
+    scan_quantization_table_refs_.clear();
+    scan_huffman_table_refs_.clear();
+}
+
+/**
+ * @brief Assigns the Huffman tables referenced by the first scan to the two slots of the Huffman table buffer.
+ *
+ * When the scan only references the tables 0 and 1 of each class, the table IDs are used as the slots, so the
+ * content of the buffer doesn't depend on the scan. Otherwise, the referenced DC tables and the referenced AC tables
+ * are assigned to the slots in the order of the components of the scan, and the table selectors of the slice
+ * parameter buffer are rewritten to the slots. A scan that references more than two tables of a class, or a table
+ * with more values than a slot holds, sets the HW_LIMITATION_HUFFMAN_TABLE flag. The VCN JPEG decoder only decodes
+ * single-scan frames, so the other scans don't need slots.
+ */
+void RocJpegStreamParser::AssignHuffmanTableSlots() {
+    const uint8_t no_slot = 0xFF;
+    uint8_t dc_slots[HUFFMAN_TABLES], ac_slots[HUFFMAN_TABLES];
+    std::memset(dc_slots, no_slot, sizeof(dc_slots));
+    std::memset(ac_slots, no_slot, sizeof(ac_slots));
+    SliceParameterBuffer &slice_parameter_buffer = jpeg_stream_parameters_.slice_parameter_buffer;
+
+    bool is_remap_required = false;
+    for (int32_t i = 0; i < slice_parameter_buffer.num_components; i++) {
+        is_remap_required |= slice_parameter_buffer.components[i].dc_table_selector >= VA_HUFFMAN_TABLES ||
+                             slice_parameter_buffer.components[i].ac_table_selector >= VA_HUFFMAN_TABLES;
+    }
+    if (!is_remap_required) {
+        for (uint8_t id = 0; id < VA_HUFFMAN_TABLES; id++) {
+            dc_slots[id] = id;
+            ac_slots[id] = id;
+        }
+    } else {
+        uint8_t num_dc_slots = 0, num_ac_slots = 0;
+        for (int32_t i = 0; i < slice_parameter_buffer.num_components; i++) {
+            uint8_t dc_id = slice_parameter_buffer.components[i].dc_table_selector;
+            uint8_t ac_id = slice_parameter_buffer.components[i].ac_table_selector;
+            if (dc_slots[dc_id] == no_slot) {
+                if (num_dc_slots == VA_HUFFMAN_TABLES) {
+                    jpeg_stream_parameters_.hardware_limitations |= HW_LIMITATION_HUFFMAN_TABLE;
+                    return;
+                }
+                dc_slots[dc_id] = num_dc_slots++;
+            }
+            if (ac_slots[ac_id] == no_slot) {
+                if (num_ac_slots == VA_HUFFMAN_TABLES) {
+                    jpeg_stream_parameters_.hardware_limitations |= HW_LIMITATION_HUFFMAN_TABLE;
+                    return;
+                }
+                ac_slots[ac_id] = num_ac_slots++;
+            }
+        }
+    }
+
+    for (uint8_t id = 0; id < HUFFMAN_TABLES; id++) {
+        const HuffmanTable &dc_table = huffman_tables_.dc_tables[id];
+        if (dc_slots[id] != no_slot && dc_table.is_defined) {
+            if (dc_table.num_values > DC_HUFFMAN_TABLE_VALUES_SIZE) {
+                jpeg_stream_parameters_.hardware_limitations |= HW_LIMITATION_HUFFMAN_TABLE;
+                return;
+            }
+            std::memcpy(huffman_table_buffer_.huffman_table[dc_slots[id]].num_dc_codes, dc_table.num_codes, 16);
+            std::memcpy(huffman_table_buffer_.huffman_table[dc_slots[id]].dc_values, dc_table.values, dc_table.num_values);
+            huffman_table_buffer_.load_huffman_table[dc_slots[id]] = 1;
+        }
+        const HuffmanTable &ac_table = huffman_tables_.ac_tables[id];
+        if (ac_slots[id] != no_slot && ac_table.is_defined) {
+            if (ac_table.num_values > AC_HUFFMAN_TABLE_VALUES_SIZE) {
+                jpeg_stream_parameters_.hardware_limitations |= HW_LIMITATION_HUFFMAN_TABLE;
+                return;
+            }
+            std::memcpy(huffman_table_buffer_.huffman_table[ac_slots[id]].num_ac_codes, ac_table.num_codes, 16);
+            std::memcpy(huffman_table_buffer_.huffman_table[ac_slots[id]].ac_values, ac_table.values, ac_table.num_values);
+            huffman_table_buffer_.load_huffman_table[ac_slots[id]] = 1;
+        }
+    }
+
+    if (is_remap_required) {
+        for (int32_t i = 0; i < slice_parameter_buffer.num_components; i++) {
+            slice_parameter_buffer.components[i].dc_table_selector = dc_slots[slice_parameter_buffer.components[i].dc_table_selector];
+            slice_parameter_buffer.components[i].ac_table_selector = ac_slots[slice_parameter_buffer.components[i].ac_table_selector];
+        }
+        jpeg_stream_parameters_.is_huffman_table_remapped = true;
+    }
+}
+
+/**
+ * @brief Interns the quantization and Huffman tables of the first scan.
+ *
+ * This function looks up the tables parsed from the DQT and DHT segments that precede the first scan in the
+ * process-wide table cache, which the parser references until the next stream is parsed, and derives the VA-API
+ * buffers from them: the Huffman tables referenced by the scan are assigned to the slots of the Huffman table
+ * buffer, and the quantization values are clamped to the 8 bits of the quantization matrix buffer (the streams with
+ * larger values are decoded by the hybrid path). The IDs of the tables identify both buffers.
+ */
+void RocJpegStreamParser::InternTables() {
+    AssignHuffmanTableSlots();
+    for (int32_t id = 0; id < NUM_COMPONENTS; id++) {
+        quantization_matrix_buffer_.load_quantiser_table[id] = quantization_tables_.load_quantiser_table[id];
+        for (int32_t i = 0; i < 64; i++) {
+            quantization_matrix_buffer_.quantiser_table[id][i] = static_cast<uint8_t>(std::min<uint16_t>(quantization_tables_.quantiser_table[id][i], 0xFF));
+        }
+    }
+    RocJpegTableCache &table_cache = RocJpegTableCache::GetInstance();
+    quantization_table_ref_ = table_cache.Intern(quantization_tables_);
+    huffman_table_ref_ = table_cache.Intern(huffman_tables_);
+    jpeg_stream_parameters_.quantization_matrix_buffer = &quantization_matrix_buffer_;
+    jpeg_stream_parameters_.quantization_matrix_id = quantization_table_ref_->id;
+    jpeg_stream_parameters_.huffman_table_buffer = &huffman_table_buffer_;
+    jpeg_stream_parameters_.huffman_table_id = huffman_table_ref_->id;
+}
+
 /**
  * @brief Determines the chroma subsampling format based on the given sampling factors.
  *
@@ -27,16 +27,29 @@ THE SOFTWARE.
 #include <stdint.h>
 #include <iostream>
 #include <cstring>
-#include <mutex>
+#include <vector>
+#include <memory>
 #include "rocjpeg_commons.h"
+#include "rocjpeg_marker_scanner.h"
 
 #pragma once
 
 #define NUM_COMPONENTS 4
-#define HUFFMAN_TABLES 2
+#define HUFFMAN_TABLES 4
+#define VA_HUFFMAN_TABLES 2
+#define HUFFMAN_TABLE_VALUES_MAX_SIZE 256
 #define AC_HUFFMAN_TABLE_VALUES_SIZE 162
 #define DC_HUFFMAN_TABLE_VALUES_SIZE 12
 #define swap_bytes(x) (((x)[0] << 8) | (x)[1])
+#define RESTART_MARKER_INDEX_MAX_ENTRIES 4096
+#define EXIF_ORIENTATION_TAG 0x0112
+#define EXIF_ORIENTATION_NORMAL 1
+#define EXIF_ORIENTATION_MAX 8
+#define EXIF_JPEG_INTERCHANGE_FORMAT_TAG 0x0201
+#define EXIF_JPEG_INTERCHANGE_FORMAT_LENGTH_TAG 0x0202
+#define MPF_MP_ENTRY_TAG 0xB002
+#define MPF_MP_ENTRY_SIZE 16
+#define EMBEDDED_IMAGE_MAX_ENTRIES 16
 
 /**
  * @brief Enumeration representing the common JPEG markers.
@@ -46,18 +59,27 @@ THE SOFTWARE.
 enum JpegMarkers {
     SOI = 0xD8, /**< Start Of Image */
     SOF = 0xC0, /**< Start Of Frame for a baseline DCT-based JPEG. */
+    SOF1 = 0xC1, /**< Start Of Frame for an extended sequential DCT-based JPEG. */
+    SOF2 = 0xC2, /**< Start Of Frame for a progressive DCT-based JPEG. */
     DHT = 0xC4, /**< Define Huffman Table */
     DQT = 0xDB, /**< Define Quantization Table */
     DRI = 0xDD, /**< Define Restart Interval */
     SOS = 0xDA, /**< Start of Scan */
+    APP1 = 0xE1, /**< Application segment 1 (EXIF) */
+    APP2 = 0xE2, /**< Application segment 2 (Multi-Picture Format) */
+    APP14 = 0xEE, /**< Application segment 14 (Adobe) */
     EOI = 0xD9, /**< End Of Image */
+    RST0 = 0xD0, /**< Restart marker 0 */
+    RST7 = 0xD7, /**< Restart marker 7 */
 };
 
 /**
  * @brief Structure representing the picture parameter buffer.
  *
  * This structure contains information about the picture width, picture height,
- * color components, color space, rotation, and reserved fields.
+ * color components, color space, and rotation. Unlike the VA-API picture parameter buffer,
+ * it only holds the (at most) four components a JPEG frame can have; it is translated to
+ * the VA-API layout when the stream is submitted to the hardware decoder.
  */
 typedef struct PictureParameterBufferType {
     uint16_t picture_width; /**< The width of the picture. */
@@ -67,11 +89,10 @@ typedef struct PictureParameterBufferType {
         uint8_t h_sampling_factor; /**< The horizontal sampling factor. */
         uint8_t v_sampling_factor; /**< The vertical sampling factor. */
         uint8_t quantiser_table_selector; /**< The quantiser table selector. */
-    } components[255]; /**< Array of color components. */
+    } components[NUM_COMPONENTS]; /**< Array of color components. */
     uint8_t num_components; /**< The number of color components. */
     uint8_t color_space; /**< The color space of the picture. */
     uint32_t rotation; /**< The rotation of the picture. */
-    uint32_t reserved[7]; /**< Reserved fields. */
 } PictureParameterBuffer;
 
 /**
@@ -102,17 +123,52 @@ typedef struct QuantizationMatrixBufferType {
  * unused.
  */
 typedef struct HuffmanTableBufferType {
-    uint8_t load_huffman_table[2]; /**< Array indicating which Huffman tables to load. */
+    uint8_t load_huffman_table[VA_HUFFMAN_TABLES]; /**< Array indicating which Huffman tables to load. */
     struct {
         uint8_t num_dc_codes[16]; /**< Array of the number of DC codes for each bit length. */
         uint8_t dc_values[12]; /**< Array of the DC values. */
         uint8_t num_ac_codes[16]; /**< Array of the number of AC codes for each bit length. */
         uint8_t ac_values[162]; /**< Array of the AC values. */
         uint8_t pad[2]; /**< Padding to align the structure. */
-    } huffman_table[2]; /**< Array of two sets of Huffman tables. */
+    } huffman_table[VA_HUFFMAN_TABLES]; /**< Array of two sets of Huffman tables. */
     uint32_t reserved[4]; /**< Reserved field for future use. */
 } HuffmanTableBuffer;
 
+/**
+ * @brief Struct representing a Huffman table defined by a DHT marker.
+ *
+ * A JPEG stream can define four DC and four AC Huffman tables, while the HuffmanTableBuffer passed to the VCN JPEG
+ * decoder has room for two of each. The parser keeps all the tables defined by the stream and assigns the tables
+ * referenced by the scan to the slots of the HuffmanTableBuffer.
+ */
+typedef struct HuffmanTableType {
+    uint8_t num_codes[16]; /**< Array of the number of codes for each bit length. */
+    uint8_t values[HUFFMAN_TABLE_VALUES_MAX_SIZE]; /**< Array of the values, in the order of their codes. */
+    uint32_t num_values; /**< The number of values. */
+    bool is_defined; /**< True if the table was defined by a DHT marker. */
+} HuffmanTable;
+
+/**
+ * @brief Struct representing the Huffman tables in effect for a scan.
+ *
+ * The parser interns the tables of each scan in the table cache; the VA-API Huffman table buffer of the stream is
+ * derived from the tables of its first scan.
+ */
+typedef struct HuffmanTableSetType {
+    HuffmanTable dc_tables[HUFFMAN_TABLES]; /**< The DC tables, indexed by their DHT table ID. */
+    HuffmanTable ac_tables[HUFFMAN_TABLES]; /**< The AC tables, indexed by their DHT table ID. */
+} HuffmanTableSet;
+
+/**
+ * @brief Struct representing the quantization tables in effect for a scan.
+ *
+ * Unlike the VA-API quantization matrix buffer, the tables keep the 16-bit values of the DQT markers.
+ */
+typedef struct QuantizationTableSetType {
+    uint16_t quantiser_table[NUM_COMPONENTS][64]; /**< The quantization tables, in zigzag order. */
+    uint8_t load_quantiser_table[NUM_COMPONENTS]; /**< Array indicating whether a quantization table was defined by a DQT marker. */
+} QuantizationTableSet;
+
 /**
  * @brief Structure representing the slice parameter buffer.
  *
@@ -155,22 +211,154 @@ typedef enum {
     CSS_UNKNOWN = -1
 } ChromaSubsampling;
 
+/**
+ * @brief Enumeration representing the coding process of a JPEG frame, as selected by its SOF marker.
+ *
+ * The sequential processes are decoded by the VCN JPEG decoder when the frame has no feature listed in
+ * JpegHardwareLimitation; the progressive process is decoded by the software entropy decoder.
+ */
+typedef enum {
+    CODING_PROCESS_BASELINE = 0, /**< Baseline sequential DCT (SOF0). */
+    CODING_PROCESS_EXTENDED = 1, /**< Extended sequential DCT, Huffman coding (SOF1). */
+    CODING_PROCESS_PROGRESSIVE = 2, /**< Progressive DCT, Huffman coding (SOF2). */
+} JpegCodingProcess;
+
+/**
+ * @brief Enumeration representing the features of a JPEG stream that the VCN JPEG decoder can't decode.
+ *
+ * The values are bit flags; a stream with any of them set is decoded by the hybrid decoder.
+ */
+typedef enum {
+    HW_LIMITATION_CODING_PROCESS = 0x1, /**< The frame isn't coded with a sequential process. */
+    HW_LIMITATION_SAMPLE_PRECISION = 0x2, /**< The samples have more than 8 bits. */
+    HW_LIMITATION_QUANTIZATION_TABLE = 0x4, /**< A quantization table has values that don't fit in 8 bits. */
+    HW_LIMITATION_HUFFMAN_TABLE = 0x8, /**< The scan references more than two DC or AC Huffman tables, or a table that doesn't fit in a slot. */
+    HW_LIMITATION_NUM_COMPONENTS = 0x10, /**< The frame has four components (CMYK or YCCK). */
+    HW_LIMITATION_MULTI_SCAN = 0x20, /**< The sequential frame is coded in several scans; decoded by the hybrid path, since the VCN JPEG decoder is submitted a single slice. */
+} JpegHardwareLimitation;
+
+/**
+ * @brief Enumeration representing the color transform signaled by the Adobe (APP14) marker.
+ *
+ * Without an Adobe marker, a frame with four components is CMYK. The CMYK samples of the streams with an Adobe marker
+ * are inverted (0 is full ink), as written by Adobe applications.
+ */
+typedef enum {
+    ADOBE_TRANSFORM_NONE = 0, /**< The components are RGB or CMYK. */
+    ADOBE_TRANSFORM_YCBCR = 1, /**< The components are YCbCr. */
+    ADOBE_TRANSFORM_YCCK = 2, /**< The components are YCbCr and K; the YCbCr components hold the inverted CMY inks. */
+} AdobeColorTransform;
+
+/**
+ * @brief Structure representing a scan of a JPEG frame.
+ *
+ * A progressive frame, and a sequential frame whose components are coded in several scans, have one entry per scan;
+ * the other frames have a single scan that spans the slice data. The tables are the ones in effect when the scan
+ * starts, interned in the table cache; consecutive scans share them until a DHT or DQT marker redefines a table.
+ */
+typedef struct JpegScanType {
+    uint32_t data_offset; /**< Offset of the entropy-coded data of the scan, relative to the start of the slice data. */
+    uint32_t data_size; /**< Size of the entropy-coded data, up to the first marker that isn't a RSTn marker. */
+    struct {
+        uint8_t component_selector; /**< The ID of the component, as in the frame header. */
+        uint8_t dc_table_selector; /**< The ID of the DC Huffman table. */
+        uint8_t ac_table_selector; /**< The ID of the AC Huffman table. */
+    } components[NUM_COMPONENTS]; /**< The components of the scan, in the order of the scan header. */
+    uint8_t num_components; /**< The number of components of the scan. */
+    uint8_t spectral_start; /**< The first coefficient of the band, in zigzag order (Ss). */
+    uint8_t spectral_end; /**< The last coefficient of the band, in zigzag order (Se). */
+    uint8_t approximation_high; /**< The successive approximation bit position high (Ah). */
+    uint8_t approximation_low; /**< The successive approximation bit position low (Al). */
+    uint16_t restart_interval; /**< The restart interval of the scan, in MCUs, or 0. */
+    const HuffmanTableSet* huffman_tables; /**< The Huffman tables of the scan. */
+    uint64_t huffman_table_id; /**< The ID of the Huffman tables in the table cache. */
+    const QuantizationTableSet* quantization_tables; /**< The quantization tables of the scan. */
+    uint64_t quantization_table_id; /**< The ID of the quantization tables in the table cache. */
+} JpegScan;
+
+/**
+ * @brief Structure representing an entry of the restart marker index.
+ *
+ * Each entry locates the restart segment that follows an RSTn marker in the scan data.
+ */
+typedef struct RestartMarkerType {
+    uint32_t byte_offset;   /**< Offset of the first byte after the RSTn marker, relative to the start of the slice data. */
+    uint32_t mcu_index;     /**< Index of the first MCU of the restart segment. */
+} RestartMarker;
+
+/**
+ * @brief Enumeration representing the progress of an incremental parse.
+ *
+ * The `IncrementalParseState` enum defines the states of a JPEG stream that is received and parsed in chunks.
+ */
+typedef enum {
+    PARSE_STATE_IDLE = 0, /**< No incremental parse is in progress. */
+    PARSE_STATE_HEADER = 1, /**< Waiting for the rest of the header, up to and including the SOS marker segment. */
+    PARSE_STATE_SCAN = 2, /**< The header is parsed; waiting for the end of the scan data. */
+    PARSE_STATE_COMPLETE = 3, /**< The stream is completely parsed and can be decoded. */
+    PARSE_STATE_FAILED = 4 /**< The stream is invalid. */
+} IncrementalParseState;
+
 /**
  * @brief Structure representing the parameters for a JPEG stream.
  *
  * This structure contains various buffers and data required for processing a JPEG stream.
  * It includes the picture parameter buffer, quantization matrix buffer, Huffman table buffer,
  * slice parameter buffer, chroma subsampling information, and the slice data buffer.
+ * The quantization and Huffman tables are interned in the process-wide table cache and shared by all the streams
+ * that use the same tables; their IDs identify the tables as long as they are referenced. The IDs of the stream are
+ * those of the tables of its first scan, from which the VA-API table buffers are derived.
+ * When a single-scan sequential stream has a restart interval, it also references the restart marker index built by
+ * the parser. The index may be decimated (only every n-th restart segment is recorded) to respect the index size limit.
  */
 typedef struct JpegParameterBuffersType {
     PictureParameterBuffer picture_parameter_buffer;
-    QuantizationMatrixBuffer quantization_matrix_buffer;
-    HuffmanTableBuffer huffman_table_buffer;
+    const QuantizationMatrixBuffer* quantization_matrix_buffer; /**< The quantization tables of the first scan in the VA-API layout (nullptr until the SOS marker is parsed). */
+    const HuffmanTableBuffer* huffman_table_buffer; /**< The Huffman tables of the first scan assigned to the VA-API slots (nullptr until the SOS marker is parsed). */
+    uint64_t quantization_matrix_id; /**< The ID of the quantization tables of the first scan in the table cache. */
+    uint64_t huffman_table_id; /**< The ID of the Huffman tables of the first scan in the table cache. */
     SliceParameterBuffer slice_parameter_buffer;
     ChromaSubsampling chroma_subsampling;
     const uint8_t* slice_data_buffer;
+    const RestartMarker* restart_markers; /**< The restart marker index, owned by the parser (nullptr if not built). */
+    uint32_t num_restart_markers; /**< The number of entries in the restart marker index. */
+    uint32_t restart_marker_stride; /**< The index records the restart segments whose index is a multiple of the stride; 1 if it records every RSTn marker. */
+    uint8_t orientation; /**< The EXIF orientation of the image (1 to 8); 1 if the stream has no valid orientation tag. */
+    JpegCodingProcess coding_process; /**< The coding process of the frame. For a progressive frame, the slice data spans all the scans. */
+    uint8_t sample_precision; /**< The number of bits of the samples (8 or 12). */
+    uint32_t hardware_limitations; /**< The JpegHardwareLimitation flags of the stream; 0 if the VCN JPEG decoder can decode it. */
+    bool has_adobe_marker; /**< True if the stream has an Adobe (APP14) marker. */
+    AdobeColorTransform adobe_color_transform; /**< The color transform of the Adobe marker; ADOBE_TRANSFORM_NONE without the marker. */
+    bool is_huffman_table_remapped; /**< True if the Huffman table selectors of the slice parameter buffer were remapped to other slots than the table IDs. */
+    const JpegScan* scans; /**< The scans of the frame, owned by the parser (nullptr until the end of the scan data is found). */
+    uint32_t num_scans; /**< The number of scans. */
 } JpegStreamParameters;
 
+/**
+ * @brief Enumeration representing where an embedded image is stored in a JPEG stream.
+ */
+typedef enum {
+    EMBEDDED_IMAGE_EXIF_THUMBNAIL = 1, /**< A JPEG thumbnail stored in IFD1 of the EXIF data (APP1). */
+    EMBEDDED_IMAGE_MPF = 2 /**< An individual image listed in the MP Index IFD of the Multi-Picture Format data (APP2). */
+} EmbeddedImageSource;
+
+/**
+ * @brief Structure representing a JPEG image embedded in a JPEG stream.
+ *
+ * The image is located by its offset from the start of the stream rather than by a pointer, so that the entry
+ * stays valid when the buffer of an incremental parse grows.
+ */
+typedef struct EmbeddedImageType {
+    EmbeddedImageSource source; /**< Where the image is stored. */
+    uint32_t offset; /**< Offset of the SOI marker of the image, relative to the start of the stream. */
+    uint32_t length; /**< Length of the image in bytes. */
+    uint16_t width; /**< The width of the image, read from its SOF marker. */
+    uint16_t height; /**< The height of the image, read from its SOF marker. */
+} EmbeddedImage;
+
+struct SharedHuffmanTable;
+struct SharedQuantizationTable;
+
 /**
  * @class RocJpegStreamParser
  * @brief A class for parsing JPEG streams and extracting stream parameters.
@@ -179,6 +367,9 @@ typedef struct JpegParameterBuffersType {
  * such as Start of Image (SOI), Start of Frame (SOF), Quantization Tables (DQT), Start of Scan (SOS),
  * Huffman Tables (DHT), Define Restart Interval (DRI), and End of Image (EOI). It also provides a method to
  * retrieve the parsed JPEG stream parameters.
+ *
+ * A parser is owned by a single stream handle and is not synchronized; the same parser must not be used
+ * from multiple threads at the same time.
  */
 class RocJpegStreamParser {
     public:
@@ -200,13 +391,105 @@ class RocJpegStreamParser {
          */
         bool ParseJpegStream(const uint8_t* jpeg_stream, uint32_t jpeg_stream_size);
 
+        /**
+         * @brief Parses only the header of a JPEG stream, up to and including the SOF marker.
+         *
+         * The picture parameters and the chroma subsampling are valid after a successful call; the scan data is not visited.
+         *
+         * @param jpeg_stream The pointer to the JPEG stream.
+         * @param jpeg_stream_size The size of the JPEG stream.
+         * @return True if the SOF marker is found and successfully parsed, false otherwise.
+         */
+        bool PeekJpegStream(const uint8_t* jpeg_stream, uint32_t jpeg_stream_size);
+
+        /**
+         * @brief Appends a chunk of a JPEG stream and parses as much of the stream as the received data allows.
+         *
+         * The chunks are copied into a buffer owned by the parser. The header is parsed as soon as the SOS marker
+         * segment is received, and the scan data is then searched for the EOI marker as the chunks arrive, so every
+         * byte is visited once. The stream parameters are complete when the state becomes PARSE_STATE_COMPLETE.
+         *
+         * @param chunk The pointer to the chunk.
+         * @param chunk_size The size of the chunk.
+         * @param first_chunk True if the chunk starts a new JPEG stream; any stream in progress is discarded.
+         * @param last_chunk True if no more data follows the chunk; if the EOI marker is missing, the scan data
+         *                   extends to the end of the received data.
+         * @return True if the received data is valid so far, false otherwise.
+         */
+        bool AppendJpegStreamChunk(const uint8_t* chunk, uint32_t chunk_size, bool first_chunk, bool last_chunk);
+
+        /**
+         * @brief Retrieves the state of the incremental parse.
+         * @return The state of the incremental parse.
+         */
+        IncrementalParseState GetIncrementalParseState() const { return incremental_parse_state_; };
+
         /**
          * @brief Retrieves the JPEG stream parameters.
          * @return A pointer to the JpegStreamParameters object.
          */
         const JpegStreamParameters* GetJpegStreamParameters() const { return &jpeg_stream_parameters_; };
 
+        /**
+         * @brief Sets the maximum number of entries of the restart marker index.
+         *
+         * When a stream has more restart segments than the limit, only every n-th segment is recorded, with n
+         * being the smallest power of two that satisfies the limit. A limit of 0 disables the index. The limit
+         * defaults to RESTART_MARKER_INDEX_MAX_ENTRIES and can be set with the ROCJPEG_RESTART_INDEX_SIZE
+         * environment variable.
+         *
+         * @param max_entries The maximum number of entries of the restart marker index.
+         */
+        void SetRestartMarkerIndexLimit(uint32_t max_entries) { restart_marker_index_limit_ = max_entries; };
+
+        /**
+         * @brief Retrieves the JPEG images embedded in the last parsed stream (EXIF thumbnail and MPF images).
+         *
+         * Only the images that are completely contained in the parsed data and whose SOF marker could be read are listed.
+         *
+         * @return The embedded images, in the order they were found.
+         */
+        const std::vector<EmbeddedImage>& GetEmbeddedImages() const { return embedded_images_; };
+
+        /**
+         * @brief Retrieves the start of the last parsed stream; the offsets of the embedded images are relative to it.
+         * @return The pointer to the first byte of the stream.
+         */
+        const uint8_t* GetStreamData() const { return stream_end_ - stream_length_; };
+
+        /**
+         * @brief Retrieves the length of the last parsed stream (the data received so far for an incremental parse).
+         * @return The length of the stream in bytes.
+         */
+        uint32_t GetStreamLength() const { return stream_length_; };
+
     private:
+        /**
+         * @brief Validates the SOI marker and parses the marker segments until the stop marker is parsed.
+         * @param jpeg_stream The pointer to the JPEG stream.
+         * @param jpeg_stream_size The size of the JPEG stream.
+         * @param stop_marker The marker after which parsing stops.
+         * @param stop_marker_found Set to true if the stop marker segment was parsed.
+         * @param dht_marker_found Set to true if a DHT marker segment was parsed.
+         * @param dqt_marker_found Set to true if a DQT marker segment was parsed.
+         * @return True if the visited marker segments are successfully parsed, false otherwise.
+         */
+        bool ParseMarkers(const uint8_t* jpeg_stream, uint32_t jpeg_stream_size, JpegMarkers stop_marker,
+                          bool &stop_marker_found, bool &dht_marker_found, bool &dqt_marker_found);
+
+        /**
+         * @brief Parses the marker segments from the current position until the stop marker is parsed.
+         * @param stop_marker The marker after which parsing stops.
+         * @param wait_for_data If true, a marker segment truncated by the end of the data is not an error; the
+         *                      position is left at the start of that segment so that parsing can resume there.
+         * @param stop_marker_found Set to true if the stop marker segment was parsed.
+         * @param dht_marker_found Set to true if a DHT marker segment was parsed.
+         * @param dqt_marker_found Set to true if a DQT marker segment was parsed.
+         * @return True if the visited marker segments are successfully parsed, false otherwise.
+         */
+        bool ParseMarkerSegments(JpegMarkers stop_marker, bool wait_for_data, bool &stop_marker_found,
+                                 bool &dht_marker_found, bool &dqt_marker_found);
+
         /**
          * @brief Parses the Start of Image (SOI) marker.
          * @return True if the SOI marker is successfully parsed, false otherwise.
@@ -215,9 +498,10 @@ class RocJpegStreamParser {
 
         /**
          * @brief Parses the Start of Frame (SOF) marker.
+         * @param marker The SOF marker of the frame (SOF or SOF2), which selects the coding process.
          * @return True if the SOF marker is successfully parsed, false otherwise.
          */
-        bool ParseSOF();
+        bool ParseSOF(uint8_t marker);
 
         /**
          * @brief Parses the Define Quantization Table (DQT) marker.
@@ -227,9 +511,10 @@ class RocJpegStreamParser {
 
         /**
          * @brief Parses the Start of Scan (SOS) marker.
+         * @param scan The scan that receives the components and the spectral selection of the scan header.
          * @return True if the SOS marker is successfully parsed, false otherwise.
          */
-        bool ParseSOS();
+        bool ParseSOS(JpegScan &scan);
 
         /**
          * @brief Parses the Define Huffman Table (DHT) marker.
@@ -243,12 +528,87 @@ class RocJpegStreamParser {
          */
         bool ParseDRI();
 
+        /**
+         * @brief Parses the APP1 marker and extracts the orientation tag and the thumbnail if the segment holds EXIF data.
+         * @return True if the APP1 marker is successfully parsed, false otherwise. Malformed EXIF data is ignored.
+         */
+        bool ParseAPP1();
+
+        /**
+         * @brief Parses the APP2 marker and extracts the individual images if the segment holds Multi-Picture Format data.
+         * @return True if the APP2 marker is successfully parsed, false otherwise. Malformed MPF data is ignored.
+         */
+        bool ParseAPP2();
+
+        /**
+         * @brief Parses the APP14 marker and extracts the color transform if the segment is an Adobe marker.
+         * @return True if the APP14 marker is successfully parsed, false otherwise. Other APP14 segments are ignored.
+         */
+        bool ParseAPP14();
+
+        /**
+         * @brief Records an embedded JPEG image if it lies within the stream and its frame size can be read.
+         * @param source Where the image is stored.
+         * @param image The pointer to the SOI marker of the image.
+         * @param length The length of the image in bytes.
+         */
+        void AddEmbeddedImage(EmbeddedImageSource source, const uint8_t *image, uint32_t length);
+
         /**
          * @brief Parses the End of Image (EOI) marker.
          * @return True if the EOI marker is successfully parsed, false otherwise.
          */
         bool ParseEOI();
 
+        /**
+         * @brief Searches the scan data for the EOI marker and records the RSTn markers in the restart marker index.
+         * @param slice_data The pointer to the start of the scan data.
+         * @param begin The pointer where the search starts (or resumes).
+         * @return The pointer to the EOI marker, or stream_end_ if it is not found.
+         */
+        const uint8_t* FindEndOfScan(const uint8_t *slice_data, const uint8_t *begin);
+
+        /**
+         * @brief Checks if the parsed frame is sequential and its first scan doesn't hold all the components.
+         * @return True if the components of the frame are coded in several scans, false otherwise.
+         */
+        bool IsMultiScanFrame() const;
+
+        /**
+         * @brief Locates the scans of the frame in the slice data and records the tables in effect for each scan.
+         * @return True if the scans are successfully parsed, false otherwise.
+         */
+        bool ParseScans();
+
+        /**
+         * @brief Sets the slice data and the restart marker index of the stream parameters.
+         * @param slice_data The pointer to the start of the scan data.
+         * @param slice_data_end The pointer past the end of the scan data.
+         */
+        void SetSliceData(const uint8_t *slice_data, const uint8_t *slice_data_end);
+
+        /**
+         * @brief Resets the quantization and Huffman tables before a new stream is parsed.
+         */
+        void ResetTables();
+
+        /**
+         * @brief Assigns the Huffman tables referenced by the first scan to the two slots of the Huffman table buffer.
+         */
+        void AssignHuffmanTableSlots();
+
+        /**
+         * @brief Interns the tables of the first scan in the table cache and derives the VA-API table buffers from them.
+         */
+        void InternTables();
+
+        /**
+         * @brief Records a restart segment in the restart marker index, decimating the index when it is full.
+         * @param byte_offset The offset of the restart segment relative to the start of the slice data.
+         * @param segment_index The index of the restart segment (the first segment after SOS has index 0).
+         */
+        void AddRestartMarker(uint32_t byte_offset, uint32_t segment_index);
+
         /**
          * @brief Retrieves the chroma subsampling information.
          * @param c1_h_sampling_factor The horizontal sampling factor for component 1.
@@ -266,7 +626,27 @@ class RocJpegStreamParser {
         const uint8_t *stream_end_; ///< Pointer to the end of the JPEG stream.
         uint32_t stream_length_; ///< Length of the JPEG stream.
         JpegStreamParameters jpeg_stream_parameters_; ///< JPEG stream parameters.
-        std::mutex mutex_; ///< Mutex for thread safety.
+        QuantizationTableSet quantization_tables_; ///< The quantization tables defined so far by the stream.
+        HuffmanTableSet huffman_tables_; ///< The Huffman tables defined so far by the stream.
+        QuantizationMatrixBuffer quantization_matrix_buffer_; ///< The quantization tables of the first scan, in the VA-API layout.
+        HuffmanTableBuffer huffman_table_buffer_; ///< The Huffman tables of the first scan, assigned to the slots.
+        std::shared_ptr<const SharedQuantizationTable> quantization_table_ref_; ///< The interned quantization tables of the first scan.
+        std::shared_ptr<const SharedHuffmanTable> huffman_table_ref_; ///< The interned Huffman tables of the first scan.
+        std::vector<std::shared_ptr<const SharedQuantizationTable>> scan_quantization_table_refs_; ///< The interned quantization tables redefined between the scans.
+        std::vector<std::shared_ptr<const SharedHuffmanTable>> scan_huffman_table_refs_; ///< The interned Huffman tables redefined between the scans.
+        RocJpegMarkerScanner marker_scanner_; ///< Scanner used to locate the markers in the JPEG stream.
+        std::vector<RestartMarker> restart_markers_; ///< The restart marker index of the last parsed stream.
+        uint32_t restart_marker_index_limit_; ///< Maximum number of entries of the restart marker index.
+        uint32_t restart_marker_stride_; ///< Only the restart segments whose index is a multiple of the stride are recorded.
+        uint32_t num_restart_segments_; ///< The number of RSTn markers visited in the scan data.
+        std::vector<EmbeddedImage> embedded_images_; ///< The embedded images of the last parsed stream.
+        std::vector<JpegScan> scans_; ///< The scans of the frame; the first one is recorded when the SOS marker is parsed.
+        std::vector<uint8_t> chunk_buffer_; ///< The data received so far by the incremental parser.
+        IncrementalParseState incremental_parse_state_; ///< The state of the incremental parse.
+        uint32_t resume_offset_; ///< Offset in chunk_buffer_ where the incremental parse resumes.
+        uint32_t scan_offset_; ///< Offset of the scan data in chunk_buffer_.
+        bool dht_marker_found_; ///< True if the incremental parse found a DHT marker segment.
+        bool dqt_marker_found_; ///< True if the incremental parse found a DQT marker segment.
 };
 
 #endif  // ROC_JPEG_PARSER_H_
\ No newline at end of file
@@ -0,0 +1,98 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include <cstdlib>
+#include "rocjpeg_commons.h"
+#include "rocjpeg_simd_dispatch.h"
+
+/**
+ * @brief Detects the highest SIMD level supported by the CPU.
+ *
+ * @return The highest supported SIMD level.
+ */
+static SimdLevel DetectSimdLevel() {
+#if ROCJPEG_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+        return kSimdAvx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return kSimdAvx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return kSimdSse2;
+    }
+#endif
+    return kSimdScalar;
+}
+
+/**
+ * @brief Returns the SIMD level to be used by the host-side code paths.
+ *
+ * The CPU features are detected only once. If the ROCJPEG_SIMD_LEVEL environment variable is set to a level
+ * lower than the detected one, the requested level is used instead.
+ *
+ * @return The selected SIMD level.
+ */
+SimdLevel GetSimdLevel() {
+    static const SimdLevel simd_level = [] {
+        SimdLevel detected_level = DetectSimdLevel();
+        char requested_level[32];
+        if (!GetEnv("ROCJPEG_SIMD_LEVEL", requested_level, sizeof(requested_level))) {
+            return detected_level;
+        }
+        SimdLevel level = detected_level;
+        if (!strcmp(requested_level, "scalar")) {
+            level = kSimdScalar;
+        } else if (!strcmp(requested_level, "sse2")) {
+            level = kSimdSse2;
+        } else if (!strcmp(requested_level, "avx2")) {
+            level = kSimdAvx2;
+        } else if (!strcmp(requested_level, "avx512")) {
+            level = kSimdAvx512;
+        } else {
+            ERR("unknown ROCJPEG_SIMD_LEVEL value: " + STR(requested_level));
+        }
+        return level < detected_level ? level : detected_level;
+    }();
+    return simd_level;
+}
+
+/**
+ * @brief Returns a printable name for the given SIMD level.
+ *
+ * @param simd_level The SIMD level.
+ * @return The name of the SIMD level.
+ */
+const char* GetSimdLevelName(SimdLevel simd_level) {
+    switch (simd_level) {
+        case kSimdScalar:
+            return "scalar";
+        case kSimdSse2:
+            return "sse2";
+        case kSimdAvx2:
+            return "avx2";
+        case kSimdAvx512:
+            return "avx512";
+        default:
+            return "unknown";
+    }
+}
@@ -0,0 +1,63 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef ROC_JPEG_SIMD_DISPATCH_H_
+#define ROC_JPEG_SIMD_DISPATCH_H_
+
+#pragma once
+
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define ROCJPEG_X86_SIMD 1
+#endif
+
+/**
+ * @brief Enumeration representing the SIMD instruction set levels used by the host-side code paths.
+ *
+ * The levels are ordered, i.e., a CPU supporting a given level is expected to support all the lower levels.
+ */
+typedef enum {
+    kSimdScalar = 0, /**< Portable C++ code path. */
+    kSimdSse2 = 1, /**< 128-bit SSE2 code path. */
+    kSimdAvx2 = 2, /**< 256-bit AVX2 code path. */
+    kSimdAvx512 = 3, /**< 512-bit AVX-512 (F + BW) code path. */
+} SimdLevel;
+
+/**
+ * @brief Returns the SIMD level to be used by the host-side code paths.
+ *
+ * The level is detected once from the CPU features at runtime. It can be lowered (never raised) with the
+ * ROCJPEG_SIMD_LEVEL environment variable, which accepts one of "scalar", "sse2", "avx2", or "avx512".
+ *
+ * @return The selected SIMD level.
+ */
+SimdLevel GetSimdLevel();
+
+/**
+ * @brief Returns a printable name for the given SIMD level.
+ * @param simd_level The SIMD level.
+ * @return The name of the SIMD level.
+ */
+const char* GetSimdLevelName(SimdLevel simd_level);
+
+#endif  // ROC_JPEG_SIMD_DISPATCH_H_
@@ -0,0 +1,157 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include <cstdlib>
+#include "rocjpeg_table_cache.h"
+
+/**
+ * @brief Computes a 64-bit hash of a table.
+ *
+ * The table is consumed in 8-byte words with a multiply-xorshift mix, which is much faster than a byte-wise hash
+ * for the ~0.5-2 KB table sets. The parser zero-fills the unused entries of the tables, so identical tables
+ * have identical bytes.
+ *
+ * @param data A pointer to the table.
+ * @param size The size of the table in bytes.
+ * @return The hash of the table.
+ */
+static uint64_t HashTable(const void *data, size_t size) {
+    const uint64_t kMultiplier = 0x9E3779B97F4A7C15ULL;
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    uint64_t hash = size * kMultiplier;
+    uint64_t word;
+    size_t i = 0;
+    for (; i + sizeof(word) <= size; i += sizeof(word)) {
+        std::memcpy(&word, bytes + i, sizeof(word));
+        hash = (hash ^ word) * kMultiplier;
+        hash ^= hash >> 32;
+    }
+    if (i < size) {
+        word = 0;
+        std::memcpy(&word, bytes + i, size - i);
+        hash = (hash ^ word) * kMultiplier;
+        hash ^= hash >> 32;
+    }
+    return hash;
+}
+
+RocJpegTableCache::RocJpegTableCache(uint32_t max_entries) : max_entries_{max_entries}, next_table_id_{1} {
+    huffman_tables_.stats = {};
+    quantization_tables_.stats = {};
+}
+
+/**
+ * @brief Returns the process-wide table cache.
+ *
+ * The cache is created on first use. Its size limit is the value of the ROCJPEG_TABLE_CACHE_SIZE environment
+ * variable if set, otherwise TABLE_CACHE_DEFAULT_MAX_ENTRIES.
+ *
+ * @return A reference to the process-wide table cache.
+ */
+RocJpegTableCache& RocJpegTableCache::GetInstance() {
+    static RocJpegTableCache table_cache([] {
+        uint32_t max_entries = TABLE_CACHE_DEFAULT_MAX_ENTRIES;
+        char requested_max_entries[16];
+        if (GetEnv("ROCJPEG_TABLE_CACHE_SIZE", requested_max_entries, sizeof(requested_max_entries))) {
+            int value = atoi(requested_max_entries);
+            if (value >= 0) {
+                max_entries = static_cast<uint32_t>(value);
+            }
+        }
+        return max_entries;
+    }());
+    return table_cache;
+}
+
+std::shared_ptr<const SharedHuffmanTable> RocJpegTableCache::Intern(const HuffmanTableSet &buffer) {
+    return InternTable(huffman_tables_, buffer);
+}
+
+std::shared_ptr<const SharedQuantizationTable> RocJpegTableCache::Intern(const QuantizationTableSet &buffer) {
+    return InternTable(quantization_tables_, buffer);
+}
+
+/**
+ * @brief Retrieves the statistics of the cache.
+ *
+ * @param huffman_table_stats The statistics of the Huffman tables.
+ * @param quantization_table_stats The statistics of the quantization tables.
+ */
+void RocJpegTableCache::GetStats(TableCacheStats &huffman_table_stats, TableCacheStats &quantization_table_stats) {
+    {
+        std::lock_guard<std::mutex> lock(huffman_tables_.mutex);
+        huffman_table_stats = huffman_tables_.stats;
+    }
+    std::lock_guard<std::mutex> lock(quantization_tables_.mutex);
+    quantization_table_stats = quantization_tables_.stats;
+}
+
+/**
+ * @brief Looks up a table in a table set and adds it if it isn't found.
+ *
+ * The table is hashed outside of the lock. On a hit, the table is compared byte by byte with the candidates of
+ * the same hash and moved to the front of the least recently used list. On a miss, a new shared copy with a new
+ * ID is added to the front, and the least recently used table is evicted when the set is full.
+ *
+ * @param table_set The table set.
+ * @param buffer The table.
+ * @return A reference to the shared copy of the table.
+ */
+template <typename SharedTableType, typename BufferType>
+std::shared_ptr<const SharedTableType> RocJpegTableCache::InternTable(TableSet<SharedTableType> &table_set, const BufferType &buffer) {
+    uint64_t hash = HashTable(&buffer, sizeof(buffer));
+
+    std::lock_guard<std::mutex> lock(table_set.mutex);
+    auto range = table_set.index.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (std::memcmp(&(*it->second)->buffer, &buffer, sizeof(buffer)) == 0) {
+            table_set.tables.splice(table_set.tables.begin(), table_set.tables, it->second);
+            table_set.stats.hits++;
+            return *it->second;
+        }
+    }
+
+    auto shared_table = std::make_shared<SharedTableType>();
+    std::memcpy(&shared_table->buffer, &buffer, sizeof(buffer));
+    shared_table->id = next_table_id_++;
+    table_set.stats.misses++;
+    if (max_entries_ == 0) {
+        return shared_table;
+    }
+
+    if (table_set.tables.size() >= max_entries_) {
+        auto lru_table = std::prev(table_set.tables.end());
+        auto lru_range = table_set.index.equal_range(HashTable(&(*lru_table)->buffer, sizeof(buffer)));
+        for (auto it = lru_range.first; it != lru_range.second; ++it) {
+            if (it->second == lru_table) {
+                table_set.index.erase(it);
+                break;
+            }
+        }
+        table_set.tables.erase(lru_table);
+        table_set.stats.evictions++;
+    }
+    table_set.tables.push_front(shared_table);
+    table_set.index.emplace(hash, table_set.tables.begin());
+    table_set.stats.num_entries = static_cast<uint32_t>(table_set.tables.size());
+
+    return shared_table;
+}
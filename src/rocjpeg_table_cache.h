@@ -0,0 +1,138 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef ROC_JPEG_TABLE_CACHE_H_
+#define ROC_JPEG_TABLE_CACHE_H_
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include "rocjpeg_parser.h"
+
+#define TABLE_CACHE_DEFAULT_MAX_ENTRIES 1024
+
+/**
+ * @brief Structure representing a set of Huffman tables interned by the table cache.
+ */
+struct SharedHuffmanTable {
+    HuffmanTableSet buffer; /**< The Huffman tables. */
+    uint64_t id; /**< The ID of the tables; an ID is never reused within the process. */
+};
+
+/**
+ * @brief Structure representing a set of quantization tables interned by the table cache.
+ */
+struct SharedQuantizationTable {
+    QuantizationTableSet buffer; /**< The quantization tables. */
+    uint64_t id; /**< The ID of the tables; an ID is never reused within the process. */
+};
+
+/**
+ * @brief Structure representing the statistics of one kind of table in the table cache.
+ */
+typedef struct TableCacheStatsType {
+    uint64_t hits; /**< The number of lookups that found the table in the cache. */
+    uint64_t misses; /**< The number of lookups that added a new table to the cache. */
+    uint64_t evictions; /**< The number of tables evicted from the cache. */
+    uint32_t num_entries; /**< The number of tables in the cache. */
+} TableCacheStats;
+
+/**
+ * @class RocJpegTableCache
+ * @brief A process-wide, bounded cache that interns the Huffman and quantization tables of the JPEG streams.
+ *
+ * Large datasets are usually produced by a few encoders, so the same DHT and DQT payloads appear in many streams.
+ * The parser interns the tables of each stream: identical tables are shared by all the streams that use them, and
+ * each distinct set of tables gets an ID that the decoders use to reuse what they prepared for it (e.g., the VA-API
+ * buffers derived from the tables, or the Huffman decoding tables of the CPU entropy decoder). The cache holds the
+ * most recently used tables up to its size limit; an evicted table stays alive until the last stream referencing it
+ * releases it. The size limit defaults to TABLE_CACHE_DEFAULT_MAX_ENTRIES tables of each kind and can be set with the
+ * ROCJPEG_TABLE_CACHE_SIZE environment variable (0 disables sharing).
+ * All the methods are thread safe.
+ */
+class RocJpegTableCache {
+    public:
+        /**
+         * @brief Constructs a RocJpegTableCache object.
+         * @param max_entries The maximum number of tables of each kind held by the cache.
+         */
+        explicit RocJpegTableCache(uint32_t max_entries);
+
+        /**
+         * @brief Returns the process-wide table cache.
+         * @return A reference to the process-wide table cache.
+         */
+        static RocJpegTableCache& GetInstance();
+
+        /**
+         * @brief Interns a set of Huffman tables.
+         * @param buffer The Huffman tables.
+         * @return A reference to the shared copy of the tables.
+         */
+        std::shared_ptr<const SharedHuffmanTable> Intern(const HuffmanTableSet &buffer);
+
+        /**
+         * @brief Interns a set of quantization tables.
+         * @param buffer The quantization tables.
+         * @return A reference to the shared copy of the tables.
+         */
+        std::shared_ptr<const SharedQuantizationTable> Intern(const QuantizationTableSet &buffer);
+
+        /**
+         * @brief Retrieves the statistics of the cache.
+         * @param huffman_table_stats The statistics of the Huffman tables.
+         * @param quantization_table_stats The statistics of the quantization tables.
+         */
+        void GetStats(TableCacheStats &huffman_table_stats, TableCacheStats &quantization_table_stats);
+
+    private:
+        /**
+         * @brief The tables of one kind held by the cache, in least recently used order.
+         */
+        template <typename SharedTableType>
+        struct TableSet {
+            std::list<std::shared_ptr<const SharedTableType>> tables; ///< The tables, the most recently used first.
+            std::unordered_multimap<uint64_t, typename std::list<std::shared_ptr<const SharedTableType>>::iterator> index; ///< The tables by hash.
+            TableCacheStats stats; ///< The statistics of the tables.
+            std::mutex mutex; ///< Mutex protecting the table set.
+        };
+
+        /**
+         * @brief Looks up a table in a table set and adds it if it isn't found.
+         * @param table_set The table set.
+         * @param buffer The table.
+         * @return A reference to the shared copy of the table.
+         */
+        template <typename SharedTableType, typename BufferType>
+        std::shared_ptr<const SharedTableType> InternTable(TableSet<SharedTableType> &table_set, const BufferType &buffer);
+
+        uint32_t max_entries_; ///< The maximum number of tables of each kind.
+        std::atomic<uint64_t> next_table_id_; ///< The ID of the next new table.
+        TableSet<SharedHuffmanTable> huffman_tables_; ///< The Huffman tables.
+        TableSet<SharedQuantizationTable> quantization_tables_; ///< The quantization tables.
+};
+
+#endif  // ROC_JPEG_TABLE_CACHE_H_
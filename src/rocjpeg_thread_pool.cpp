@@ -0,0 +1,150 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <cstdlib>
+#include "rocjpeg_commons.h"
+#include "rocjpeg_thread_pool.h"
+
+RocJpegThreadPool::RocJpegThreadPool(int num_threads) : shutdown_{false} {
+    for (int i = 1; i < num_threads; i++) {
+        workers_.emplace_back(&RocJpegThreadPool::WorkerLoop, this);
+    }
+}
+
+RocJpegThreadPool::~RocJpegThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        shutdown_ = true;
+    }
+    cond_var_.notify_all();
+    for (auto &worker : workers_) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Returns the process-wide thread pool.
+ *
+ * The pool is created on first use. Its size is the value of the ROCJPEG_NUM_THREADS environment variable if set,
+ * otherwise the number of hardware threads.
+ *
+ * @return A reference to the process-wide thread pool.
+ */
+RocJpegThreadPool& RocJpegThreadPool::GetInstance() {
+    static RocJpegThreadPool thread_pool([] {
+        int num_threads = static_cast<int>(std::thread::hardware_concurrency());
+        char requested_num_threads[16];
+        if (GetEnv("ROCJPEG_NUM_THREADS", requested_num_threads, sizeof(requested_num_threads))) {
+            int value = atoi(requested_num_threads);
+            if (value > 0) {
+                num_threads = value;
+            } else {
+                ERR("invalid ROCJPEG_NUM_THREADS value: " + STR(requested_num_threads));
+            }
+        }
+        return num_threads > 0 ? num_threads : 1;
+    }());
+    return thread_pool;
+}
+
+/**
+ * @brief The loop run by each worker thread.
+ *
+ * Each worker waits for a task, runs it without holding the lock, and exits once the pool shuts down
+ * and the queue is empty.
+ */
+void RocJpegThreadPool::WorkerLoop() {
+    std::function<void()> task;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cond_var_.wait(lock, [&] { return shutdown_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop();
+        }
+        task();
+    }
+}
+
+/**
+ * @brief Runs job(i) for every i in [0, num_jobs) on the pool and waits for all of them to complete.
+ *
+ * One runner task per helping worker is queued; every runner, as well as the calling thread, pulls the next
+ * iteration index from a shared atomic counter until all the iterations are taken. The call returns once the
+ * last iteration has finished, so `job` only needs to outlive this call. Runners that start after all the
+ * iterations are taken return immediately.
+ *
+ * @param num_jobs The number of iterations.
+ * @param job The function to be called for each iteration.
+ */
+void RocJpegThreadPool::ParallelFor(int num_jobs, const std::function<void(int)> &job) {
+    if (num_jobs <= 0) {
+        return;
+    }
+    int num_helpers = std::min(static_cast<int>(workers_.size()), num_jobs - 1);
+    if (num_helpers == 0) {
+        for (int i = 0; i < num_jobs; i++) {
+            job(i);
+        }
+        return;
+    }
+
+    struct LoopState {
+        std::atomic<int> next_index{0};
+        int num_completed = 0;
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+    auto state = std::make_shared<LoopState>();
+    const std::function<void(int)> *job_ptr = &job;
+    auto runner = [state, job_ptr, num_jobs]() {
+        int num_run = 0;
+        for (int i = state->next_index.fetch_add(1); i < num_jobs; i = state->next_index.fetch_add(1)) {
+            (*job_ptr)(i);
+            num_run++;
+        }
+        if (num_run > 0) {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            state->num_completed += num_run;
+            if (state->num_completed == num_jobs) {
+                state->done.notify_one();
+            }
+        }
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (int i = 0; i < num_helpers; i++) {
+            tasks_.emplace(runner);
+        }
+    }
+    cond_var_.notify_all();
+
+    runner();
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->done.wait(lock, [&] { return state->num_completed == num_jobs; });
+}
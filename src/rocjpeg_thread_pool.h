@@ -0,0 +1,89 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#ifndef ROC_JPEG_THREAD_POOL_H_
+#define ROC_JPEG_THREAD_POOL_H_
+
+#pragma once
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+/**
+ * @class RocJpegThreadPool
+ * @brief A pool of worker threads used by the host-side code paths of rocJPEG.
+ *
+ * The pool runs index-based parallel loops: the iterations are handed out dynamically to the workers and to
+ * the calling thread, so uneven iteration costs (e.g., JPEG streams of very different sizes) are balanced.
+ * A process-wide instance is shared by all the rocJPEG handles; its size defaults to the number of hardware
+ * threads and can be set with the ROCJPEG_NUM_THREADS environment variable.
+ */
+class RocJpegThreadPool {
+    public:
+        /**
+         * @brief Constructs a RocJpegThreadPool object.
+         * @param num_threads The total number of threads running a parallel loop, including the calling thread.
+         */
+        explicit RocJpegThreadPool(int num_threads);
+
+        /**
+         * @brief Destroys the RocJpegThreadPool object and joins the worker threads.
+         */
+        ~RocJpegThreadPool();
+
+        /**
+         * @brief Returns the process-wide thread pool.
+         * @return A reference to the process-wide thread pool.
+         */
+        static RocJpegThreadPool& GetInstance();
+
+        /**
+         * @brief Returns the number of threads running a parallel loop, including the calling thread.
+         * @return The number of threads.
+         */
+        int GetNumThreads() const { return static_cast<int>(workers_.size()) + 1; }
+
+        /**
+         * @brief Runs job(i) for every i in [0, num_jobs) on the pool and waits for all of them to complete.
+         * @param num_jobs The number of iterations.
+         * @param job The function to be called for each iteration; it must not throw.
+         */
+        void ParallelFor(int num_jobs, const std::function<void(int)> &job);
+
+    private:
+        /**
+         * @brief The loop run by each worker thread.
+         */
+        void WorkerLoop();
+
+        std::vector<std::thread> workers_; ///< The worker threads.
+        std::queue<std::function<void()>> tasks_; ///< The pending tasks.
+        std::mutex mutex_; ///< Mutex protecting the task queue.
+        std::condition_variable cond_var_; ///< Signals the workers that a task is pending or the pool shuts down.
+        bool shutdown_; ///< Set when the pool is destroyed.
+};
+
+#endif  // ROC_JPEG_THREAD_POOL_H_
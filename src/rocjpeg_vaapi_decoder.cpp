@@ -290,7 +290,7 @@ bool RocJpegVaapiMemoryPool::SetSurfaceAsIdle(VASurfaceID surface_id) {
 RocJpegVappiDecoder::RocJpegVappiDecoder(int device_id) : device_id_{device_id}, drm_fd_{-1}, min_picture_width_{64}, min_picture_height_{64},
     max_picture_width_{4096}, max_picture_height_{4096}, va_display_{0}, va_config_attrib_{{}}, va_config_id_{0}, va_profile_{VAProfileJPEGBaseline},
     vaapi_mem_pool_(std::make_unique<RocJpegVaapiMemoryPool>()), current_vcn_jpeg_spec_{0}, va_picture_parameter_buf_id_{0}, va_quantization_matrix_buf_id_{0}, va_huffmantable_buf_id_{0},
-    va_slice_param_buf_id_{0}, va_slice_data_buf_id_{0} {
+    va_slice_param_buf_id_{0}, va_slice_data_buf_id_{0}, va_picture_parameter_buffer_{}, va_quantization_matrix_id_{0}, va_huffman_table_id_{0} {
         vcn_jpeg_spec_ = {{"gfx908", {2, false, false}},
                           {"gfx90a", {2, false, false}},
                           {"gfx942_mi300a", {24, true, true}},
@@ -540,10 +540,12 @@ RocJpegStatus RocJpegVappiDecoder::DestroyDataBuffers() {
     if (va_quantization_matrix_buf_id_) {
         CHECK_VAAPI(vaDestroyBuffer(va_display_, va_quantization_matrix_buf_id_));
         va_quantization_matrix_buf_id_ = 0;
+        va_quantization_matrix_id_ = 0;
     }
     if (va_huffmantable_buf_id_) {
         CHECK_VAAPI(vaDestroyBuffer(va_display_, va_huffmantable_buf_id_));
         va_huffmantable_buf_id_ = 0;
+        va_huffman_table_id_ = 0;
     }
     if (va_slice_param_buf_id_) {
         CHECK_VAAPI(vaDestroyBuffer(va_display_, va_slice_param_buf_id_));
@@ -556,6 +558,55 @@ RocJpegStatus RocJpegVappiDecoder::DestroyDataBuffers() {
     return ROCJPEG_STATUS_SUCCESS;
 }
 
+/**
+ * @brief Creates the data buffers of a JPEG stream.
+ *
+ * The picture parameter, slice parameter, and slice data buffers are created for every image. The quantization
+ * matrix and Huffman table buffers are only created when the tables differ from those of the previous image:
+ * the parser interns the tables, so images produced by the same encoder have the same table IDs and the VA-API
+ * buffers created for the previous image are submitted again.
+ *
+ * @param jpeg_stream_params The JPEG stream parameters.
+ * @return The status of the operation. Returns ROCJPEG_STATUS_SUCCESS if the data buffers were successfully created.
+ */
+RocJpegStatus RocJpegVappiDecoder::CreateDataBuffers(const JpegStreamParameters *jpeg_stream_params) {
+    if (va_picture_parameter_buf_id_) {
+        CHECK_VAAPI(vaDestroyBuffer(va_display_, va_picture_parameter_buf_id_));
+        va_picture_parameter_buf_id_ = 0;
+    }
+    if (va_slice_param_buf_id_) {
+        CHECK_VAAPI(vaDestroyBuffer(va_display_, va_slice_param_buf_id_));
+        va_slice_param_buf_id_ = 0;
+    }
+    if (va_slice_data_buf_id_) {
+        CHECK_VAAPI(vaDestroyBuffer(va_display_, va_slice_data_buf_id_));
+        va_slice_data_buf_id_ = 0;
+    }
+
+    CHECK_VAAPI(vaCreateBuffer(va_display_, va_context_id_, VAPictureParameterBufferType, sizeof(VAPictureParameterBufferJPEGBaseline), 1, &va_picture_parameter_buffer_, &va_picture_parameter_buf_id_));
+    if (va_quantization_matrix_buf_id_ == 0 || va_quantization_matrix_id_ != jpeg_stream_params->quantization_matrix_id) {
+        if (va_quantization_matrix_buf_id_) {
+            CHECK_VAAPI(vaDestroyBuffer(va_display_, va_quantization_matrix_buf_id_));
+            va_quantization_matrix_buf_id_ = 0;
+        }
+        CHECK_VAAPI(vaCreateBuffer(va_display_, va_context_id_, VAIQMatrixBufferType, sizeof(VAIQMatrixBufferJPEGBaseline), 1, (void *)jpeg_stream_params->quantization_matrix_buffer, &va_quantization_matrix_buf_id_));
+        va_quantization_matrix_id_ = jpeg_stream_params->quantization_matrix_id;
+    }
+    // the slots of remapped Huffman tables depend on the scan, so their buffer isn't identified by the table ID
+    if (va_huffmantable_buf_id_ == 0 || va_huffman_table_id_ != jpeg_stream_params->huffman_table_id || jpeg_stream_params->is_huffman_table_remapped) {
+        if (va_huffmantable_buf_id_) {
+            CHECK_VAAPI(vaDestroyBuffer(va_display_, va_huffmantable_buf_id_));
+            va_huffmantable_buf_id_ = 0;
+        }
+        CHECK_VAAPI(vaCreateBuffer(va_display_, va_context_id_, VAHuffmanTableBufferType, sizeof(VAHuffmanTableBufferJPEGBaseline), 1, (void *)jpeg_stream_params->huffman_table_buffer, &va_huffmantable_buf_id_));
+        va_huffman_table_id_ = jpeg_stream_params->is_huffman_table_remapped ? 0 : jpeg_stream_params->huffman_table_id;
+    }
+    CHECK_VAAPI(vaCreateBuffer(va_display_, va_context_id_, VASliceParameterBufferType, sizeof(VASliceParameterBufferJPEGBaseline), 1, (void *)&jpeg_stream_params->slice_parameter_buffer, &va_slice_param_buf_id_));
+    CHECK_VAAPI(vaCreateBuffer(va_display_, va_context_id_, VASliceDataBufferType, jpeg_stream_params->slice_parameter_buffer.slice_data_size, 1, (void *)jpeg_stream_params->slice_data_buffer, &va_slice_data_buf_id_));
+
+    return ROCJPEG_STATUS_SUCCESS;
+}
+
 /**
  * @brief Submits a JPEG decode operation to the VAAPI decoder.
  *
@@ -575,10 +626,14 @@ RocJpegStatus RocJpegVappiDecoder::SubmitDecode(const JpegStreamParameters *jpeg
     if (jpeg_stream_params == nullptr || decode_params == nullptr) {
         return ROCJPEG_STATUS_INVALID_PARAMETER;
     }
+    if (jpeg_stream_params->slice_data_buffer == nullptr || jpeg_stream_params->quantization_matrix_buffer == nullptr ||
+        jpeg_stream_params->huffman_table_buffer == nullptr) {
+        ERR("the JPEG stream is not completely parsed!");
+        return ROCJPEG_STATUS_INVALID_PARAMETER;
+    }
 
-    if (sizeof(jpeg_stream_params->picture_parameter_buffer) != sizeof(VAPictureParameterBufferJPEGBaseline) ||
-        sizeof(jpeg_stream_params->quantization_matrix_buffer) != sizeof(VAIQMatrixBufferJPEGBaseline) ||
-        sizeof(jpeg_stream_params->huffman_table_buffer) != sizeof(VAHuffmanTableBufferJPEGBaseline) ||
+    if (sizeof(QuantizationMatrixBuffer) != sizeof(VAIQMatrixBufferJPEGBaseline) ||
+        sizeof(HuffmanTableBuffer) != sizeof(VAHuffmanTableBufferJPEGBaseline) ||
         sizeof(jpeg_stream_params->slice_parameter_buffer) != sizeof(VASliceParameterBufferJPEGBaseline)) {
         return ROCJPEG_STATUS_INVALID_PARAMETER;
     }
@@ -637,25 +692,7 @@ RocJpegStatus RocJpegVappiDecoder::SubmitDecode(const JpegStreamParameters *jpeg
         }
     }
 
-    // if the HW JPEG decoder has a built-in ROI-decode capability then fill the requested crop rectangle to the picture parameter buffer
-    void *picture_parameter_buffer = (void*)&jpeg_stream_params->picture_parameter_buffer;
-    if (current_vcn_jpeg_spec_.can_roi_decode) {
-        uint32_t roi_width;
-        uint32_t roi_height;
-        roi_width = decode_params->crop_rectangle.right - decode_params->crop_rectangle.left;
-        roi_height = decode_params->crop_rectangle.bottom - decode_params->crop_rectangle.top;
-        if (roi_width > 0 && roi_height > 0 && roi_width <= jpeg_stream_params->picture_parameter_buffer.picture_width && roi_height <= jpeg_stream_params->picture_parameter_buffer.picture_height) {
-#if VA_CHECK_VERSION(1, 21, 0)
-            reinterpret_cast<VAPictureParameterBufferJPEGBaseline*>(picture_parameter_buffer)->crop_rectangle.x = decode_params->crop_rectangle.left;
-            reinterpret_cast<VAPictureParameterBufferJPEGBaseline*>(picture_parameter_buffer)->crop_rectangle.y = decode_params->crop_rectangle.top;
-            reinterpret_cast<VAPictureParameterBufferJPEGBaseline*>(picture_parameter_buffer)->crop_rectangle.width = roi_width;
-            reinterpret_cast<VAPictureParameterBufferJPEGBaseline*>(picture_parameter_buffer)->crop_rectangle.height = roi_height;
-#else
-            reinterpret_cast<VAPictureParameterBufferJPEGBaseline*>(picture_parameter_buffer)->va_reserved[0] = decode_params->crop_rectangle.top << 16 | decode_params->crop_rectangle.left;
-            reinterpret_cast<VAPictureParameterBufferJPEGBaseline*>(picture_parameter_buffer)->va_reserved[1] = roi_height << 16 | roi_width;
-#endif
-        }
-    }
+    FillPictureParameterBuffer(jpeg_stream_params->picture_parameter_buffer, decode_params);
 
     uint32_t surface_pixel_format = static_cast<uint32_t>(surface_attrib.value.value.i);
     RocJpegVaapiMemPoolEntry mem_pool_entry = vaapi_mem_pool_->GetEntry(surface_pixel_format, jpeg_stream_params->picture_parameter_buffer.picture_width, jpeg_stream_params->picture_parameter_buffer.picture_height, 1);
@@ -672,13 +709,7 @@ RocJpegStatus RocJpegVappiDecoder::SubmitDecode(const JpegStreamParameters *jpeg
         surface_id = mem_pool_entry.va_surface_ids[0];
     }
 
-    CHECK_ROCJPEG(DestroyDataBuffers());
-
-    CHECK_VAAPI(vaCreateBuffer(va_display_, va_context_id_, VAPictureParameterBufferType, sizeof(VAPictureParameterBufferJPEGBaseline), 1, picture_parameter_buffer, &va_picture_parameter_buf_id_));
-    CHECK_VAAPI(vaCreateBuffer(va_display_, va_context_id_, VAIQMatrixBufferType, sizeof(VAIQMatrixBufferJPEGBaseline), 1, (void *)&jpeg_stream_params->quantization_matrix_buffer, &va_quantization_matrix_buf_id_));
-    CHECK_VAAPI(vaCreateBuffer(va_display_, va_context_id_, VAHuffmanTableBufferType, sizeof(VAHuffmanTableBufferJPEGBaseline), 1, (void *)&jpeg_stream_params->huffman_table_buffer, &va_huffmantable_buf_id_));
-    CHECK_VAAPI(vaCreateBuffer(va_display_, va_context_id_, VASliceParameterBufferType, sizeof(VASliceParameterBufferJPEGBaseline), 1, (void *)&jpeg_stream_params->slice_parameter_buffer, &va_slice_param_buf_id_));
-    CHECK_VAAPI(vaCreateBuffer(va_display_, va_context_id_, VASliceDataBufferType, jpeg_stream_params->slice_parameter_buffer.slice_data_size, 1, (void *)jpeg_stream_params->slice_data_buffer, &va_slice_data_buf_id_));
+    CHECK_ROCJPEG(CreateDataBuffers(jpeg_stream_params));
 
     CHECK_VAAPI(vaBeginPicture(va_display_, va_context_id_,  surface_id));
     CHECK_VAAPI(vaRenderPicture(va_display_, va_context_id_, &va_picture_parameter_buf_id_, 1));
@@ -691,7 +722,19 @@ RocJpegStatus RocJpegVappiDecoder::SubmitDecode(const JpegStreamParameters *jpeg
     return ROCJPEG_STATUS_SUCCESS;
 }
 
-RocJpegStatus RocJpegVappiDecoder::SubmitDecodeBatched(JpegStreamParameters *jpeg_streams_params, int batch_size, const RocJpegDecodeParams *decode_params, uint32_t *surface_ids) {
+/**
+ * @brief Submits a batch of JPEG decode operations to the VAAPI decoder.
+ *
+ * The JPEG streams are grouped by surface format and dimensions, so that the surfaces of each group can be
+ * allocated (or reused from the memory pool) at once, and then each stream is submitted to the hardware decoder.
+ *
+ * @param jpeg_streams_params An array of pointers to the JPEG stream parameters to be decoded.
+ * @param batch_size The number of JPEG streams in the batch.
+ * @param decode_params Additional parameters for the decode operation.
+ * @param surface_ids [out] An array to store the IDs of the output surfaces.
+ * @return The status of the decode operation.
+ */
+RocJpegStatus RocJpegVappiDecoder::SubmitDecodeBatched(const JpegStreamParameters **jpeg_streams_params, int batch_size, const RocJpegDecodeParams *decode_params, uint32_t *surface_ids) {
     if (jpeg_streams_params == nullptr || decode_params == nullptr || surface_ids == nullptr) {
         return ROCJPEG_STATUS_INVALID_PARAMETER;
     }
@@ -701,15 +744,16 @@ RocJpegStatus RocJpegVappiDecoder::SubmitDecodeBatched(JpegStreamParameters *jpe
     // representing the indices of the JPEG streams in the batch.
     std::unordered_map<JpegStreamKey, std::vector<int>> jpeg_stream_groups;
     for (int i = 0; i < batch_size; i++) {
-        if (sizeof(jpeg_streams_params[i].picture_parameter_buffer) != sizeof(VAPictureParameterBufferJPEGBaseline) ||
-            sizeof(jpeg_streams_params[i].quantization_matrix_buffer) != sizeof(VAIQMatrixBufferJPEGBaseline) ||
-            sizeof(jpeg_streams_params[i].huffman_table_buffer) != sizeof(VAHuffmanTableBufferJPEGBaseline) ||
-            sizeof(jpeg_streams_params[i].slice_parameter_buffer) != sizeof(VASliceParameterBufferJPEGBaseline)) {
+        if (jpeg_streams_params[i] == nullptr || jpeg_streams_params[i]->slice_data_buffer == nullptr ||
+            jpeg_streams_params[i]->quantization_matrix_buffer == nullptr || jpeg_streams_params[i]->huffman_table_buffer == nullptr ||
+            sizeof(QuantizationMatrixBuffer) != sizeof(VAIQMatrixBufferJPEGBaseline) ||
+            sizeof(HuffmanTableBuffer) != sizeof(VAHuffmanTableBufferJPEGBaseline) ||
+            sizeof(jpeg_streams_params[i]->slice_parameter_buffer) != sizeof(VASliceParameterBufferJPEGBaseline)) {
             return ROCJPEG_STATUS_INVALID_PARAMETER;
         }
         JpegStreamKey jpeg_stream_key = {};
-        jpeg_stream_key.width = jpeg_streams_params[i].picture_parameter_buffer.picture_width;
-        jpeg_stream_key.height = jpeg_streams_params[i].picture_parameter_buffer.picture_height;
+        jpeg_stream_key.width = jpeg_streams_params[i]->picture_parameter_buffer.picture_width;
+        jpeg_stream_key.height = jpeg_streams_params[i]->picture_parameter_buffer.picture_height;
         if (jpeg_stream_key.width < min_picture_width_ ||
             jpeg_stream_key.height < min_picture_height_ ||
             jpeg_stream_key.width > max_picture_width_ ||
@@ -718,7 +762,7 @@ RocJpegStatus RocJpegVappiDecoder::SubmitDecodeBatched(JpegStreamParameters *jpe
                 return ROCJPEG_STATUS_JPEG_NOT_SUPPORTED;
             }
 
-        if ((decode_params->output_format == ROCJPEG_OUTPUT_RGB || decode_params->output_format == ROCJPEG_OUTPUT_RGB_PLANAR) && current_vcn_jpeg_spec_.can_convert_to_rgb && jpeg_streams_params[i].chroma_subsampling != CSS_440) {
+        if ((decode_params->output_format == ROCJPEG_OUTPUT_RGB || decode_params->output_format == ROCJPEG_OUTPUT_RGB_PLANAR) && current_vcn_jpeg_spec_.can_convert_to_rgb && jpeg_streams_params[i]->chroma_subsampling != CSS_440) {
             if (decode_params->output_format == ROCJPEG_OUTPUT_RGB) {
                 jpeg_stream_key.surface_format = VA_RT_FORMAT_RGB32;
                 jpeg_stream_key.pixel_format = VA_FOURCC_RGBA;
@@ -727,7 +771,7 @@ RocJpegStatus RocJpegVappiDecoder::SubmitDecodeBatched(JpegStreamParameters *jpe
                 jpeg_stream_key.pixel_format = VA_FOURCC_RGBP;
             }
         } else {
-            switch (jpeg_streams_params[i].chroma_subsampling) {
+            switch (jpeg_streams_params[i]->chroma_subsampling) {
                 case CSS_444:
                     jpeg_stream_key.surface_format = VA_RT_FORMAT_YUV444;
                     jpeg_stream_key.pixel_format = VA_FOURCC_444P;
@@ -762,10 +806,6 @@ RocJpegStatus RocJpegVappiDecoder::SubmitDecodeBatched(JpegStreamParameters *jpe
     surface_attrib.type = VASurfaceAttribPixelFormat;
     surface_attrib.flags = VA_SURFACE_ATTRIB_SETTABLE;
     surface_attrib.value.type = VAGenericValueTypeInteger;
-    uint32_t roi_width;
-    uint32_t roi_height;
-    roi_width = decode_params->crop_rectangle.right - decode_params->crop_rectangle.left;
-    roi_height = decode_params->crop_rectangle.bottom - decode_params->crop_rectangle.top;
 
     // Iterate through all entries of jpeg_stream_groups.
     // Check if there is a matching entry in the memory pool.
@@ -797,27 +837,9 @@ RocJpegStatus RocJpegVappiDecoder::SubmitDecodeBatched(JpegStreamParameters *jpe
         }
 
         for (int idx : indices) {
-            // if the HW JPEG decoder has a built-in ROI-decode capability then fill the requested crop rectangle to the picture parameter buffer
-            void* picture_parameter_buffer = &jpeg_streams_params[idx].picture_parameter_buffer;
-            if (current_vcn_jpeg_spec_.can_roi_decode && roi_width > 0 && roi_height > 0 &&
-                roi_width <= jpeg_streams_params[idx].picture_parameter_buffer.picture_width &&
-                roi_height <= jpeg_streams_params[idx].picture_parameter_buffer.picture_height) {
-#if VA_CHECK_VERSION(1, 21, 0)
-            reinterpret_cast<VAPictureParameterBufferJPEGBaseline*>(picture_parameter_buffer)->crop_rectangle.x = decode_params->crop_rectangle.left;
-            reinterpret_cast<VAPictureParameterBufferJPEGBaseline*>(picture_parameter_buffer)->crop_rectangle.y = decode_params->crop_rectangle.top;
-            reinterpret_cast<VAPictureParameterBufferJPEGBaseline*>(picture_parameter_buffer)->crop_rectangle.width = roi_width;
-            reinterpret_cast<VAPictureParameterBufferJPEGBaseline*>(picture_parameter_buffer)->crop_rectangle.height = roi_height;
-#else
-            reinterpret_cast<VAPictureParameterBufferJPEGBaseline*>(picture_parameter_buffer)->va_reserved[0] = decode_params->crop_rectangle.top << 16 | decode_params->crop_rectangle.left;
-            reinterpret_cast<VAPictureParameterBufferJPEGBaseline*>(picture_parameter_buffer)->va_reserved[1] = roi_height << 16 | roi_width;
-#endif
-            }
-            CHECK_ROCJPEG(DestroyDataBuffers());
-            CHECK_VAAPI(vaCreateBuffer(va_display_, va_context_id_, VAPictureParameterBufferType, sizeof(VAPictureParameterBufferJPEGBaseline), 1, picture_parameter_buffer, &va_picture_parameter_buf_id_));
-            CHECK_VAAPI(vaCreateBuffer(va_display_, va_context_id_, VAIQMatrixBufferType, sizeof(VAIQMatrixBufferJPEGBaseline), 1, (void *)&jpeg_streams_params[idx].quantization_matrix_buffer, &va_quantization_matrix_buf_id_));
-            CHECK_VAAPI(vaCreateBuffer(va_display_, va_context_id_, VAHuffmanTableBufferType, sizeof(VAHuffmanTableBufferJPEGBaseline), 1, (void *)&jpeg_streams_params[idx].huffman_table_buffer, &va_huffmantable_buf_id_));
-            CHECK_VAAPI(vaCreateBuffer(va_display_, va_context_id_, VASliceParameterBufferType, sizeof(VASliceParameterBufferJPEGBaseline), 1, (void *)&jpeg_streams_params[idx].slice_parameter_buffer, &va_slice_param_buf_id_));
-            CHECK_VAAPI(vaCreateBuffer(va_display_, va_context_id_, VASliceDataBufferType, jpeg_streams_params[idx].slice_parameter_buffer.slice_data_size, 1, (void *)jpeg_streams_params[idx].slice_data_buffer, &va_slice_data_buf_id_));
+            const JpegStreamParameters *jpeg_stream_params = jpeg_streams_params[idx];
+            FillPictureParameterBuffer(jpeg_stream_params->picture_parameter_buffer, decode_params);
+            CHECK_ROCJPEG(CreateDataBuffers(jpeg_stream_params));
 
             CHECK_VAAPI(vaBeginPicture(va_display_, va_context_id_, surface_ids[idx]));
             CHECK_VAAPI(vaRenderPicture(va_display_, va_context_id_, &va_picture_parameter_buf_id_, 1));
@@ -833,6 +855,52 @@ RocJpegStatus RocJpegVappiDecoder::SubmitDecodeBatched(JpegStreamParameters *jpe
     return ROCJPEG_STATUS_SUCCESS;
 }
 
+/**
+ * @brief Translates the picture parameters of a JPEG stream to the VA-API picture parameter buffer.
+ *
+ * The compact picture parameter buffer of the parser is copied into va_picture_parameter_buffer_, which is
+ * zero-initialized once, so only the components of the frame have to be written for each image. If the HW JPEG
+ * decoder has a built-in ROI-decode capability, the requested crop rectangle is also filled; otherwise the crop
+ * rectangle of the previous image is cleared.
+ *
+ * @param picture_parameter_buffer The picture parameters of the JPEG stream.
+ * @param decode_params Additional parameters for the decode operation.
+ */
+void RocJpegVappiDecoder::FillPictureParameterBuffer(const PictureParameterBuffer &picture_parameter_buffer, const RocJpegDecodeParams *decode_params) {
+    va_picture_parameter_buffer_.picture_width = picture_parameter_buffer.picture_width;
+    va_picture_parameter_buffer_.picture_height = picture_parameter_buffer.picture_height;
+    for (int i = 0; i < NUM_COMPONENTS; i++) {
+        va_picture_parameter_buffer_.components[i].component_id = picture_parameter_buffer.components[i].component_id;
+        va_picture_parameter_buffer_.components[i].h_sampling_factor = picture_parameter_buffer.components[i].h_sampling_factor;
+        va_picture_parameter_buffer_.components[i].v_sampling_factor = picture_parameter_buffer.components[i].v_sampling_factor;
+        va_picture_parameter_buffer_.components[i].quantiser_table_selector = picture_parameter_buffer.components[i].quantiser_table_selector;
+    }
+    va_picture_parameter_buffer_.num_components = picture_parameter_buffer.num_components;
+    va_picture_parameter_buffer_.color_space = picture_parameter_buffer.color_space;
+    va_picture_parameter_buffer_.rotation = picture_parameter_buffer.rotation;
+
+    uint32_t roi_width = 0;
+    uint32_t roi_height = 0;
+    if (current_vcn_jpeg_spec_.can_roi_decode) {
+        roi_width = decode_params->crop_rectangle.right - decode_params->crop_rectangle.left;
+        roi_height = decode_params->crop_rectangle.bottom - decode_params->crop_rectangle.top;
+        if (roi_width == 0 || roi_height == 0 || roi_width > picture_parameter_buffer.picture_width || roi_height > picture_parameter_buffer.picture_height) {
+            roi_width = 0;
+            roi_height = 0;
+        }
+    }
+    bool is_roi_valid = roi_width > 0 && roi_height > 0;
+#if VA_CHECK_VERSION(1, 21, 0)
+    va_picture_parameter_buffer_.crop_rectangle.x = is_roi_valid ? decode_params->crop_rectangle.left : 0;
+    va_picture_parameter_buffer_.crop_rectangle.y = is_roi_valid ? decode_params->crop_rectangle.top : 0;
+    va_picture_parameter_buffer_.crop_rectangle.width = roi_width;
+    va_picture_parameter_buffer_.crop_rectangle.height = roi_height;
+#else
+    va_picture_parameter_buffer_.va_reserved[0] = is_roi_valid ? (decode_params->crop_rectangle.top << 16 | decode_params->crop_rectangle.left) : 0;
+    va_picture_parameter_buffer_.va_reserved[1] = roi_height << 16 | roi_width;
+#endif
+}
+
 /**
  * @brief Synchronizes the specified VASurfaceID.
  *
@@ -89,8 +89,8 @@ struct HipInteropDeviceMem {
     uint32_t width; /**< Width of the surface in pixels. */
     uint32_t height; /**< Height of the surface in pixels. */
     uint32_t size; /**< Size of the surface in pixels. */
-    uint32_t offset[3]; /**< Offset of each plane */
-    uint32_t pitch[3]; /**< Pitch of each plane */
+    uint32_t offset[4]; /**< Offset of each plane (the fourth plane is only used for the four-component surfaces of the hybrid decoder) */
+    uint32_t pitch[4]; /**< Pitch of each plane */
     uint32_t num_layers; /**< Number of layers making up the surface */
 };
 
@@ -316,13 +316,13 @@ public:
     /**
      * Submits a batch of JPEG streams for decoding using the VAAPI decoder.
      *
-     * @param jpeg_streams_params An array of the JPEG streams parameters to be decoded.
+     * @param jpeg_streams_params An array of pointers to the JPEG streams parameters to be decoded.
      * @param batch_size The number of JPEG streams in the batch.
      * @param decode_params The decoding parameters for the VAAPI decoder.
      * @param surface_ids An array to store the surface IDs of the decoded frames.
      * @return The status of the decoding operation.
      */
-    RocJpegStatus SubmitDecodeBatched(JpegStreamParameters *jpeg_streams_params, int batch_size, const RocJpegDecodeParams *decode_params, uint32_t *surface_ids);
+    RocJpegStatus SubmitDecodeBatched(const JpegStreamParameters **jpeg_streams_params, int batch_size, const RocJpegDecodeParams *decode_params, uint32_t *surface_ids);
 
     /**
      * @brief Returns the current VCN JPEG specification.
@@ -330,6 +330,16 @@ public:
      */
     const VcnJpegSpec& GetCurrentVcnJpegSpec() const {return current_vcn_jpeg_spec_;}
 
+    /**
+     * @brief Checks if the VCN JPEG decoder accepts a picture size.
+     * @param width The width of the picture.
+     * @param height The height of the picture.
+     * @return True if the size is within the minimum and maximum picture sizes of the decoder, false otherwise.
+     */
+    bool IsResolutionSupported(uint32_t width, uint32_t height) const {
+        return width >= min_picture_width_ && height >= min_picture_height_ && width <= max_picture_width_ && height <= max_picture_height_;
+    }
+
     /**
      * Sets the specified VASurfaceID as idle.
      *
@@ -358,6 +368,9 @@ private:
     VABufferID va_huffmantable_buf_id_; // The VAAPI Huffman table buffer ID
     VABufferID va_slice_param_buf_id_; // The VAAPI slice parameter buffer ID
     VABufferID va_slice_data_buf_id_; // The VAAPI slice data buffer ID
+    VAPictureParameterBufferJPEGBaseline va_picture_parameter_buffer_; // The VAAPI picture parameter buffer filled at submit time
+    uint64_t va_quantization_matrix_id_; // The ID of the quantization tables in the VAAPI quantization matrix buffer
+    uint64_t va_huffman_table_id_; // The ID of the Huffman tables in the VAAPI Huffman table buffer
 
     /**
      * @brief Initializes the VAAPI with the specified DRM node.
@@ -382,12 +395,26 @@ private:
      */
     RocJpegStatus CreateDecoderContext();
 
+    /**
+     * @brief Translates the picture parameters of a JPEG stream to the VAAPI picture parameter buffer.
+     * @param picture_parameter_buffer The picture parameters of the JPEG stream.
+     * @param decode_params Additional parameters for the decode operation (used for the crop rectangle).
+     */
+    void FillPictureParameterBuffer(const PictureParameterBuffer &picture_parameter_buffer, const RocJpegDecodeParams *decode_params);
+
     /**
      * @brief Destroys the data buffers.
      * @return The status of the buffer destruction.
      */
     RocJpegStatus DestroyDataBuffers();
 
+    /**
+     * @brief Creates the data buffers of a JPEG stream, reusing the table buffers of the previous stream if its tables are the same.
+     * @param jpeg_stream_params The JPEG stream parameters.
+     * @return The status of the buffer creation.
+     */
+    RocJpegStatus CreateDataBuffers(const JpegStreamParameters *jpeg_stream_params);
+
     /**
      * @brief Retrieves the visible devices.
      * @param visible_devices The vector to store the visible devices.